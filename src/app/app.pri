@@ -7,6 +7,8 @@ HEADERS += \
     $$PWD/filelogger.h \
     $$PWD/qtlocalpeer/qtlocalpeer.h \
     $$PWD/signalhandler.h \
+    $$PWD/torrenteventstream.h \
+    $$PWD/torrenthookrunner.h \
     $$PWD/upgrade.h
 
 SOURCES += \
@@ -17,6 +19,8 @@ SOURCES += \
     $$PWD/main.cpp \
     $$PWD/qtlocalpeer/qtlocalpeer.cpp \
     $$PWD/signalhandler.cpp \
+    $$PWD/torrenteventstream.cpp \
+    $$PWD/torrenthookrunner.cpp \
     $$PWD/upgrade.cpp
 
 stacktrace {
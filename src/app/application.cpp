@@ -30,15 +30,14 @@
 #include "application.h"
 
 #include <algorithm>
+#include <chrono>
 
 #ifdef DISABLE_GUI
 #include <cstdio>
 #endif
 
 #ifdef Q_OS_WIN
-#include <memory>
 #include <Windows.h>
-#include <Shellapi.h>
 #elif defined(Q_OS_UNIX)
 #include <sys/resource.h>
 #endif
@@ -47,7 +46,6 @@
 #include <QDebug>
 #include <QLibraryInfo>
 #include <QMetaObject>
-#include <QProcess>
 
 #ifndef DISABLE_GUI
 #include <QMenu>
@@ -66,12 +64,14 @@
 #include "base/bittorrent/infohash.h"
 #include "base/bittorrent/session.h"
 #include "base/bittorrent/torrent.h"
+#include "base/bittorrent/torrentcreationmanager.h"
 #include "base/exceptions.h"
 #include "base/global.h"
 #include "base/iconprovider.h"
 #include "base/logger.h"
 #include "base/net/downloadmanager.h"
 #include "base/net/geoipmanager.h"
+#include "base/net/peermetadataresolver.h"
 #include "base/net/proxyconfigurationmanager.h"
 #include "base/net/smtp.h"
 #include "base/preferences.h"
@@ -88,6 +88,7 @@
 #include "base/version.h"
 #include "applicationinstancemanager.h"
 #include "filelogger.h"
+#include "torrenthookrunner.h"
 #include "upgrade.h"
 
 #ifndef DISABLE_GUI
@@ -107,6 +108,7 @@ namespace
 {
 #define SETTINGS_KEY(name) u"Application/" name
 #define FILELOGGER_SETTINGS_KEY(name) (SETTINGS_KEY(u"FileLogger/") name)
+#define PEERLOG_SETTINGS_KEY(name) (SETTINGS_KEY(u"PeerLog/") name)
 #define NOTIFICATIONS_SETTINGS_KEY(name) (SETTINGS_KEY(u"GUI/Notifications/"_qs) name)
 
     const QString LOG_FOLDER = u"logs"_qs;
@@ -134,6 +136,8 @@ Application::Application(int &argc, char **argv)
     , m_storeFileLoggerAge(FILELOGGER_SETTINGS_KEY(u"Age"_qs))
     , m_storeFileLoggerAgeType(FILELOGGER_SETTINGS_KEY(u"AgeType"_qs))
     , m_storeFileLoggerPath(FILELOGGER_SETTINGS_KEY(u"Path"_qs))
+    , m_storeFileLoggerCompressBackups(FILELOGGER_SETTINGS_KEY(u"CompressBackups"_qs))
+    , m_storeFileLoggerRotationInterval(FILELOGGER_SETTINGS_KEY(u"RotationIntervalHours"_qs))
     , m_storeMemoryWorkingSetLimit(SETTINGS_KEY(u"MemoryWorkingSetLimit"_qs))
 #ifdef Q_OS_WIN
     , m_processMemoryPriority(SETTINGS_KEY(u"ProcessMemoryPriority"_qs))
@@ -205,7 +209,13 @@ Application::Application(int &argc, char **argv)
     }
 
     if (isFileLoggerEnabled())
-        m_fileLogger = new FileLogger(fileLoggerPath(), isFileLoggerBackup(), fileLoggerMaxSize(), isFileLoggerDeleteOld(), fileLoggerAge(), static_cast<FileLogger::FileLogAgeType>(fileLoggerAgeType()));
+        startFileLogger();
+
+    Logger *logger = Logger::instance();
+    const SettingValue<int> peerLogAggregationInterval {PEERLOG_SETTINGS_KEY(u"AggregationIntervalMs"_qs)};
+    logger->setPeerAggregationInterval(std::chrono::milliseconds(peerLogAggregationInterval.get(logger->peerAggregationInterval().count())));
+    const SettingValue<int> peerLogRateLimit {PEERLOG_SETTINGS_KEY(u"RecordRateLimit"_qs)};
+    logger->setPeerRecordRateLimit(peerLogRateLimit.get(logger->peerRecordRateLimit()));
 
     if (m_commandLineArgs.webUiPort > 0) // it will be -1 when user did not set any value
         Preferences::instance()->setWebUiPort(m_commandLineArgs.webUiPort);
@@ -275,7 +285,7 @@ bool Application::isFileLoggerEnabled() const
 void Application::setFileLoggerEnabled(const bool value)
 {
     if (value && !m_fileLogger)
-        m_fileLogger = new FileLogger(fileLoggerPath(), isFileLoggerBackup(), fileLoggerMaxSize(), isFileLoggerDeleteOld(), fileLoggerAge(), static_cast<FileLogger::FileLogAgeType>(fileLoggerAgeType()));
+        startFileLogger();
     else if (!value)
         delete m_fileLogger;
     m_storeFileLoggerEnabled = value;
@@ -342,6 +352,14 @@ void Application::setFileLoggerAge(const int value)
     m_storeFileLoggerAge = std::min(std::max(value, 1), 365);
 }
 
+void Application::startFileLogger()
+{
+    m_fileLogger = new FileLogger(fileLoggerPath(), isFileLoggerBackup(), fileLoggerMaxSize(), isFileLoggerDeleteOld(), fileLoggerAge(), static_cast<FileLogger::FileLogAgeType>(fileLoggerAgeType()));
+    // These have no UI, they are intended for advanced users only
+    m_fileLogger->setCompressBackups(m_storeFileLoggerCompressBackups.get(false));
+    m_fileLogger->setRotationInterval(std::chrono::hours(std::max(0, m_storeFileLoggerRotationInterval.get(0))));
+}
+
 int Application::fileLoggerAgeType() const
 {
     const int val = m_storeFileLoggerAgeType.get(1);
@@ -387,141 +405,6 @@ void Application::processMessage(const QString &message)
         m_paramsQueue.append(params);
 }
 
-void Application::runExternalProgram(const QString &programTemplate, const BitTorrent::Torrent *torrent) const
-{
-    // Cannot give users shell environment by default, as doing so could
-    // enable command injection via torrent name and other arguments
-    // (especially when some automated download mechanism has been setup).
-    // See: https://github.com/qbittorrent/qBittorrent/issues/10925
-
-    const auto replaceVariables = [torrent](QString str) -> QString
-    {
-        for (int i = (str.length() - 2); i >= 0; --i)
-        {
-            if (str[i] != u'%')
-                continue;
-
-            const ushort specifier = str[i + 1].unicode();
-            switch (specifier)
-            {
-            case u'C':
-                str.replace(i, 2, QString::number(torrent->filesCount()));
-                break;
-            case u'D':
-                str.replace(i, 2, torrent->savePath().toString());
-                break;
-            case u'F':
-                str.replace(i, 2, torrent->contentPath().toString());
-                break;
-            case u'G':
-                str.replace(i, 2, torrent->tags().join(u","_qs));
-                break;
-            case u'I':
-                str.replace(i, 2, (torrent->infoHash().v1().isValid() ? torrent->infoHash().v1().toString() : u"-"_qs));
-                break;
-            case u'J':
-                str.replace(i, 2, (torrent->infoHash().v2().isValid() ? torrent->infoHash().v2().toString() : u"-"_qs));
-                break;
-            case u'K':
-                str.replace(i, 2, torrent->id().toString());
-                break;
-            case u'L':
-                str.replace(i, 2, torrent->category());
-                break;
-            case u'N':
-                str.replace(i, 2, torrent->name());
-                break;
-            case u'R':
-                str.replace(i, 2, torrent->rootPath().toString());
-                break;
-            case u'T':
-                str.replace(i, 2, torrent->currentTracker());
-                break;
-            case u'Z':
-                str.replace(i, 2, QString::number(torrent->totalSize()));
-                break;
-            default:
-                // do nothing
-                break;
-            }
-
-            // decrement `i` to avoid unwanted replacement, example pattern: "%%N"
-            --i;
-        }
-
-        return str;
-    };
-
-    const QString logMsg = tr("Running external program. Torrent: \"%1\". Command: `%2`");
-
-    // The processing sequenece is different for Windows and other OS, this is intentional
-#if defined(Q_OS_WIN)
-    const QString program = replaceVariables(programTemplate);
-    const std::wstring programWStr = program.toStdWString();
-
-    // Need to split arguments manually because QProcess::startDetached(QString)
-    // will strip off empty parameters.
-    // E.g. `python.exe "1" "" "3"` will become `python.exe "1" "3"`
-    int argCount = 0;
-    std::unique_ptr<LPWSTR[], decltype(&::LocalFree)> args {::CommandLineToArgvW(programWStr.c_str(), &argCount), ::LocalFree};
-
-    if (argCount <= 0)
-        return;
-
-    QStringList argList;
-    for (int i = 1; i < argCount; ++i)
-        argList += QString::fromWCharArray(args[i]);
-
-    LogMsg(logMsg.arg(torrent->name(), program));
-
-    QProcess proc;
-    proc.setProgram(QString::fromWCharArray(args[0]));
-    proc.setArguments(argList);
-    proc.setCreateProcessArgumentsModifier([](QProcess::CreateProcessArguments *args)
-    {
-        if (Preferences::instance()->isAutoRunConsoleEnabled())
-        {
-            args->flags |= CREATE_NEW_CONSOLE;
-            args->flags &= ~(CREATE_NO_WINDOW | DETACHED_PROCESS);
-        }
-        else
-        {
-            args->flags |= CREATE_NO_WINDOW;
-            args->flags &= ~(CREATE_NEW_CONSOLE | DETACHED_PROCESS);
-        }
-        args->inheritHandles = false;
-        args->startupInfo->dwFlags &= ~STARTF_USESTDHANDLES;
-        ::CloseHandle(args->startupInfo->hStdInput);
-        ::CloseHandle(args->startupInfo->hStdOutput);
-        ::CloseHandle(args->startupInfo->hStdError);
-        args->startupInfo->hStdInput = nullptr;
-        args->startupInfo->hStdOutput = nullptr;
-        args->startupInfo->hStdError = nullptr;
-    });
-    proc.startDetached();
-#else // Q_OS_WIN
-    QStringList args = Utils::String::splitCommand(programTemplate);
-
-    if (args.isEmpty())
-        return;
-
-    for (QString &arg : args)
-    {
-        // strip redundant quotes
-        if (arg.startsWith(u'"') && arg.endsWith(u'"'))
-            arg = arg.mid(1, (arg.size() - 2));
-
-        arg = replaceVariables(arg);
-    }
-
-    // show intended command in log
-    LogMsg(logMsg.arg(torrent->name(), replaceVariables(programTemplate)));
-
-    const QString command = args.takeFirst();
-    QProcess::startDetached(command, args);
-#endif
-}
-
 void Application::sendNotificationEmail(const BitTorrent::Torrent *torrent)
 {
     // Prepare mail content
@@ -543,11 +426,8 @@ void Application::sendNotificationEmail(const BitTorrent::Torrent *torrent)
 
 void Application::torrentAdded(const BitTorrent::Torrent *torrent) const
 {
-    const Preferences *pref = Preferences::instance();
-
     // AutoRun program
-    if (pref->isAutoRunOnTorrentAddedEnabled())
-        runExternalProgram(pref->getAutoRunOnTorrentAddedProgram().trimmed(), torrent);
+    m_torrentHookRunner->handleTorrentEvent(TorrentHookRunner::Event::TorrentAdded, torrent);
 }
 
 void Application::torrentFinished(const BitTorrent::Torrent *torrent)
@@ -555,8 +435,7 @@ void Application::torrentFinished(const BitTorrent::Torrent *torrent)
     const Preferences *pref = Preferences::instance();
 
     // AutoRun program
-    if (pref->isAutoRunOnTorrentFinishedEnabled())
-        runExternalProgram(pref->getAutoRunOnTorrentFinishedProgram().trimmed(), torrent);
+    m_torrentHookRunner->handleTorrentEvent(TorrentHookRunner::Event::TorrentFinished, torrent);
 
     // Mail notification
     if (pref->isMailNotificationEnabled())
@@ -763,12 +642,15 @@ try
 #endif
     connect(BitTorrent::Session::instance(), &BitTorrent::Session::restored, this, [this]()
     {
+        m_torrentHookRunner = new TorrentHookRunner(this);
         connect(BitTorrent::Session::instance(), &BitTorrent::Session::torrentAdded, this, &Application::torrentAdded);
         connect(BitTorrent::Session::instance(), &BitTorrent::Session::torrentFinished, this, &Application::torrentFinished);
         connect(BitTorrent::Session::instance(), &BitTorrent::Session::allTorrentsFinished, this, &Application::allTorrentsFinished, Qt::QueuedConnection);
 
         Net::GeoIPManager::initInstance();
+        Net::PeerMetadataResolver::initInstance();
         TorrentFilesWatcher::initInstance();
+        BitTorrent::TorrentCreationManager::initInstance();
 
         new RSS::Session; // create RSS::Session singleton
         new RSS::AutoDownloader; // create RSS::AutoDownloader singleton
@@ -1194,8 +1076,11 @@ void Application::cleanup()
     delete RSS::AutoDownloader::instance();
     delete RSS::Session::instance();
 
+    BitTorrent::TorrentCreationManager::freeInstance();
     TorrentFilesWatcher::freeInstance();
     BitTorrent::Session::freeInstance();
+    delete m_torrentHookRunner;
+    Net::PeerMetadataResolver::freeInstance();
     Net::GeoIPManager::freeInstance();
     Net::DownloadManager::freeInstance();
     Net::ProxyConfigurationManager::freeInstance();
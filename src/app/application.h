@@ -54,6 +54,7 @@
 
 class ApplicationInstanceManager;
 class FileLogger;
+class TorrentHookRunner;
 
 namespace BitTorrent
 {
@@ -156,8 +157,8 @@ private:
     void initializeTranslation();
     AddTorrentParams parseParams(const QStringList &params) const;
     void processParams(const AddTorrentParams &params);
-    void runExternalProgram(const QString &programTemplate, const BitTorrent::Torrent *torrent) const;
     void sendNotificationEmail(const BitTorrent::Torrent *torrent);
+    void startFileLogger();
 
 #ifdef QBT_USES_LIBTORRENT2
     void applyMemoryWorkingSetLimit() const;
@@ -184,6 +185,8 @@ private:
     // FileLog
     QPointer<FileLogger> m_fileLogger;
 
+    TorrentHookRunner *m_torrentHookRunner = nullptr;
+
     QTranslator m_qtTranslator;
     QTranslator m_translator;
 
@@ -196,6 +199,8 @@ private:
     SettingValue<int> m_storeFileLoggerAge;
     SettingValue<int> m_storeFileLoggerAgeType;
     SettingValue<Path> m_storeFileLoggerPath;
+    SettingValue<bool> m_storeFileLoggerCompressBackups;
+    SettingValue<int> m_storeFileLoggerRotationInterval;
     SettingValue<int> m_storeMemoryWorkingSetLimit;
 
 #ifdef Q_OS_WIN
@@ -28,31 +28,253 @@
 
 #include "filelogger.h"
 
-#include <chrono>
+#include <utility>
 
 #include <QDateTime>
 #include <QDir>
-#include <QTextStream>
+#include <QFile>
+#include <QMutex>
+#include <QThread>
 #include <QVector>
 
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/utils/fs.h"
+#include "base/utils/gzip.h"
+#include "base/utils/io.h"
 
 namespace
 {
-    const std::chrono::seconds FLUSH_INTERVAL {2};
+    // Messages exceeding the limit are dropped if the worker can't keep up
+    const int MAX_QUEUED_MESSAGES = 50000;
+
+    QString formatMessage(const Log::MsgType type, const qint64 timestamp, const QString &message)
+    {
+        QString typeTag;
+        switch (type)
+        {
+        case Log::INFO:
+            typeTag = u"(I) "_qs;
+            break;
+        case Log::WARNING:
+            typeTag = u"(W) "_qs;
+            break;
+        case Log::CRITICAL:
+            typeTag = u"(C) "_qs;
+            break;
+        default:
+            typeTag = u"(N) "_qs;
+        }
+
+        return typeTag + QDateTime::fromSecsSinceEpoch(timestamp).toString(Qt::ISODate) + u" - " + message + u'\n';
+    }
 }
 
+class FileLogger::Worker final : public QObject
+{
+public:
+    Worker(const bool backup, const int maxSize)
+        : m_backup {backup}
+        , m_maxSize {maxSize}
+    {
+    }
+
+    ~Worker() override
+    {
+        closeLogFile();
+    }
+
+    // Can be called from any thread
+    void enqueue(const Log::Msg &msg)
+    {
+        const QMutexLocker locker {&m_queueMutex};
+
+        if (m_queue.size() >= MAX_QUEUED_MESSAGES)
+        {
+            ++m_droppedMessageCount;
+            return;
+        }
+
+        if (m_queue.isEmpty())
+            QMetaObject::invokeMethod(this, [this] { processQueue(); }, Qt::QueuedConnection);
+        m_queue.append(msg);
+    }
+
+    // Writes all the queued messages at once
+    void processQueue()
+    {
+        QVector<Log::Msg> messages;
+        int droppedMessageCount = 0;
+        {
+            const QMutexLocker locker {&m_queueMutex};
+            messages.swap(m_queue);
+            droppedMessageCount = std::exchange(m_droppedMessageCount, 0);
+        }
+
+        if (!m_logFile.isOpen())
+            return;
+
+        QString data;
+        for (const Log::Msg &msg : asConst(messages))
+            data += formatMessage(msg.type, msg.timestamp, msg.message);
+        if (droppedMessageCount > 0)
+        {
+            data += formatMessage(Log::WARNING, QDateTime::currentSecsSinceEpoch()
+                , FileLogger::tr("%1 log messages were not written to the log file since it couldn't keep up with them.").arg(droppedMessageCount));
+        }
+
+        m_logFile.write(data.toUtf8());
+        m_logFile.flush();
+
+        if (isRotationNeeded())
+            rotate();
+    }
+
+    void changePath(const Path &path)
+    {
+        closeLogFile();
+        m_path = path;
+        Utils::Fs::mkpath(m_path.parentPath());
+        openLogFile();
+    }
+
+    void deleteOld(const int age, const FileLogAgeType ageType)
+    {
+        const QDateTime date = QDateTime::currentDateTime();
+        const QDir dir {m_path.parentPath().data()};
+        const QFileInfoList fileList = dir.entryInfoList(QStringList(u"qbittorrent.log.bak*"_qs)
+            , (QDir::Files | QDir::Writable), (QDir::Time | QDir::Reversed));
+
+        for (const QFileInfo &file : fileList)
+        {
+            QDateTime modificationDate = file.lastModified();
+            switch (ageType)
+            {
+            case DAYS:
+                modificationDate = modificationDate.addDays(age);
+                break;
+            case MONTHS:
+                modificationDate = modificationDate.addMonths(age);
+                break;
+            default:
+                modificationDate = modificationDate.addYears(age);
+            }
+            if (modificationDate > date)
+                break;
+            Utils::Fs::removeFile(Path(file.absoluteFilePath()));
+        }
+    }
+
+    void setBackup(const bool value)
+    {
+        m_backup = value;
+    }
+
+    void setMaxSize(const int value)
+    {
+        m_maxSize = value;
+    }
+
+    void setCompressBackups(const bool value)
+    {
+        m_compressBackups = value;
+    }
+
+    void setRotationInterval(const std::chrono::hours interval)
+    {
+        m_rotationInterval = interval;
+    }
+
+private:
+    void openLogFile()
+    {
+        m_logFile.setFileName(m_path.data());
+        if (!m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)
+            || !m_logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner))
+        {
+            m_logFile.close();
+            LogMsg(FileLogger::tr("An error occurred while trying to open the log file. Logging to file is disabled."), Log::CRITICAL);
+            return;
+        }
+
+        m_logFileCreationTime = m_logFile.fileTime(QFileDevice::FileBirthTime);
+        if (!m_logFileCreationTime.isValid())
+            m_logFileCreationTime = QDateTime::currentDateTime();
+    }
+
+    void closeLogFile()
+    {
+        m_logFile.close();
+    }
+
+    bool isRotationNeeded() const
+    {
+        if (!m_backup)
+            return false;
+
+        if (m_logFile.size() >= m_maxSize)
+            return true;
+
+        return ((m_rotationInterval > std::chrono::hours::zero())
+            && (m_logFileCreationTime.secsTo(QDateTime::currentDateTime()) >= std::chrono::seconds(m_rotationInterval).count()));
+    }
+
+    void rotate()
+    {
+        closeLogFile();
+
+        int counter = 0;
+        Path backupLogFilename = m_path + u".bak";
+        while (backupLogFilename.exists() || (backupLogFilename + u".gz").exists())
+        {
+            ++counter;
+            backupLogFilename = m_path + u".bak" + QString::number(counter);
+        }
+
+        if (Utils::Fs::renameFile(m_path, backupLogFilename) && m_compressBackups)
+            compressBackup(backupLogFilename);
+
+        openLogFile();
+    }
+
+    void compressBackup(const Path &path)
+    {
+        QFile file {path.data()};
+        if (!file.open(QIODevice::ReadOnly))
+            return;
+
+        bool ok = false;
+        const QByteArray compressedData = Utils::Gzip::compress(file.readAll(), 6, &ok);
+        file.close();
+        if (!ok)
+            return;
+
+        if (Utils::IO::saveToFile((path + u".gz"), compressedData))
+            Utils::Fs::removeFile(path);
+    }
+
+    QMutex m_queueMutex;
+    QVector<Log::Msg> m_queue;
+    int m_droppedMessageCount = 0;
+
+    Path m_path;
+    bool m_backup = false;
+    int m_maxSize = 0;
+    bool m_compressBackups = false;
+    std::chrono::hours m_rotationInterval {0};
+    QFile m_logFile;
+    QDateTime m_logFileCreationTime;
+};
+
 FileLogger::FileLogger(const Path &path, const bool backup
                        , const int maxSize, const bool deleteOld, const int age
                        , const FileLogAgeType ageType)
-    : m_backup(backup)
-    , m_maxSize(maxSize)
+    : m_workerThread {new QThread}
+    , m_worker {new Worker(backup, maxSize)}
 {
-    m_flusher.setInterval(FLUSH_INTERVAL);
-    m_flusher.setSingleShot(true);
-    connect(&m_flusher, &QTimer::timeout, this, &FileLogger::flushLog);
+    m_worker->moveToThread(m_workerThread.get());
+    connect(m_workerThread.get(), &QThread::finished, m_worker, &QObject::deleteLater);
+    m_workerThread->start();
 
     changePath(path);
     if (deleteOld)
@@ -67,7 +289,9 @@ FileLogger::FileLogger(const Path &path, const bool backup
 
 FileLogger::~FileLogger()
 {
-    closeLogFile();
+    disconnect(Logger::instance(), nullptr, this, nullptr);
+    // write out the remaining messages before the worker thread is stopped
+    QMetaObject::invokeMethod(m_worker, [this] { m_worker->processQueue(); }, Qt::BlockingQueuedConnection);
 }
 
 void FileLogger::changePath(const Path &newPath)
@@ -76,118 +300,36 @@ void FileLogger::changePath(const Path &newPath)
     if (newPath.data() == m_path.parentPath().data())
         return;
 
-    closeLogFile();
-
     m_path = newPath / Path(u"qbittorrent.log"_qs);
-    m_logFile.setFileName(m_path.data());
-
-    Utils::Fs::mkpath(newPath);
-    openLogFile();
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, path = m_path] { worker->changePath(path); });
 }
 
 void FileLogger::deleteOld(const int age, const FileLogAgeType ageType)
 {
-    const QDateTime date = QDateTime::currentDateTime();
-    const QDir dir {m_path.parentPath().data()};
-    const QFileInfoList fileList = dir.entryInfoList(QStringList(u"qbittorrent.log.bak*"_qs)
-        , (QDir::Files | QDir::Writable), (QDir::Time | QDir::Reversed));
-
-    for (const QFileInfo &file : fileList)
-    {
-        QDateTime modificationDate = file.lastModified();
-        switch (ageType)
-        {
-        case DAYS:
-            modificationDate = modificationDate.addDays(age);
-            break;
-        case MONTHS:
-            modificationDate = modificationDate.addMonths(age);
-            break;
-        default:
-            modificationDate = modificationDate.addYears(age);
-        }
-        if (modificationDate > date)
-            break;
-        Utils::Fs::removeFile(Path(file.absoluteFilePath()));
-    }
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, age, ageType] { worker->deleteOld(age, ageType); });
 }
 
 void FileLogger::setBackup(const bool value)
 {
-    m_backup = value;
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, value] { worker->setBackup(value); });
 }
 
 void FileLogger::setMaxSize(const int value)
 {
-    m_maxSize = value;
-}
-
-void FileLogger::addLogMessage(const Log::Msg &msg)
-{
-    if (!m_logFile.isOpen()) return;
-
-    QTextStream stream(&m_logFile);
-#if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
-    stream.setCodec("UTF-8");
-#endif
-
-    switch (msg.type)
-    {
-    case Log::INFO:
-        stream << QStringView(u"(I) ");
-        break;
-    case Log::WARNING:
-        stream << QStringView(u"(W) ");
-        break;
-    case Log::CRITICAL:
-        stream << QStringView(u"(C) ");
-        break;
-    default:
-        stream << QStringView(u"(N) ");
-    }
-
-    stream << QDateTime::fromSecsSinceEpoch(msg.timestamp).toString(Qt::ISODate) << QStringView(u" - ") << msg.message << QChar(u'\n');
-
-    if (m_backup && (m_logFile.size() >= m_maxSize))
-    {
-        closeLogFile();
-        int counter = 0;
-        Path backupLogFilename = m_path + u".bak";
-
-        while (backupLogFilename.exists())
-        {
-            ++counter;
-            backupLogFilename = m_path + u".bak" + QString::number(counter);
-        }
-
-        Utils::Fs::renameFile(m_path, backupLogFilename);
-        openLogFile();
-    }
-    else
-    {
-        if (!m_flusher.isActive())
-            m_flusher.start();
-    }
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, value] { worker->setMaxSize(value); });
 }
 
-void FileLogger::flushLog()
+void FileLogger::setCompressBackups(const bool value)
 {
-    if (m_logFile.isOpen())
-        m_logFile.flush();
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, value] { worker->setCompressBackups(value); });
 }
 
-void FileLogger::openLogFile()
+void FileLogger::setRotationInterval(const std::chrono::hours interval)
 {
-    if (!m_logFile.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)
-        || !m_logFile.setPermissions(QFile::ReadOwner | QFile::WriteOwner))
-    {
-        m_logFile.close();
-        LogMsg(tr("An error occurred while trying to open the log file. Logging to file is disabled."), Log::CRITICAL);
-    }
+    QMetaObject::invokeMethod(m_worker, [worker = m_worker, interval] { worker->setRotationInterval(interval); });
 }
 
-void FileLogger::closeLogFile()
+void FileLogger::addLogMessage(const Log::Msg &msg)
 {
-    m_flusher.stop();
-    m_logFile.close();
+    m_worker->enqueue(msg);
 }
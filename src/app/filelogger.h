@@ -28,11 +28,12 @@
 
 #pragma once
 
-#include <QFile>
+#include <chrono>
+
 #include <QObject>
-#include <QTimer>
 
 #include "base/path.h"
+#include "base/utils/thread.h"
 
 namespace Log
 {
@@ -59,18 +60,18 @@ public:
     void deleteOld(int age, FileLogAgeType ageType);
     void setBackup(bool value);
     void setMaxSize(int value);
+    // Rotated log files are compressed with gzip
+    void setCompressBackups(bool value);
+    // Log file is also rotated when it gets older than the interval (zero disables it)
+    void setRotationInterval(std::chrono::hours interval);
 
 private slots:
     void addLogMessage(const Log::Msg &msg);
-    void flushLog();
 
 private:
-    void openLogFile();
-    void closeLogFile();
+    class Worker;
 
     Path m_path;
-    bool m_backup;
-    int m_maxSize;
-    QFile m_logFile;
-    QTimer m_flusher;
+    Utils::Thread::UniquePtr m_workerThread;
+    Worker *m_worker = nullptr;
 };
@@ -0,0 +1,236 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrenteventstream.h"
+
+#ifdef Q_OS_UNIX
+#include <cerrno>
+#include <csignal>
+#include <ctime>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <QLocalSocket>
+#ifdef Q_OS_UNIX
+#include <QSocketNotifier>
+#endif
+
+#include "base/logger.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // the amount of data which can be waiting for a slow reader
+    const qint64 MAX_PENDING_DATA_SIZE = 1024 * 1024;
+    const auto RECONNECT_INTERVAL = 5s;
+}
+
+TorrentEventStream::TorrentEventStream(const Path &path, QObject *parent)
+    : QObject(parent)
+    , m_path {path}
+{
+#ifdef Q_OS_UNIX
+    struct stat fileStat {};
+    m_isFIFO = (::stat(m_path.toString().toLocal8Bit().constData(), &fileStat) == 0) && S_ISFIFO(fileStat.st_mode);
+    if (m_isFIFO)
+        return;
+#endif
+
+    // events are kept until there is a reader, reconnection is attempted from time to time
+    m_reconnectTimer.setSingleShot(true);
+    m_reconnectTimer.setInterval(RECONNECT_INTERVAL);
+    connect(&m_reconnectTimer, &QTimer::timeout, this, &TorrentEventStream::connectToServer);
+
+    m_socket = new QLocalSocket(this);
+    connect(m_socket, &QLocalSocket::connected, this, [this]()
+    {
+        LogMsg(tr("Connected to torrent event stream. Path: \"%1\"").arg(m_path.toString()));
+        m_socket->write(m_pendingData);
+        m_pendingData.clear();
+    });
+    connect(m_socket, &QLocalSocket::disconnected, this, [this]()
+    {
+        LogMsg(tr("Torrent event stream is disconnected. Path: \"%1\"").arg(m_path.toString()), Log::WARNING);
+        m_reconnectTimer.start();
+    });
+    connect(m_socket, &QLocalSocket::errorOccurred, this, [this]()
+    {
+        if (m_socket->state() == QLocalSocket::UnconnectedState)
+            m_reconnectTimer.start();
+    });
+    connectToServer();
+}
+
+TorrentEventStream::~TorrentEventStream()
+{
+#ifdef Q_OS_UNIX
+    closeFIFO();
+#endif
+}
+
+Path TorrentEventStream::path() const
+{
+    return m_path;
+}
+
+void TorrentEventStream::write(const QByteArray &line)
+{
+#ifdef Q_OS_UNIX
+    if (m_isFIFO)
+    {
+        writeToFIFO(line);
+        return;
+    }
+#endif
+
+    writeToSocket(line);
+}
+
+void TorrentEventStream::setReconnectInterval(const std::chrono::milliseconds interval)
+{
+    m_reconnectTimer.setInterval(interval);
+}
+
+void TorrentEventStream::connectToServer()
+{
+    m_socket->connectToServer(m_path.toString(), QIODevice::WriteOnly);
+}
+
+void TorrentEventStream::writeToSocket(const QByteArray &line)
+{
+    switch (m_socket->state())
+    {
+    case QLocalSocket::ConnectedState:
+        if ((m_socket->bytesToWrite() + line.size()) <= MAX_PENDING_DATA_SIZE)
+            m_socket->write(line);
+        break;
+    case QLocalSocket::ConnectingState:
+    case QLocalSocket::UnconnectedState:
+        if ((m_pendingData.size() + line.size()) <= MAX_PENDING_DATA_SIZE)
+            m_pendingData.append(line);
+        break;
+    default:
+        break;
+    }
+}
+
+#ifdef Q_OS_UNIX
+void TorrentEventStream::writeToFIFO(const QByteArray &line)
+{
+    if ((m_pendingData.size() + line.size()) <= MAX_PENDING_DATA_SIZE)
+        m_pendingData.append(line);
+
+    flushFIFO();
+}
+
+void TorrentEventStream::flushFIFO()
+{
+    if (m_fifoFD < 0)
+    {
+        // opening FIFO for writing in non-blocking mode fails if there is no reader
+        m_fifoFD = ::open(m_path.toString().toLocal8Bit().constData(), (O_WRONLY | O_NONBLOCK | O_CLOEXEC));
+        if (m_fifoFD < 0)
+            return;
+#ifdef F_SETNOSIGPIPE
+        ::fcntl(m_fifoFD, F_SETNOSIGPIPE, 1);
+#endif
+
+        // the rest of the data is written once the reader consumes some
+        m_fifoNotifier = new QSocketNotifier(m_fifoFD, QSocketNotifier::Write, this);
+        connect(m_fifoNotifier, &QSocketNotifier::activated, this, &TorrentEventStream::flushFIFO);
+    }
+
+    if (m_pendingData.isEmpty())
+    {
+        m_fifoNotifier->setEnabled(false);
+        return;
+    }
+
+#ifndef F_SETNOSIGPIPE
+    // Writing to FIFO which was closed by the reader raises SIGPIPE,
+    // so it is blocked (and then consumed) to get EPIPE error instead.
+    sigset_t sigpipeMask;
+    sigemptyset(&sigpipeMask);
+    sigaddset(&sigpipeMask, SIGPIPE);
+    sigset_t oldMask;
+    pthread_sigmask(SIG_BLOCK, &sigpipeMask, &oldMask);
+#endif
+
+    const ssize_t written = ::write(m_fifoFD, m_pendingData.constData(), static_cast<size_t>(m_pendingData.size()));
+    const int writeError = errno;
+
+#ifndef F_SETNOSIGPIPE
+    if ((written < 0) && (writeError == EPIPE))
+    {
+        const timespec noWait {};
+        ::sigtimedwait(&sigpipeMask, nullptr, &noWait);
+    }
+    pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+#endif
+
+    if (written < 0)
+    {
+        if ((writeError != EAGAIN) && (writeError != EWOULDBLOCK))
+            closeFIFO();
+        else
+            m_fifoNotifier->setEnabled(true);
+        return;
+    }
+
+    if (written > 0)
+    {
+        // slow reader can get a part of a line, the rest of it is written later
+        m_isLineIncomplete = (m_pendingData[static_cast<int>(written) - 1] != '\n');
+        m_pendingData.remove(0, static_cast<int>(written));
+    }
+    m_fifoNotifier->setEnabled(!m_pendingData.isEmpty());
+}
+
+void TorrentEventStream::closeFIFO()
+{
+    if (m_fifoFD < 0)
+        return;
+
+    delete m_fifoNotifier;
+    m_fifoNotifier = nullptr;
+    ::close(m_fifoFD);
+    m_fifoFD = -1;
+
+    // the next reader shouldn't get the rest of the line the previous one has got a part of
+    if (m_isLineIncomplete)
+    {
+        m_pendingData.remove(0, (m_pendingData.indexOf('\n') + 1));
+        m_isLineIncomplete = false;
+    }
+}
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <chrono>
+
+#include <QByteArray>
+#include <QObject>
+#include <QTimer>
+
+#include "base/path.h"
+
+class QLocalSocket;
+class QSocketNotifier;
+
+// Writes torrent lifecycle events as JSON lines to a local socket (Unix domain socket
+// or Windows named pipe) or to a FIFO. It never blocks: events are buffered (up to
+// a limit) while the socket is not connected and dropped once the reader doesn't keep up.
+class TorrentEventStream final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TorrentEventStream)
+
+public:
+    explicit TorrentEventStream(const Path &path, QObject *parent = nullptr);
+    ~TorrentEventStream() override;
+
+    Path path() const;
+    void write(const QByteArray &line);
+
+    void setReconnectInterval(std::chrono::milliseconds interval);
+
+private:
+    void connectToServer();
+    void writeToSocket(const QByteArray &line);
+#ifdef Q_OS_UNIX
+    void writeToFIFO(const QByteArray &line);
+    void flushFIFO();
+    void closeFIFO();
+#endif
+
+    const Path m_path;
+    QLocalSocket *m_socket = nullptr;
+    QByteArray m_pendingData;
+    QTimer m_reconnectTimer;
+#ifdef Q_OS_UNIX
+    bool m_isFIFO = false;
+    int m_fifoFD = -1;
+    QSocketNotifier *m_fifoNotifier = nullptr;
+    // the first pending line was written partially
+    bool m_isLineIncomplete = false;
+#endif
+};
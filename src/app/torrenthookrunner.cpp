@@ -0,0 +1,465 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrenthookrunner.h"
+
+#include <algorithm>
+#include <chrono>
+
+#ifdef Q_OS_WIN
+#include <memory>
+
+#include <Windows.h>
+#include <Shellapi.h>
+#endif
+
+#include <QDateTime>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QProcess>
+#include <QTimer>
+
+#include "base/bittorrent/infohash.h"
+#include "base/bittorrent/torrent.h"
+#include "base/global.h"
+#include "base/logger.h"
+#include "base/preferences.h"
+#include "base/utils/string.h"
+#include "torrenteventstream.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    // torrents completed around the same time (e.g. after recheck) get into the same batch
+    const auto BATCH_COLLECTING_DELAY = 1s;
+    // keep command line reasonably short (Windows limits it to 32767 characters)
+    const int MAX_BATCH_SIZE = 50;
+
+    QString eventName(const TorrentHookRunner::Event event)
+    {
+        switch (event)
+        {
+        case TorrentHookRunner::Event::TorrentAdded:
+            return u"added"_qs;
+        case TorrentHookRunner::Event::TorrentFinished:
+            return u"finished"_qs;
+        }
+
+        return {};
+    }
+
+    QString replaceVariables(QString str, const BitTorrent::Torrent *torrent)
+    {
+        for (int i = (str.length() - 2); i >= 0; --i)
+        {
+            if (str[i] != u'%')
+                continue;
+
+            const ushort specifier = str[i + 1].unicode();
+            switch (specifier)
+            {
+            case u'C':
+                str.replace(i, 2, QString::number(torrent->filesCount()));
+                break;
+            case u'D':
+                str.replace(i, 2, torrent->savePath().toString());
+                break;
+            case u'F':
+                str.replace(i, 2, torrent->contentPath().toString());
+                break;
+            case u'G':
+                str.replace(i, 2, torrent->tags().join(u","_qs));
+                break;
+            case u'I':
+                str.replace(i, 2, (torrent->infoHash().v1().isValid() ? torrent->infoHash().v1().toString() : u"-"_qs));
+                break;
+            case u'J':
+                str.replace(i, 2, (torrent->infoHash().v2().isValid() ? torrent->infoHash().v2().toString() : u"-"_qs));
+                break;
+            case u'K':
+                str.replace(i, 2, torrent->id().toString());
+                break;
+            case u'L':
+                str.replace(i, 2, torrent->category());
+                break;
+            case u'N':
+                str.replace(i, 2, torrent->name());
+                break;
+            case u'R':
+                str.replace(i, 2, torrent->rootPath().toString());
+                break;
+            case u'T':
+                str.replace(i, 2, torrent->currentTracker());
+                break;
+            case u'Z':
+                str.replace(i, 2, QString::number(torrent->totalSize()));
+                break;
+            default:
+                // do nothing
+                break;
+            }
+
+            // decrement `i` to avoid unwanted replacement, example pattern: "%%N"
+            --i;
+        }
+
+        return str;
+    }
+
+    QStringList splitCommandLine(const QString &commandLine)
+    {
+#ifdef Q_OS_WIN
+        // Need to split arguments manually because QProcess::startDetached(QString)
+        // will strip off empty parameters.
+        // E.g. `python.exe "1" "" "3"` will become `python.exe "1" "3"`
+        const std::wstring commandLineWStr = commandLine.toStdWString();
+        int argCount = 0;
+        std::unique_ptr<LPWSTR[], decltype(&::LocalFree)> args {::CommandLineToArgvW(commandLineWStr.c_str(), &argCount), ::LocalFree};
+
+        QStringList argList;
+        for (int i = 0; i < argCount; ++i)
+            argList += QString::fromWCharArray(args[i]);
+        return argList;
+#else
+        QStringList args = Utils::String::splitCommand(commandLine);
+        for (QString &arg : args)
+        {
+            // strip redundant quotes
+            if (arg.startsWith(u'"') && arg.endsWith(u'"'))
+                arg = arg.mid(1, (arg.size() - 2));
+        }
+        return args;
+#endif
+    }
+
+    QByteArray serializeEvent(const TorrentHookRunner::Event event, const BitTorrent::Torrent *torrent)
+    {
+        const BitTorrent::InfoHash infoHash = torrent->infoHash();
+
+        QJsonArray tags;
+        for (const QString &tag : asConst(torrent->tags()))
+            tags.append(tag);
+
+        const QJsonObject jsonEvent
+        {
+            {u"event"_qs, eventName(event)},
+            {u"timestamp"_qs, QDateTime::currentSecsSinceEpoch()},
+            {u"hash"_qs, torrent->id().toString()},
+            {u"infohash_v1"_qs, (infoHash.v1().isValid() ? infoHash.v1().toString() : QString())},
+            {u"infohash_v2"_qs, (infoHash.v2().isValid() ? infoHash.v2().toString() : QString())},
+            {u"name"_qs, torrent->name()},
+            {u"category"_qs, torrent->category()},
+            {u"tags"_qs, tags},
+            {u"save_path"_qs, torrent->savePath().toString()},
+            {u"content_path"_qs, torrent->contentPath().toString()},
+            {u"root_path"_qs, torrent->rootPath().toString()},
+            {u"size"_qs, torrent->totalSize()},
+            {u"num_files"_qs, torrent->filesCount()},
+            {u"tracker"_qs, torrent->currentTracker()}
+        };
+
+        return QJsonDocument(jsonEvent).toJson(QJsonDocument::Compact) + '\n';
+    }
+}
+
+TorrentHookRunner::TorrentHookRunner(QObject *parent)
+    : QObject(parent)
+    , m_batchTimer {new QTimer(this)}
+{
+    m_batchTimer->setSingleShot(true);
+    m_batchTimer->setInterval(BATCH_COLLECTING_DELAY);
+    connect(m_batchTimer, &QTimer::timeout, this, &TorrentHookRunner::flushBatches);
+}
+
+TorrentHookRunner::~TorrentHookRunner()
+{
+    // torrents collected for a batch shouldn't be lost on exit
+    m_batchTimer->stop();
+    flushBatches();
+
+    // there is no one to wait for the queued programs anymore, so they are run detached
+    while (!m_commandQueue.isEmpty())
+    {
+        const Command command = m_commandQueue.dequeue();
+        LogMsg(tr("Running external program. Torrent: \"%1\". Command: `%2`").arg(command.torrentNames, command.commandLine));
+        if (!QProcess::startDetached(command.program, command.arguments))
+            LogMsg(tr("Failed to run external program. Command: `%1`.").arg(command.commandLine), Log::WARNING);
+    }
+
+    // QProcess kills the running program when it is destroyed,
+    // so the running programs are waited for until they finish or time out
+    if (!m_runningProcesses.isEmpty())
+    {
+        LogMsg(tr("Waiting for external programs to finish. Count: %1").arg(m_runningProcesses.size()));
+        for (auto it = m_runningProcesses.cbegin(); it != m_runningProcesses.cend(); ++it)
+        {
+            QProcess *process = it.key();
+            process->disconnect(this);
+            // remaining time of the program without timeout is -1, i.e. it is waited for without limit
+            if (!process->waitForFinished(static_cast<int>(it.value().remainingTime())))
+            {
+                process->kill();
+                LogMsg(tr("External program timed out and was killed. Command: `%1`")
+                    .arg((QStringList {process->program()} + process->arguments()).join(u' ')), Log::WARNING);
+            }
+        }
+    }
+}
+
+void TorrentHookRunner::handleTorrentEvent(const Event event, const BitTorrent::Torrent *torrent)
+{
+    const Preferences *pref = Preferences::instance();
+
+    switch (event)
+    {
+    case Event::TorrentAdded:
+        if (pref->isAutoRunOnTorrentAddedEnabled())
+            enqueueProgram(event, pref->getAutoRunOnTorrentAddedProgram().trimmed(), torrent);
+        break;
+    case Event::TorrentFinished:
+        if (pref->isAutoRunOnTorrentFinishedEnabled())
+            enqueueProgram(event, pref->getAutoRunOnTorrentFinishedProgram().trimmed(), torrent);
+        break;
+    }
+
+    writeEvent(event, torrent);
+}
+
+void TorrentHookRunner::enqueueProgram(const Event event, const QString &programTemplate, const BitTorrent::Torrent *torrent)
+{
+    // Cannot give users shell environment by default, as doing so could
+    // enable command injection via torrent name and other arguments
+    // (especially when some automated download mechanism has been setup).
+    // See: https://github.com/qbittorrent/qBittorrent/issues/10925
+
+    if (Preferences::instance()->isAutoRunBatchingEnabled())
+    {
+        addToBatch(event, programTemplate, torrent);
+        return;
+    }
+
+    auto [args, commandLine] = expandCommand(programTemplate, torrent);
+    if (args.isEmpty())
+        return;
+
+    const QString program = args.takeFirst();
+    m_commandQueue.enqueue({program, args, torrent->name(), commandLine});
+    startCommands();
+}
+
+TorrentHookRunner::ExpandedCommand TorrentHookRunner::expandCommand(const QString &programTemplate, const BitTorrent::Torrent *torrent)
+{
+    // The processing sequenece is different for Windows and other OS, this is intentional
+#if defined(Q_OS_WIN)
+    const QString commandLine = replaceVariables(programTemplate, torrent);
+    const QStringList args = splitCommandLine(commandLine);
+#else
+    QStringList args = splitCommandLine(programTemplate);
+    for (QString &arg : args)
+        arg = replaceVariables(arg, torrent);
+
+    // show intended command in log
+    const QString commandLine = replaceVariables(programTemplate, torrent);
+#endif
+
+    return {args, commandLine};
+}
+
+void TorrentHookRunner::addToBatch(const Event event, const QString &programTemplate, const BitTorrent::Torrent *torrent)
+{
+    Batch &batch = m_batches[static_cast<int>(event)];
+    if (batch.programTemplate != programTemplate)
+    {
+        // program was changed, so collected torrents are processed by the old one
+        flushBatch(batch);
+        batch.programTemplate = programTemplate;
+        batch.templateArgs = splitCommandLine(programTemplate);
+    }
+
+    if (batch.templateArgs.isEmpty())
+        return;
+
+    auto [args, commandLine] = expandCommand(programTemplate, torrent);
+    if (args.isEmpty())
+        return;
+
+    if (args.size() != batch.templateArgs.size())
+    {
+        // Variables were replaced within the whole command line and some value was split
+        // into several arguments, so the arguments don't match the ones of other torrents
+        const QString program = args.takeFirst();
+        m_commandQueue.enqueue({program, args, torrent->name(), commandLine});
+        startCommands();
+        return;
+    }
+
+    batch.torrentArgs.append(args);
+    batch.torrentNames.append(torrent->name());
+
+    if (batch.torrentArgs.size() >= MAX_BATCH_SIZE)
+        flushBatch(batch);
+    else if (!m_batchTimer->isActive())
+        m_batchTimer->start();
+}
+
+void TorrentHookRunner::flushBatches()
+{
+    for (Batch &batch : m_batches)
+        flushBatch(batch);
+}
+
+void TorrentHookRunner::flushBatch(Batch &batch)
+{
+    if (batch.torrentArgs.isEmpty())
+        return;
+
+    // Each argument containing some variable is repeated for every torrent of the batch,
+    // e.g. `script.sh -v "%N"` becomes `script.sh -v "name1" "name2" "name3"`.
+    const QStringList &templateArgs = batch.templateArgs;
+    QStringList args;
+    for (int i = 1; i < templateArgs.size(); ++i)
+    {
+        if (templateArgs[i] == batch.torrentArgs[0][i])
+        {
+            args.append(templateArgs[i]);
+            continue;
+        }
+
+        for (const QStringList &torrentArgs : asConst(batch.torrentArgs))
+            args.append(torrentArgs[i]);
+    }
+
+    const QString program = batch.torrentArgs[0][0];
+    const QString commandLine = (QStringList {program} + args).join(u' ');
+    m_commandQueue.enqueue({program, args, batch.torrentNames.join(u", "_qs), commandLine});
+
+    batch.torrentArgs.clear();
+    batch.torrentNames.clear();
+
+    startCommands();
+}
+
+void TorrentHookRunner::writeEvent(const Event event, const BitTorrent::Torrent *torrent)
+{
+    const Path eventStreamPath = Preferences::instance()->getTorrentEventStreamPath();
+    if (eventStreamPath.isEmpty())
+    {
+        delete m_eventStream;
+        m_eventStream = nullptr;
+        return;
+    }
+
+    if (!m_eventStream || (m_eventStream->path() != eventStreamPath))
+    {
+        delete m_eventStream;
+        m_eventStream = new TorrentEventStream(eventStreamPath, this);
+    }
+
+    m_eventStream->write(serializeEvent(event, torrent));
+}
+
+void TorrentHookRunner::startCommands()
+{
+    const int maxRunningCount = std::max(1, Preferences::instance()->getAutoRunMaxConcurrentPrograms());
+    while (!m_commandQueue.isEmpty() && (m_runningProcesses.size() < maxRunningCount))
+        startProcess(m_commandQueue.dequeue());
+}
+
+void TorrentHookRunner::startProcess(const Command &command)
+{
+    LogMsg(tr("Running external program. Torrent: \"%1\". Command: `%2`").arg(command.torrentNames, command.commandLine));
+
+    auto *process = new QProcess(this);
+    process->setProgram(command.program);
+    process->setArguments(command.arguments);
+    process->setStandardInputFile(QProcess::nullDevice());
+#ifdef Q_OS_WIN
+    const bool isConsoleEnabled = Preferences::instance()->isAutoRunConsoleEnabled();
+    // the output is shown in the console otherwise
+    if (!isConsoleEnabled)
+    {
+        process->setStandardOutputFile(QProcess::nullDevice());
+        process->setStandardErrorFile(QProcess::nullDevice());
+    }
+    process->setCreateProcessArgumentsModifier([isConsoleEnabled](QProcess::CreateProcessArguments *args)
+    {
+        if (isConsoleEnabled)
+        {
+            args->flags |= CREATE_NEW_CONSOLE;
+            args->flags &= ~(CREATE_NO_WINDOW | DETACHED_PROCESS);
+        }
+        else
+        {
+            args->flags |= CREATE_NO_WINDOW;
+            args->flags &= ~(CREATE_NEW_CONSOLE | DETACHED_PROCESS);
+        }
+    });
+#else
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setStandardErrorFile(QProcess::nullDevice());
+#endif
+
+    connect(process, qOverload<int, QProcess::ExitStatus>(&QProcess::finished)
+            , this, [this, process]() { handleProcessFinished(process); });
+    connect(process, &QProcess::errorOccurred, this, [this, process, command](const QProcess::ProcessError error)
+    {
+        if (error != QProcess::FailedToStart)
+            return;
+
+        LogMsg(tr("Failed to run external program. Command: `%1`. Reason: %2").arg(command.commandLine, process->errorString()), Log::WARNING);
+        handleProcessFinished(process);
+    });
+
+    // hung program shouldn't occupy its slot in the queue forever
+    const int timeout = Preferences::instance()->getAutoRunTimeout();
+    m_runningProcesses.insert(process, ((timeout > 0) ? QDeadlineTimer(std::chrono::seconds(timeout)) : QDeadlineTimer(QDeadlineTimer::Forever)));
+    process->start();
+
+    if (timeout > 0)
+    {
+        QTimer::singleShot(std::chrono::seconds(timeout), process, [process, command]()
+        {
+            if (process->state() == QProcess::NotRunning)
+                return;
+
+            LogMsg(tr("External program timed out and was killed. Command: `%1`").arg(command.commandLine), Log::WARNING);
+            process->kill();
+        });
+    }
+}
+
+void TorrentHookRunner::handleProcessFinished(QProcess *process)
+{
+    if (!m_runningProcesses.remove(process))
+        return;
+
+    process->deleteLater();
+    startCommands();
+}
@@ -0,0 +1,110 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QObject>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+class QProcess;
+class QTimer;
+
+class TorrentEventStream;
+
+namespace BitTorrent
+{
+    class Torrent;
+}
+
+// Runs "on torrent added/finished" external programs and feeds the torrent event stream.
+// Programs are started through a queue with limited number of concurrently running
+// processes, optionally running single program instance for a batch of torrents.
+class TorrentHookRunner final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TorrentHookRunner)
+
+public:
+    enum class Event
+    {
+        TorrentAdded,
+        TorrentFinished
+    };
+
+    explicit TorrentHookRunner(QObject *parent = nullptr);
+    ~TorrentHookRunner() override;
+
+    void handleTorrentEvent(Event event, const BitTorrent::Torrent *torrent);
+
+private:
+    struct Command
+    {
+        QString program;
+        QStringList arguments;
+        QString torrentNames;
+        QString commandLine;
+    };
+
+    struct Batch
+    {
+        QString programTemplate;
+        QStringList templateArgs;
+        QStringList torrentNames;
+        // arguments expanded for each torrent of the batch
+        QVector<QStringList> torrentArgs;
+    };
+
+    struct ExpandedCommand
+    {
+        QStringList args;
+        QString commandLine;
+    };
+
+    static ExpandedCommand expandCommand(const QString &programTemplate, const BitTorrent::Torrent *torrent);
+
+    void enqueueProgram(Event event, const QString &programTemplate, const BitTorrent::Torrent *torrent);
+    void addToBatch(Event event, const QString &programTemplate, const BitTorrent::Torrent *torrent);
+    void flushBatches();
+    void flushBatch(Batch &batch);
+    void writeEvent(Event event, const BitTorrent::Torrent *torrent);
+
+    void startCommands();
+    void startProcess(const Command &command);
+    void handleProcessFinished(QProcess *process);
+
+    QQueue<Command> m_commandQueue;
+    QHash<QProcess *, QDeadlineTimer> m_runningProcesses;  // maps process to the time it is killed at
+    Batch m_batches[2];
+    QTimer *m_batchTimer = nullptr;
+    TorrentEventStream *m_eventStream = nullptr;
+};
@@ -5,6 +5,7 @@ HEADERS += \
     $$PWD/asyncfilestorage.h \
     $$PWD/bittorrent/abstractfilestorage.h \
     $$PWD/bittorrent/addtorrentparams.h \
+    $$PWD/bittorrent/addtorrentrequest.h \
     $$PWD/bittorrent/bandwidthscheduler.h \
     $$PWD/bittorrent/bencoderesumedatastorage.h \
     $$PWD/bittorrent/cachestatus.h \
@@ -22,6 +23,9 @@ HEADERS += \
     $$PWD/bittorrent/ltqhash.h \
     $$PWD/bittorrent/lttypecast.h \
     $$PWD/bittorrent/magneturi.h \
+    $$PWD/bittorrent/movestoragejobstatus.h \
+    $$PWD/bittorrent/movestorageprogresschecker.h \
+    $$PWD/bittorrent/movestoragequeue.h \
     $$PWD/bittorrent/nativesessionextension.h \
     $$PWD/bittorrent/nativetorrentextension.h \
     $$PWD/bittorrent/peeraddress.h \
@@ -34,6 +38,7 @@ HEADERS += \
     $$PWD/bittorrent/speedmonitor.h \
     $$PWD/bittorrent/torrent.h \
     $$PWD/bittorrent/torrentcontentlayout.h \
+    $$PWD/bittorrent/torrentcreationmanager.h \
     $$PWD/bittorrent/torrentcreatorthread.h \
     $$PWD/bittorrent/torrentimpl.h \
     $$PWD/bittorrent/torrentinfo.h \
@@ -60,9 +65,9 @@ HEADERS += \
     $$PWD/net/downloadmanager.h \
     $$PWD/net/geoipdatabase.h \
     $$PWD/net/geoipmanager.h \
+    $$PWD/net/peermetadataresolver.h \
     $$PWD/net/portforwarder.h \
     $$PWD/net/proxyconfigurationmanager.h \
-    $$PWD/net/reverseresolution.h \
     $$PWD/net/smtp.h \
     $$PWD/orderedset.h \
     $$PWD/path.h \
@@ -74,6 +79,7 @@ HEADERS += \
     $$PWD/rss/rss_article.h \
     $$PWD/rss/rss_autodownloader.h \
     $$PWD/rss/rss_autodownloadrule.h \
+    $$PWD/rss/rss_autodownloadrulematcher.h \
     $$PWD/rss/rss_feed.h \
     $$PWD/rss/rss_folder.h \
     $$PWD/rss/rss_item.h \
@@ -82,6 +88,8 @@ HEADERS += \
     $$PWD/search/searchdownloadhandler.h \
     $$PWD/search/searchhandler.h \
     $$PWD/search/searchpluginmanager.h \
+    $$PWD/search/searchresultstore.h \
+    $$PWD/search/searchworkerpool.h \
     $$PWD/settingsstorage.h \
     $$PWD/settingvalue.h \
     $$PWD/tagset.h \
@@ -120,6 +128,7 @@ SOURCES += \
     $$PWD/bittorrent/infohash.cpp \
     $$PWD/bittorrent/ltqbitarray.cpp \
     $$PWD/bittorrent/magneturi.cpp \
+    $$PWD/bittorrent/movestorageprogresschecker.cpp \
     $$PWD/bittorrent/nativesessionextension.cpp \
     $$PWD/bittorrent/nativetorrentextension.cpp \
     $$PWD/bittorrent/peeraddress.cpp \
@@ -129,6 +138,7 @@ SOURCES += \
     $$PWD/bittorrent/sessionimpl.cpp \
     $$PWD/bittorrent/speedmonitor.cpp \
     $$PWD/bittorrent/torrent.cpp \
+    $$PWD/bittorrent/torrentcreationmanager.cpp \
     $$PWD/bittorrent/torrentcreatorthread.cpp \
     $$PWD/bittorrent/torrentimpl.cpp \
     $$PWD/bittorrent/torrentinfo.cpp \
@@ -148,9 +158,9 @@ SOURCES += \
     $$PWD/net/downloadmanager.cpp \
     $$PWD/net/geoipdatabase.cpp \
     $$PWD/net/geoipmanager.cpp \
+    $$PWD/net/peermetadataresolver.cpp \
     $$PWD/net/portforwarder.cpp \
     $$PWD/net/proxyconfigurationmanager.cpp \
-    $$PWD/net/reverseresolution.cpp \
     $$PWD/net/smtp.cpp \
     $$PWD/path.cpp \
     $$PWD/preferences.cpp \
@@ -160,6 +170,7 @@ SOURCES += \
     $$PWD/rss/rss_article.cpp \
     $$PWD/rss/rss_autodownloader.cpp \
     $$PWD/rss/rss_autodownloadrule.cpp \
+    $$PWD/rss/rss_autodownloadrulematcher.cpp \
     $$PWD/rss/rss_feed.cpp \
     $$PWD/rss/rss_folder.cpp \
     $$PWD/rss/rss_item.cpp \
@@ -168,6 +179,8 @@ SOURCES += \
     $$PWD/search/searchdownloadhandler.cpp \
     $$PWD/search/searchhandler.cpp \
     $$PWD/search/searchpluginmanager.cpp \
+    $$PWD/search/searchresultstore.cpp \
+    $$PWD/search/searchworkerpool.cpp \
     $$PWD/settingsstorage.cpp \
     $$PWD/tagset.cpp \
     $$PWD/torrentfileguard.cpp \
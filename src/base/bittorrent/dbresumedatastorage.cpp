@@ -184,6 +184,7 @@ namespace BitTorrent
         void store(const TorrentID &id, const LoadTorrentParams &resumeData) const;
         void remove(const TorrentID &id) const;
         void storeQueue(const QVector<TorrentID> &queue) const;
+        void storeBatch(const QHash<TorrentID, LoadTorrentParams> &resumeData) const;
 
     private:
         const Path m_path;
@@ -375,6 +376,14 @@ void BitTorrent::DBResumeDataStorage::storeQueue(const QVector<TorrentID> &queue
     });
 }
 
+void BitTorrent::DBResumeDataStorage::storeBatch(const QHash<TorrentID, LoadTorrentParams> &resumeData) const
+{
+    QMetaObject::invokeMethod(m_asyncWorker, [this, resumeData]()
+    {
+        m_asyncWorker->storeBatch(resumeData);
+    });
+}
+
 void BitTorrent::DBResumeDataStorage::doLoadAll() const
 {
     const QString connectionName = u"ResumeDataStorageLoadAll"_qs;
@@ -788,3 +797,28 @@ void BitTorrent::DBResumeDataStorage::Worker::storeQueue(const QVector<TorrentID
             .arg(err.message()), Log::CRITICAL);
     }
 }
+
+void BitTorrent::DBResumeDataStorage::Worker::storeBatch(const QHash<TorrentID, LoadTorrentParams> &resumeData) const
+{
+    auto db = QSqlDatabase::database(m_connectionName);
+
+    // Store all the items in single transaction to avoid committing each of them separately
+    bool isTransactionStarted = false;
+    {
+        const QWriteLocker locker {&m_dbLock};
+        isTransactionStarted = db.transaction();
+    }
+
+    for (auto it = resumeData.cbegin(); it != resumeData.cend(); ++it)
+        store(it.key(), it.value());
+
+    if (isTransactionStarted)
+    {
+        const QWriteLocker locker {&m_dbLock};
+        if (!db.commit())
+        {
+            LogMsg(tr("Couldn't store resume data. Error: %1").arg(db.lastError().text()), Log::CRITICAL);
+            db.rollback();
+        }
+    }
+}
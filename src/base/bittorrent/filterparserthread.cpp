@@ -28,15 +28,26 @@
 
 #include "filterparserthread.h"
 
+#include <algorithm>
 #include <cctype>
+#include <cstring>
+#include <vector>
 
 #include <libtorrent/error_code.hpp>
 
+#include <QByteArray>
+#include <QCryptographicHash>
 #include <QDataStream>
+#include <QDateTime>
 #include <QFile>
+#include <QThreadPool>
+#include <QtEndian>
+#include <QVector>
 
 #include "base/global.h"
 #include "base/logger.h"
+#include "base/utils/fs.h"
+#include "base/utils/io.h"
 
 namespace
 {
@@ -105,332 +116,391 @@ namespace
         return !ec;
     }
 
-    const int BUFFER_SIZE = 2 * 1024 * 1024; // 2 MiB
     const int MAX_LOGGED_ERRORS = 5;
-}
-
-FilterParserThread::FilterParserThread(QObject *parent)
-    : QThread(parent)
-    , m_abort(false)
-{
-}
-
-FilterParserThread::~FilterParserThread()
-{
-    m_abort = true;
-    wait();
-}
-
-// Parser for eMule ip filter in DAT format
-int FilterParserThread::parseDATFilterFile()
-{
-    int ruleCount = 0;
-    QFile file {m_filePath.data()};
-    if (!file.exists()) return ruleCount;
+    const qint64 MIN_CHUNK_SIZE = 1024 * 1024; // 1 MiB
+
+    // Cache file layout (all integers are big-endian):
+    //  magic (4), version (4), source size (8), source modification time (8), source SHA-1 (20),
+    //  rule count (4), IPv4 range count (4), IPv6 range count (4),
+    //  followed by IPv4 ranges (4 + 4 bytes each) and IPv6 ranges (16 + 16 bytes each)
+    const quint32 CACHE_MAGIC = 0x51424946; // "QBIF"
+    const quint32 CACHE_VERSION = 1;
+    const int SOURCE_HASH_SIZE = 20;
+    const qint64 CACHE_HEADER_SIZE = 4 + 4 + 8 + 8 + SOURCE_HASH_SIZE + 4 + 4 + 4;
+    const qint64 CACHED_V4_RANGE_SIZE = 2 * 4;
+    const qint64 CACHED_V6_RANGE_SIZE = 2 * 16;
+
+    enum class LineStatus
+    {
+        Rule,
+        Skipped,
+        Malformed,
+        MalformedStartIP,
+        MalformedEndIP,
+        IPVersionMismatch
+    };
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    struct ParsedRule
     {
-        LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
-        return ruleCount;
-    }
+        lt::address first;
+        lt::address last;
+        int lineNumber = 0;
+    };
 
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QVector
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
-    int parseErrorCount = 0;
-    const auto addLog = [&parseErrorCount](const QString &msg)
+    struct ParsingError
     {
-        if (parseErrorCount <= MAX_LOGGED_ERRORS)
-            LogMsg(msg, Log::CRITICAL);
+        LineStatus status = LineStatus::Malformed;
+        int lineNumber = 0;
     };
 
-    while (true)
+    struct ChunkParsingResult
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
-            break;
+        std::vector<ParsedRule> rules;
+        // Only the first MAX_LOGGED_ERRORS errors are kept, the rest are just counted
+        QVector<ParsingError> errors;
+        int errorCount = 0;
+        int lineCount = 0;
+    };
+
+    using LineParser = LineStatus (*)(char *line, int endOfLine, lt::address &startAddr, lt::address &endAddr);
 
-        for (start = 0; start < dataSize; ++start)
+    int findAndNullDelimiter(char *const data, const char delimiter, const int start, const int end, const bool reverse = false)
+    {
+        if (!reverse)
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
+            for (int i = start; i <= end; ++i)
             {
-                for (int i = start; i < dataSize; ++i)
+                if (data[i] == delimiter)
                 {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
+                    data[i] = '\0';
+                    return i;
                 }
             }
-            else
+        }
+        else
+        {
+            for (int i = end; i >= start; --i)
             {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
+                if (data[i] == delimiter)
+                {
+                    data[i] = '\0';
+                    return i;
+                }
             }
+        }
+
+        return -1;
+    }
+
+    int trim(char *const data, const int start, const int end)
+    {
+        if (start >= end) return start;
+        int newStart = start;
 
-            if (endOfLine == -1)
+        for (int i = start; i <= end; ++i)
+        {
+            if (isspace(data[i]) != 0)
+            {
+                data[i] = '\0';
+            }
+            else
             {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
+                newStart = i;
                 break;
             }
+        }
 
-            ++nbLine;
+        for (int i = end; i >= start; --i)
+        {
+            if (isspace(data[i]) != 0)
+                data[i] = '\0';
+            else
+                break;
+        }
 
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-                {
-                start = endOfLine;
-                continue;
-            }
+        return newStart;
+    }
 
-            // Each line should follow this format:
-            // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
-            // The 3rd entry is access level and if above 127 the IP range isn't blocked.
-            const int firstComma = findAndNullDelimiter(buffer.data(), ',', start, endOfLine);
-            if (firstComma != -1)
-                findAndNullDelimiter(buffer.data(), ',', firstComma + 1, endOfLine);
+    bool isComment(const char *line)
+    {
+        return ((line[0] == '#') || ((line[0] == '/') && (line[1] == '/')));
+    }
 
-            // Check if there is an access value (apparently not mandatory)
-            if (firstComma != -1)
-            {
-                // There is possibly one
-                const long int nbAccess = strtol(buffer.data() + firstComma + 1, nullptr, 10);
-                // Ignoring this rule because access value is too high
-                if (nbAccess > 127L)
-                {
-                    start = endOfLine;
-                    continue;
-                }
-            }
+    LineStatus parseIPRange(char *const line, const int start, const int delimIP, const int end
+            , lt::address &startAddr, lt::address &endAddr)
+    {
+        if (!parseIPAddress(line + trim(line, start, delimIP - 1), startAddr))
+            return LineStatus::MalformedStartIP;
 
-            // IP Range should be split by a dash
-            const int endOfIPRange = ((firstComma == -1) ? (endOfLine - 1) : (firstComma - 1));
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', start, endOfIPRange);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+        if (!parseIPAddress(line + trim(line, delimIP + 1, end), endAddr))
+            return LineStatus::MalformedEndIP;
+
+        if ((startAddr.is_v4() != endAddr.is_v4())
+            || (startAddr.is_v6() != endAddr.is_v6()))
+        {
+            return LineStatus::IPVersionMismatch;
+        }
+
+        return LineStatus::Rule;
+    }
+
+    // Parser for eMule ip filter in DAT format
+    LineStatus parseDATLine(char *const line, const int endOfLine, lt::address &startAddr, lt::address &endAddr)
+    {
+        if (isComment(line))
+            return LineStatus::Skipped;
+
+        // Each line should follow this format:
+        // 001.009.096.105 - 001.009.096.105 , 000 , Some organization
+        // The 3rd entry is access level and if above 127 the IP range isn't blocked.
+        const int firstComma = findAndNullDelimiter(line, ',', 0, endOfLine);
+        if (firstComma != -1)
+        {
+            findAndNullDelimiter(line, ',', firstComma + 1, endOfLine);
+
+            // There is possibly an access value (apparently not mandatory)
+            const long int nbAccess = strtol(line + firstComma + 1, nullptr, 10);
+            // Ignoring this rule because access value is too high
+            if (nbAccess > 127L)
+                return LineStatus::Skipped;
+        }
+
+        // IP Range should be split by a dash
+        const int endOfIPRange = ((firstComma == -1) ? (endOfLine - 1) : (firstComma - 1));
+        const int delimIP = findAndNullDelimiter(line, '-', 0, endOfIPRange);
+        if (delimIP == -1)
+            return LineStatus::Malformed;
+
+        return parseIPRange(line, 0, delimIP, endOfIPRange, startAddr, endAddr);
+    }
+
+    // Parser for PeerGuardian ip filter in p2p format
+    LineStatus parseP2PLine(char *const line, const int endOfLine, lt::address &startAddr, lt::address &endAddr)
+    {
+        if (isComment(line))
+            return LineStatus::Skipped;
+
+        // Each line should follow this format:
+        // Some organization:1.0.0.0-1.255.255.255
+        // The "Some organization" part might contain a ':' char itself so we find the last occurrence
+        const int partsDelimiter = findAndNullDelimiter(line, ':', 0, endOfLine, true);
+        if (partsDelimiter == -1)
+            return LineStatus::Malformed;
+
+        // IP Range should be split by a dash
+        const int delimIP = findAndNullDelimiter(line, '-', (partsDelimiter + 1), endOfLine);
+        if (delimIP == -1)
+            return LineStatus::Malformed;
+
+        return parseIPRange(line, (partsDelimiter + 1), delimIP, endOfLine, startAddr, endAddr);
+    }
+
+    ChunkParsingResult parseChunk(const char *begin, const char *end, const LineParser parseLine, const std::atomic_bool &abort)
+    {
+        ChunkParsingResult result;
+        std::vector<char> lineBuffer;
+
+        const char *lineStart = begin;
+        while ((lineStart < end) && !abort)
+        {
+            const auto *newLine = static_cast<const char *>(std::memchr(lineStart, '\n', (end - lineStart)));
+            const char *lineEnd = (newLine ? newLine : end);
+            // Handle CRLF line endings the same way QIODevice::Text would do
+            if (newLine && (lineEnd > lineStart) && (*(lineEnd - 1) == '\r'))
+                --lineEnd;
+
+            // The line is copied so that it can be split in place. It is terminated by NULL
+            // in case the line has only an IP range, otherwise the parser won't work for the end IP.
+            const int endOfLine = static_cast<int>(lineEnd - lineStart);
+            lineBuffer.assign(lineStart, lineEnd);
+            lineBuffer.push_back('\0');
+            ++result.lineCount;
 
             lt::address startAddr;
-            int newStart = trim(buffer.data(), start, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
+            lt::address endAddr;
+            const LineStatus status = parseLine(lineBuffer.data(), endOfLine, startAddr, endAddr);
+            if (status == LineStatus::Rule)
             {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
+                result.rules.push_back({startAddr, endAddr, result.lineCount});
             }
-
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfIPRange);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
+            else if (status != LineStatus::Skipped)
             {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
+                ++result.errorCount;
+                if (result.errors.size() < MAX_LOGGED_ERRORS)
+                    result.errors.append({status, result.lineCount});
             }
 
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-                {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+            lineStart = (newLine ? (newLine + 1) : end);
+        }
 
-            start = endOfLine;
+        return result;
+    }
 
-            // Now Add to the filter
-            try
-            {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
-                ++ruleCount;
-            }
-            catch (const std::exception &e)
+    // Splits data into chunks of about equal size, each of them ending at line boundary
+    std::vector<std::pair<const char *, const char *>> splitIntoChunks(const char *data, const qint64 size, const int maxChunkCount)
+    {
+        const qint64 chunkSize = std::max(MIN_CHUNK_SIZE, ((size / std::max(maxChunkCount, 1)) + 1));
+        const char *dataEnd = data + size;
+
+        std::vector<std::pair<const char *, const char *>> chunks;
+        const char *chunkStart = data;
+        while (chunkStart < dataEnd)
+        {
+            const char *chunkEnd = dataEnd;
+            if ((dataEnd - chunkStart) > chunkSize)
             {
-                ++parseErrorCount;
-                addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
+                const char *searchStart = chunkStart + chunkSize;
+                const auto *newLine = static_cast<const char *>(std::memchr(searchStart, '\n', (dataEnd - searchStart)));
+                if (newLine)
+                    chunkEnd = newLine + 1;
             }
+
+            chunks.emplace_back(chunkStart, chunkEnd);
+            chunkStart = chunkEnd;
         }
 
-        if (start >= dataSize)
-            offset = 0;
+        return chunks;
     }
 
-    if (parseErrorCount > MAX_LOGGED_ERRORS)
-        LogMsg(tr("%1 extra IP filter parsing errors occurred.", "513 extra IP filter parsing errors occurred.")
-               .arg(parseErrorCount - MAX_LOGGED_ERRORS), Log::CRITICAL);
-    return ruleCount;
+    QByteArray fileHash(const Path &path)
+    {
+        QFile file {path.data()};
+        if (!file.open(QIODevice::ReadOnly))
+            return {};
+
+        QCryptographicHash hash {QCryptographicHash::Sha1};
+        if (!hash.addData(&file))
+            return {};
+
+        return hash.result();
+    }
+
+    template <typename T>
+    T readBigEndian(const uchar *&ptr)
+    {
+        const T value = qFromBigEndian<T>(ptr);
+        ptr += sizeof(T);
+        return value;
+    }
+
+    template <typename Address>
+    Address readAddress(const uchar *&ptr)
+    {
+        typename Address::bytes_type bytes;
+        std::memcpy(bytes.data(), ptr, bytes.size());
+        ptr += bytes.size();
+        return Address(bytes);
+    }
+
+    template <typename Address>
+    void writeAddress(QDataStream &stream, const Address &address)
+    {
+        const typename Address::bytes_type bytes = address.to_bytes();
+        stream.writeRawData(reinterpret_cast<const char *>(bytes.data()), static_cast<int>(bytes.size()));
+    }
 }
 
-// Parser for PeerGuardian ip filter in p2p format
-int FilterParserThread::parseP2PFilterFile()
+FilterParserThread::FilterParserThread(const Path &cacheFilePath, QObject *parent)
+    : QThread(parent)
+    , m_cacheFilePath(cacheFilePath)
+{
+}
+
+FilterParserThread::~FilterParserThread()
+{
+    m_abort = true;
+    wait();
+}
+
+// Parser for eMule ip filter in DAT format and PeerGuardian ip filter in p2p format.
+// The file is split into chunks which are parsed concurrently, then parsed rules
+// are added to the filter in the original order.
+int FilterParserThread::parseTextFilterFile(const TextFormat format)
 {
-    int ruleCount = 0;
     QFile file {m_filePath.data()};
-    if (!file.exists()) return ruleCount;
+    if (!file.exists()) return 0;
 
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (!file.open(QIODevice::ReadOnly))
     {
         LogMsg(tr("I/O Error: Could not open IP filter file in read mode."), Log::CRITICAL);
-        return ruleCount;
+        return 0;
     }
 
-    std::vector<char> buffer(BUFFER_SIZE, 0); // seems a bit faster than QVector
-    qint64 bytesRead = 0;
-    int offset = 0;
-    int start = 0;
-    int endOfLine = -1;
-    int nbLine = 0;
+    QByteArray fileData;
+    qint64 dataSize = file.size();
+    const char *data = reinterpret_cast<const char *>(file.map(0, dataSize));
+    if (!data)
+    {
+        fileData = file.readAll();
+        data = fileData.constData();
+        dataSize = fileData.size();
+    }
+
+    const LineParser parseLine = ((format == TextFormat::P2P) ? parseP2PLine : parseDATLine);
+    const std::vector<std::pair<const char *, const char *>> chunks = splitIntoChunks(data, dataSize, QThread::idealThreadCount());
+    std::vector<ChunkParsingResult> results(chunks.size());
+
+    QThreadPool threadPool;
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        threadPool.start([this, parseLine, &result = results[i], chunk = chunks[i]]
+        {
+            result = parseChunk(chunk.first, chunk.second, parseLine, m_abort);
+        });
+    }
+    threadPool.waitForDone();
+
+    int ruleCount = 0;
     int parseErrorCount = 0;
     const auto addLog = [&parseErrorCount](const QString &msg)
     {
         if (parseErrorCount <= MAX_LOGGED_ERRORS)
             LogMsg(msg, Log::CRITICAL);
     };
-
-    while (true)
+    const auto errorMessage = [](const LineStatus status, const int lineNumber) -> QString
     {
-        bytesRead = file.read(buffer.data() + offset, BUFFER_SIZE - offset - 1);
-        if (bytesRead < 0)
-            break;
-        const int dataSize = bytesRead + offset;
-        if ((bytesRead == 0) && (dataSize == 0))
-            break;
-
-        for (start = 0; start < dataSize; ++start)
+        switch (status)
         {
-            endOfLine = -1;
-            // The file might have ended without the last line having a newline
-            if (!((bytesRead == 0) && (dataSize > 0)))
-            {
-                for (int i = start; i < dataSize; ++i)
-                {
-                    if (buffer[i] == '\n')
-                    {
-                        endOfLine = i;
-                        // We need to NULL the newline in case the line has only an IP range.
-                        // In that case the parser won't work for the end IP, because it ends
-                        // with the newline and not with a number.
-                        buffer[i] = '\0';
-                        break;
-                    }
-                }
-            }
-            else
-            {
-                endOfLine = dataSize;
-                buffer[dataSize] = '\0';
-            }
-
-            if (endOfLine == -1)
-            {
-                // read the next chunk from file
-                // but first move(copy) the leftover data to the front of the buffer
-                offset = dataSize - start;
-                memmove(buffer.data(), buffer.data() + start, offset);
-                break;
-            }
-
-            ++nbLine;
-
-            if ((buffer[start] == '#')
-                || ((buffer[start] == '/') && ((start + 1 < dataSize) && (buffer[start + 1] == '/'))))
-                {
-                start = endOfLine;
-                continue;
-            }
-
-            // Each line should follow this format:
-            // Some organization:1.0.0.0-1.255.255.255
-            // The "Some organization" part might contain a ':' char itself so we find the last occurrence
-            const int partsDelimiter = findAndNullDelimiter(buffer.data(), ':', start, endOfLine, true);
-            if (partsDelimiter == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            // IP Range should be split by a dash
-            const int delimIP = findAndNullDelimiter(buffer.data(), '-', partsDelimiter + 1, endOfLine);
-            if (delimIP == -1)
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            lt::address startAddr;
-            int newStart = trim(buffer.data(), partsDelimiter + 1, delimIP - 1);
-            if (!parseIPAddress(buffer.data() + newStart, startAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
-
-            lt::address endAddr;
-            newStart = trim(buffer.data(), delimIP + 1, endOfLine);
-            if (!parseIPAddress(buffer.data() + newStart, endAddr))
-            {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+        case LineStatus::MalformedStartIP:
+            return tr("IP filter line %1 is malformed. Start IP of the range is malformed.").arg(lineNumber);
+        case LineStatus::MalformedEndIP:
+            return tr("IP filter line %1 is malformed. End IP of the range is malformed.").arg(lineNumber);
+        case LineStatus::IPVersionMismatch:
+            return tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(lineNumber);
+        default:
+            return tr("IP filter line %1 is malformed.").arg(lineNumber);
+        }
+    };
 
-            if ((startAddr.is_v4() != endAddr.is_v4())
-                || (startAddr.is_v6() != endAddr.is_v6()))
-                {
-                ++parseErrorCount;
-                addLog(tr("IP filter line %1 is malformed. One IP is IPv4 and the other is IPv6!").arg(nbLine));
-                start = endOfLine;
-                continue;
-            }
+    int lineOffset = 0;
+    for (const ChunkParsingResult &result : results)
+    {
+        if (m_abort) return ruleCount;
 
-            start = endOfLine;
+        for (const ParsingError &error : result.errors)
+        {
+            ++parseErrorCount;
+            addLog(errorMessage(error.status, (lineOffset + error.lineNumber)));
+        }
+        parseErrorCount += (result.errorCount - static_cast<int>(result.errors.size()));
 
+        // Now Add to the filter
+        for (const ParsedRule &rule : result.rules)
+        {
             try
             {
-                m_filter.add_rule(startAddr, endAddr, lt::ip_filter::blocked);
+                m_filter.add_rule(rule.first, rule.last, lt::ip_filter::blocked);
                 ++ruleCount;
             }
             catch (const std::exception &e)
             {
                 ++parseErrorCount;
                 addLog(tr("IP filter exception thrown for line %1. Exception is: %2")
-                       .arg(nbLine).arg(QString::fromLocal8Bit(e.what())));
+                       .arg(lineOffset + rule.lineNumber).arg(QString::fromLocal8Bit(e.what())));
             }
         }
 
-        if (start >= dataSize)
-            offset = 0;
+        lineOffset += result.lineCount;
     }
 
     if (parseErrorCount > MAX_LOGGED_ERRORS)
@@ -618,20 +688,11 @@ void FilterParserThread::run()
 {
     qDebug("Processing filter file");
     int ruleCount = 0;
-    if (m_filePath.hasExtension(u".p2p"_qs))
-    {
-        // PeerGuardian p2p file
-        ruleCount = parseP2PFilterFile();
-    }
-    else if (m_filePath.hasExtension(u".p2b"_qs))
-    {
-        // PeerGuardian p2b file
-        ruleCount = parseP2BFilterFile();
-    }
-    else if (m_filePath.hasExtension(u".dat"_qs))
+    if (!loadCache(ruleCount))
     {
-        // eMule DAT format
-        ruleCount = parseDATFilterFile();
+        ruleCount = parseFilterFile();
+        if (!m_abort && (ruleCount > 0))
+            storeCache(ruleCount);
     }
 
     if (m_abort) return;
@@ -648,59 +709,144 @@ void FilterParserThread::run()
     qDebug("IP Filter thread: finished parsing, filter applied");
 }
 
-int FilterParserThread::findAndNullDelimiter(char *const data, const char delimiter, const int start, const int end, const bool reverse)
+int FilterParserThread::parseFilterFile()
 {
-    if (!reverse)
+    if (m_filePath.hasExtension(u".p2p"_qs))
     {
-        for (int i = start; i <= end; ++i)
-        {
-            if (data[i] == delimiter)
-            {
-                data[i] = '\0';
-                return i;
-            }
-        }
+        // PeerGuardian p2p file
+        return parseTextFilterFile(TextFormat::P2P);
     }
-    else
+
+    if (m_filePath.hasExtension(u".p2b"_qs))
     {
-        for (int i = end; i >= start; --i)
-        {
-            if (data[i] == delimiter)
-            {
-                data[i] = '\0';
-                return i;
-            }
-        }
+        // PeerGuardian p2b file
+        return parseP2BFilterFile();
     }
 
-    return -1;
+    if (m_filePath.hasExtension(u".dat"_qs))
+    {
+        // eMule DAT format
+        return parseTextFilterFile(TextFormat::DAT);
+    }
+
+    return 0;
 }
 
-int FilterParserThread::trim(char *const data, const int start, const int end)
+// Loads previously parsed filter if it was built from the same source file.
+// The source file is considered the same if it has the same size and modification time,
+// or, if only the modification time differs, the same content hash.
+bool FilterParserThread::loadCache(int &ruleCount)
 {
-    if (start >= end) return start;
-    int newStart = start;
+    if (m_cacheFilePath.isEmpty() || !m_filePath.exists())
+        return false;
+
+    QFile cacheFile {m_cacheFilePath.data()};
+    if (!cacheFile.open(QIODevice::ReadOnly))
+        return false;
+
+    const qint64 cacheSize = cacheFile.size();
+    if (cacheSize < CACHE_HEADER_SIZE)
+        return false;
+
+    const uchar *data = cacheFile.map(0, cacheSize);
+    if (!data)
+        return false;
+
+    const uchar *ptr = data;
+    if ((readBigEndian<quint32>(ptr) != CACHE_MAGIC) || (readBigEndian<quint32>(ptr) != CACHE_VERSION))
+        return false;
+
+    const auto sourceSize = readBigEndian<qint64>(ptr);
+    const auto sourceModificationTime = readBigEndian<qint64>(ptr);
+    const QByteArray sourceHash = QByteArray::fromRawData(reinterpret_cast<const char *>(ptr), SOURCE_HASH_SIZE);
+    ptr += SOURCE_HASH_SIZE;
+    const auto cachedRuleCount = readBigEndian<qint32>(ptr);
+    const auto v4RangeCount = readBigEndian<quint32>(ptr);
+    const auto v6RangeCount = readBigEndian<quint32>(ptr);
+
+    const qint64 expectedCacheSize = CACHE_HEADER_SIZE
+            + (v4RangeCount * CACHED_V4_RANGE_SIZE) + (v6RangeCount * CACHED_V6_RANGE_SIZE);
+    if (expectedCacheSize != cacheSize)
+        return false;
+
+    if (sourceSize != QFile(m_filePath.data()).size())
+        return false;
+
+    if ((sourceModificationTime != Utils::Fs::lastModified(m_filePath).toMSecsSinceEpoch())
+        && (sourceHash != fileHash(m_filePath)))
+    {
+        return false;
+    }
 
-    for (int i = start; i <= end; ++i)
+    lt::ip_filter filter;
+    for (quint32 i = 0; i < v4RangeCount; ++i)
     {
-        if (isspace(data[i]) != 0)
-        {
-            data[i] = '\0';
-        }
-        else
-        {
-            newStart = i;
-            break;
-        }
+        const auto first = readAddress<lt::address_v4>(ptr);
+        const auto last = readAddress<lt::address_v4>(ptr);
+        filter.add_rule(first, last, lt::ip_filter::blocked);
+
+        if (m_abort) return false;
+    }
+    for (quint32 i = 0; i < v6RangeCount; ++i)
+    {
+        const auto first = readAddress<lt::address_v6>(ptr);
+        const auto last = readAddress<lt::address_v6>(ptr);
+        filter.add_rule(first, last, lt::ip_filter::blocked);
+
+        if (m_abort) return false;
     }
 
-    for (int i = end; i >= start; --i)
+    m_filter = filter;
+    ruleCount = cachedRuleCount;
+    qDebug("IP filter loaded from cache: %d rules", ruleCount);
+    return true;
+}
+
+void FilterParserThread::storeCache(const int ruleCount) const
+{
+    if (m_cacheFilePath.isEmpty())
+        return;
+
+    const QByteArray sourceHash = fileHash(m_filePath);
+    if (sourceHash.size() != SOURCE_HASH_SIZE)
+        return;
+
+    const auto [v4Ranges, v6Ranges] = m_filter.export_filter();
+    const auto isBlocked = [](const auto &range) { return (range.flags == lt::ip_filter::blocked); };
+    const auto v4RangeCount = static_cast<quint32>(std::count_if(v4Ranges.cbegin(), v4Ranges.cend(), isBlocked));
+    const auto v6RangeCount = static_cast<quint32>(std::count_if(v6Ranges.cbegin(), v6Ranges.cend(), isBlocked));
+
+    QByteArray data;
+    data.reserve(CACHE_HEADER_SIZE + (v4RangeCount * CACHED_V4_RANGE_SIZE) + (v6RangeCount * CACHED_V6_RANGE_SIZE));
+
+    QDataStream stream {&data, QIODevice::WriteOnly};
+    stream << CACHE_MAGIC << CACHE_VERSION
+           << QFile(m_filePath.data()).size()
+           << Utils::Fs::lastModified(m_filePath).toMSecsSinceEpoch();
+    stream.writeRawData(sourceHash.constData(), sourceHash.size());
+    stream << static_cast<qint32>(ruleCount) << v4RangeCount << v6RangeCount;
+
+    for (const auto &range : v4Ranges)
     {
-        if (isspace(data[i]) != 0)
-            data[i] = '\0';
-        else
-            break;
+        if (!isBlocked(range))
+            continue;
+
+        writeAddress(stream, range.first);
+        writeAddress(stream, range.last);
     }
+    for (const auto &range : v6Ranges)
+    {
+        if (!isBlocked(range))
+            continue;
 
-    return newStart;
+        writeAddress(stream, range.first);
+        writeAddress(stream, range.last);
+    }
+
+    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(m_cacheFilePath, data);
+    if (!result)
+    {
+        LogMsg(tr("Couldn't save IP filter cache. File: \"%1\". Error: \"%2\"")
+               .arg(m_cacheFilePath.toString(), result.error()), Log::WARNING);
+    }
 }
@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include <libtorrent/ip_filter.hpp>
 
 #include <QThread>
@@ -42,7 +44,7 @@ class FilterParserThread final : public QThread
     Q_DISABLE_COPY_MOVE(FilterParserThread)
 
 public:
-    FilterParserThread(QObject *parent = nullptr);
+    explicit FilterParserThread(const Path &cacheFilePath = {}, QObject *parent = nullptr);
     ~FilterParserThread();
     void processFilterFile(const Path &filePath);
     lt::ip_filter IPfilter();
@@ -55,14 +57,21 @@ protected:
     void run() override;
 
 private:
-    int findAndNullDelimiter(char *const data, char delimiter, int start, int end, bool reverse = false);
-    int trim(char *const data, int start, int end);
-    int parseDATFilterFile();
-    int parseP2PFilterFile();
+    enum class TextFormat
+    {
+        DAT,
+        P2P
+    };
+
+    int parseFilterFile();
+    int parseTextFilterFile(TextFormat format);
     int getlineInStream(QDataStream &stream, std::string &name, char delim);
     int parseP2BFilterFile();
+    bool loadCache(int &ruleCount);
+    void storeCache(int ruleCount) const;
 
-    bool m_abort;
+    std::atomic_bool m_abort {false};
+    Path m_cacheFilePath;
     Path m_filePath;
     lt::ip_filter m_filter;
 };
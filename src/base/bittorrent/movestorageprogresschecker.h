@@ -1,6 +1,6 @@
 /*
  * Bittorrent Client using Qt and libtorrent.
- * Copyright (C) 2006  Christophe Dumez <chris@qbittorrent.org>
+ * Copyright (C) 2026  agent <agent@local>
  *
  * This program is free software; you can redistribute it and/or
  * modify it under the terms of the GNU General Public License
@@ -28,34 +28,28 @@
 
 #pragma once
 
-#include <QCache>
-#include <QHostAddress>
+#include <QtContainerFwd>
 #include <QObject>
 
-class QHostInfo;
-class QString;
+#include "base/path.h"
 
-namespace Net
+namespace BitTorrent
 {
-    class ReverseResolution : public QObject
+    // Finds out how much data of the files being moved is already at the target location.
+    // It lives in I/O thread so the main thread isn't blocked by the file system.
+    class MoveStorageProgressChecker final : public QObject
     {
         Q_OBJECT
-        Q_DISABLE_COPY_MOVE(ReverseResolution)
+        Q_DISABLE_COPY_MOVE(MoveStorageProgressChecker)
 
     public:
-        explicit ReverseResolution(QObject *parent = nullptr);
-        ~ReverseResolution();
+        MoveStorageProgressChecker() = default;
 
-        void resolve(const QHostAddress &ip);
+    public slots:
+        void check(quint64 jobID, const PathList &filePaths);
 
     signals:
-        void ipResolved(const QHostAddress &ip, const QString &hostname);
-
-    private slots:
-        void hostResolved(const QHostInfo &host);
-
-    private:
-        QHash<int, QHostAddress> m_lookups;  // <LookupID, IP>
-        QCache<QHostAddress, QString> m_cache;  // <IP, HostName>
+        // Sizes are in the same order as paths are, missing files have zero size
+        void checked(quint64 jobID, const QVector<qint64> &fileSizes);
     };
 }
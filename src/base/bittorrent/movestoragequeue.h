@@ -0,0 +1,175 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <QtGlobal>
+#include <QHash>
+#include <QString>
+
+namespace BitTorrent
+{
+    // Decides when move storage jobs are started.
+    // Jobs are started in order they are added, but the ones moving data between different
+    // storage devices are limited per target device: writing is the expensive part and
+    // parallel writes to the same device slow each other down. It still allows moving data
+    // from one device to several ones in parallel. Moving within the same device doesn't copy
+    // the data, so it isn't limited. Each torrent (identified by Key) can have one waiting
+    // and one running job and it is never moved by several jobs at a time.
+    template <typename Key>
+    class MoveStorageQueue
+    {
+    public:
+        explicit MoveStorageQueue(const int maxActiveJobsPerDevice)
+            : m_maxActiveJobsPerDevice {maxActiveJobsPerDevice}
+        {
+        }
+
+        // Replaces the waiting job of the same torrent. Returns ID of the new job.
+        quint64 enqueue(const Key &key, const QString &sourceDevice, const QString &targetDevice)
+        {
+            const quint64 jobID = ++m_lastJobID;
+            m_queuedJobs.insert_or_assign(key, Job {jobID, sourceDevice, targetDevice});
+            m_queue.emplace_back(key, jobID);
+            return jobID;
+        }
+
+        // Removes the waiting job of the torrent
+        bool remove(const Key &key)
+        {
+            return (m_queuedJobs.erase(key) > 0);
+        }
+
+        // Returns the torrents which jobs can be started now in order the jobs were added.
+        // These jobs are regarded running until finish() is called.
+        std::vector<Key> start()
+        {
+            std::vector<Key> startedKeys;
+            for (auto iter = m_queue.begin(); iter != m_queue.end();)
+            {
+                const auto jobIter = m_queuedJobs.find(iter->first);
+                if ((jobIter == m_queuedJobs.end()) || (jobIter->second.id != iter->second))
+                {
+                    // job was removed or replaced with another one
+                    iter = m_queue.erase(iter);
+                    continue;
+                }
+
+                if (isActive(iter->first) || !canStart(jobIter->second))
+                {
+                    ++iter;
+                    continue;
+                }
+
+                const Job &job = m_activeJobs.insert_or_assign(iter->first, jobIter->second).first->second;
+                if (job.sourceDevice != job.targetDevice)
+                    ++m_activeJobsByDevice[job.targetDevice];
+
+                startedKeys.push_back(iter->first);
+                m_queuedJobs.erase(jobIter);
+                iter = m_queue.erase(iter);
+            }
+
+            return startedKeys;
+        }
+
+        void finish(const Key &key)
+        {
+            const auto jobIter = m_activeJobs.find(key);
+            if (jobIter == m_activeJobs.end())
+                return;
+
+            const Job &job = jobIter->second;
+            if (job.sourceDevice != job.targetDevice)
+            {
+                if (--m_activeJobsByDevice[job.targetDevice] <= 0)
+                    m_activeJobsByDevice.remove(job.targetDevice);
+            }
+
+            m_activeJobs.erase(jobIter);
+        }
+
+        bool isActive(const Key &key) const
+        {
+            return (m_activeJobs.find(key) != m_activeJobs.cend());
+        }
+
+        bool isQueued(const Key &key) const
+        {
+            return (m_queuedJobs.find(key) != m_queuedJobs.cend());
+        }
+
+        bool isEmpty() const
+        {
+            return (m_activeJobs.empty() && m_queuedJobs.empty());
+        }
+
+        // Returns the torrents having waiting jobs in order the jobs will be started
+        std::vector<Key> queuedKeys() const
+        {
+            std::vector<Key> keys;
+            keys.reserve(m_queuedJobs.size());
+            for (const auto &[key, jobID] : m_queue)
+            {
+                const auto jobIter = m_queuedJobs.find(key);
+                if ((jobIter != m_queuedJobs.cend()) && (jobIter->second.id == jobID))
+                    keys.push_back(key);
+            }
+
+            return keys;
+        }
+
+    private:
+        struct Job
+        {
+            quint64 id = 0;
+            QString sourceDevice;
+            QString targetDevice;
+        };
+
+        bool canStart(const Job &job) const
+        {
+            if (job.sourceDevice == job.targetDevice)
+                return true;
+
+            return (m_activeJobsByDevice.value(job.targetDevice) < m_maxActiveJobsPerDevice);
+        }
+
+        const int m_maxActiveJobsPerDevice;
+        std::unordered_map<Key, Job> m_activeJobs;
+        std::unordered_map<Key, Job> m_queuedJobs;
+        std::deque<std::pair<Key, quint64>> m_queue;  // waiting jobs in order of addition
+        quint64 m_lastJobID = 0;
+        QHash<QString, int> m_activeJobsByDevice;  // <TargetDevice, ActiveJobsCount>
+    };
+}
@@ -48,6 +48,12 @@ Path BitTorrent::ResumeDataStorage::path() const
     return m_path;
 }
 
+void BitTorrent::ResumeDataStorage::storeBatch(const QHash<TorrentID, LoadTorrentParams> &resumeData) const
+{
+    for (auto it = resumeData.cbegin(); it != resumeData.cend(); ++it)
+        store(it.key(), it.value());
+}
+
 void BitTorrent::ResumeDataStorage::loadAll() const
 {
     m_loadedResumeData.reserve(1024);
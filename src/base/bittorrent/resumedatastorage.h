@@ -29,6 +29,7 @@
 #pragma once
 
 #include <QtContainerFwd>
+#include <QHash>
 #include <QList>
 #include <QMutex>
 #include <QObject>
@@ -63,6 +64,7 @@ namespace BitTorrent
         virtual void store(const TorrentID &id, const LoadTorrentParams &resumeData) const = 0;
         virtual void remove(const TorrentID &id) const = 0;
         virtual void storeQueue(const QVector<TorrentID> &queue) const = 0;
+        virtual void storeBatch(const QHash<TorrentID, LoadTorrentParams> &resumeData) const;
 
         void loadAll() const;
         QList<LoadedResumeData> fetchLoadedResumeData() const;
@@ -29,10 +29,13 @@
 
 #pragma once
 
+#include <chrono>
+
 #include <QtContainerFwd>
 #include <QObject>
 
 #include "base/pathfwd.h"
+#include "base/torrentfilter.h"
 #include "addtorrentparams.h"
 #include "categoryoptions.h"
 #include "trackerentry.h"
@@ -62,9 +65,21 @@ namespace BitTorrent
     class Torrent;
     class TorrentID;
     class TorrentInfo;
+    struct AddTorrentRequest;
+    struct AddTorrentResult;
     struct CacheStatus;
+    struct MoveStorageJobStatus;
     struct SessionStatus;
 
+    enum class TorrentState;
+
+    // Torrents that aren't expected to change often are refreshed less frequently
+    enum class TorrentRefreshTier
+    {
+        Active,
+        Idle
+    };
+
     // Using `Q_ENUM_NS()` without a wrapper namespace in our case is not advised
     // since `Q_NAMESPACE` cannot be used when the same namespace resides at different files.
     // https://www.kdab.com/new-qt-5-8-meta-object-support-namespaces/#comment-143779
@@ -403,19 +418,29 @@ namespace BitTorrent
         virtual Torrent *findTorrent(const InfoHash &infoHash) const = 0;
         virtual QVector<Torrent *> torrents() const = 0;
         virtual qsizetype torrentsCount() const = 0;
+        virtual qsizetype torrentsCount(TorrentFilter::Type stateFilter) const = 0;
+        virtual qsizetype torrentsCount(TorrentRefreshTier refreshTier) const = 0;
         virtual const SessionStatus &status() const = 0;
         virtual const CacheStatus &cacheStatus() const = 0;
+        virtual QVector<MoveStorageJobStatus> moveStorageJobs() const = 0;
+        virtual bool moveStorageJobStatus(const TorrentID &id, MoveStorageJobStatus &status) const = 0;
         virtual bool isListening() const = 0;
 
         virtual MaxRatioAction maxRatioAction() const = 0;
         virtual void setMaxRatioAction(MaxRatioAction act) = 0;
 
         virtual void banIP(const QString &ip) = 0;
+        // All the given IPs are banned at once applying a single filter update.
+        // Bans having non-zero duration expire automatically and aren't stored.
+        virtual void banIPs(const QStringList &ips, std::chrono::seconds duration = {}) = 0;
+        virtual void unbanIPs(const QStringList &ips) = 0;
 
         virtual bool isKnownTorrent(const InfoHash &infoHash) const = 0;
         virtual bool addTorrent(const QString &source, const AddTorrentParams &params = {}) = 0;
         virtual bool addTorrent(const MagnetUri &magnetUri, const AddTorrentParams &params = {}) = 0;
         virtual bool addTorrent(const TorrentInfo &torrentInfo, const AddTorrentParams &params = {}) = 0;
+        // Adds torrents in bulk, the result of each request is at the same position as the request
+        virtual QVector<AddTorrentResult> addTorrents(const QVector<AddTorrentRequest> &requests) = 0;
         virtual bool deleteTorrent(const TorrentID &id, DeleteOption deleteOption = DeleteOption::DeleteTorrent) = 0;
         virtual bool downloadMetadata(const MagnetUri &magnetUri) = 0;
         virtual bool cancelDownloadMetadata(const TorrentID &id) = 0;
@@ -450,10 +475,13 @@ namespace BitTorrent
         void torrentFinished(Torrent *torrent);
         void torrentFinishedChecking(Torrent *torrent);
         void torrentMetadataReceived(Torrent *torrent);
+        void torrentNameChanged(Torrent *torrent);
         void torrentPaused(Torrent *torrent);
         void torrentResumed(Torrent *torrent);
         void torrentSavePathChanged(Torrent *torrent);
         void torrentSavingModeChanged(Torrent *torrent);
+        void torrentStorageMoveProgressUpdated(Torrent *torrent);
+        void torrentStateChanged(Torrent *torrent, TorrentState prevState);
         void torrentsLoaded(const QVector<Torrent *> &torrents);
         void torrentsUpdated(const QVector<Torrent *> &torrents);
         void torrentTagAdded(Torrent *torrent, const QString &tag);
@@ -84,7 +84,6 @@
 #include "base/profile.h"
 #include "base/torrentfileguard.h"
 #include "base/torrentfilter.h"
-#include "base/unicodestrings.h"
 #include "base/utils/bytearray.h"
 #include "base/utils/fs.h"
 #include "base/utils/io.h"
@@ -92,6 +91,7 @@
 #include "base/utils/net.h"
 #include "base/utils/random.h"
 #include "base/version.h"
+#include "addtorrentrequest.h"
 #include "bandwidthscheduler.h"
 #include "bencoderesumedatastorage.h"
 #include "common.h"
@@ -104,6 +104,7 @@
 #include "loadtorrentparams.h"
 #include "lttypecast.h"
 #include "magneturi.h"
+#include "movestorageprogresschecker.h"
 #include "nativesessionextension.h"
 #include "portforwarderimpl.h"
 #include "resumedatastorage.h"
@@ -116,6 +117,12 @@ using namespace BitTorrent;
 const Path CATEGORIES_FILE_NAME {u"categories.json"_qs};
 const int MAX_PROCESSING_RESUMEDATA_COUNT = 50;
 const int STATISTICS_SAVE_INTERVAL = std::chrono::milliseconds(15min).count();
+// Parallel copying to the same device only makes the moves compete for its bandwidth
+// (and seek time of HDD), so they are done one by one
+const int MAX_ACTIVE_MOVE_STORAGE_JOBS_PER_DEVICE = 1;
+const int MOVE_STORAGE_PROGRESS_FILES_PER_UPDATE = 64;
+// Idle torrents are notified about once per this number of refresh cycles
+const int IDLE_TORRENTS_REFRESH_CYCLES = 10;
 
 namespace
 {
@@ -222,6 +229,23 @@ namespace
         return u"INVALID"_qs;
     }
 
+    Log::PeerAddress toLogPeerAddress(const lt::address &address)
+    {
+        Log::PeerAddress peerAddress;
+        if (address.is_v4())
+        {
+            const lt::address_v4::bytes_type bytes = address.to_v4().to_bytes();
+            std::copy(bytes.cbegin(), bytes.cend(), peerAddress.bytes.begin());
+        }
+        else
+        {
+            const lt::address_v6::bytes_type bytes = address.to_v6().to_bytes();
+            std::copy(bytes.cbegin(), bytes.cend(), peerAddress.bytes.begin());
+            peerAddress.isIPv6 = true;
+        }
+        return peerAddress;
+    }
+
     QString toString(const lt::address &address)
     {
         try
@@ -314,6 +338,24 @@ namespace
             return lt::move_flags_t::always_replace_files;
         }
     }
+
+    // Periodic status updates are requested for all the torrents so they shouldn't
+    // include heavy fields (e.g. piece bitfields). Such fields are queried on demand.
+    const lt::status_flags_t TORRENT_STATUS_UPDATE_FLAGS = lt::torrent_handle::query_accurate_download_counters
+            | lt::torrent_handle::query_distributed_copies
+            | lt::torrent_handle::query_last_seen_complete
+            | lt::torrent_handle::query_name
+            | lt::torrent_handle::query_save_path
+            | lt::torrent_handle::query_torrent_file;
+
+    TorrentID toTorrentID(const lt::torrent_handle &nativeHandle)
+    {
+#ifdef QBT_USES_LIBTORRENT2
+        return TorrentID::fromInfoHash(nativeHandle.info_hashes());
+#else
+        return TorrentID::fromInfoHash(nativeHandle.info_hash());
+#endif
+    }
 }
 
 struct BitTorrent::SessionImpl::ResumeSessionContext final : public QObject
@@ -499,20 +541,16 @@ SessionImpl::SessionImpl(QObject *parent)
     , m_requestQueueSize(BITTORRENT_SESSION_KEY(u"RequestQueueSize"_qs), 500)
     , m_isExcludedFileNamesEnabled(BITTORRENT_KEY(u"ExcludedFileNamesEnabled"_qs), false)
     , m_excludedFileNames(BITTORRENT_SESSION_KEY(u"ExcludedFileNames"_qs))
-    , m_bannedIPs(u"State/BannedIPs"_qs
-                  , QStringList()
-                  , [](const QStringList &value)
-                        {
-                            QStringList tmp = value;
-                            tmp.sort();
-                            return tmp;
-                        }
-                 )
+    , m_storedBannedIPs(u"State/BannedIPs"_qs)
     , m_resumeDataStorageType(BITTORRENT_SESSION_KEY(u"ResumeDataStorageType"_qs), ResumeDataStorageType::Legacy)
     , m_seedingLimitTimer {new QTimer {this}}
     , m_resumeDataTimer {new QTimer {this}}
+    , m_initialResumeDataTimer {new QTimer {this}}
     , m_ioThread {new QThread}
     , m_recentErroredTorrentsTimer {new QTimer {this}}
+    , m_moveStorageQueue {MAX_ACTIVE_MOVE_STORAGE_JOBS_PER_DEVICE}
+    , m_moveStorageProgressTimer {new QTimer {this}}
+    , m_banExpirationTimer {new QTimer {this}}
 #if (QT_VERSION < QT_VERSION_CHECK(6, 0, 0))
     , m_networkManager {new QNetworkConfigurationManager {this}}
 #endif
@@ -525,6 +563,18 @@ SessionImpl::SessionImpl(QObject *parent)
     connect(m_recentErroredTorrentsTimer, &QTimer::timeout
         , this, [this]() { m_recentErroredTorrents.clear(); });
 
+    m_moveStorageProgressTimer->setInterval(1s);
+    connect(m_moveStorageProgressTimer, &QTimer::timeout, this, &SessionImpl::updateMoveStorageProgress);
+
+    const QStringList storedBannedIPs = m_storedBannedIPs.get();
+    m_bannedIPs = QSet<QString>(storedBannedIPs.cbegin(), storedBannedIPs.cend());
+    m_banExpirationTimer->setSingleShot(true);
+    connect(m_banExpirationTimer, &QTimer::timeout, this, &SessionImpl::processExpiredBans);
+
+    m_initialResumeDataTimer->setSingleShot(true);
+    m_initialResumeDataTimer->setInterval(1s);
+    connect(m_initialResumeDataTimer, &QTimer::timeout, this, &SessionImpl::requestInitialResumeData);
+
     m_seedingLimitTimer->setInterval(10s);
     connect(m_seedingLimitTimer, &QTimer::timeout, this, &SessionImpl::processShareLimits);
 
@@ -566,6 +616,11 @@ SessionImpl::SessionImpl(QObject *parent)
     connect(m_ioThread.get(), &QThread::finished, m_fileSearcher, &QObject::deleteLater);
     connect(m_fileSearcher, &FileSearcher::searchFinished, this, &SessionImpl::fileSearchFinished);
 
+    m_moveStorageProgressChecker = new MoveStorageProgressChecker;
+    m_moveStorageProgressChecker->moveToThread(m_ioThread.get());
+    connect(m_ioThread.get(), &QThread::finished, m_moveStorageProgressChecker, &QObject::deleteLater);
+    connect(m_moveStorageProgressChecker, &MoveStorageProgressChecker::checked, this, &SessionImpl::handleMoveStorageProgressChecked);
+
     m_ioThread->start();
 
     initMetrics();
@@ -1146,7 +1201,7 @@ void SessionImpl::prepareStartup()
 
         if (!m_refreshEnqueued)
         {
-            m_nativeSession->post_torrent_updates();
+            m_nativeSession->post_torrent_updates(TORRENT_STATUS_UPDATE_FLAGS);
             m_refreshEnqueued = true;
         }
 
@@ -1481,15 +1536,66 @@ void SessionImpl::initializeNativeSession()
 
 void SessionImpl::processBannedIPs(lt::ip_filter &filter)
 {
-    // First, import current filter
-    for (const QString &ip : asConst(m_bannedIPs.get()))
+    const auto addRule = [&filter](const QString &ip)
     {
         lt::error_code ec;
         const lt::address addr = lt::make_address(ip.toLatin1().constData(), ec);
         Q_ASSERT(!ec);
         if (!ec)
             filter.add_rule(addr, addr, lt::ip_filter::blocked);
+    };
+
+    // First, import current filter
+    for (const QString &ip : asConst(m_bannedIPs))
+        addRule(ip);
+    for (auto it = m_temporaryBannedIPs.cbegin(); it != m_temporaryBannedIPs.cend(); ++it)
+        addRule(it.key());
+}
+
+void SessionImpl::storeBannedIPs()
+{
+    m_storedBannedIPs = bannedIPs();
+}
+
+void SessionImpl::scheduleBanExpiration()
+{
+    if (m_temporaryBannedIPs.isEmpty())
+    {
+        m_banExpirationTimer->stop();
+        return;
+    }
+
+    const QDateTime nearestExpiration = *std::min_element(m_temporaryBannedIPs.cbegin(), m_temporaryBannedIPs.cend());
+    // Limit the interval so long bans don't overflow the timer
+    const qint64 interval = std::clamp<qint64>(QDateTime::currentDateTime().msecsTo(nearestExpiration), 0, (24 * 60 * 60 * 1000));
+    m_banExpirationTimer->start(static_cast<int>(interval));
+}
+
+void SessionImpl::processExpiredBans()
+{
+    const QDateTime now = QDateTime::currentDateTime();
+    bool hasExpiredBans = false;
+    for (auto it = m_temporaryBannedIPs.begin(); it != m_temporaryBannedIPs.end();)
+    {
+        if (it.value() <= now)
+        {
+            it = m_temporaryBannedIPs.erase(it);
+            hasExpiredBans = true;
+        }
+        else
+        {
+            ++it;
+        }
     }
+
+    if (hasExpiredBans)
+    {
+        // rules can't be removed from lt::ip_filter so we have to rebuild it
+        m_IPFilteringConfigured = false;
+        configureDeferred();
+    }
+
+    scheduleBanExpiration();
 }
 
 void SessionImpl::initMetrics()
@@ -2179,20 +2285,97 @@ Torrent *SessionImpl::findTorrent(const InfoHash &infoHash) const
 
 void SessionImpl::banIP(const QString &ip)
 {
-    QStringList bannedIPs = m_bannedIPs;
-    if (!bannedIPs.contains(ip))
+    banIPs({ip});
+}
+
+void SessionImpl::banIPs(const QStringList &ips, const std::chrono::seconds duration)
+{
+    const QDateTime expirationTime = (duration > 0s)
+            ? QDateTime::currentDateTime().addSecs(duration.count()) : QDateTime();
+
+    std::vector<lt::address> newBannedAddresses;
+    bool isBannedIPsChanged = false;
+    for (const QString &ip : ips)
     {
-        lt::ip_filter filter = m_nativeSession->get_ip_filter();
+        if (!Utils::Net::isValidIP(ip))
+        {
+            LogMsg(tr("Rejected invalid IP address while banning peers. IP: \"%1\"").arg(ip), Log::WARNING);
+            continue;
+        }
+
+        // the same IPv6 addresses could be written in different forms
+        const QString normalizedIP = QHostAddress(ip).toString();
+        if (m_bannedIPs.contains(normalizedIP))
+            continue;
+
+        const bool isTemporaryBanned = m_temporaryBannedIPs.contains(normalizedIP);
+        if (expirationTime.isValid())
+        {
+            QDateTime &banExpirationTime = m_temporaryBannedIPs[normalizedIP];
+            if (!isTemporaryBanned || (banExpirationTime < expirationTime))
+                banExpirationTime = expirationTime;
+        }
+        else
+        {
+            m_temporaryBannedIPs.remove(normalizedIP);
+            m_bannedIPs.insert(normalizedIP);
+            isBannedIPsChanged = true;
+        }
+
+        if (isTemporaryBanned)
+            continue; // it is already blocked by current filter
+
         lt::error_code ec;
-        const lt::address addr = lt::make_address(ip.toLatin1().constData(), ec);
+        const lt::address addr = lt::make_address(normalizedIP.toLatin1().constData(), ec);
         Q_ASSERT(!ec);
-        if (ec) return;
-        filter.add_rule(addr, addr, lt::ip_filter::blocked);
+        if (!ec)
+            newBannedAddresses.push_back(addr);
+    }
+
+    if (!newBannedAddresses.empty())
+    {
+        lt::ip_filter filter = m_nativeSession->get_ip_filter();
+        for (const lt::address &addr : newBannedAddresses)
+            filter.add_rule(addr, addr, lt::ip_filter::blocked);
         m_nativeSession->set_ip_filter(filter);
+    }
+
+    if (isBannedIPsChanged)
+        storeBannedIPs();
+    if (expirationTime.isValid())
+        scheduleBanExpiration();
+}
+
+void SessionImpl::unbanIPs(const QStringList &ips)
+{
+    bool isBannedIPsChanged = false;
+    bool isFilterChanged = false;
+    for (const QString &ip : ips)
+    {
+        if (!Utils::Net::isValidIP(ip))
+            continue;
 
-        bannedIPs << ip;
-        bannedIPs.sort();
-        m_bannedIPs = bannedIPs;
+        const QString normalizedIP = QHostAddress(ip).toString();
+        if (m_bannedIPs.remove(normalizedIP))
+        {
+            isBannedIPsChanged = true;
+            isFilterChanged = true;
+        }
+        else if (m_temporaryBannedIPs.remove(normalizedIP) > 0)
+        {
+            isFilterChanged = true;
+        }
+    }
+
+    if (isBannedIPsChanged)
+        storeBannedIPs();
+
+    if (isFilterChanged)
+    {
+        // rules can't be removed from lt::ip_filter so we have to rebuild it
+        m_IPFilteringConfigured = false;
+        configureDeferred();
+        scheduleBanExpiration();
     }
 }
 
@@ -2203,6 +2386,14 @@ bool SessionImpl::deleteTorrent(const TorrentID &id, const DeleteOption deleteOp
     TorrentImpl *const torrent = m_torrents.take(id);
     if (!torrent) return false;
 
+    adjustTorrentsCountByStateFilter(torrent->stateFilterTypes(), -1);
+    adjustTorrentsCountByRefreshTier(torrent->refreshTier(), -1);
+    m_deferredUpdatedTorrents.remove(torrent);
+    m_torrentsAwaitingInitialSave.remove(torrent);
+    m_initialResumeDataBatch.remove(id);
+    if (m_initialResumeDataRequests.remove(id) && m_initialResumeDataRequests.isEmpty())
+        storeInitialResumeData();
+
     qDebug("Deleting torrent with ID: %s", qUtf8Printable(torrent->id().toString()));
     emit torrentAboutToBeRemoved(torrent);
 
@@ -2215,12 +2406,7 @@ bool SessionImpl::deleteTorrent(const TorrentID &id, const DeleteOption deleteOp
         m_removingTorrents[torrent->id()] = {torrent->name(), {}, deleteOption};
 
         const lt::torrent_handle nativeHandle {torrent->nativeHandle()};
-        const auto iter = std::find_if(m_moveStorageQueue.begin(), m_moveStorageQueue.end()
-                                 , [&nativeHandle](const MoveStorageJob &job)
-        {
-            return job.torrentHandle == nativeHandle;
-        });
-        if (iter != m_moveStorageQueue.end())
+        if (hasMoveStorageJob(nativeHandle))
         {
             // We shouldn't actually remove torrent until existing "move storage jobs" are done
             torrentQueuePositionBottom(nativeHandle);
@@ -2236,18 +2422,10 @@ bool SessionImpl::deleteTorrent(const TorrentID &id, const DeleteOption deleteOp
     {
         m_removingTorrents[torrent->id()] = {torrent->name(), torrent->rootPath(), deleteOption};
 
-        if (m_moveStorageQueue.size() > 1)
-        {
-            // Delete "move storage job" for the deleted torrent
-            // (note: we shouldn't delete active job)
-            const auto iter = std::find_if(m_moveStorageQueue.begin() + 1, m_moveStorageQueue.end()
-                                     , [torrent](const MoveStorageJob &job)
-            {
-                return job.torrentHandle == torrent->nativeHandle();
-            });
-            if (iter != m_moveStorageQueue.end())
-                m_moveStorageQueue.erase(iter);
-        }
+        // Delete "move storage job" for the deleted torrent
+        // (note: we shouldn't delete active job)
+        m_queuedMoveStorageJobs.erase(torrent->nativeHandle());
+        m_moveStorageQueue.remove(torrent->nativeHandle());
 
         m_nativeSession->remove_torrent(torrent->nativeHandle(), lt::session::delete_files);
     }
@@ -2418,8 +2596,10 @@ void SessionImpl::handleTorrentSaveResumeDataRequested(const TorrentImpl *torren
 
 void SessionImpl::handleTorrentSaveResumeDataFailed(const TorrentImpl *torrent)
 {
-    Q_UNUSED(torrent);
     --m_numResumeData;
+
+    if (m_initialResumeDataRequests.remove(torrent->id()) && m_initialResumeDataRequests.isEmpty())
+        storeInitialResumeData();
 }
 
 QVector<Torrent *> SessionImpl::torrents() const
@@ -2437,6 +2617,19 @@ qsizetype SessionImpl::torrentsCount() const
     return m_torrents.size();
 }
 
+qsizetype SessionImpl::torrentsCount(const TorrentFilter::Type stateFilter) const
+{
+    if (stateFilter == TorrentFilter::All)
+        return m_torrents.size();
+
+    return m_torrentsCountByStateFilter[stateFilter];
+}
+
+qsizetype SessionImpl::torrentsCount(const TorrentRefreshTier refreshTier) const
+{
+    return m_torrentsCountByRefreshTier[static_cast<int>(refreshTier)];
+}
+
 bool SessionImpl::addTorrent(const QString &source, const AddTorrentParams &params)
 {
     // `source`: .torrent file path/url or magnet uri
@@ -2479,7 +2672,7 @@ bool SessionImpl::addTorrent(const MagnetUri &magnetUri, const AddTorrentParams
     if (!magnetUri.isValid())
         return false;
 
-    return addTorrent_impl(magnetUri, params);
+    return (addTorrent_impl(magnetUri, params).status == AddTorrentStatus::Added);
 }
 
 bool SessionImpl::addTorrent(const TorrentInfo &torrentInfo, const AddTorrentParams &params)
@@ -2487,7 +2680,68 @@ bool SessionImpl::addTorrent(const TorrentInfo &torrentInfo, const AddTorrentPar
     if (!isRestored())
         return false;
 
-    return addTorrent_impl(torrentInfo, params);
+    return (addTorrent_impl(torrentInfo, params).status == AddTorrentStatus::Added);
+}
+
+QVector<AddTorrentResult> SessionImpl::addTorrents(const QVector<AddTorrentRequest> &requests)
+{
+    QVector<AddTorrentResult> results;
+    results.reserve(requests.size());
+
+    if (!isRestored())
+    {
+        for (int i = 0; i < requests.size(); ++i)
+            results.append({{}, AddTorrentStatus::Failed, tr("Session is not ready yet")});
+        return results;
+    }
+
+    QSet<TorrentID> batchTorrentIDs;
+    batchTorrentIDs.reserve(requests.size());
+    int addedTorrentsCount = 0;
+
+    m_isAddingTorrentsBatch = true;
+    for (const AddTorrentRequest &request : requests)
+    {
+        const bool hasMetadata = std::holds_alternative<TorrentInfo>(request.source);
+        if (hasMetadata ? !std::get<TorrentInfo>(request.source).isValid() : !std::get<MagnetUri>(request.source).isValid())
+        {
+            results.append({{}, AddTorrentStatus::InvalidSource, tr("Invalid torrent source")});
+            continue;
+        }
+
+        const InfoHash infoHash = (hasMetadata ? std::get<TorrentInfo>(request.source).infoHash() : std::get<MagnetUri>(request.source).infoHash());
+        const auto id = TorrentID::fromInfoHash(infoHash);
+        if (batchTorrentIDs.contains(id))
+        {
+            results.append({id, AddTorrentStatus::Duplicate, tr("Torrent is specified more than once")});
+            continue;
+        }
+
+        batchTorrentIDs.insert(id);
+        const AddTorrentResult result = addTorrent_impl(request.source, request.params);
+        if (result.status == AddTorrentStatus::Added)
+        {
+            m_batchAddedTorrentIDs.insert(id);
+            ++addedTorrentsCount;
+        }
+
+        results.append(result);
+    }
+    m_isAddingTorrentsBatch = false;
+
+    if (!m_batchFileSearches.isEmpty())
+    {
+        QMetaObject::invokeMethod(m_fileSearcher, [searchJobs = std::exchange(m_batchFileSearches, {})]()
+        {
+            for (const std::function<void ()> &searchJob : searchJobs)
+                searchJob();
+        });
+    }
+
+    LogMsg(tr("Adding torrents in batch. Requested: %1. Accepted: %2")
+        .arg(QString::number(requests.size()), QString::number(addedTorrentsCount)));
+
+    return results;
 }
 
 LoadTorrentParams SessionImpl::initLoadTorrentParams(const AddTorrentParams &addTorrentParams)
@@ -2548,7 +2802,7 @@ LoadTorrentParams SessionImpl::initLoadTorrentParams(const AddTorrentParams &add
 }
 
 // Add a torrent to the BitTorrent session
-bool SessionImpl::addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &source, const AddTorrentParams &addTorrentParams)
+AddTorrentResult SessionImpl::addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &source, const AddTorrentParams &addTorrentParams)
 {
     Q_ASSERT(isRestored());
 
@@ -2562,17 +2816,17 @@ bool SessionImpl::addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &so
     // We should not add the torrent if it is already
     // processed or is pending to add to session
     if (m_loadingTorrents.contains(id) || (infoHash.isHybrid() && m_loadingTorrents.contains(altID)))
-        return false;
+        return {id, AddTorrentStatus::Duplicate, tr("Torrent is already being added")};
 
     if (Torrent *torrent = findTorrent(infoHash); torrent)
     {
-        if (hasMetadata)
+        // Trying to set metadata to existing torrent in case if it has none
+        if (hasMetadata && torrent->setMetadata(std::get<TorrentInfo>(source)))
         {
-            // Trying to set metadata to existing torrent in case if it has none
-            torrent->setMetadata(std::get<TorrentInfo>(source));
+            return {torrent->id(), AddTorrentStatus::Duplicate, tr("Torrent is already present. Its metadata has been updated")};
         }
 
-        return false;
+        return {torrent->id(), AddTorrentStatus::Duplicate, tr("Torrent is already present")};
     }
 
     // It looks illogical that we don't just use an existing handle,
@@ -2743,17 +2997,17 @@ bool SessionImpl::addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &so
     if (!isFindingIncompleteFiles)
         m_nativeSession->async_add_torrent(p);
 
-    return true;
+    return {id, AddTorrentStatus::Added, {}};
 }
 
 void SessionImpl::findIncompleteFiles(const TorrentInfo &torrentInfo, const Path &savePath
-                                  , const Path &downloadPath, const PathList &filePaths) const
+                                  , const Path &downloadPath, const PathList &filePaths)
 {
     Q_ASSERT(filePaths.isEmpty() || (filePaths.size() == torrentInfo.filesCount()));
 
     const auto searchId = TorrentID::fromInfoHash(torrentInfo.infoHash());
     const PathList originalFileNames = (filePaths.isEmpty() ? torrentInfo.filePaths() : filePaths);
-    QMetaObject::invokeMethod(m_fileSearcher, [=]()
+    scheduleFileSearch([=]()
     {
         m_fileSearcher->search(searchId, originalFileNames, savePath, downloadPath, isAppendExtensionEnabled(), false,  nullptr);
     });
@@ -2781,12 +3035,24 @@ void SessionImpl::findIncompleteFilesAndCategory(const TorrentInfo &torrentInfo,
 
     const auto searchId = TorrentID::fromInfoHash(torrentInfo.infoHash());
     const PathList originalFileNames = (filePaths.isEmpty() ? torrentInfo.filePaths() : filePaths);
-    QMetaObject::invokeMethod(m_fileSearcher, [=]()
+    scheduleFileSearch([=]()
     {
         m_fileSearcher->search(searchId, originalFileNames, savePath, downloadPath, isAppendExtensionEnabled(), torrentParams.hasSeedStatus, &m_categoryPaths);
     });
 }
 
+void SessionImpl::scheduleFileSearch(std::function<void ()> searchJob)
+{
+    if (m_isAddingTorrentsBatch)
+    {
+        // searches of the whole batch are dispatched to file searcher at once
+        m_batchFileSearches.append(std::move(searchJob));
+        return;
+    }
+
+    QMetaObject::invokeMethod(m_fileSearcher, std::move(searchJob));
+}
+
 // Add a torrent to libtorrent session in hidden mode
 // and force it to download its metadata
 bool SessionImpl::downloadMetadata(const MagnetUri &magnetUri)
@@ -2906,9 +3172,15 @@ void SessionImpl::saveResumeData()
     if (isQueueingSystemEnabled())
         saveTorrentsQueue();
 
-    for (const TorrentImpl *torrent : asConst(m_torrents))
-        torrent->nativeHandle().save_resume_data(lt::torrent_handle::only_if_modified);
+    for (TorrentImpl *torrent : asConst(m_torrents))
+    {
+        // Torrents added in batch can still have no resume data stored
+        const lt::resume_data_flags_t flags = m_torrentsAwaitingInitialSave.contains(torrent)
+                ? lt::torrent_handle::save_info_dict : lt::torrent_handle::only_if_modified;
+        torrent->nativeHandle().save_resume_data(flags);
+    }
     m_numResumeData += m_torrents.size();
+    m_torrentsAwaitingInitialSave.clear();
 
     QElapsedTimer timer;
     timer.start();
@@ -2942,6 +3214,26 @@ void SessionImpl::saveResumeData()
             break;
         }
     }
+
+    if (!m_initialResumeDataBatch.isEmpty())
+        storeInitialResumeData();
+}
+
+void SessionImpl::requestInitialResumeData()
+{
+    for (TorrentImpl *torrent : asConst(m_torrentsAwaitingInitialSave))
+    {
+        m_initialResumeDataRequests.insert(torrent->id());
+        torrent->saveResumeData(lt::torrent_handle::save_info_dict);
+    }
+
+    m_torrentsAwaitingInitialSave.clear();
+}
+
+void SessionImpl::storeInitialResumeData()
+{
+    m_resumeDataStorage->storeBatch(m_initialResumeDataBatch);
+    m_initialResumeDataBatch.clear();
 }
 
 void SessionImpl::saveTorrentsQueue() const
@@ -3607,10 +3899,8 @@ bool SessionImpl::isFilenameExcluded(const QString &fileName) const
 
 void SessionImpl::setBannedIPs(const QStringList &newList)
 {
-    if (newList == m_bannedIPs)
-        return; // do nothing
     // here filter out incorrect IP
-    QStringList filteredList;
+    QSet<QString> filteredIPs;
     for (const QString &ip : newList)
     {
         if (Utils::Net::isValidIP(ip))
@@ -3618,7 +3908,7 @@ void SessionImpl::setBannedIPs(const QStringList &newList)
             // the same IPv6 addresses could be written in different forms;
             // QHostAddress::toString() result format follows RFC5952;
             // thus we avoid duplicate entries pointing to the same address
-            filteredList << QHostAddress(ip).toString();
+            filteredIPs.insert(QHostAddress(ip).toString());
         }
         else
         {
@@ -3627,16 +3917,14 @@ void SessionImpl::setBannedIPs(const QStringList &newList)
                 , Log::WARNING);
         }
     }
-    // now we have to sort IPs and make them unique
-    filteredList.sort();
-    filteredList.removeDuplicates();
-    // Again ensure that the new list is different from the stored one.
-    if (filteredList == m_bannedIPs)
+    // Ensure that the new list is different from the stored one.
+    if (filteredIPs == m_bannedIPs)
         return; // do nothing
     // store to session settings
     // also here we have to recreate filter list including 3rd party ban file
     // and install it again into m_session
-    m_bannedIPs = filteredList;
+    m_bannedIPs = filteredIPs;
+    storeBannedIPs();
     m_IPFilteringConfigured = false;
     configureDeferred();
 }
@@ -3653,7 +3941,9 @@ void SessionImpl::setResumeDataStorageType(const ResumeDataStorageType type)
 
 QStringList SessionImpl::bannedIPs() const
 {
-    return m_bannedIPs;
+    QStringList bannedIPs = m_bannedIPs.values();
+    bannedIPs.sort();
+    return bannedIPs;
 }
 
 bool SessionImpl::isRestored() const
@@ -4532,8 +4822,9 @@ void SessionImpl::handleTorrentShareLimitChanged(TorrentImpl *const)
     updateSeedingLimitTimer();
 }
 
-void SessionImpl::handleTorrentNameChanged(TorrentImpl *const)
+void SessionImpl::handleTorrentNameChanged(TorrentImpl *const torrent)
 {
+    emit torrentNameChanged(torrent);
 }
 
 void SessionImpl::handleTorrentSavePathChanged(TorrentImpl *const torrent)
@@ -4561,6 +4852,37 @@ void SessionImpl::handleTorrentSavingModeChanged(TorrentImpl *const torrent)
     emit torrentSavingModeChanged(torrent);
 }
 
+void SessionImpl::handleTorrentStateChanged(TorrentImpl *const torrent, const TorrentState prevState
+        , const TorrentFilter::TypeFlags prevStateFilterTypes)
+{
+    // Torrent is being constructed. Its initial state is counted once it is registered.
+    if (!m_torrents.contains(torrent->id()))
+        return;
+
+    const TorrentFilter::TypeFlags stateFilterTypes = torrent->stateFilterTypes();
+    adjustTorrentsCountByStateFilter((prevStateFilterTypes & ~stateFilterTypes), -1);
+    adjustTorrentsCountByStateFilter((stateFilterTypes & ~prevStateFilterTypes), 1);
+
+    emit torrentStateChanged(torrent, prevState);
+}
+
+void SessionImpl::adjustTorrentsCountByStateFilter(const TorrentFilter::TypeFlags types, const qsizetype delta)
+{
+    if (types.none())
+        return;
+
+    for (int i = 0; i < TorrentFilter::TypeCount; ++i)
+    {
+        if (types[i])
+            m_torrentsCountByStateFilter[i] += delta;
+    }
+}
+
+void SessionImpl::adjustTorrentsCountByRefreshTier(const TorrentRefreshTier refreshTier, const qsizetype delta)
+{
+    m_torrentsCountByRefreshTier[static_cast<int>(refreshTier)] += delta;
+}
+
 void SessionImpl::handleTorrentTrackersAdded(TorrentImpl *const torrent, const QVector<TrackerEntry> &newTrackers)
 {
     for (const TrackerEntry &newTracker : newTrackers)
@@ -4653,7 +4975,17 @@ void SessionImpl::handleTorrentResumeDataReady(TorrentImpl *const torrent, const
 {
     --m_numResumeData;
 
-    m_resumeDataStorage->store(torrent->id(), data);
+    if (m_initialResumeDataRequests.remove(torrent->id()))
+    {
+        m_initialResumeDataBatch.insert(torrent->id(), data);
+        if (m_initialResumeDataRequests.isEmpty())
+            storeInitialResumeData();
+    }
+    else
+    {
+        m_resumeDataStorage->store(torrent->id(), data);
+    }
+
     const auto iter = m_changedTorrentIDs.find(torrent->id());
     if (iter != m_changedTorrentIDs.end())
     {
@@ -4683,36 +5015,23 @@ bool SessionImpl::addMoveTorrentStorageJob(TorrentImpl *torrent, const Path &new
 
     const lt::torrent_handle torrentHandle = torrent->nativeHandle();
     const Path currentLocation = torrent->actualStorageLocation();
+    const auto activeJobIter = m_activeMoveStorageJobs.find(torrentHandle);
+    const bool hasActiveJob = (activeJobIter != m_activeMoveStorageJobs.end());
 
-    if (m_moveStorageQueue.size() > 1)
+    if (const auto queuedJobIter = m_queuedMoveStorageJobs.find(torrentHandle); queuedJobIter != m_queuedMoveStorageJobs.end())
     {
-        auto iter = std::find_if(m_moveStorageQueue.begin() + 1, m_moveStorageQueue.end()
-                                 , [&torrentHandle](const MoveStorageJob &job)
-        {
-            return job.torrentHandle == torrentHandle;
-        });
-
-        if (iter != m_moveStorageQueue.end())
-        {
-            // remove existing inactive job
-            LogMsg(tr("Torrent move canceled. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), iter->path.toString()));
-            iter = m_moveStorageQueue.erase(iter);
-
-            iter = std::find_if(iter, m_moveStorageQueue.end(), [&torrentHandle](const MoveStorageJob &job)
-            {
-                return job.torrentHandle == torrentHandle;
-            });
-
-            const bool torrentHasOutstandingJob = (iter != m_moveStorageQueue.end());
-            torrent->handleMoveStorageJobFinished(currentLocation, torrentHasOutstandingJob);
-        }
+        // remove existing inactive job
+        LogMsg(tr("Torrent move canceled. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), queuedJobIter->second.path.toString()));
+        m_queuedMoveStorageJobs.erase(queuedJobIter);
+        m_moveStorageQueue.remove(torrentHandle);
+        torrent->handleMoveStorageJobFinished(currentLocation, hasActiveJob);
     }
 
-    if (!m_moveStorageQueue.isEmpty() && (m_moveStorageQueue.first().torrentHandle == torrentHandle))
+    if (hasActiveJob)
     {
         // if there is active job for this torrent prevent creating meaningless
         // job that will move torrent to the same location as current one
-        if (m_moveStorageQueue.first().path == newPath)
+        if (activeJobIter->second.path == newPath)
         {
             LogMsg(tr("Failed to enqueue torrent move. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\". Reason: torrent is currently moving to the destination")
                    .arg(torrent->name(), currentLocation.toString(), newPath.toString()));
@@ -4729,45 +5048,109 @@ bool SessionImpl::addMoveTorrentStorageJob(TorrentImpl *torrent, const Path &new
         }
     }
 
-    const MoveStorageJob moveStorageJob {torrentHandle, newPath, mode};
-    m_moveStorageQueue << moveStorageJob;
+    MoveStorageJob moveStorageJob {torrentHandle, newPath, mode};
+    // queued job is started after the active one, so it moves the data from the active job destination
+    moveStorageJob.sourceDevice = storageDeviceID(hasActiveJob ? activeJobIter->second.path : currentLocation);
+    moveStorageJob.targetDevice = storageDeviceID(newPath);
+    moveStorageJob.id = m_moveStorageQueue.enqueue(torrentHandle, moveStorageJob.sourceDevice, moveStorageJob.targetDevice);
+    m_queuedMoveStorageJobs.insert_or_assign(torrentHandle, std::move(moveStorageJob));
     LogMsg(tr("Enqueued torrent move. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\"").arg(torrent->name(), currentLocation.toString(), newPath.toString()));
 
-    if (m_moveStorageQueue.size() == 1)
-        moveTorrentStorage(moveStorageJob);
+    startMoveStorageJobs();
 
     return true;
 }
 
-void SessionImpl::moveTorrentStorage(const MoveStorageJob &job) const
+bool SessionImpl::hasMoveStorageJob(const lt::torrent_handle &torrentHandle) const
 {
-#ifdef QBT_USES_LIBTORRENT2
-    const auto id = TorrentID::fromInfoHash(job.torrentHandle.info_hashes());
-#else
-    const auto id = TorrentID::fromInfoHash(job.torrentHandle.info_hash());
-#endif
+    return (m_activeMoveStorageJobs.find(torrentHandle) != m_activeMoveStorageJobs.cend())
+        || (m_queuedMoveStorageJobs.find(torrentHandle) != m_queuedMoveStorageJobs.cend());
+}
+
+QString SessionImpl::storageDeviceID(const Path &path)
+{
+    // many torrents are usually moved between the same few folders
+    const auto iter = m_storageDeviceIDs.constFind(path);
+    if (iter != m_storageDeviceIDs.cend())
+        return iter.value();
+
+    const QString deviceID = Utils::Fs::storageDeviceID(path);
+    m_storageDeviceIDs.insert(path, deviceID);
+    return deviceID;
+}
+
+void SessionImpl::startMoveStorageJobs()
+{
+    for (const lt::torrent_handle &torrentHandle : m_moveStorageQueue.start())
+    {
+        const auto jobIter = m_queuedMoveStorageJobs.find(torrentHandle);
+        Q_ASSERT(jobIter != m_queuedMoveStorageJobs.end());
+
+        MoveStorageJob &job = m_activeMoveStorageJobs.insert_or_assign(torrentHandle, std::move(jobIter->second)).first->second;
+        m_queuedMoveStorageJobs.erase(jobIter);
+
+        moveTorrentStorage(job);
+    }
+
+    if (m_activeMoveStorageJobs.empty())
+    {
+        m_moveStorageProgressTimer->stop();
+        if (m_queuedMoveStorageJobs.empty())
+            m_storageDeviceIDs.clear();
+    }
+    else if (!m_moveStorageProgressTimer->isActive())
+    {
+        m_moveStorageProgressTimer->start();
+    }
+}
+
+void SessionImpl::moveTorrentStorage(MoveStorageJob &job)
+{
+    const TorrentID id = toTorrentID(job.torrentHandle);
     const TorrentImpl *torrent = m_torrents.value(id);
     const QString torrentName = (torrent ? torrent->name() : id.toString());
     LogMsg(tr("Start moving torrent. Torrent: \"%1\". Destination: \"%2\"").arg(torrentName, job.path.toString()));
 
+    if (job.sourceDevice != job.targetDevice)
+    {
+        if (torrent && torrent->hasMetadata())
+        {
+            // only downloaded parts of files are expected to be moved
+            const QVector<qreal> filesProgress = torrent->filesProgress();
+            const int filesCount = filesProgress.size();
+            job.fileSizes.reserve(filesCount);
+            job.movedFileSizes.fill(0, filesCount);
+            for (int i = 0; i < filesCount; ++i)
+            {
+                const auto fileSize = static_cast<qint64>(torrent->fileSize(i) * filesProgress[i]);
+                job.fileSizes.append(fileSize);
+                job.totalBytes += fileSize;
+                if (fileSize > 0)
+                    job.pendingFiles.append(i);
+            }
+        }
+    }
+
+    job.elapsedTimer.start();
     job.torrentHandle.move_storage(job.path.toString().toStdString(), toNative(job.mode));
 }
 
-void SessionImpl::handleMoveTorrentStorageJobFinished(const Path &newPath)
+void SessionImpl::handleMoveTorrentStorageJobFinished(const lt::torrent_handle &torrentHandle, const Path &newPath)
 {
-    const MoveStorageJob finishedJob = m_moveStorageQueue.takeFirst();
-    if (!m_moveStorageQueue.isEmpty())
-        moveTorrentStorage(m_moveStorageQueue.first());
+    const auto jobIter = m_activeMoveStorageJobs.find(torrentHandle);
+    Q_ASSERT(jobIter != m_activeMoveStorageJobs.end());
+    if (jobIter == m_activeMoveStorageJobs.end())
+        return;
 
-    const auto iter = std::find_if(m_moveStorageQueue.cbegin(), m_moveStorageQueue.cend()
-                                   , [&finishedJob](const MoveStorageJob &job)
-    {
-        return job.torrentHandle == finishedJob.torrentHandle;
-    });
+    const MoveStorageJob finishedJob = std::move(jobIter->second);
+    m_activeMoveStorageJobs.erase(jobIter);
+    m_moveStorageQueue.finish(torrentHandle);
+
+    startMoveStorageJobs();
 
-    const bool torrentHasOutstandingJob = (iter != m_moveStorageQueue.cend());
+    const bool torrentHasOutstandingJob = hasMoveStorageJob(torrentHandle);
 
-    TorrentImpl *torrent = m_torrents.value(finishedJob.torrentHandle.info_hash());
+    TorrentImpl *torrent = m_torrents.value(toTorrentID(torrentHandle));
     if (torrent)
     {
         torrent->handleMoveStorageJobFinished(newPath, torrentHasOutstandingJob);
@@ -4782,6 +5165,134 @@ void SessionImpl::handleMoveTorrentStorageJobFinished(const Path &newPath)
     }
 }
 
+void SessionImpl::updateMoveStorageProgress()
+{
+    for (auto &[torrentHandle, job] : m_activeMoveStorageJobs)
+    {
+        // nothing to check or the previous check isn't finished yet
+        if (job.pendingFiles.isEmpty() || !job.checkingFiles.isEmpty())
+            continue;
+
+        const TorrentImpl *torrent = m_torrents.value(toTorrentID(torrentHandle));
+        if (!torrent)
+            continue;
+
+        // Files can be moved in any order (e.g. whole folders are copied at once),
+        // so a limited number of not yet moved files is checked on each update.
+        const int checkCount = std::min<int>(job.pendingFiles.size(), MOVE_STORAGE_PROGRESS_FILES_PER_UPDATE);
+        PathList filePaths;
+        filePaths.reserve(checkCount);
+        job.checkingFiles.reserve(checkCount);
+        for (int i = 0; i < checkCount; ++i)
+        {
+            if (job.pendingFilesCursor >= job.pendingFiles.size())
+                job.pendingFilesCursor = 0;
+
+            const int fileIndex = job.pendingFiles[job.pendingFilesCursor++];
+            job.checkingFiles.append(fileIndex);
+            filePaths.append(job.path / torrent->actualFilePath(fileIndex));
+        }
+
+        QMetaObject::invokeMethod(m_moveStorageProgressChecker
+                , [checker = m_moveStorageProgressChecker, jobID = job.id, filePaths]
+        {
+            checker->check(jobID, filePaths);
+        });
+    }
+}
+
+void SessionImpl::handleMoveStorageProgressChecked(const quint64 jobID, const QVector<qint64> &fileSizes)
+{
+    const auto jobIter = std::find_if(m_activeMoveStorageJobs.begin(), m_activeMoveStorageJobs.end()
+            , [jobID](const auto &item) { return (item.second.id == jobID); });
+    // job could be finished while its files were being checked
+    if (jobIter == m_activeMoveStorageJobs.end())
+        return;
+
+    MoveStorageJob &job = jobIter->second;
+    Q_ASSERT(job.checkingFiles.size() == fileSizes.size());
+
+    for (int i = 0; i < job.checkingFiles.size(); ++i)
+    {
+        const int fileIndex = job.checkingFiles[i];
+        const qint64 expectedSize = job.fileSizes[fileIndex];
+        const qint64 movedSize = std::clamp<qint64>(fileSizes.value(i), 0, expectedSize);
+
+        job.movedBytes += (movedSize - job.movedFileSizes[fileIndex]);
+        job.movedFileSizes[fileIndex] = movedSize;
+
+        if (movedSize >= expectedSize)
+        {
+            const int pendingIndex = job.pendingFiles.indexOf(fileIndex);
+            job.pendingFiles[pendingIndex] = job.pendingFiles.last();
+            job.pendingFiles.removeLast();
+        }
+    }
+    job.checkingFiles.clear();
+
+    if (TorrentImpl *torrent = m_torrents.value(toTorrentID(jobIter->first)))
+        emit torrentStorageMoveProgressUpdated(torrent);
+}
+
+MoveStorageJobStatus SessionImpl::toMoveStorageJobStatus(const MoveStorageJob &job, const bool isActive) const
+{
+    MoveStorageJobStatus status;
+    status.torrentID = toTorrentID(job.torrentHandle);
+    status.targetPath = job.path;
+    status.isActive = isActive;
+    status.totalBytes = job.totalBytes;
+    status.movedBytes = job.movedBytes;
+    if (isActive)
+    {
+        const qint64 elapsed = job.elapsedTimer.elapsed();
+        if (elapsed > 0)
+            status.speed = (job.movedBytes * 1000) / elapsed;
+    }
+
+    return status;
+}
+
+QVector<MoveStorageJobStatus> SessionImpl::moveStorageJobs() const
+{
+    QVector<MoveStorageJobStatus> jobs;
+    jobs.reserve(static_cast<decltype(jobs)::size_type>(m_activeMoveStorageJobs.size() + m_queuedMoveStorageJobs.size()));
+
+    for (const auto &[torrentHandle, job] : m_activeMoveStorageJobs)
+        jobs.append(toMoveStorageJobStatus(job, true));
+
+    // queued jobs are listed in order they will be started
+    for (const lt::torrent_handle &torrentHandle : m_moveStorageQueue.queuedKeys())
+    {
+        const auto jobIter = m_queuedMoveStorageJobs.find(torrentHandle);
+        if (jobIter != m_queuedMoveStorageJobs.cend())
+            jobs.append(toMoveStorageJobStatus(jobIter->second, false));
+    }
+
+    return jobs;
+}
+
+bool SessionImpl::moveStorageJobStatus(const TorrentID &id, MoveStorageJobStatus &status) const
+{
+    const TorrentImpl *torrent = m_torrents.value(id);
+    if (!torrent)
+        return false;
+
+    const lt::torrent_handle torrentHandle = torrent->nativeHandle();
+    if (const auto jobIter = m_activeMoveStorageJobs.find(torrentHandle); jobIter != m_activeMoveStorageJobs.cend())
+    {
+        status = toMoveStorageJobStatus(jobIter->second, true);
+        return true;
+    }
+
+    if (const auto jobIter = m_queuedMoveStorageJobs.find(torrentHandle); jobIter != m_queuedMoveStorageJobs.cend())
+    {
+        status = toMoveStorageJobStatus(jobIter->second, false);
+        return true;
+    }
+
+    return false;
+}
+
 void SessionImpl::storeCategories() const
 {
     QJsonObject jsonObj;
@@ -4900,7 +5411,7 @@ void SessionImpl::enableIPFilter()
     //    set between clearing the old one and setting the new one.
     if (!m_filterParser)
     {
-        m_filterParser = new FilterParserThread(this);
+        m_filterParser = new FilterParserThread((specialFolderLocation(SpecialFolder::Cache) / Path(u"ipfilter.cache"_qs)), this);
         connect(m_filterParser.data(), &FilterParserThread::IPFilterParsed, this, &SessionImpl::handleIPFilterParsed);
         connect(m_filterParser.data(), &FilterParserThread::IPFilterError, this, &SessionImpl::handleIPFilterError);
     }
@@ -4973,7 +5484,7 @@ void SessionImpl::enqueueRefresh()
 
     QTimer::singleShot(refreshInterval(), Qt::CoarseTimer, this, [this]
     {
-        m_nativeSession->post_torrent_updates();
+        m_nativeSession->post_torrent_updates(TORRENT_STATUS_UPDATE_FLAGS);
         m_nativeSession->post_session_stats();
     });
 
@@ -5061,6 +5572,7 @@ void SessionImpl::handleAddTorrentAlerts(const std::vector<lt::alert *> &alerts)
             const InfoHash infoHash {(hasMetadata ? params.ti->info_hash() : params.info_hash)};
 #endif
             m_loadingTorrents.remove(TorrentID::fromInfoHash(infoHash));
+            m_batchAddedTorrentIDs.remove(TorrentID::fromInfoHash(infoHash));
 
             return;
         }
@@ -5215,12 +5727,24 @@ TorrentImpl *SessionImpl::createTorrent(const lt::torrent_handle &nativeHandle,
 {
     auto *const torrent = new TorrentImpl(this, m_nativeSession, nativeHandle, params);
     m_torrents.insert(torrent->id(), torrent);
+    adjustTorrentsCountByStateFilter(torrent->stateFilterTypes(), 1);
+    adjustTorrentsCountByRefreshTier(torrent->refreshTier(), 1);
     if (const InfoHash infoHash = torrent->infoHash(); infoHash.isHybrid())
         m_hybridTorrentsByAltID.insert(TorrentID::fromSHA1Hash(infoHash.v1()), torrent);
 
     if (isRestored())
     {
-        torrent->saveResumeData(lt::torrent_handle::save_info_dict);
+        if (m_batchAddedTorrentIDs.remove(torrent->id()))
+        {
+            // Initial resume data of torrents added in batch is stored all at once
+            m_torrentsAwaitingInitialSave.insert(torrent);
+            if (!m_initialResumeDataTimer->isActive())
+                m_initialResumeDataTimer->start();
+        }
+        else
+        {
+            torrent->saveResumeData(lt::torrent_handle::save_info_dict);
+        }
 
         // The following is useless for newly added magnet
         if (torrent->hasMetadata())
@@ -5390,39 +5914,35 @@ void SessionImpl::handlePortmapAlert(const lt::portmap_alert *p)
 
 void SessionImpl::handlePeerBlockedAlert(const lt::peer_blocked_alert *p)
 {
-    QString reason;
+    Log::PeerEvent event = Log::PeerEvent::BlockedByIPFilter;
     switch (p->reason)
     {
     case lt::peer_blocked_alert::ip_filter:
-        reason = tr("IP filter", "this peer was blocked. Reason: IP filter.");
+        event = Log::PeerEvent::BlockedByIPFilter;
         break;
     case lt::peer_blocked_alert::port_filter:
-        reason = tr("port filter", "this peer was blocked. Reason: port filter.");
+        event = Log::PeerEvent::BlockedByPortFilter;
         break;
     case lt::peer_blocked_alert::i2p_mixed:
-        reason = tr("%1 mixed mode restrictions", "this peer was blocked. Reason: I2P mixed mode restrictions.").arg(u"I2P"_qs); // don't translate I2P
+        event = Log::PeerEvent::BlockedByI2PMixedMode;
         break;
     case lt::peer_blocked_alert::privileged_ports:
-        reason = tr("use of privileged port", "this peer was blocked. Reason: use of privileged port.");
+        event = Log::PeerEvent::BlockedByPrivilegedPort;
         break;
     case lt::peer_blocked_alert::utp_disabled:
-        reason = tr("%1 is disabled", "this peer was blocked. Reason: uTP is disabled.").arg(C_UTP); // don't translate μTP
+        event = Log::PeerEvent::BlockedByUTPDisabled;
         break;
     case lt::peer_blocked_alert::tcp_disabled:
-        reason = tr("%1 is disabled", "this peer was blocked. Reason: TCP is disabled.").arg(u"TCP"_qs); // don't translate TCP
+        event = Log::PeerEvent::BlockedByTCPDisabled;
         break;
     }
 
-    const QString ip {toString(p->endpoint.address())};
-    if (!ip.isEmpty())
-        Logger::instance()->addPeer(ip, true, reason);
+    Logger::instance()->addPeer(toLogPeerAddress(p->endpoint.address()), event);
 }
 
 void SessionImpl::handlePeerBanAlert(const lt::peer_ban_alert *p)
 {
-    const QString ip {toString(p->endpoint.address())};
-    if (!ip.isEmpty())
-        Logger::instance()->addPeer(ip, false);
+    Logger::instance()->addPeer(toLogPeerAddress(p->endpoint.address()), Log::PeerEvent::Banned);
 }
 
 void SessionImpl::handleUrlSeedAlert(const lt::url_seed_alert *p)
@@ -5578,40 +6098,32 @@ void SessionImpl::handleAlertsDroppedAlert(const lt::alerts_dropped_alert *p) co
 
 void SessionImpl::handleStorageMovedAlert(const lt::storage_moved_alert *p)
 {
-    Q_ASSERT(!m_moveStorageQueue.isEmpty());
-
-    const MoveStorageJob &currentJob = m_moveStorageQueue.first();
-    Q_ASSERT(currentJob.torrentHandle == p->handle);
+    const auto jobIter = m_activeMoveStorageJobs.find(p->handle);
+    Q_ASSERT(jobIter != m_activeMoveStorageJobs.end());
+    if (jobIter == m_activeMoveStorageJobs.end())
+        return;
 
+    const MoveStorageJob &currentJob = jobIter->second;
     const Path newPath {QString::fromUtf8(p->storage_path())};
     Q_ASSERT(newPath == currentJob.path);
 
-#ifdef QBT_USES_LIBTORRENT2
-    const auto id = TorrentID::fromInfoHash(currentJob.torrentHandle.info_hashes());
-#else
-    const auto id = TorrentID::fromInfoHash(currentJob.torrentHandle.info_hash());
-#endif
-
+    const TorrentID id = toTorrentID(currentJob.torrentHandle);
     TorrentImpl *torrent = m_torrents.value(id);
     const QString torrentName = (torrent ? torrent->name() : id.toString());
     LogMsg(tr("Moved torrent successfully. Torrent: \"%1\". Destination: \"%2\"").arg(torrentName, newPath.toString()));
 
-    handleMoveTorrentStorageJobFinished(newPath);
+    handleMoveTorrentStorageJobFinished(p->handle, newPath);
 }
 
 void SessionImpl::handleStorageMovedFailedAlert(const lt::storage_moved_failed_alert *p)
 {
-    Q_ASSERT(!m_moveStorageQueue.isEmpty());
-
-    const MoveStorageJob &currentJob = m_moveStorageQueue.first();
-    Q_ASSERT(currentJob.torrentHandle == p->handle);
-
-#ifdef QBT_USES_LIBTORRENT2
-    const auto id = TorrentID::fromInfoHash(currentJob.torrentHandle.info_hashes());
-#else
-    const auto id = TorrentID::fromInfoHash(currentJob.torrentHandle.info_hash());
-#endif
+    const auto jobIter = m_activeMoveStorageJobs.find(p->handle);
+    Q_ASSERT(jobIter != m_activeMoveStorageJobs.end());
+    if (jobIter == m_activeMoveStorageJobs.end())
+        return;
 
+    const MoveStorageJob &currentJob = jobIter->second;
+    const TorrentID id = toTorrentID(currentJob.torrentHandle);
     TorrentImpl *torrent = m_torrents.value(id);
     const QString torrentName = (torrent ? torrent->name() : id.toString());
     const Path currentLocation = (torrent ? torrent->actualStorageLocation()
@@ -5620,11 +6132,30 @@ void SessionImpl::handleStorageMovedFailedAlert(const lt::storage_moved_failed_a
     LogMsg(tr("Failed to move torrent. Torrent: \"%1\". Source: \"%2\". Destination: \"%3\". Reason: \"%4\"")
            .arg(torrentName, currentLocation.toString(), currentJob.path.toString(), errorMessage), Log::WARNING);
 
-    handleMoveTorrentStorageJobFinished(currentLocation);
+    handleMoveTorrentStorageJobFinished(p->handle, currentLocation);
 }
 
 void SessionImpl::handleStateUpdateAlert(const lt::state_update_alert *p)
 {
+    // The reply to the on demand request of TorrentImpl::pieces() comes in a separate alert.
+    // It isn't a part of periodic updates and contains nothing else of interest.
+    if (p->status.size() == 1)
+    {
+        const lt::torrent_status &status = p->status.front();
+#ifdef QBT_USES_LIBTORRENT2
+        const auto id = TorrentID::fromInfoHash(status.info_hashes);
+#else
+        const auto id = TorrentID::fromInfoHash(status.info_hash);
+#endif
+        TorrentImpl *const torrent = m_torrents.value(id);
+        // periodic updates never include piece bitfield
+        if (torrent && torrent->isPiecesRequested() && !status.pieces.empty())
+        {
+            torrent->handlePiecesUpdate(status.pieces);
+            return;
+        }
+    }
+
     QVector<Torrent *> updatedTorrents;
     updatedTorrents.reserve(static_cast<decltype(updatedTorrents)::size_type>(p->status.size()));
 
@@ -5639,8 +6170,35 @@ void SessionImpl::handleStateUpdateAlert(const lt::state_update_alert *p)
         if (!torrent)
             continue;
 
+        const TorrentRefreshTier prevRefreshTier = torrent->refreshTier();
         torrent->handleStateUpdate(status);
-        updatedTorrents.push_back(torrent);
+        const TorrentRefreshTier refreshTier = torrent->refreshTier();
+        if (refreshTier != prevRefreshTier)
+        {
+            adjustTorrentsCountByRefreshTier(prevRefreshTier, -1);
+            adjustTorrentsCountByRefreshTier(refreshTier, 1);
+        }
+
+        // Changes of idle torrents aren't interesting enough to notify about them
+        // on each refresh cycle, so they are delivered in batches less frequently.
+        // Torrent that has just become idle is notified immediately to show its final state.
+        if ((refreshTier == TorrentRefreshTier::Idle) && (prevRefreshTier == TorrentRefreshTier::Idle))
+        {
+            m_deferredUpdatedTorrents.insert(torrent);
+        }
+        else
+        {
+            m_deferredUpdatedTorrents.remove(torrent);
+            updatedTorrents.push_back(torrent);
+        }
+    }
+
+    m_refreshCycle = (m_refreshCycle + 1) % IDLE_TORRENTS_REFRESH_CYCLES;
+    if ((m_refreshCycle == 0) && !m_deferredUpdatedTorrents.isEmpty())
+    {
+        for (TorrentImpl *torrent : asConst(m_deferredUpdatedTorrents))
+            updatedTorrents.push_back(torrent);
+        m_deferredUpdatedTorrents.clear();
     }
 
     if (!updatedTorrents.isEmpty())
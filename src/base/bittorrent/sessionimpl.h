@@ -29,12 +29,17 @@
 
 #pragma once
 
+#include <array>
+#include <functional>
+#include <unordered_map>
+#include <utility>
 #include <variant>
 #include <vector>
 
 #include <libtorrent/fwd.hpp>
 #include <libtorrent/torrent_handle.hpp>
 
+#include <QDateTime>
 #include <QElapsedTimer>
 #include <QHash>
 #include <QPointer>
@@ -49,6 +54,8 @@
 #include "addtorrentparams.h"
 #include "cachestatus.h"
 #include "categoryoptions.h"
+#include "movestoragejobstatus.h"
+#include "movestoragequeue.h"
 #include "session.h"
 #include "sessionstatus.h"
 #include "torrentinfo.h"
@@ -76,6 +83,7 @@ namespace BitTorrent
 {
     class InfoHash;
     class MagnetUri;
+    class MoveStorageProgressChecker;
     class ResumeDataStorage;
     class Torrent;
     class TorrentImpl;
@@ -376,19 +384,26 @@ namespace BitTorrent
         Torrent *findTorrent(const InfoHash &infoHash) const override;
         QVector<Torrent *> torrents() const override;
         qsizetype torrentsCount() const override;
+        qsizetype torrentsCount(TorrentFilter::Type stateFilter) const override;
+        qsizetype torrentsCount(TorrentRefreshTier refreshTier) const override;
         const SessionStatus &status() const override;
         const CacheStatus &cacheStatus() const override;
+        QVector<MoveStorageJobStatus> moveStorageJobs() const override;
+        bool moveStorageJobStatus(const TorrentID &id, MoveStorageJobStatus &status) const override;
         bool isListening() const override;
 
         MaxRatioAction maxRatioAction() const override;
         void setMaxRatioAction(MaxRatioAction act) override;
 
         void banIP(const QString &ip) override;
+        void banIPs(const QStringList &ips, std::chrono::seconds duration = {}) override;
+        void unbanIPs(const QStringList &ips) override;
 
         bool isKnownTorrent(const InfoHash &infoHash) const override;
         bool addTorrent(const QString &source, const AddTorrentParams &params = {}) override;
         bool addTorrent(const MagnetUri &magnetUri, const AddTorrentParams &params = {}) override;
         bool addTorrent(const TorrentInfo &torrentInfo, const AddTorrentParams &params = {}) override;
+        QVector<AddTorrentResult> addTorrents(const QVector<AddTorrentRequest> &requests) override;
         bool deleteTorrent(const TorrentID &id, DeleteOption deleteOption = DeleteTorrent) override;
         bool downloadMetadata(const MagnetUri &magnetUri) override;
         bool cancelDownloadMetadata(const TorrentID &id) override;
@@ -410,6 +425,7 @@ namespace BitTorrent
         void handleTorrentTagAdded(TorrentImpl *const torrent, const QString &tag);
         void handleTorrentTagRemoved(TorrentImpl *const torrent, const QString &tag);
         void handleTorrentSavingModeChanged(TorrentImpl *const torrent);
+        void handleTorrentStateChanged(TorrentImpl *const torrent, TorrentState prevState, TorrentFilter::TypeFlags prevStateFilterTypes);
         void handleTorrentMetadataReceived(TorrentImpl *const torrent);
         void handleTorrentPaused(TorrentImpl *const torrent);
         void handleTorrentResumed(TorrentImpl *const torrent);
@@ -426,7 +442,7 @@ namespace BitTorrent
         bool addMoveTorrentStorageJob(TorrentImpl *torrent, const Path &newPath, MoveStorageMode mode);
 
         void findIncompleteFiles(const TorrentInfo &torrentInfo, const Path &savePath
-                                 , const Path &downloadPath, const PathList &filePaths = {}) const;
+                                 , const Path &downloadPath, const PathList &filePaths = {});
 
         void findIncompleteFilesAndCategory(const TorrentInfo &torrentInfo, const Path &savePath
                 , const Path &downloadPath, const LoadTorrentParams &torrentParams, const PathList &filePaths = {});
@@ -457,6 +473,19 @@ namespace BitTorrent
             lt::torrent_handle torrentHandle;
             Path path;
             MoveStorageMode mode;
+            QString sourceDevice;
+            QString targetDevice;
+            quint64 id = 0;
+
+            // Progress of active job (estimated by size of files which are already at target location)
+            QVector<qint64> fileSizes;
+            QVector<qint64> movedFileSizes;
+            QVector<int> pendingFiles;
+            int pendingFilesCursor = 0;
+            QVector<int> checkingFiles;  // files which sizes are being checked now
+            qint64 totalBytes = 0;
+            qint64 movedBytes = 0;
+            QElapsedTimer elapsedTimer;
         };
 
         struct RemovingTorrentData
@@ -482,6 +511,9 @@ namespace BitTorrent
         void initMetrics();
         void applyBandwidthLimits();
         void processBannedIPs(lt::ip_filter &filter);
+        void storeBannedIPs();
+        void scheduleBanExpiration();
+        void processExpiredBans();
         QStringList getListeningIPs() const;
         void configureListeningInterface();
         void enableTracker(bool enable);
@@ -497,9 +529,12 @@ namespace BitTorrent
         void endStartup(ResumeSessionContext *context);
 
         LoadTorrentParams initLoadTorrentParams(const AddTorrentParams &addTorrentParams);
-        bool addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &source, const AddTorrentParams &addTorrentParams);
+        AddTorrentResult addTorrent_impl(const std::variant<MagnetUri, TorrentInfo> &source, const AddTorrentParams &addTorrentParams);
+        void scheduleFileSearch(std::function<void ()> searchJob);
 
         void updateSeedingLimitTimer();
+        void adjustTorrentsCountByStateFilter(TorrentFilter::TypeFlags types, qsizetype delta);
+        void adjustTorrentsCountByRefreshTier(TorrentRefreshTier refreshTier, qsizetype delta);
         void exportTorrentFile(const Torrent *torrent, const Path &folderPath);
 
         void handleAlert(const lt::alert *a);
@@ -532,13 +567,21 @@ namespace BitTorrent
         TorrentImpl *createTorrent(const lt::torrent_handle &nativeHandle, const LoadTorrentParams &params);
 
         void saveResumeData();
+        void requestInitialResumeData();
+        void storeInitialResumeData();
         void saveTorrentsQueue() const;
         void removeTorrentsQueue() const;
 
         std::vector<lt::alert *> getPendingAlerts(lt::time_duration time = lt::time_duration::zero()) const;
 
-        void moveTorrentStorage(const MoveStorageJob &job) const;
-        void handleMoveTorrentStorageJobFinished(const Path &newPath);
+        bool hasMoveStorageJob(const lt::torrent_handle &torrentHandle) const;
+        QString storageDeviceID(const Path &path);
+        void startMoveStorageJobs();
+        void moveTorrentStorage(MoveStorageJob &job);
+        void handleMoveTorrentStorageJobFinished(const lt::torrent_handle &torrentHandle, const Path &newPath);
+        void updateMoveStorageProgress();
+        void handleMoveStorageProgressChecked(quint64 jobID, const QVector<qint64> &fileSizes);
+        MoveStorageJobStatus toMoveStorageJobStatus(const MoveStorageJob &job, bool isActive) const;
 
         void loadCategories();
         void storeCategories() const;
@@ -659,7 +702,7 @@ namespace BitTorrent
         CachedSettingValue<int> m_requestQueueSize;
         CachedSettingValue<bool> m_isExcludedFileNamesEnabled;
         CachedSettingValue<QStringList> m_excludedFileNames;
-        CachedSettingValue<QStringList> m_bannedIPs;
+        SettingValue<QStringList> m_storedBannedIPs;
         CachedSettingValue<ResumeDataStorageType> m_resumeDataStorageType;
 
         bool m_isRestored = false;
@@ -682,6 +725,7 @@ namespace BitTorrent
         bool m_refreshEnqueued = false;
         QTimer *m_seedingLimitTimer = nullptr;
         QTimer *m_resumeDataTimer = nullptr;
+        QTimer *m_initialResumeDataTimer = nullptr;
         // IP filtering
         QPointer<FilterParserThread> m_filterParser;
         QPointer<BandwidthScheduler> m_bwScheduler;
@@ -691,26 +735,52 @@ namespace BitTorrent
         Utils::Thread::UniquePtr m_ioThread;
         ResumeDataStorage *m_resumeDataStorage = nullptr;
         FileSearcher *m_fileSearcher = nullptr;
+        MoveStorageProgressChecker *m_moveStorageProgressChecker = nullptr;
 
         QSet<TorrentID> m_downloadedMetadata;
 
         QHash<TorrentID, TorrentImpl *> m_torrents;
         QHash<TorrentID, TorrentImpl *> m_hybridTorrentsByAltID;
+        std::array<qsizetype, TorrentFilter::TypeCount> m_torrentsCountByStateFilter {};
+        std::array<qsizetype, 2> m_torrentsCountByRefreshTier {};
+        // Idle torrents updated since their last notification
+        QSet<TorrentImpl *> m_deferredUpdatedTorrents;
+        int m_refreshCycle = 0;
         QHash<TorrentID, LoadTorrentParams> m_loadingTorrents;
         QHash<QString, AddTorrentParams> m_downloadedTorrents;
         QHash<TorrentID, RemovingTorrentData> m_removingTorrents;
         QSet<TorrentID> m_needSaveResumeDataTorrents;
         QHash<TorrentID, TorrentID> m_changedTorrentIDs;
+        // Torrents added in batch have their file searches dispatched
+        // and initial resume data stored all at once
+        bool m_isAddingTorrentsBatch = false;
+        QVector<std::function<void ()>> m_batchFileSearches;
+        QSet<TorrentID> m_batchAddedTorrentIDs;
+        QSet<TorrentImpl *> m_torrentsAwaitingInitialSave;
+        QSet<TorrentID> m_initialResumeDataRequests;
+        QHash<TorrentID, LoadTorrentParams> m_initialResumeDataBatch;
         QMap<QString, CategoryOptions> m_categories;
         QList<QPair<QString, Path>> m_categoryPaths;
         QSet<QString> m_tags;
 
+        QSet<QString> m_bannedIPs;
+        QHash<QString, QDateTime> m_temporaryBannedIPs;
+        QTimer *m_banExpirationTimer = nullptr;
+
         QHash<Torrent *, QSet<QString>> m_updatedTrackerEntries;
 
         // I/O errored torrents
         QSet<TorrentID> m_recentErroredTorrents;
         QTimer *m_recentErroredTorrentsTimer = nullptr;
 
+        // Storage moving
+        // (there can be one active and one queued job per torrent)
+        std::unordered_map<lt::torrent_handle, MoveStorageJob> m_activeMoveStorageJobs;
+        std::unordered_map<lt::torrent_handle, MoveStorageJob> m_queuedMoveStorageJobs;
+        MoveStorageQueue<lt::torrent_handle> m_moveStorageQueue;
+        QHash<Path, QString> m_storageDeviceIDs;
+        QTimer *m_moveStorageProgressTimer = nullptr;
+
         SessionMetricIndices m_metricIndices;
         lt::time_point m_statsLastTimestamp = lt::clock_type::now();
 
@@ -720,8 +790,6 @@ namespace BitTorrent
         QNetworkConfigurationManager *m_networkManager = nullptr;
 #endif
 
-        QList<MoveStorageJob> m_moveStorageQueue;
-
         QString m_lastExternalIP;
 
         bool m_needUpgradeDownloadPath = false;
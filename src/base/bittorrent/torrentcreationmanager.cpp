@@ -0,0 +1,420 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrentcreationmanager.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QStorageInfo>
+#include <QThread>
+#include <QUuid>
+
+#include "base/global.h"
+#include "base/utils/fs.h"
+#include "addtorrentparams.h"
+#include "session.h"
+#include "torrent.h"
+#include "torrentinfo.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    const int MAX_FINISHED_TASKS = 500;
+    const qint64 FINISHED_TASK_LIFETIME = 24 * 60 * 60;  // in seconds
+
+    QByteArray storageDevice(const Path &path)
+    {
+        return QStorageInfo(path.data()).device();
+    }
+}
+
+using namespace BitTorrent;
+
+TorrentCreationTask::TorrentCreationTask(const QString &id, const TorrentCreatorParams &params
+        , const bool startSeeding, const bool ignoreShareLimits, QObject *parent)
+    : QObject(parent)
+    , m_id {id}
+    , m_params {params}
+    , m_startSeeding {startSeeding}
+    , m_ignoreShareLimits {ignoreShareLimits}
+    , m_timeAdded {QDateTime::currentDateTime()}
+{
+}
+
+QString TorrentCreationTask::id() const
+{
+    return m_id;
+}
+
+const TorrentCreatorParams &TorrentCreationTask::params() const
+{
+    return m_params;
+}
+
+bool TorrentCreationTask::isSeedingRequested() const
+{
+    return m_startSeeding;
+}
+
+bool TorrentCreationTask::isShareLimitIgnored() const
+{
+    return m_ignoreShareLimits;
+}
+
+TorrentCreationTask::State TorrentCreationTask::state() const
+{
+    return m_state;
+}
+
+bool TorrentCreationTask::isDone() const
+{
+    return (m_state != State::Queued) && (m_state != State::Running);
+}
+
+int TorrentCreationTask::progress() const
+{
+    return m_progress;
+}
+
+qint64 TorrentCreationTask::throughput() const
+{
+    return m_throughput;
+}
+
+QString TorrentCreationTask::errorMessage() const
+{
+    return m_errorMessage;
+}
+
+QDateTime TorrentCreationTask::timeAdded() const
+{
+    return m_timeAdded;
+}
+
+QDateTime TorrentCreationTask::timeStarted() const
+{
+    return m_timeStarted;
+}
+
+QDateTime TorrentCreationTask::timeFinished() const
+{
+    return m_timeFinished;
+}
+
+void TorrentCreationTask::start()
+{
+    Q_ASSERT(m_state == State::Queued);
+
+    m_state = State::Running;
+    m_timeStarted = QDateTime::currentDateTime();
+
+    m_creatorThread = new TorrentCreatorThread(this);
+    connect(m_creatorThread, &TorrentCreatorThread::creationSuccess, this, &TorrentCreationTask::handleCreationSuccess);
+    connect(m_creatorThread, &TorrentCreatorThread::creationFailure, this, &TorrentCreationTask::handleCreationFailure);
+    connect(m_creatorThread, &TorrentCreatorThread::updateProgress, this, [this](const int progress)
+    {
+        m_progress = progress;
+    });
+    connect(m_creatorThread, &TorrentCreatorThread::updateThroughput, this, [this](const qint64 bytesPerSecond)
+    {
+        m_throughput = bytesPerSecond;
+    });
+    m_creatorThread->create(m_params);
+}
+
+void TorrentCreationTask::cancel()
+{
+    if (m_state == State::Queued)
+    {
+        finish(State::Cancelled);
+    }
+    else if (m_state == State::Running)
+    {
+        // the task is finished once the creator thread acknowledges the interruption
+        m_isCancelRequested = true;
+        m_creatorThread->requestInterruption();
+    }
+}
+
+void TorrentCreationTask::handleCreationSuccess(const Path &path, const Path &branchPath)
+{
+    // the torrent was already created when the interruption was requested
+    if (m_isCancelRequested)
+    {
+        finish(State::Cancelled);
+        return;
+    }
+
+    if (m_startSeeding)
+    {
+        const nonstd::expected<TorrentInfo, QString> result = TorrentInfo::loadFromFile(path);
+        if (!result)
+        {
+            m_errorMessage = tr("Created torrent is invalid. It won't be added to download list.");
+            finish(State::Failed);
+            return;
+        }
+
+        // the content is known to be complete so it doesn't need to be checked
+        AddTorrentParams params;
+        params.savePath = branchPath;
+        params.skipChecking = true;
+        if (m_ignoreShareLimits)
+        {
+            params.ratioLimit = Torrent::NO_RATIO_LIMIT;
+            params.seedingTimeLimit = Torrent::NO_SEEDING_TIME_LIMIT;
+        }
+        params.useAutoTMM = false;  // otherwise if it is on by default, it will overwrite `savePath` to the default save path
+
+        if (!Session::instance()->addTorrent(result.value(), params))
+            m_errorMessage = tr("Torrent was created but it couldn't be added for seeding.");
+    }
+
+    m_progress = 100;
+    finish(State::Finished);
+}
+
+void TorrentCreationTask::handleCreationFailure(const QString &msg)
+{
+    if (m_isCancelRequested)
+    {
+        finish(State::Cancelled);
+    }
+    else
+    {
+        m_errorMessage = msg;
+        finish(State::Failed);
+    }
+}
+
+void TorrentCreationTask::finish(const State state)
+{
+    m_state = state;
+    m_timeFinished = QDateTime::currentDateTime();
+    emit finished();
+}
+
+TorrentCreationManager *TorrentCreationManager::m_instance = nullptr;
+
+void TorrentCreationManager::initInstance()
+{
+    if (!m_instance)
+        m_instance = new TorrentCreationManager;
+}
+
+void TorrentCreationManager::freeInstance()
+{
+    delete m_instance;
+    m_instance = nullptr;
+}
+
+TorrentCreationManager *TorrentCreationManager::instance()
+{
+    return m_instance;
+}
+
+TorrentCreationManager::TorrentCreationManager(QObject *parent)
+    : QObject(parent)
+    , m_tempFolder {Utils::Fs::tempPath() / Path(u"torrentcreator"_qs)}
+{
+    m_expirationTimer.setInterval(10min);
+    connect(&m_expirationTimer, &QTimer::timeout, this, &TorrentCreationManager::removeExpiredTasks);
+    m_expirationTimer.start();
+}
+
+TorrentCreationManager::~TorrentCreationManager()
+{
+    QVector<TorrentCreationTask *> tasks = m_tasks;
+    for (TorrentCreationTask *task : asConst(m_removedTasks))
+        tasks.append(task);
+
+    // running tasks are interrupted by their creator threads
+    for (TorrentCreationTask *task : asConst(tasks))
+    {
+        const Path torrentPath = task->params().savePath;
+        delete task;
+
+        if (isTemporaryFile(torrentPath))
+            Utils::Fs::removeFile(torrentPath);
+    }
+}
+
+QString TorrentCreationManager::createTask(TorrentCreatorParams params, const bool startSeeding, const bool ignoreShareLimits)
+{
+    const QString id = QUuid::createUuid().toString(QUuid::WithoutBraces);
+    if (params.savePath.isEmpty())
+    {
+        Utils::Fs::mkpath(m_tempFolder);
+        params.savePath = m_tempFolder / Path(u"%1.torrent"_qs.arg(id));
+    }
+
+    auto *task = new TorrentCreationTask(id, params, startSeeding, ignoreShareLimits, this);
+    connect(task, &TorrentCreationTask::finished, this, &TorrentCreationManager::startQueuedTasks);
+    // the task may be expired (and deleted) only after it has finished emitting the signal
+    connect(task, &TorrentCreationTask::finished, this, &TorrentCreationManager::removeExpiredTasks, Qt::QueuedConnection);
+    m_tasks.append(task);
+    m_tasksByID.insert(id, task);
+
+    startQueuedTasks();
+    return id;
+}
+
+TorrentCreationTask *TorrentCreationManager::getTask(const QString &id) const
+{
+    return m_tasksByID.value(id);
+}
+
+QVector<TorrentCreationTask *> TorrentCreationManager::tasks() const
+{
+    return m_tasks;
+}
+
+bool TorrentCreationManager::cancelTask(const QString &id)
+{
+    TorrentCreationTask *task = m_tasksByID.value(id);
+    if (!task)
+        return false;
+
+    task->cancel();
+    return true;
+}
+
+bool TorrentCreationManager::deleteTask(const QString &id)
+{
+    TorrentCreationTask *task = m_tasksByID.value(id);
+    if (!task)
+        return false;
+
+    removeTask(task);
+    return true;
+}
+
+int TorrentCreationManager::maxRunningTasks() const
+{
+    // Every task already hashes on all cores, so additional tasks
+    // mostly help to keep several disks busy at the same time
+    return std::max(1, (QThread::idealThreadCount() / 4));
+}
+
+void TorrentCreationManager::startQueuedTasks()
+{
+    // Interleaved reads of several tasks would defeat the large sequential
+    // reads of each of them, so only one task is run per storage device
+    int runningCount = m_removedTasks.size();
+    QSet<QByteArray> busyDevices;
+    for (const TorrentCreationTask *task : asConst(m_removedTasks))
+        busyDevices.insert(storageDevice(task->params().inputPath));
+    for (const TorrentCreationTask *task : asConst(m_tasks))
+    {
+        if (task->state() == TorrentCreationTask::State::Running)
+        {
+            ++runningCount;
+            busyDevices.insert(storageDevice(task->params().inputPath));
+        }
+    }
+
+    for (TorrentCreationTask *task : asConst(m_tasks))
+    {
+        if (runningCount >= maxRunningTasks())
+            break;
+        if (task->state() != TorrentCreationTask::State::Queued)
+            continue;
+
+        const QByteArray device = storageDevice(task->params().inputPath);
+        if (busyDevices.contains(device))
+            continue;
+
+        busyDevices.insert(device);
+        ++runningCount;
+        task->start();
+    }
+}
+
+void TorrentCreationManager::removeExpiredTasks()
+{
+    QVector<TorrentCreationTask *> finishedTasks;
+    for (TorrentCreationTask *task : asConst(m_tasks))
+    {
+        if (task->isDone())
+            finishedTasks.append(task);
+    }
+
+    // the most recently finished tasks are kept
+    std::sort(finishedTasks.begin(), finishedTasks.end()
+        , [](const TorrentCreationTask *left, const TorrentCreationTask *right)
+    {
+        return (left->timeFinished() > right->timeFinished());
+    });
+
+    const QDateTime expirationTime = QDateTime::currentDateTime().addSecs(-FINISHED_TASK_LIFETIME);
+    for (int i = 0; i < finishedTasks.size(); ++i)
+    {
+        TorrentCreationTask *task = finishedTasks[i];
+        if ((i >= MAX_FINISHED_TASKS) || (task->timeFinished() < expirationTime))
+            removeTask(task);
+    }
+}
+
+void TorrentCreationManager::removeTask(TorrentCreationTask *task)
+{
+    m_tasksByID.remove(task->id());
+    m_tasks.removeOne(task);
+
+    const Path torrentPath = task->params().savePath;
+    if (task->state() == TorrentCreationTask::State::Running)
+    {
+        // the task keeps its storage device busy until the creator thread
+        // acknowledges the interruption, so it is deleted only then
+        task->disconnect(this);
+        m_removedTasks.insert(task);
+        connect(task, &TorrentCreationTask::finished, this, [this, task, torrentPath]()
+        {
+            m_removedTasks.remove(task);
+            task->deleteLater();
+
+            if (isTemporaryFile(torrentPath))
+                Utils::Fs::removeFile(torrentPath);
+
+            startQueuedTasks();
+        });
+        task->cancel();
+        return;
+    }
+
+    delete task;
+
+    if (isTemporaryFile(torrentPath))
+        Utils::Fs::removeFile(torrentPath);
+}
+
+bool TorrentCreationManager::isTemporaryFile(const Path &path) const
+{
+    return (path.parentPath() == m_tempFolder);
+}
@@ -0,0 +1,143 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QDateTime>
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QTimer>
+#include <QVector>
+
+#include "base/path.h"
+#include "torrentcreatorthread.h"
+
+namespace BitTorrent
+{
+    class TorrentCreationTask final : public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(TorrentCreationTask)
+
+        friend class TorrentCreationManager;
+
+    public:
+        enum class State
+        {
+            Queued,
+            Running,
+            Finished,
+            Failed,
+            Cancelled
+        };
+
+        QString id() const;
+        const TorrentCreatorParams &params() const;
+        bool isSeedingRequested() const;
+        bool isShareLimitIgnored() const;
+
+        State state() const;
+        bool isDone() const;
+        int progress() const;
+        qint64 throughput() const;
+        QString errorMessage() const;
+
+        QDateTime timeAdded() const;
+        QDateTime timeStarted() const;
+        QDateTime timeFinished() const;
+
+    signals:
+        void finished();
+
+    private:
+        TorrentCreationTask(const QString &id, const TorrentCreatorParams &params
+                , bool startSeeding, bool ignoreShareLimits, QObject *parent = nullptr);
+
+        void start();
+        void cancel();
+        void handleCreationSuccess(const Path &path, const Path &branchPath);
+        void handleCreationFailure(const QString &msg);
+        void finish(State state);
+
+        const QString m_id;
+        const TorrentCreatorParams m_params;
+        const bool m_startSeeding;
+        const bool m_ignoreShareLimits;
+
+        TorrentCreatorThread *m_creatorThread = nullptr;
+        State m_state = State::Queued;
+        bool m_isCancelRequested = false;
+        int m_progress = 0;
+        qint64 m_throughput = 0;
+        QString m_errorMessage;
+        QDateTime m_timeAdded;
+        QDateTime m_timeStarted;
+        QDateTime m_timeFinished;
+    };
+
+    class TorrentCreationManager final : public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(TorrentCreationManager)
+
+    public:
+        static void initInstance();
+        static void freeInstance();
+        static TorrentCreationManager *instance();
+
+        // An empty save path in `params` means that the torrent file
+        // is kept in a temporary location until the task is deleted.
+        // Finished tasks are deleted automatically once they expire.
+        QString createTask(TorrentCreatorParams params, bool startSeeding, bool ignoreShareLimits);
+        TorrentCreationTask *getTask(const QString &id) const;
+        QVector<TorrentCreationTask *> tasks() const;
+        bool cancelTask(const QString &id);
+        bool deleteTask(const QString &id);
+
+        int maxRunningTasks() const;
+
+    private:
+        explicit TorrentCreationManager(QObject *parent = nullptr);
+        ~TorrentCreationManager() override;
+
+        void startQueuedTasks();
+        void removeExpiredTasks();
+        void removeTask(TorrentCreationTask *task);
+        bool isTemporaryFile(const Path &path) const;
+
+        static TorrentCreationManager *m_instance;
+
+        const Path m_tempFolder;
+        QVector<TorrentCreationTask *> m_tasks;
+        QHash<QString, TorrentCreationTask *> m_tasksByID;
+        // deleted tasks which wait for their creator threads to be interrupted
+        QSet<TorrentCreationTask *> m_removedTasks;
+        QTimer m_expirationTimer;
+    };
+}
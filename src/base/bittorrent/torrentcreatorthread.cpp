@@ -28,15 +28,25 @@
 
 #include "torrentcreatorthread.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <fstream>
+#include <vector>
 
 #include <libtorrent/create_torrent.hpp>
 #include <libtorrent/file_storage.hpp>
+#include <libtorrent/hasher.hpp>
+#include <libtorrent/settings_pack.hpp>
 #include <libtorrent/torrent_info.hpp>
 
 #include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QFileInfo>
 #include <QHash>
+#include <QSemaphore>
+#include <QThreadPool>
 
 #include "base/exceptions.h"
 #include "base/global.h"
@@ -48,6 +58,20 @@
 
 namespace
 {
+    // torrent content is read in batches of whole pieces so disk access stays large and sequential
+    const qint64 READ_BATCH_SIZE = 16 * 1024 * 1024;
+    const qint64 MAX_UNHASHED_DATA_SIZE = 8 * READ_BATCH_SIZE;
+
+    int hashingThreadCount()
+    {
+        return std::max(1, QThread::idealThreadCount());
+    }
+
+    int piecesPerBatch(const int pieceLength)
+    {
+        return std::max(1, static_cast<int>(READ_BATCH_SIZE / pieceLength));
+    }
+
     // do not include files and folders whose
     // name starts with a .
     bool fileFilter(const std::string &f)
@@ -96,12 +120,173 @@ void TorrentCreatorThread::sendProgressSignal(int currentPieceIdx, int totalPiec
     emit updateProgress(static_cast<int>((currentPieceIdx * 100.) / totalPieces));
 }
 
+void TorrentCreatorThread::sendThroughputSignal(const qint64 hashedBytes, const qint64 elapsedMSecs)
+{
+    if (elapsedMSecs > 0)
+        emit updateThroughput((hashedBytes * 1000) / elapsedMSecs);
+}
+
 void TorrentCreatorThread::checkInterruptionRequested() const
 {
     if (isInterruptionRequested())
         throw RuntimeError(tr("Operation aborted"));
 }
 
+void TorrentCreatorThread::calculateV1PieceHashes(lt::create_torrent &newTorrent, const Path &basePath)
+{
+    // This thread reads the content sequentially while the pieces
+    // already read are hashed by the pool in parallel
+    const lt::file_storage &fs = newTorrent.files();
+    const std::string basePathStr = basePath.toString().toStdString();
+    const int numPieces = newTorrent.num_pieces();
+    const int pieceLength = newTorrent.piece_length();
+    const int batchPieces = piecesPerBatch(pieceLength);
+    const int threadCount = hashingThreadCount();
+
+    std::vector<lt::sha1_hash> hashes(numPieces);
+    std::atomic_int hashedPieces {0};
+    // the amount of data which is read but not hashed yet is limited by size,
+    // but the slots for the whole batch are acquired at once, so there have to be at least as many
+    const qint64 maxUnhashedPieces = std::min<qint64>(std::max((2 * batchPieces), (2 * threadCount))
+            , (MAX_UNHASHED_DATA_SIZE / pieceLength));
+    QSemaphore freeSlots {std::max(batchPieces, static_cast<int>(maxUnhashedPieces))};
+
+    QThreadPool hashingPool;
+    hashingPool.setMaxThreadCount(threadCount);
+
+    QFile file;
+    int fileIndex = -1;
+    qint64 fileBytesLeft = 0;
+    const auto readContent = [&fs, &basePathStr, &file, &fileIndex, &fileBytesLeft](char *buffer, qint64 size)
+    {
+        while (size > 0)
+        {
+            while (fileBytesLeft == 0)
+            {
+                file.close();
+
+                ++fileIndex;
+                if (fileIndex >= fs.num_files())
+                    throw RuntimeError(tr("Unexpected end of torrent content"));
+
+                const lt::file_index_t index {fileIndex};
+                fileBytesLeft = fs.file_size(index);
+                if ((fileBytesLeft > 0) && !fs.pad_file_at(index))
+                {
+                    file.setFileName(QString::fromStdString(fs.file_path(index, basePathStr)));
+                    if (!file.open(QIODevice::ReadOnly | QIODevice::Unbuffered))
+                    {
+                        throw RuntimeError(tr("Cannot read file %1: %2")
+                            .arg(Path(file.fileName()).toString(), file.errorString()));
+                    }
+                }
+            }
+
+            const qint64 chunkSize = std::min(size, fileBytesLeft);
+            if (file.isOpen())
+            {
+                if (file.read(buffer, chunkSize) != chunkSize)
+                {
+                    throw RuntimeError(tr("Cannot read file %1: %2")
+                        .arg(Path(file.fileName()).toString(), file.errorString()));
+                }
+            }
+            else
+            {
+                // pad files are virtual and consist of zeroes
+                std::memset(buffer, 0, chunkSize);
+            }
+
+            buffer += chunkSize;
+            size -= chunkSize;
+            fileBytesLeft -= chunkSize;
+        }
+    };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    try
+    {
+        for (int batchStart = 0; batchStart < numPieces; batchStart += batchPieces)
+        {
+            checkInterruptionRequested();
+
+            const int batchEnd = std::min(numPieces, (batchStart + batchPieces));
+            const int batchSize = ((batchEnd - batchStart - 1) * pieceLength)
+                    + newTorrent.piece_size(lt::piece_index_t {batchEnd - 1});
+
+            freeSlots.acquire(batchEnd - batchStart);
+
+            QByteArray batch {batchSize, Qt::Uninitialized};
+            readContent(batch.data(), batchSize);
+
+            for (int pieceIndex = batchStart; pieceIndex < batchEnd; ++pieceIndex)
+            {
+                const int offset = (pieceIndex - batchStart) * pieceLength;
+                const int pieceSize = newTorrent.piece_size(lt::piece_index_t {pieceIndex});
+                hashingPool.start([batch, offset, pieceSize, pieceIndex, &hashes, &hashedPieces, &freeSlots]()
+                {
+                    hashes[pieceIndex] = lt::hasher(batch.constData() + offset, pieceSize).final();
+                    ++hashedPieces;
+                    freeSlots.release();
+                });
+            }
+
+            const int hashedCount = hashedPieces;
+            sendProgressSignal(hashedCount, numPieces);
+            sendThroughputSignal((static_cast<qint64>(hashedCount) * pieceLength), timer.elapsed());
+        }
+
+        hashingPool.waitForDone();
+    }
+    catch (...)
+    {
+        // drop the pieces which are still queued, the running ones are awaited on destruction
+        hashingPool.clear();
+        throw;
+    }
+
+    sendThroughputSignal(fs.total_size(), timer.elapsed());
+
+    for (int pieceIndex = 0; pieceIndex < numPieces; ++pieceIndex)
+        newTorrent.set_hash(lt::piece_index_t {pieceIndex}, hashes[pieceIndex]);
+}
+
+#ifdef QBT_USES_LIBTORRENT2
+void TorrentCreatorThread::calculatePieceHashes(lt::create_torrent &newTorrent, const Path &basePath)
+{
+    // v2 merkle trees are built by libtorrent itself,
+    // so let its disk subsystem spread block hashing over several threads
+    lt::settings_pack settings;
+    settings.set_int(lt::settings_pack::hashing_threads, hashingThreadCount());
+
+    const int numPieces = newTorrent.num_pieces();
+    const int pieceLength = newTorrent.piece_length();
+    const int batchPieces = piecesPerBatch(pieceLength);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    lt::error_code ec;
+    lt::set_piece_hashes(newTorrent, basePath.toString().toStdString(), settings
+        , [this, numPieces, pieceLength, batchPieces, &timer](const lt::piece_index_t n)
+    {
+        checkInterruptionRequested();
+
+        const int pieceIndex = LT::toUnderlyingType(n);
+        sendProgressSignal(pieceIndex, numPieces);
+        if ((pieceIndex % batchPieces) == 0)
+            sendThroughputSignal((static_cast<qint64>(pieceIndex + 1) * pieceLength), timer.elapsed());
+    }, ec);
+
+    if (ec)
+        throw RuntimeError(QString::fromLocal8Bit(ec.message().c_str()));
+
+    sendThroughputSignal(newTorrent.files().total_size(), timer.elapsed());
+}
+#endif
+
 void TorrentCreatorThread::run()
 {
     emit updateProgress(0);
@@ -182,12 +367,14 @@ void TorrentCreatorThread::run()
         }
 
         // calculate the hash for all pieces
-        lt::set_piece_hashes(newTorrent, parentPath.toString().toStdString()
-            , [this, &newTorrent](const lt::piece_index_t n)
-        {
-            checkInterruptionRequested();
-            sendProgressSignal(LT::toUnderlyingType(n), newTorrent.num_pieces());
-        });
+#ifdef QBT_USES_LIBTORRENT2
+        if (m_params.torrentFormat == TorrentFormat::V1)
+            calculateV1PieceHashes(newTorrent, parentPath);
+        else
+            calculatePieceHashes(newTorrent, parentPath);
+#else
+        calculateV1PieceHashes(newTorrent, parentPath);
+#endif
 
         // Set qBittorrent as creator and add user comment to
         // torrent_info structure
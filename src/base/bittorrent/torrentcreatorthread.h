@@ -28,11 +28,15 @@
 
 #pragma once
 
+#include <libtorrent/fwd.hpp>
+
 #include <QStringList>
 #include <QThread>
 
 #include "base/path.h"
 
+class TestBittorrentTorrentCreatorThread;
+
 namespace BitTorrent
 {
 #ifdef QBT_USES_LIBTORRENT2
@@ -67,6 +71,8 @@ namespace BitTorrent
         Q_OBJECT
         Q_DISABLE_COPY_MOVE(TorrentCreatorThread)
 
+        friend class ::TestBittorrentTorrentCreatorThread;
+
     public:
         explicit TorrentCreatorThread(QObject *parent = nullptr);
         ~TorrentCreatorThread() override;
@@ -84,11 +90,19 @@ namespace BitTorrent
         void creationFailure(const QString &msg);
         void creationSuccess(const Path &path, const Path &branchPath);
         void updateProgress(int progress);
+        void updateThroughput(qint64 bytesPerSecond);
 
     private:
         void run() override;
         void sendProgressSignal(int currentPieceIdx, int totalPieces);
+        void sendThroughputSignal(qint64 hashedBytes, qint64 elapsedMSecs);
         void checkInterruptionRequested() const;
+        // Sets v1 piece hashes of `newTorrent` which content is located in `basePath`.
+        // Pad files of `newTorrent` are hashed as zeroes.
+        void calculateV1PieceHashes(lt::create_torrent &newTorrent, const Path &basePath);
+#ifdef QBT_USES_LIBTORRENT2
+        void calculatePieceHashes(lt::create_torrent &newTorrent, const Path &basePath);
+#endif
 
         TorrentCreatorParams m_params;
     };
@@ -993,8 +993,21 @@ TorrentState TorrentImpl::state() const
     return m_state;
 }
 
+TorrentFilter::TypeFlags TorrentImpl::stateFilterTypes() const
+{
+    return m_stateFilterTypes;
+}
+
+TorrentRefreshTier TorrentImpl::refreshTier() const
+{
+    return m_refreshTier;
+}
+
 void TorrentImpl::updateState()
 {
+    const TorrentState prevState = m_state;
+    const TorrentFilter::TypeFlags prevStateFilterTypes = m_stateFilterTypes;
+
     if (m_nativeStatus.state == lt::torrent_status::checking_resume_data)
     {
         m_state = TorrentState::CheckingResumeData;
@@ -1051,6 +1064,34 @@ void TorrentImpl::updateState()
         else
             m_state = TorrentState::StalledDownloading;
     }
+
+    m_stateFilterTypes = TorrentFilter::matchedTypes(this);
+    if ((m_state != prevState) || (m_stateFilterTypes != prevStateFilterTypes))
+        m_session->handleTorrentStateChanged(this, prevState, prevStateFilterTypes);
+}
+
+void TorrentImpl::updateRefreshTier()
+{
+    switch (m_state)
+    {
+    case TorrentState::PausedDownloading:
+    case TorrentState::PausedUploading:
+    case TorrentState::QueuedDownloading:
+    case TorrentState::QueuedUploading:
+    case TorrentState::MissingFiles:
+    case TorrentState::Error:
+        m_refreshTier = TorrentRefreshTier::Idle;
+        break;
+    case TorrentState::StalledDownloading:
+    case TorrentState::StalledUploading:
+    case TorrentState::ForcedUploading:
+        // nothing can change until some peer is connected
+        m_refreshTier = (m_nativeStatus.num_peers > 0) ? TorrentRefreshTier::Active : TorrentRefreshTier::Idle;
+        break;
+    default:
+        m_refreshTier = TorrentRefreshTier::Active;
+        break;
+    }
 }
 
 bool TorrentImpl::hasMetadata() const
@@ -1292,8 +1333,33 @@ QVector<PeerInfo> TorrentImpl::peers() const
 
 QBitArray TorrentImpl::pieces() const
 {
-    if (m_pieces.isEmpty())
-        m_pieces = LT::toQBitArray(m_nativeStatus.pieces);
+    if (!hasMetadata())
+        return {};
+
+    if (m_nativeStatus.num_pieces == piecesCount())
+    {
+        if (m_isPiecesOutdated)
+        {
+            m_pieces = QBitArray(piecesCount(), true);
+            m_isPiecesOutdated = false;
+        }
+        return m_pieces;
+    }
+
+    // Piece bitfield isn't included in periodic status updates so it is queried
+    // only for torrents someone is interested in. Once there is a known one
+    // it is provided until the updated one is received asynchronously.
+    if (m_pieces.size() != piecesCount())
+    {
+        m_pieces = LT::toQBitArray(m_nativeHandle.status(lt::torrent_handle::query_pieces).pieces);
+        m_isPiecesOutdated = false;
+    }
+    else if (m_isPiecesOutdated && !m_isPiecesRequested)
+    {
+        m_nativeHandle.post_status(lt::torrent_handle::query_pieces);
+        m_isPiecesRequested = true;
+    }
+
     return m_pieces;
 }
 
@@ -1639,6 +1705,8 @@ void TorrentImpl::reload()
 {
     m_completedFiles.fill(false);
     m_pieces.clear();
+    m_isPiecesOutdated = true;
+    m_isPiecesRequested = false;
 
     const auto queuePos = m_nativeHandle.queue_position();
 
@@ -1693,6 +1761,8 @@ void TorrentImpl::pause()
 
         m_payloadRateMonitor.reset();
     }
+
+    updateState();
 }
 
 void TorrentImpl::resume(const TorrentOperatingMode mode)
@@ -1711,6 +1781,7 @@ void TorrentImpl::resume(const TorrentOperatingMode mode)
         m_isStopped = false;
         m_ltAddTorrentParams.ti = std::const_pointer_cast<lt::torrent_info>(nativeTorrentInfo());
         reload();
+        updateState();
         return;
     }
 
@@ -1727,6 +1798,8 @@ void TorrentImpl::resume(const TorrentOperatingMode mode)
         if (m_operatingMode == TorrentOperatingMode::Forced)
             m_nativeHandle.resume();
     }
+
+    updateState();
 }
 
 void TorrentImpl::moveStorage(const Path &newPath, const MoveStorageMode mode)
@@ -1759,6 +1832,19 @@ void TorrentImpl::handleStateUpdate(const lt::torrent_status &nativeStatus)
     updateStatus(nativeStatus);
 }
 
+bool TorrentImpl::isPiecesRequested() const
+{
+    return m_isPiecesRequested;
+}
+
+void TorrentImpl::handlePiecesUpdate(const lt::bitfield &pieces)
+{
+    m_pieces = LT::toQBitArray(pieces);
+    m_isPiecesRequested = false;
+    // pieces could be completed while the request was in progress
+    m_isPiecesOutdated = (pieces.count() != m_nativeStatus.num_pieces);
+}
+
 void TorrentImpl::handleMoveStorageJobFinished(const Path &path, const bool hasOutstandingJob)
 {
     m_session->handleTorrentNeedSaveResumeData(this);
@@ -2252,12 +2338,17 @@ bool TorrentImpl::isMoveInProgress() const
 
 void TorrentImpl::updateStatus(const lt::torrent_status &nativeStatus)
 {
-    m_pieces.clear();
-    m_nativeStatus = nativeStatus;
-    updateState();
+    // cached pieces remain valid until some piece is completed or lost
+    if ((nativeStatus.num_pieces != m_nativeStatus.num_pieces) || (nativeStatus.state != m_nativeStatus.state))
+        m_isPiecesOutdated = true;
 
+    m_nativeStatus = nativeStatus;
+    // "active" state filter depends on the current payload rates
     m_payloadRateMonitor.addSample({nativeStatus.download_payload_rate
                               , nativeStatus.upload_payload_rate});
+    updateState();
+
+    updateRefreshTier();
 
     if (hasMetadata())
     {
@@ -49,6 +49,7 @@
 
 #include "base/path.h"
 #include "base/tagset.h"
+#include "base/torrentfilter.h"
 #include "infohash.h"
 #include "speedmonitor.h"
 #include "torrent.h"
@@ -240,9 +241,13 @@ namespace BitTorrent
 
         // Session interface
         lt::torrent_handle nativeHandle() const;
+        TorrentFilter::TypeFlags stateFilterTypes() const;
+        TorrentRefreshTier refreshTier() const;
 
         void handleAlert(const lt::alert *a);
         void handleStateUpdate(const lt::torrent_status &nativeStatus);
+        bool isPiecesRequested() const;
+        void handlePiecesUpdate(const lt::bitfield &pieces);
         void handleCategoryOptionsChanged();
         void handleAppendExtensionToggled();
         void saveResumeData(lt::resume_data_flags_t flags = {});
@@ -259,6 +264,7 @@ namespace BitTorrent
         void refreshTrackerEntries() const;
         void updateStatus(const lt::torrent_status &nativeStatus);
         void updateState();
+        void updateRefreshTier();
 
         void handleFastResumeRejectedAlert(const lt::fastresume_rejected_alert *p);
         void handleFileCompletedAlert(const lt::file_completed_alert *p);
@@ -299,6 +305,8 @@ namespace BitTorrent
         lt::torrent_handle m_nativeHandle;
         mutable lt::torrent_status m_nativeStatus;
         TorrentState m_state = TorrentState::Unknown;
+        TorrentFilter::TypeFlags m_stateFilterTypes;
+        TorrentRefreshTier m_refreshTier = TorrentRefreshTier::Active;
         TorrentInfo m_torrentInfo;
         PathList m_filePaths;
         QHash<lt::file_index_t, int> m_indexMap;
@@ -349,5 +357,7 @@ namespace BitTorrent
         int m_uploadLimit = 0;
 
         mutable QBitArray m_pieces;
+        mutable bool m_isPiecesOutdated = true;
+        mutable bool m_isPiecesRequested = false;
     };
 }
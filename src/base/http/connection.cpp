@@ -34,7 +34,6 @@
 
 #include "base/logger.h"
 #include "irequesthandler.h"
-#include "requestparser.h"
 #include "responsegenerator.h"
 
 using namespace Http;
@@ -66,18 +65,18 @@ Connection::~Connection()
 
 void Connection::read()
 {
-    m_receivedData.append(m_socket->readAll());
+    m_requestParser.addData(m_socket->readAll());
 
-    while (!m_receivedData.isEmpty())
+    while (m_requestParser.bufferedSize() > 0)
     {
-        const RequestParser::ParseResult result = RequestParser::parse(m_receivedData);
+        const RequestParser::ParseResult result = m_requestParser.parseNext();
 
         switch (result.status)
         {
         case RequestParser::ParseStatus::Incomplete:
             {
                 const long bufferLimit = RequestParser::MAX_CONTENT_SIZE * 1.1;  // some margin for headers
-                if (m_receivedData.size() > bufferLimit)
+                if (m_requestParser.bufferedSize() > bufferLimit)
                 {
                     LogMsg(tr("Http request size exceeds limitation, closing socket. Limit: %1, IP: %2")
                         .arg(bufferLimit).arg(m_socket->peerAddress().toString()), Log::WARNING);
@@ -116,7 +115,6 @@ void Connection::read()
                 resp.headers[HEADER_CONNECTION] = u"keep-alive"_qs;
 
                 sendResponse(resp);
-                m_receivedData = m_receivedData.mid(result.frameSize);
             }
             break;
 
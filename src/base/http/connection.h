@@ -33,6 +33,8 @@
 #include <QElapsedTimer>
 #include <QObject>
 
+#include "requestparser.h"
+
 class QTcpSocket;
 
 namespace Http
@@ -59,7 +61,7 @@ namespace Http
 
         QTcpSocket *m_socket = nullptr;
         IRequestHandler *m_requestHandler = nullptr;
-        QByteArray m_receivedData;
+        RequestParser m_requestParser;
         QElapsedTimer m_idleTimer;
     };
 }
@@ -35,6 +35,7 @@
 #include <QDebug>
 #include <QRegularExpression>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QUrl>
 #include <QUrlQuery>
 
@@ -75,38 +76,71 @@ namespace
     }
 }
 
-RequestParser::RequestParser()
-{
-}
+RequestParser::RequestParser() = default;
+
+RequestParser::~RequestParser() = default;
 
 RequestParser::ParseResult RequestParser::parse(const QByteArray &data)
 {
     // Warning! Header names are converted to lowercase
-    return RequestParser().doParse(data);
+    RequestParser parser;
+    parser.addData(data);
+    return parser.parseNext();
+}
+
+void RequestParser::addData(const QByteArray &data)
+{
+    compactBuffer();
+    m_buffer.append(data);
+}
+
+int RequestParser::bufferedSize() const
+{
+    return (m_buffer.size() - m_pos);
+}
+
+RequestParser::ParseResult RequestParser::parseNext()
+{
+    switch (m_state)
+    {
+    case State::Headers:
+        return parseHeaders();
+    case State::Body:
+        return parseBody();
+    case State::MultipartBody:
+        return parseMultipartBody();
+    }
+
+    Q_ASSERT(false);
+    return badRequest();
 }
 
-RequestParser::ParseResult RequestParser::doParse(const QByteArray &data)
+RequestParser::ParseResult RequestParser::parseHeaders()
 {
     // we don't handle malformed requests which use double `LF` as delimiter
-    const int headerEnd = data.indexOf(EOH);
+    const int headerEnd = m_buffer.indexOf(EOH, m_searchPos);
     if (headerEnd < 0)
     {
+        // the delimiter can be split between this and the next chunk of data
+        m_searchPos = std::max(m_pos, (m_buffer.size() - EOH.size() + 1));
         qDebug() << Q_FUNC_INFO << "incomplete request";
         return {ParseStatus::Incomplete, Request(), 0};
     }
 
-    const QString httpHeaders = QString::fromLatin1(data.constData(), headerEnd);
+    const QString httpHeaders = QString::fromLatin1((m_buffer.constData() + m_pos), (headerEnd - m_pos));
     if (!parseStartLines(httpHeaders))
     {
         qWarning() << Q_FUNC_INFO << "header parsing error";
-        return {ParseStatus::BadRequest, Request(), 0};
+        return badRequest();
     }
 
-    const int headerLength = headerEnd + EOH.length();
+    m_headerLength = headerEnd + EOH.length() - m_pos;
+    m_pos += m_headerLength;
+    m_searchPos = m_pos;
 
     // handle supported methods
     if ((m_request.method == HEADER_REQUEST_METHOD_GET) || (m_request.method == HEADER_REQUEST_METHOD_HEAD))
-        return {ParseStatus::OK, m_request, headerLength};
+        return finishRequest();
     if (m_request.method == HEADER_REQUEST_METHOD_POST)
     {
         const auto parseContentLength = [this]() -> int
@@ -119,39 +153,209 @@ RequestParser::ParseResult RequestParser::doParse(const QByteArray &data)
             return Utils::String::parseInt(rawValue).value_or(-1);
         };
 
-        const int contentLength = parseContentLength();
-        if (contentLength < 0)
+        m_contentLength = parseContentLength();
+        if (m_contentLength < 0)
         {
             qWarning() << Q_FUNC_INFO << "bad request: content-length invalid";
-            return {ParseStatus::BadRequest, Request(), 0};
+            return badRequest();
         }
-        if (contentLength > MAX_CONTENT_SIZE)
+        if (m_contentLength > MAX_CONTENT_SIZE)
         {
             qWarning() << Q_FUNC_INFO << "bad request: message too long";
-            return {ParseStatus::BadRequest, Request(), 0};
+            return badRequest();
         }
 
-        if (contentLength > 0)
+        if (m_contentLength == 0)
+            return finishRequest();
+
+        m_remainingContentLength = m_contentLength;
+
+        const QString contentType = m_request.headers[HEADER_CONTENT_TYPE];
+        if (contentType.toLower().startsWith(CONTENT_TYPE_FORM_DATA))
         {
-            const QByteArray httpBodyView = midView(data, headerLength, contentLength);
-            if (httpBodyView.length() < contentLength)
+            // [rfc2046] 5.1.1. Common Syntax
+
+            // find boundary delimiter
+            const QString boundaryFieldName = u"boundary="_qs;
+            const int idx = contentType.indexOf(boundaryFieldName);
+            if (idx < 0)
             {
-                qDebug() << Q_FUNC_INFO << "incomplete request";
-                return {ParseStatus::Incomplete, Request(), 0};
+                qWarning() << Q_FUNC_INFO << "Could not find boundary in multipart/form-data header!";
+                return badRequest();
             }
 
-            if (!parsePostMessage(httpBodyView))
+            const QByteArray delimiter = Utils::String::unquote(QStringView(contentType).mid(idx + boundaryFieldName.size())).toLatin1();
+            if (delimiter.isEmpty())
             {
-                qWarning() << Q_FUNC_INFO << "message body parsing error";
-                return {ParseStatus::BadRequest, Request(), 0};
+                qWarning() << Q_FUNC_INFO << "boundary delimiter field empty!";
+                return badRequest();
             }
+
+            m_partDelimiter = QByteArray("--") + delimiter + CRLF;
+            m_endDelimiter = QByteArray("--") + delimiter + QByteArray("--") + CRLF;
+            m_state = State::MultipartBody;
+            return parseMultipartBody();
         }
 
-        return {ParseStatus::OK, m_request, (headerLength + contentLength)};
+        m_state = State::Body;
+        return parseBody();
     }
 
     qWarning() << Q_FUNC_INFO << "unsupported request method: " << m_request.method;
-    return {ParseStatus::BadRequest, Request(), 0};  // TODO: SHOULD respond "501 Not Implemented"
+    return badRequest();  // TODO: SHOULD respond "501 Not Implemented"
+}
+
+RequestParser::ParseResult RequestParser::parseBody()
+{
+    if (bufferedSize() < m_contentLength)
+    {
+        qDebug() << Q_FUNC_INFO << "incomplete request";
+        return {ParseStatus::Incomplete, Request(), 0};
+    }
+
+    if (!parsePostMessage(midView(m_buffer, m_pos, m_contentLength)))
+    {
+        qWarning() << Q_FUNC_INFO << "message body parsing error";
+        return badRequest();
+    }
+
+    m_pos += m_contentLength;
+    return finishRequest();
+}
+
+RequestParser::ParseResult RequestParser::parseMultipartBody()
+{
+    // Data is split by "dash-boundary" and each part is parsed as soon as
+    // the delimiter following it is received. The last part ends with the body.
+    const int bodyEnd = m_pos + std::min(bufferedSize(), m_remainingContentLength);
+    const QByteArray bodyView = QByteArray::fromRawData(m_buffer.constData(), bodyEnd);
+
+    int delimiterPos = bodyView.indexOf(m_partDelimiter, m_searchPos);
+    while (delimiterPos >= 0)
+    {
+        const QByteArray partView = midView(m_buffer, m_pos, (delimiterPos - m_pos));
+        if (m_spilledPart)
+        {
+            const QByteArray partData = takeSpilledPartData() + partView;
+            if (!parseFormData(partData))
+                return badRequest();
+        }
+        else if (!partView.isEmpty())
+        {
+            if (!parseFormData(partView))
+                return badRequest();
+        }
+
+        const int consumedSize = delimiterPos + m_partDelimiter.size() - m_pos;
+        m_remainingContentLength -= consumedSize;
+        m_pos += consumedSize;
+        m_searchPos = m_pos;
+
+        delimiterPos = bodyView.indexOf(m_partDelimiter, m_searchPos);
+    }
+
+    if (bufferedSize() >= m_remainingContentLength)
+    {
+        // the whole body is received, so the rest of it is the last part
+        const QByteArray partView = midView(m_buffer, m_pos, m_remainingContentLength);
+        if (m_spilledPart)
+        {
+            const QByteArray partData = takeSpilledPartData() + partView;
+            if (!parseFormData(viewWithoutEndingWith(partData, m_endDelimiter)))
+                return badRequest();
+        }
+        else if (!partView.isEmpty())
+        {
+            if (!parseFormData(viewWithoutEndingWith(partView, m_endDelimiter)))
+                return badRequest();
+        }
+        else if (m_request.posts.isEmpty() && m_request.files.isEmpty())
+        {
+            qWarning() << Q_FUNC_INFO << "multipart empty";
+            return badRequest();
+        }
+
+        m_pos += m_remainingContentLength;
+        m_remainingContentLength = 0;
+        return finishRequest();
+    }
+
+    // the delimiter can be split between this and the next chunk of data
+    m_searchPos = std::max(m_pos, (bodyEnd - m_partDelimiter.size() + 1));
+
+    // keep large part in temporary file until it is complete
+    const int spillableSize = m_searchPos - m_pos;
+    if ((spillableSize > MAX_PART_BUFFER_SIZE) && !spillPartData(spillableSize))
+        return badRequest();
+
+    qDebug() << Q_FUNC_INFO << "incomplete request";
+    return {ParseStatus::Incomplete, Request(), 0};
+}
+
+RequestParser::ParseResult RequestParser::finishRequest()
+{
+    const ParseResult result {ParseStatus::OK, m_request, (m_headerLength + m_contentLength)};
+
+    // prepare for the next request
+    m_state = State::Headers;
+    m_searchPos = m_pos;
+    m_headerLength = 0;
+    m_contentLength = 0;
+    m_remainingContentLength = 0;
+    m_partDelimiter.clear();
+    m_endDelimiter.clear();
+    m_request = {};
+
+    return result;
+}
+
+RequestParser::ParseResult RequestParser::badRequest()
+{
+    return {ParseStatus::BadRequest, Request(), 0};
+}
+
+void RequestParser::compactBuffer()
+{
+    // discard already processed data
+    if (m_pos == 0)
+        return;
+
+    m_buffer.remove(0, m_pos);
+    m_searchPos -= m_pos;
+    m_pos = 0;
+}
+
+bool RequestParser::spillPartData(const int size)
+{
+    if (!m_spilledPart)
+    {
+        m_spilledPart = std::make_unique<QTemporaryFile>();
+        if (!m_spilledPart->open())
+        {
+            qWarning() << Q_FUNC_INFO << "couldn't create temporary file:" << m_spilledPart->errorString();
+            m_spilledPart.reset();
+            return false;
+        }
+    }
+
+    if (m_spilledPart->write((m_buffer.constData() + m_pos), size) != size)
+    {
+        qWarning() << Q_FUNC_INFO << "couldn't write temporary file:" << m_spilledPart->errorString();
+        m_spilledPart.reset();
+        return false;
+    }
+
+    m_pos += size;
+    m_remainingContentLength -= size;
+    return true;
+}
+
+QByteArray RequestParser::takeSpilledPartData()
+{
+    m_spilledPart->seek(0);
+    const QByteArray data = m_spilledPart->readAll();
+    m_spilledPart.reset();
+    return data;
 }
 
 bool RequestParser::parseStartLines(const QStringView data)
@@ -262,46 +466,6 @@ bool RequestParser::parsePostMessage(const QByteArray &data)
         return true;
     }
 
-    // multipart/form-data
-    if (contentTypeLower.startsWith(CONTENT_TYPE_FORM_DATA))
-    {
-        // [rfc2046] 5.1.1. Common Syntax
-
-        // find boundary delimiter
-        const QString boundaryFieldName = u"boundary="_qs;
-        const int idx = contentType.indexOf(boundaryFieldName);
-        if (idx < 0)
-        {
-            qWarning() << Q_FUNC_INFO << "Could not find boundary in multipart/form-data header!";
-            return false;
-        }
-
-        const QByteArray delimiter = Utils::String::unquote(QStringView(contentType).mid(idx + boundaryFieldName.size())).toLatin1();
-        if (delimiter.isEmpty())
-        {
-            qWarning() << Q_FUNC_INFO << "boundary delimiter field empty!";
-            return false;
-        }
-
-        // split data by "dash-boundary"
-        const QByteArray dashDelimiter = QByteArray("--") + delimiter + CRLF;
-        QVector<QByteArray> multipart = splitToViews(data, dashDelimiter, Qt::SkipEmptyParts);
-        if (multipart.isEmpty())
-        {
-            qWarning() << Q_FUNC_INFO << "multipart empty";
-            return false;
-        }
-
-        // remove the ending delimiter
-        const QByteArray endDelimiter = QByteArray("--") + delimiter + QByteArray("--") + CRLF;
-        multipart.push_back(viewWithoutEndingWith(multipart.takeLast(), endDelimiter));
-
-        return std::all_of(multipart.cbegin(), multipart.cend(), [this](const QByteArray &part)
-        {
-            return this->parseFormData(part);
-        });
-    }
-
     qWarning() << Q_FUNC_INFO << "unknown content type:" << contentType;
     return false;
 }
@@ -352,7 +516,8 @@ bool RequestParser::parseFormData(const QByteArray &data)
 
     if (headersMap.contains(filename))
     {
-        m_request.files.append({headersMap[filename], headersMap[HEADER_CONTENT_TYPE], payload});
+        // payload refers to the parser buffer which is reused, so it has to be copied
+        m_request.files.append({headersMap[filename], headersMap[HEADER_CONTENT_TYPE], QByteArray(payload.constData(), payload.size())});
     }
     else if (headersMap.contains(name))
     {
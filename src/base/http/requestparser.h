@@ -30,12 +30,23 @@
 
 #pragma once
 
+#include <memory>
+
+#include <QByteArray>
+
 #include "types.h"
 
+class QTemporaryFile;
+
 namespace Http
 {
+    // Parser keeps its state between calls, so the request can be parsed incrementally
+    // as its data arrives. Parsing is resumed from the position where it stopped and
+    // multipart/form-data parts are extracted as soon as they are completely received.
     class RequestParser
     {
+        Q_DISABLE_COPY_MOVE(RequestParser)
+
     public:
         enum class ParseStatus
         {
@@ -52,20 +63,55 @@ namespace Http
             long frameSize;  // http request frame size (bytes)
         };
 
+        RequestParser();
+        ~RequestParser();
+
         static ParseResult parse(const QByteArray &data);
 
+        void addData(const QByteArray &data);
+        // Parses next request from the data added so far.
+        // Data of the parsed request is discarded, so the next call will parse the next request.
+        ParseResult parseNext();
+        // Size of data kept in memory, it doesn't include the spilled data
+        int bufferedSize() const;
+
         static const long MAX_CONTENT_SIZE = 64 * 1024 * 1024;  // 64 MB
+        // multipart/form-data part exceeding this size is spilled to temporary file until it is complete
+        static const int MAX_PART_BUFFER_SIZE = 4 * 1024 * 1024;  // 4 MB
 
     private:
-        RequestParser();
+        enum class State
+        {
+            Headers,
+            Body,
+            MultipartBody
+        };
+
+        ParseResult parseHeaders();
+        ParseResult parseBody();
+        ParseResult parseMultipartBody();
+        ParseResult finishRequest();
+        ParseResult badRequest();
+        void compactBuffer();
 
-        ParseResult doParse(const QByteArray &data);
         bool parseStartLines(QStringView data);
         bool parseRequestLine(const QString &line);
 
         bool parsePostMessage(const QByteArray &data);
         bool parseFormData(const QByteArray &data);
+        bool spillPartData(int size);
+        QByteArray takeSpilledPartData();
 
+        State m_state = State::Headers;
+        QByteArray m_buffer;
+        int m_pos = 0;  // start of unprocessed data
+        int m_searchPos = 0;  // position to resume delimiter search from
+        int m_headerLength = 0;
+        int m_contentLength = 0;
+        int m_remainingContentLength = 0;
+        QByteArray m_partDelimiter;
+        QByteArray m_endDelimiter;
+        std::unique_ptr<QTemporaryFile> m_spilledPart;
         Request m_request;
     };
 }
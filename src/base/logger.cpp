@@ -29,12 +29,25 @@
 #include "logger.h"
 
 #include <algorithm>
+#include <cstring>
 
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QHostAddress>
+#include <QtEndian>
+#include <QTimer>
 #include <QVector>
 
+#include "base/global.h"
+#include "base/unicodestrings.h"
+
+using namespace std::chrono_literals;
+
 namespace
 {
+    const std::chrono::milliseconds DEFAULT_PEER_AGGREGATION_INTERVAL = 1s;
+    const int DEFAULT_PEER_RECORD_RATE_LIMIT = 200;
+
     template <typename T>
     QVector<T> loadFromBuffer(const boost::circular_buffer_space_optimized<T> &src, const int offset = 0)
     {
@@ -45,11 +58,40 @@ namespace
     }
 }
 
+QString Log::PeerAddress::toString() const
+{
+    if (!isIPv6)
+        return QHostAddress(qFromBigEndian<quint32>(bytes.data())).toString();
+
+    Q_IPV6ADDR address;
+    std::memcpy(address.c, bytes.data(), bytes.size());
+    return QHostAddress(address).toString();
+}
+
+bool Log::operator==(const PeerEventKey &left, const PeerEventKey &right)
+{
+    return (left.event == right.event)
+        && (left.address.isIPv6 == right.address.isIPv6)
+        && (left.address.bytes == right.address.bytes);
+}
+
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+std::size_t Log::qHash(const PeerEventKey &key, const std::size_t seed)
+#else
+uint Log::qHash(const PeerEventKey &key, const uint seed)
+#endif
+{
+    const int addressSize = (key.address.isIPv6 ? 16 : 4);
+    return (::qHashBits(key.address.bytes.data(), addressSize, seed) ^ static_cast<uint>(key.event));
+}
+
 Logger *Logger::m_instance = nullptr;
 
 Logger::Logger()
     : m_messages(MAX_LOG_MESSAGES)
     , m_peers(MAX_LOG_MESSAGES)
+    , m_peerAggregationInterval(DEFAULT_PEER_AGGREGATION_INTERVAL)
+    , m_peerRecordRateLimit(DEFAULT_PEER_RECORD_RATE_LIMIT)
 {
 }
 
@@ -80,14 +122,100 @@ void Logger::addMessage(const QString &message, const Log::MsgType &type)
     emit newLogMessage(msg);
 }
 
-void Logger::addPeer(const QString &ip, const bool blocked, const QString &reason)
+void Logger::addPeer(const Log::PeerAddress &address, const Log::PeerEvent event)
+{
+    const QWriteLocker locker(&m_lock);
+
+    const Log::PeerEventKey key {address, event};
+    const auto indexIter = m_pendingPeerIndexes.constFind(key);
+    if (indexIter != m_pendingPeerIndexes.cend())
+    {
+        ++m_pendingPeers[indexIter.value()].count;
+        return;
+    }
+
+    if (m_pendingPeers.size() >= maxPendingPeerCount())
+    {
+        ++m_droppedPeerEventCount;
+        return;
+    }
+
+    if (m_pendingPeers.isEmpty())
+        QTimer::singleShot(m_peerAggregationInterval, this, &Logger::flushPendingPeers);
+
+    m_pendingPeerIndexes.insert(key, static_cast<int>(m_pendingPeers.size()));
+    m_pendingPeers.append({-1, event, QDateTime::currentSecsSinceEpoch(), address, 1});
+}
+
+qsizetype Logger::maxPendingPeerCount() const
+{
+    // there is no point in collecting more records than the log can keep
+    if (m_peerRecordRateLimit <= 0)
+        return MAX_LOG_MESSAGES;
+
+    const qsizetype maxRecordCount = (m_peerRecordRateLimit * m_peerAggregationInterval.count()) / 1000;
+    return std::clamp<qsizetype>(maxRecordCount, 1, MAX_LOG_MESSAGES);
+}
+
+void Logger::flushPendingPeers()
 {
     QWriteLocker locker(&m_lock);
-    const Log::Peer msg = {m_peerCounter++, blocked, QDateTime::currentSecsSinceEpoch(), ip, reason};
-    m_peers.push_back(msg);
+
+    QVector<Log::Peer> newPeers;
+    newPeers.reserve(m_pendingPeers.size());
+    for (PeerRecord &record : m_pendingPeers)
+    {
+        record.id = m_peerCounter++;
+        m_peers.push_back(record);
+        newPeers.append(toPeer(record));
+    }
+
+    const int droppedEventCount = m_droppedPeerEventCount;
+    m_droppedPeerEventCount = 0;
+    m_pendingPeers.clear();
+    m_pendingPeerIndexes.clear();
     locker.unlock();
 
-    emit newLogPeer(msg);
+    for (const Log::Peer &peer : asConst(newPeers))
+        emit newLogPeer(peer);
+
+    if (droppedEventCount > 0)
+    {
+        addMessage(tr("%1 peer events were not logged because the peer log rate limit was exceeded.")
+                   .arg(droppedEventCount), Log::WARNING);
+    }
+}
+
+Log::Peer Logger::toPeer(const PeerRecord &record)
+{
+    // the reasons keep the translation context they had when peers were logged by the session
+    QString reason;
+    switch (record.event)
+    {
+    case Log::PeerEvent::Banned:
+        break;
+    case Log::PeerEvent::BlockedByIPFilter:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "IP filter", "this peer was blocked. Reason: IP filter.");
+        break;
+    case Log::PeerEvent::BlockedByPortFilter:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "port filter", "this peer was blocked. Reason: port filter.");
+        break;
+    case Log::PeerEvent::BlockedByI2PMixedMode:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "%1 mixed mode restrictions", "this peer was blocked. Reason: I2P mixed mode restrictions.").arg(u"I2P"_qs); // don't translate I2P
+        break;
+    case Log::PeerEvent::BlockedByPrivilegedPort:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "use of privileged port", "this peer was blocked. Reason: use of privileged port.");
+        break;
+    case Log::PeerEvent::BlockedByUTPDisabled:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "%1 is disabled", "this peer was blocked. Reason: uTP is disabled.").arg(C_UTP); // don't translate μTP
+        break;
+    case Log::PeerEvent::BlockedByTCPDisabled:
+        reason = QCoreApplication::translate("BitTorrent::SessionImpl", "%1 is disabled", "this peer was blocked. Reason: TCP is disabled.").arg(u"TCP"_qs); // don't translate TCP
+        break;
+    }
+
+    const bool blocked = (record.event != Log::PeerEvent::Banned);
+    return {record.id, blocked, record.timestamp, record.address.toString(), reason, record.count};
 }
 
 QVector<Log::Msg> Logger::getMessages(const int lastKnownId) const
@@ -113,13 +241,42 @@ QVector<Log::Peer> Logger::getPeers(const int lastKnownId) const
     const int diff = m_peerCounter - lastKnownId - 1;
     const int size = static_cast<int>(m_peers.size());
 
-    if ((lastKnownId == -1) || (diff >= size))
-        return loadFromBuffer(m_peers);
+    int offset = 0;
+    if ((lastKnownId != -1) && (diff < size))
+    {
+        if (diff <= 0)
+            return {};
+        offset = size - diff;
+    }
 
-    if (diff <= 0)
-        return {};
+    QVector<Log::Peer> peers;
+    peers.reserve(size - offset);
+    std::transform((m_peers.begin() + offset), m_peers.end(), std::back_inserter(peers), &Logger::toPeer);
+    return peers;
+}
+
+std::chrono::milliseconds Logger::peerAggregationInterval() const
+{
+    const QReadLocker locker(&m_lock);
+    return m_peerAggregationInterval;
+}
+
+void Logger::setPeerAggregationInterval(const std::chrono::milliseconds interval)
+{
+    const QWriteLocker locker(&m_lock);
+    m_peerAggregationInterval = std::max<std::chrono::milliseconds>(interval, 100ms);
+}
 
-    return loadFromBuffer(m_peers, (size - diff));
+int Logger::peerRecordRateLimit() const
+{
+    const QReadLocker locker(&m_lock);
+    return m_peerRecordRateLimit;
+}
+
+void Logger::setPeerRecordRateLimit(const int limit)
+{
+    const QWriteLocker locker(&m_lock);
+    m_peerRecordRateLimit = std::max(0, limit);
 }
 
 void LogMsg(const QString &message, const Log::MsgType &type)
@@ -28,12 +28,17 @@
 
 #pragma once
 
+#include <array>
+#include <chrono>
+
 #include <boost/circular_buffer.hpp>
 
+#include <QHash>
 #include <QObject>
 #include <QReadWriteLock>
 #include <QString>
 #include <QtContainerFwd>
+#include <QVector>
 
 const int MAX_LOG_MESSAGES = 20000;
 
@@ -64,7 +69,41 @@ namespace Log
         qint64 timestamp;
         QString ip;
         QString reason;
+        int count; // number of aggregated events
+    };
+
+    enum class PeerEvent : quint8
+    {
+        Banned,
+        BlockedByIPFilter,
+        BlockedByPortFilter,
+        BlockedByI2PMixedMode,
+        BlockedByPrivilegedPort,
+        BlockedByUTPDisabled,
+        BlockedByTCPDisabled
+    };
+
+    // Raw address bytes in network byte order, IPv4 address occupies the first 4 bytes
+    struct PeerAddress
+    {
+        std::array<quint8, 16> bytes {};
+        bool isIPv6 = false;
+
+        QString toString() const;
+    };
+
+    struct PeerEventKey
+    {
+        PeerAddress address;
+        PeerEvent event;
     };
+
+    bool operator==(const PeerEventKey &left, const PeerEventKey &right);
+#if (QT_VERSION >= QT_VERSION_CHECK(6, 0, 0))
+    std::size_t qHash(const PeerEventKey &key, std::size_t seed = 0);
+#else
+    uint qHash(const PeerEventKey &key, uint seed = 0);
+#endif
 }
 
 Q_DECLARE_OPERATORS_FOR_FLAGS(Log::MsgTypes)
@@ -80,24 +119,53 @@ public:
     static Logger *instance();
 
     void addMessage(const QString &message, const Log::MsgType &type = Log::NORMAL);
-    void addPeer(const QString &ip, bool blocked, const QString &reason = {});
+    // Peer events are cheap to add: repeated events of the same peer are aggregated
+    // during aggregation interval and records are formatted only when they are read
+    void addPeer(const Log::PeerAddress &address, Log::PeerEvent event);
     QVector<Log::Msg> getMessages(int lastKnownId = -1) const;
     QVector<Log::Peer> getPeers(int lastKnownId = -1) const;
 
+    std::chrono::milliseconds peerAggregationInterval() const;
+    void setPeerAggregationInterval(std::chrono::milliseconds interval);
+    // Maximum number of peer records stored per second (0 means no limit).
+    // Records exceeding the limit are dropped and only their count is reported.
+    int peerRecordRateLimit() const;
+    void setPeerRecordRateLimit(int limit);
+
 signals:
     void newLogMessage(const Log::Msg &message);
     void newLogPeer(const Log::Peer &peer);
 
 private:
+    struct PeerRecord
+    {
+        int id;
+        Log::PeerEvent event;
+        qint64 timestamp;
+        Log::PeerAddress address;
+        int count;
+    };
+
     Logger();
     ~Logger() = default;
 
+    static Log::Peer toPeer(const PeerRecord &record);
+    qsizetype maxPendingPeerCount() const;
+    void flushPendingPeers();
+
     static Logger *m_instance;
     boost::circular_buffer_space_optimized<Log::Msg> m_messages;
-    boost::circular_buffer_space_optimized<Log::Peer> m_peers;
+    boost::circular_buffer_space_optimized<PeerRecord> m_peers;
     mutable QReadWriteLock m_lock;
     int m_msgCounter = 0;
     int m_peerCounter = 0;
+
+    // Peer events collected during current aggregation interval
+    QVector<PeerRecord> m_pendingPeers;
+    QHash<Log::PeerEventKey, int> m_pendingPeerIndexes;
+    int m_droppedPeerEventCount = 0;
+    std::chrono::milliseconds m_peerAggregationInterval;
+    int m_peerRecordRateLimit;
 };
 
 // Helper function
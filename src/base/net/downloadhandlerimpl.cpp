@@ -123,6 +123,18 @@ void DownloadHandlerImpl::processFinishedDownload()
         return;
     }
 
+    m_result.eTag = m_reply->rawHeader("ETag");
+    m_result.lastModified = m_reply->rawHeader("Last-Modified");
+
+    const int httpStatusCode = m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (httpStatusCode == 304)
+    {
+        // Conditional request matched, there is no content to process
+        m_result.status = Net::DownloadStatus::NotModified;
+        finish();
+        return;
+    }
+
     // Success
 #ifdef QT_NO_COMPRESS
     m_result.data = (m_reply->rawHeader("Content-Encoding") == "gzip")
@@ -123,6 +123,11 @@ namespace
 
         // Spoof HTTP Referer to allow adding torrent link from Torcache/KickAssTorrents
         request.setRawHeader("Referer", request.url().toEncoded().data());
+
+        if (!downloadRequest.ifNoneMatch().isEmpty())
+            request.setRawHeader("If-None-Match", downloadRequest.ifNoneMatch());
+        if (!downloadRequest.ifModifiedSince().isEmpty())
+            request.setRawHeader("If-Modified-Since", downloadRequest.ifModifiedSince());
 #ifdef QT_NO_COMPRESS
         // The macro "QT_NO_COMPRESS" defined in QT will disable the zlib related features
         // and reply data auto-decompression in QT will also be disabled. But we can support
@@ -363,6 +368,28 @@ Net::DownloadRequest &Net::DownloadRequest::destFileName(const Path &value)
     return *this;
 }
 
+QByteArray Net::DownloadRequest::ifNoneMatch() const
+{
+    return m_ifNoneMatch;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::ifNoneMatch(const QByteArray &value)
+{
+    m_ifNoneMatch = value;
+    return *this;
+}
+
+QByteArray Net::DownloadRequest::ifModifiedSince() const
+{
+    return m_ifModifiedSince;
+}
+
+Net::DownloadRequest &Net::DownloadRequest::ifModifiedSince(const QByteArray &value)
+{
+    m_ifModifiedSince = value;
+    return *this;
+}
+
 Net::ServiceID Net::ServiceID::fromURL(const QUrl &url)
 {
     return {url.host(), url.port(80)};
@@ -63,6 +63,7 @@ namespace Net
     enum class DownloadStatus
     {
         Success,
+        NotModified,
         RedirectedToMagnet,
         Failed
     };
@@ -91,12 +92,23 @@ namespace Net
         Path destFileName() const;
         DownloadRequest &destFileName(const Path &value);
 
+        // Cache validators of previously downloaded content. If any of them is set
+        // the request is made conditional and DownloadStatus::NotModified is reported
+        // (with no data) when the server confirms that the content hasn't changed.
+        QByteArray ifNoneMatch() const;
+        DownloadRequest &ifNoneMatch(const QByteArray &value);
+
+        QByteArray ifModifiedSince() const;
+        DownloadRequest &ifModifiedSince(const QByteArray &value);
+
     private:
         QString m_url;
         QString m_userAgent;
         qint64 m_limit = 0;
         bool m_saveToFile = false;
         Path m_destFileName;
+        QByteArray m_ifNoneMatch;
+        QByteArray m_ifModifiedSince;
     };
 
     struct DownloadResult
@@ -107,6 +119,8 @@ namespace Net
         QByteArray data;
         Path filePath;
         QString magnet;
+        QByteArray eTag;
+        QByteArray lastModified;
     };
 
     class DownloadHandler : public QObject
@@ -28,10 +28,13 @@
 
 #include "geoipdatabase.h"
 
+#include <algorithm>
+
 #include <QDateTime>
 #include <QDebug>
 #include <QFile>
 #include <QHostAddress>
+#include <QMutexLocker>
 #include <QVariant>
 
 #include "base/global.h"
@@ -40,6 +43,7 @@
 namespace
 {
     const qint32 MAX_FILE_SIZE = 67108864; // 64MB
+    const int MAX_LOOKUP_CACHE_SIZE = 16384;
     const quint32 MAX_METADATA_SIZE = 131072; // 128KB
     const char METADATA_BEGIN_MARK[] = "\xab\xcd\xefMaxMind.com";
     const char DATA_SECTION_SEPARATOR[16] = {0};
@@ -75,44 +79,52 @@ struct DataFieldDescriptor
     };
 };
 
-GeoIPDatabase::GeoIPDatabase(const quint32 size)
-    : m_size(size)
-    , m_data(new uchar[size])
+GeoIPDatabase::GeoIPDatabase(const uchar *data, const quint32 size)
+    : m_lookupCache(MAX_LOOKUP_CACHE_SIZE)
+    , m_size(size)
+    , m_data(data)
 {
 }
 
 GeoIPDatabase *GeoIPDatabase::load(const Path &filename, QString &error)
 {
-    QFile file {filename.data()};
-    if (file.size() > MAX_FILE_SIZE)
+    auto file = std::make_unique<QFile>(filename.data());
+    if (file->size() > MAX_FILE_SIZE)
     {
         error = tr("Unsupported database file size.");
         return nullptr;
     }
 
-    if (!file.open(QFile::ReadOnly))
+    if (!file->open(QFile::ReadOnly))
     {
-        error = file.errorString();
+        error = file->errorString();
         return nullptr;
     }
 
-    auto *db = new GeoIPDatabase(file.size());
-
-    if (file.read(reinterpret_cast<char *>(db->m_data), db->m_size) != db->m_size)
+    // Map the file rather than reading it so that only the pages touched by lookups get loaded
+    const qint64 fileSize = file->size();
+    if (const uchar *data = file->map(0, fileSize))
     {
-        error = file.errorString();
-        delete db;
-        return nullptr;
-    }
+        auto *db = new GeoIPDatabase(data, fileSize);
+        db->m_file = std::move(file);
+        if (!db->parseMetadata(db->readMetadata(), error) || !db->loadDB(error))
+        {
+            delete db;
+            return nullptr;
+        }
 
+        return db;
+    }
 
-    if (!db->parseMetadata(db->readMetadata(), error) || !db->loadDB(error))
+    // Mapping isn't supported everywhere, fall back to reading the whole file
+    const QByteArray data = file->readAll();
+    if (data.size() != fileSize)
     {
-        delete db;
+        error = file->errorString();
         return nullptr;
     }
 
-    return db;
+    return load(data, error);
 }
 
 GeoIPDatabase *GeoIPDatabase::load(const QByteArray &data, QString &error)
@@ -123,9 +135,9 @@ GeoIPDatabase *GeoIPDatabase::load(const QByteArray &data, QString &error)
         return nullptr;
     }
 
-    auto *db = new GeoIPDatabase(data.size());
-
-    memcpy(reinterpret_cast<char *>(db->m_data), data.constData(), db->m_size);
+    // Share the buffer with the caller instead of copying it
+    auto *db = new GeoIPDatabase(reinterpret_cast<const uchar *>(data.constData()), data.size());
+    db->m_buffer = data;
 
     if (!db->parseMetadata(db->readMetadata(), error) || !db->loadDB(error))
     {
@@ -136,10 +148,7 @@ GeoIPDatabase *GeoIPDatabase::load(const QByteArray &data, QString &error)
     return db;
 }
 
-GeoIPDatabase::~GeoIPDatabase()
-{
-    delete [] m_data;
-}
+GeoIPDatabase::~GeoIPDatabase() = default;
 
 QString GeoIPDatabase::type() const
 {
@@ -158,50 +167,76 @@ QDateTime GeoIPDatabase::buildEpoch() const
 
 QString GeoIPDatabase::lookup(const QHostAddress &hostAddr) const
 {
-    Q_IPV6ADDR addr = hostAddr.toIPv6Address();
+    // IPv4 addresses are converted to IPv4-mapped IPv6 addresses (::ffff:a.b.c.d)
+    const Q_IPV6ADDR addr = hostAddr.toIPv6Address();
+
+    QPair<quint64, quint64> cacheKey;
+    memcpy(&cacheKey.first, &addr.c[0], sizeof(cacheKey.first));
+    memcpy(&cacheKey.second, &addr.c[8], sizeof(cacheKey.second));
+    {
+        const QMutexLocker locker {&m_cacheMutex};
+        if (const QString *country = m_lookupCache.object(cacheKey))
+            return *country;
+    }
+
+    const bool isIPv4 = std::all_of(&addr.c[0], &addr.c[10], [](const quint8 byte) { return byte == 0; })
+        && (addr[10] == 0xFF) && (addr[11] == 0xFF);
+    // IPv4 addresses only need to walk the last 32 bits starting from the IPv4 subtree
+    const quint32 record = isIPv4
+        ? findRecord(addr, m_ipv4StartNode, 96)
+        : findRecord(addr, 0, 0);
+
+    const QMutexLocker locker {&m_cacheMutex};
+    const QString country = countryFromRecord(record);
+    m_lookupCache.insert(cacheKey, new QString(country));
+    return country;
+}
+
+quint32 GeoIPDatabase::readRecord(const quint32 node, const bool right) const
+{
+    const uchar *ptr = m_data + (node * m_nodeSize);
+    // Interpret the left/right record as number
+    if (right)
+        ptr += m_recordBytes;
+
+    quint32 id = 0;
+    auto *idPtr = reinterpret_cast<uchar *>(&id);
+    memcpy(&idPtr[4 - m_recordBytes], ptr, m_recordBytes);
+    fromBigEndian(idPtr, 4);
+    return id;
+}
+
+quint32 GeoIPDatabase::findRecord(const Q_IPV6ADDR &addr, quint32 node, const int startBit) const
+{
+    for (int bit = startBit; (bit < 128) && (node < m_nodeCount); ++bit)
+    {
+        const bool right = static_cast<bool>((addr[bit / 8] >> (7 - (bit % 8))) & 1);
+        node = readRecord(node, right);
+    }
+
+    return node;
+}
 
-    const uchar *ptr = m_data;
+QString GeoIPDatabase::countryFromRecord(const quint32 record) const
+{
+    // Records equal to node count mean "no data", records less than it are tree nodes
+    if (record <= m_nodeCount)
+        return {};
 
-    for (int i = 0; i < 16; ++i)
+    QString country = m_countries.value(record);
+    if (country.isEmpty())
     {
-        for (int j = 0; j < 8; ++j)
+        const quint32 offset = record - m_nodeCount - sizeof(DATA_SECTION_SEPARATOR);
+        quint32 tmp = offset + m_indexSize + sizeof(DATA_SECTION_SEPARATOR);
+        const QVariant val = readDataField(tmp);
+        if (val.userType() == QMetaType::QVariantHash)
         {
-            const bool right = static_cast<bool>((addr[i] >> (7 - j)) & 1);
-            // Interpret the left/right record as number
-            if (right)
-                ptr += m_recordBytes;
-
-            quint32 id = 0;
-            auto *idPtr = reinterpret_cast<uchar *>(&id);
-            memcpy(&idPtr[4 - m_recordBytes], ptr, m_recordBytes);
-            fromBigEndian(idPtr, 4);
-
-            if (id == m_nodeCount)
-            {
-                return {};
-            }
-            if (id > m_nodeCount)
-            {
-                QString country = m_countries.value(id);
-                if (country.isEmpty())
-                {
-                    const quint32 offset = id - m_nodeCount - sizeof(DATA_SECTION_SEPARATOR);
-                    quint32 tmp = offset + m_indexSize + sizeof(DATA_SECTION_SEPARATOR);
-                    const QVariant val = readDataField(tmp);
-                    if (val.userType() == QMetaType::QVariantHash)
-                    {
-                        country = val.toHash()[u"country"_qs].toHash()[u"iso_code"_qs].toString();
-                        m_countries[id] = country;
-                    }
-                }
-                return country;
-            }
-
-            ptr = m_data + (id * m_nodeSize);
+            country = val.toHash()[u"country"_qs].toHash()[u"iso_code"_qs].toString();
+            m_countries[record] = country;
         }
     }
 
-    return {};
+    return country;
 }
 
 #define CHECK_METADATA_REQ(key, type) \
@@ -277,7 +312,7 @@ bool GeoIPDatabase::parseMetadata(const QVariantHash &metadata, QString &error)
     return true;
 }
 
-bool GeoIPDatabase::loadDB(QString &error) const
+bool GeoIPDatabase::loadDB(QString &error)
 {
     qDebug() << "Parsing IP geolocation database index tree...";
 
@@ -290,6 +325,11 @@ bool GeoIPDatabase::loadDB(QString &error) const
         return false;
     }
 
+    // IPv4 addresses are stored in the subtree at ::/96, find its root once
+    m_ipv4StartNode = 0;
+    for (int i = 0; (i < 96) && (m_ipv4StartNode < m_nodeCount); ++i)
+        m_ipv4StartNode = readRecord(m_ipv4StartNode, false);
+
     return true;
 }
 
@@ -28,15 +28,21 @@
 
 #pragma once
 
+#include <memory>
+
 #include <QtGlobal>
+#include <QByteArray>
+#include <QCache>
 #include <QCoreApplication>
 #include <QDateTime>
 #include <QHash>
+#include <QMutex>
+#include <QPair>
 #include <QVariant>
 
 #include "base/pathfwd.h"
 
-class QByteArray;
+class QFile;
 class QHostAddress;
 class QString;
 
@@ -59,12 +65,16 @@ public:
     QString lookup(const QHostAddress &hostAddr) const;
 
 private:
-    explicit GeoIPDatabase(quint32 size);
+    GeoIPDatabase(const uchar *data, quint32 size);
 
     bool parseMetadata(const QVariantHash &metadata, QString &error);
-    bool loadDB(QString &error) const;
+    bool loadDB(QString &error);
     QVariantHash readMetadata() const;
 
+    quint32 readRecord(quint32 node, bool right) const;
+    quint32 findRecord(const Q_IPV6ADDR &addr, quint32 node, int startBit) const;
+    QString countryFromRecord(quint32 record) const;
+
     QVariant readDataField(quint32 &offset) const;
     bool readDataFieldDescriptor(quint32 &offset, DataFieldDescriptor &out) const;
     void fromBigEndian(uchar *buf, quint32 len) const;
@@ -83,7 +93,15 @@ private:
     QDateTime m_buildEpoch;
     QString m_dbType;
     // Search data
+    // lookup() can be called from several threads, so the caches below are guarded by m_cacheMutex
+    mutable QMutex m_cacheMutex;
     mutable QHash<quint32, QString> m_countries;
+    // Recently looked up addresses (as two halves of IPv6 address) and their countries
+    mutable QCache<QPair<quint64, quint64>, QString> m_lookupCache;
+    quint32 m_ipv4StartNode = 0;
     quint32 m_size = 0;
-    uchar *m_data = nullptr;
+    const uchar *m_data = nullptr;
+    // Owners of m_data
+    std::unique_ptr<QFile> m_file;
+    QByteArray m_buffer;
 };
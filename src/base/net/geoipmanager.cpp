@@ -102,6 +102,7 @@ void GeoIPManager::loadDatabase()
         LogMsg(tr("Couldn't load IP geolocation database. Reason: %1").arg(error), Log::WARNING);
     }
 
+    emit databaseChanged();
     manageDatabaseUpdate();
 }
 
@@ -418,6 +419,7 @@ void GeoIPManager::configure()
         {
             delete m_geoIPDatabase;
             m_geoIPDatabase = nullptr;
+            emit databaseChanged();
         }
     }
 }
@@ -449,6 +451,7 @@ void GeoIPManager::downloadFinished(const DownloadResult &result)
             LogMsg(tr("IP geolocation database loaded. Type: %1. Build time: %2.")
                 .arg(m_geoIPDatabase->type(), m_geoIPDatabase->buildEpoch().toString())
                    , Log::INFO);
+            emit databaseChanged();
             const Path targetPath = specialFolderLocation(SpecialFolder::Data) / Path(GEODB_FOLDER);
             if (!targetPath.exists())
                 Utils::Fs::mkpath(targetPath);
@@ -54,6 +54,9 @@ namespace Net
 
         static QString CountryName(const QString &countryISOCode);
 
+    signals:
+        void databaseChanged();
+
     private slots:
         void configure();
         void downloadFinished(const DownloadResult &result);
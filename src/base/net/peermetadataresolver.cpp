@@ -0,0 +1,223 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "peermetadataresolver.h"
+
+#include <QHostInfo>
+#include <QTimer>
+
+#include "base/global.h"
+#include "base/preferences.h"
+#include "geoipmanager.h"
+
+namespace
+{
+    const int CACHE_SIZE = 8192;
+    const int MAX_CONCURRENT_LOOKUPS = 32;
+    const int NOTIFY_INTERVAL = 200; // ms
+
+    bool isUsefulHostName(const QString &hostname, const QHostAddress &ip)
+    {
+        return (!hostname.isEmpty() && (hostname != ip.toString()));
+    }
+}
+
+using namespace Net;
+
+PeerMetadataResolver *PeerMetadataResolver::m_instance = nullptr;
+
+PeerMetadataResolver::PeerMetadataResolver()
+    : m_cache(CACHE_SIZE)
+    , m_lookupTimer {new QTimer(this)}
+    , m_notifyTimer {new QTimer(this)}
+{
+    // lookups requested during the same event loop iteration are started together
+    m_lookupTimer->setSingleShot(true);
+    connect(m_lookupTimer, &QTimer::timeout, this, &PeerMetadataResolver::startLookups);
+
+    m_notifyTimer->setSingleShot(true);
+    m_notifyTimer->setInterval(NOTIFY_INTERVAL);
+    connect(m_notifyTimer, &QTimer::timeout, this, &PeerMetadataResolver::notifyResolved);
+
+    configure();
+    connect(Preferences::instance(), &Preferences::changed, this, &PeerMetadataResolver::configure);
+
+    if (const auto *geoIPManager = GeoIPManager::instance())
+    {
+        // cached countries are refreshed lazily when they're requested next time
+        connect(geoIPManager, &GeoIPManager::databaseChanged, this, [this]() { ++m_countryRevision; });
+    }
+}
+
+PeerMetadataResolver::~PeerMetadataResolver()
+{
+    // abort on-going lookups instead of waiting them
+    abortLookups();
+}
+
+void PeerMetadataResolver::initInstance()
+{
+    if (!m_instance)
+        m_instance = new PeerMetadataResolver;
+}
+
+void PeerMetadataResolver::freeInstance()
+{
+    delete m_instance;
+    m_instance = nullptr;
+}
+
+PeerMetadataResolver *PeerMetadataResolver::instance()
+{
+    return m_instance;
+}
+
+PeerMetadata PeerMetadataResolver::metadata(const QHostAddress &ip)
+{
+    const Entry *entry = cachedEntry(ip);
+    if (!m_resolveHostNames)
+        return {entry->countryCode, entry->countryName, {}};
+
+    if (!entry->isHostNameResolved && !m_pendingIPs.contains(ip))
+    {
+        m_pendingIPs.insert(ip);
+        m_queuedLookups.append(ip);
+        if (!m_lookupTimer->isActive())
+            m_lookupTimer->start();
+    }
+
+    return {entry->countryCode, entry->countryName, entry->hostName};
+}
+
+PeerMetadata PeerMetadataResolver::countryMetadata(const QHostAddress &ip)
+{
+    const Entry *entry = cachedEntry(ip);
+    return {entry->countryCode, entry->countryName, {}};
+}
+
+PeerMetadataResolver::Entry *PeerMetadataResolver::cachedEntry(const QHostAddress &ip)
+{
+    Entry *entry = m_cache.object(ip);
+    if (!entry)
+    {
+        entry = new Entry;
+        m_cache.insert(ip, entry);
+    }
+
+    if (entry->countryRevision != m_countryRevision)
+        updateCountry(ip, entry);
+
+    return entry;
+}
+
+void PeerMetadataResolver::configure()
+{
+    const bool resolveHostNames = Preferences::instance()->resolvePeerHostNames();
+    if (resolveHostNames == m_resolveHostNames)
+        return;
+
+    m_resolveHostNames = resolveHostNames;
+    if (!m_resolveHostNames)
+    {
+        abortLookups();
+        m_notifyTimer->stop();
+        m_resolvedHostNames.clear();
+    }
+}
+
+void PeerMetadataResolver::startLookups()
+{
+    while (!m_queuedLookups.isEmpty() && (m_lookups.size() < MAX_CONCURRENT_LOOKUPS))
+    {
+        // do reverse lookup: IP -> hostname
+        const QHostAddress ip = m_queuedLookups.takeFirst();
+        const int lookupId = QHostInfo::lookupHost(ip.toString(), this, &PeerMetadataResolver::hostResolved);
+        m_lookups.insert(lookupId, ip);
+    }
+}
+
+void PeerMetadataResolver::hostResolved(const QHostInfo &host)
+{
+    const auto lookupIter = m_lookups.find(host.lookupId());
+    if (lookupIter == m_lookups.end())
+        return;
+
+    const QHostAddress ip = lookupIter.value();
+    m_lookups.erase(lookupIter);
+    m_pendingIPs.remove(ip);
+
+    // failed lookups are cached as well so they aren't retried until the entry gets evicted
+    const QString hostName = ((host.error() == QHostInfo::NoError) && isUsefulHostName(host.hostName(), ip))
+        ? host.hostName()
+        : QString();
+
+    Entry *entry = m_cache.object(ip);
+    if (!entry)
+    {
+        entry = new Entry;
+        updateCountry(ip, entry);
+        m_cache.insert(ip, entry);
+    }
+    entry->hostName = hostName;
+    entry->isHostNameResolved = true;
+
+    if (!hostName.isEmpty())
+    {
+        m_resolvedHostNames[ip] = hostName;
+        if (!m_notifyTimer->isActive())
+            m_notifyTimer->start();
+    }
+
+    startLookups();
+}
+
+void PeerMetadataResolver::notifyResolved()
+{
+    const QHash<QHostAddress, QString> hostNames = m_resolvedHostNames;
+    m_resolvedHostNames.clear();
+    emit hostNamesResolved(hostNames);
+}
+
+void PeerMetadataResolver::updateCountry(const QHostAddress &ip, Entry *entry) const
+{
+    const auto *geoIPManager = GeoIPManager::instance();
+    entry->countryCode = geoIPManager ? geoIPManager->lookup(ip) : QString();
+    entry->countryName = !entry->countryCode.isEmpty() ? GeoIPManager::CountryName(entry->countryCode) : QString();
+    entry->countryRevision = m_countryRevision;
+}
+
+void PeerMetadataResolver::abortLookups()
+{
+    for (auto iter = m_lookups.cbegin(); iter != m_lookups.cend(); ++iter)
+        QHostInfo::abortHostLookup(iter.key());
+
+    m_lookups.clear();
+    m_queuedLookups.clear();
+    m_pendingIPs.clear();
+    m_lookupTimer->stop();
+}
@@ -0,0 +1,108 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QCache>
+#include <QHash>
+#include <QHostAddress>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+
+class QHostInfo;
+class QTimer;
+
+namespace Net
+{
+    struct PeerMetadata
+    {
+        QString countryCode;
+        QString countryName;
+        QString hostName;
+    };
+
+    // Resolves and caches metadata of peer addresses (country, host name)
+    // so it can be shared by all the peer views instead of resolving it for each of them
+    class PeerMetadataResolver final : public QObject
+    {
+        Q_OBJECT
+        Q_DISABLE_COPY_MOVE(PeerMetadataResolver)
+
+    public:
+        static void initInstance();
+        static void freeInstance();
+        static PeerMetadataResolver *instance();
+
+        // Returns currently known metadata, missing host name is resolved asynchronously
+        PeerMetadata metadata(const QHostAddress &ip);
+        // Returns country only, host name lookup isn't started
+        PeerMetadata countryMetadata(const QHostAddress &ip);
+
+    signals:
+        void hostNamesResolved(const QHash<QHostAddress, QString> &hostNames);
+
+    private slots:
+        void configure();
+        void startLookups();
+        void hostResolved(const QHostInfo &host);
+        void notifyResolved();
+
+    private:
+        struct Entry
+        {
+            QString countryCode;
+            QString countryName;
+            QString hostName;
+            quint64 countryRevision = 0;
+            bool isHostNameResolved = false;
+        };
+
+        PeerMetadataResolver();
+        ~PeerMetadataResolver() override;
+
+        Entry *cachedEntry(const QHostAddress &ip);
+        void updateCountry(const QHostAddress &ip, Entry *entry) const;
+        void abortLookups();
+
+        static PeerMetadataResolver *m_instance;
+
+        bool m_resolveHostNames = false;
+        quint64 m_countryRevision = 1;
+        QCache<QHostAddress, Entry> m_cache;
+
+        QList<QHostAddress> m_queuedLookups;
+        QSet<QHostAddress> m_pendingIPs;  // queued or running lookups
+        QHash<int, QHostAddress> m_lookups;  // <LookupID, IP>
+        QTimer *m_lookupTimer = nullptr;
+
+        QHash<QHostAddress, QString> m_resolvedHostNames;
+        QTimer *m_notifyTimer = nullptr;
+    };
+}
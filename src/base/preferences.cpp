@@ -30,6 +30,7 @@
 #include "preferences.h"
 
 #include <chrono>
+#include <memory>
 
 #ifdef Q_OS_MACOS
 #include <CoreServices/CoreServices.h>
@@ -84,7 +85,10 @@ namespace
 
 Preferences *Preferences::m_instance = nullptr;
 
-Preferences::Preferences() = default;
+Preferences::Preferences()
+{
+    updateSnapshot();
+}
 
 Preferences *Preferences::instance()
 {
@@ -635,22 +639,24 @@ void Preferences::setWebUIPassword(const QByteArray &password)
 
 int Preferences::getWebUIMaxAuthFailCount() const
 {
-    return value<int>(u"Preferences/WebUI/MaxAuthenticationFailCount"_qs, 5);
+    return snapshot()->webUIMaxAuthFailCount;
 }
 
 void Preferences::setWebUIMaxAuthFailCount(const int count)
 {
     setValue(u"Preferences/WebUI/MaxAuthenticationFailCount"_qs, count);
+    updateSnapshot();
 }
 
 std::chrono::seconds Preferences::getWebUIBanDuration() const
 {
-    return std::chrono::seconds(value<int>(u"Preferences/WebUI/BanDuration"_qs, 3600));
+    return snapshot()->webUIBanDuration;
 }
 
 void Preferences::setWebUIBanDuration(const std::chrono::seconds duration)
 {
     setValue(u"Preferences/WebUI/BanDuration"_qs, static_cast<int>(duration.count()));
+    updateSnapshot();
 }
 
 int Preferences::getWebUISessionTimeout() const
@@ -916,6 +922,47 @@ void Preferences::setAutoRunConsoleEnabled(const bool enabled)
 }
 #endif
 
+int Preferences::getAutoRunMaxConcurrentPrograms() const
+{
+    return value(u"AutoRun/MaxConcurrentPrograms"_qs, 4);
+}
+
+void Preferences::setAutoRunMaxConcurrentPrograms(const int count)
+{
+    setValue(u"AutoRun/MaxConcurrentPrograms"_qs, count);
+}
+
+int Preferences::getAutoRunTimeout() const
+{
+    // 0 means there is no timeout
+    return value(u"AutoRun/Timeout"_qs, 0);
+}
+
+void Preferences::setAutoRunTimeout(const int seconds)
+{
+    setValue(u"AutoRun/Timeout"_qs, seconds);
+}
+
+bool Preferences::isAutoRunBatchingEnabled() const
+{
+    return value(u"AutoRun/BatchingEnabled"_qs, false);
+}
+
+void Preferences::setAutoRunBatchingEnabled(const bool enabled)
+{
+    setValue(u"AutoRun/BatchingEnabled"_qs, enabled);
+}
+
+Path Preferences::getTorrentEventStreamPath() const
+{
+    return value<Path>(u"AutoRun/EventStreamPath"_qs);
+}
+
+void Preferences::setTorrentEventStreamPath(const Path &path)
+{
+    setValue(u"AutoRun/EventStreamPath"_qs, path);
+}
+
 bool Preferences::shutdownWhenDownloadsComplete() const
 {
     return value(u"Preferences/Downloads/AutoShutDownOnCompletion"_qs, false);
@@ -968,32 +1015,35 @@ void Preferences::setDontConfirmAutoExit(const bool dontConfirmAutoExit)
 
 bool Preferences::recheckTorrentsOnCompletion() const
 {
-    return value(u"Preferences/Advanced/RecheckOnCompletion"_qs, false);
+    return snapshot()->recheckTorrentsOnCompletion;
 }
 
 void Preferences::recheckTorrentsOnCompletion(const bool recheck)
 {
     setValue(u"Preferences/Advanced/RecheckOnCompletion"_qs, recheck);
+    updateSnapshot();
 }
 
 bool Preferences::resolvePeerCountries() const
 {
-    return value(u"Preferences/Connection/ResolvePeerCountries"_qs, true);
+    return snapshot()->resolvePeerCountries;
 }
 
 void Preferences::resolvePeerCountries(const bool resolve)
 {
     setValue(u"Preferences/Connection/ResolvePeerCountries"_qs, resolve);
+    updateSnapshot();
 }
 
 bool Preferences::resolvePeerHostNames() const
 {
-    return value(u"Preferences/Connection/ResolvePeerHostNames"_qs, false);
+    return snapshot()->resolvePeerHostNames;
 }
 
 void Preferences::resolvePeerHostNames(const bool resolve)
 {
     setValue(u"Preferences/Connection/ResolvePeerHostNames"_qs, resolve);
+    updateSnapshot();
 }
 
 #if (defined(Q_OS_UNIX) && !defined(Q_OS_MACOS))
@@ -1650,6 +1700,37 @@ void Preferences::setSpeedWidgetGraphEnable(const int id, const bool enable)
     setValue(u"SpeedWidget/graph_enable_%1"_qs.arg(id), enable);
 }
 
+std::shared_ptr<const Preferences::Snapshot> Preferences::snapshot() const
+{
+    return std::atomic_load(&m_snapshot);
+}
+
+void Preferences::updateSnapshot()
+{
+    // values are read under the lock too, otherwise concurrent updates could publish outdated ones
+    const QMutexLocker locker {&m_snapshotMutex};
+
+    auto newSnapshot = std::make_shared<Snapshot>();
+    newSnapshot->recheckTorrentsOnCompletion = value(u"Preferences/Advanced/RecheckOnCompletion"_qs, false);
+    newSnapshot->resolvePeerCountries = value(u"Preferences/Connection/ResolvePeerCountries"_qs, true);
+    newSnapshot->resolvePeerHostNames = value(u"Preferences/Connection/ResolvePeerHostNames"_qs, false);
+    newSnapshot->webUIMaxAuthFailCount = value<int>(u"Preferences/WebUI/MaxAuthenticationFailCount"_qs, 5);
+    newSnapshot->webUIBanDuration = std::chrono::seconds(value<int>(u"Preferences/WebUI/BanDuration"_qs, 3600));
+
+    const std::shared_ptr<const Snapshot> currentSnapshot = std::atomic_load(&m_snapshot);
+    if (currentSnapshot
+        && (currentSnapshot->recheckTorrentsOnCompletion == newSnapshot->recheckTorrentsOnCompletion)
+        && (currentSnapshot->resolvePeerCountries == newSnapshot->resolvePeerCountries)
+        && (currentSnapshot->resolvePeerHostNames == newSnapshot->resolvePeerHostNames)
+        && (currentSnapshot->webUIMaxAuthFailCount == newSnapshot->webUIMaxAuthFailCount)
+        && (currentSnapshot->webUIBanDuration == newSnapshot->webUIBanDuration))
+    {
+        return;
+    }
+
+    std::atomic_store(&m_snapshot, std::shared_ptr<const Snapshot>(std::move(newSnapshot)));
+}
+
 void Preferences::apply()
 {
     if (SettingsStorage::instance()->save())
@@ -29,8 +29,12 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+
 #include <QtContainerFwd>
 #include <QtGlobal>
+#include <QMutex>
 #include <QObject>
 
 #include "base/pathfwd.h"
@@ -264,6 +268,14 @@ public:
     bool isAutoRunConsoleEnabled() const;
     void setAutoRunConsoleEnabled(bool enabled);
 #endif
+    int getAutoRunMaxConcurrentPrograms() const;
+    void setAutoRunMaxConcurrentPrograms(int count);
+    int getAutoRunTimeout() const;
+    void setAutoRunTimeout(int seconds);
+    bool isAutoRunBatchingEnabled() const;
+    void setAutoRunBatchingEnabled(bool enabled);
+    Path getTorrentEventStreamPath() const;
+    void setTorrentEventStreamPath(const Path &path);
 
     bool shutdownWhenDownloadsComplete() const;
     void setShutdownWhenDownloadsComplete(bool shutdown);
@@ -417,5 +429,26 @@ signals:
     void changed();
 
 private:
+    // Immutable copy of frequently read values. It is replaced as a whole when any of them is changed,
+    // so readers on any thread get consistent values without locking and looking up the storage.
+    struct Snapshot
+    {
+        bool recheckTorrentsOnCompletion = false;
+        bool resolvePeerCountries = false;
+        bool resolvePeerHostNames = false;
+        int webUIMaxAuthFailCount = 0;
+        std::chrono::seconds webUIBanDuration {0};
+    };
+
+    std::shared_ptr<const Snapshot> snapshot() const;
+    void updateSnapshot();
+
     static Preferences *m_instance;
+
+    // Accessed only via std::atomic_load()/std::atomic_store(). They aren't lock-free
+    // (standard libraries guard shared_ptr by a mutex from a small pool) but the lock
+    // is held only while the pointer is copied, not while the values are read.
+    // A replaced snapshot is freed once the last reader that still uses it releases it.
+    std::shared_ptr<const Snapshot> m_snapshot;
+    QMutex m_snapshotMutex;
 };
@@ -35,57 +35,452 @@
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QThread>
 #include <QVector>
 
+#include "base/exceptions.h"
+#include "base/global.h"
 #include "base/logger.h"
-#include "base/path.h"
-#include "base/utils/io.h"
-#include "rss_article.h"
+#include "base/utils/fs.h"
 
-const int ARTICLEDATALIST_TYPEID = qRegisterMetaType<QVector<QVariantHash>>();
+const int ARTICLEDATALIST_TYPEID = qRegisterMetaType<QVector<RSS::ArticleData>>();
+const int ARTICLEDATAHASH_TYPEID = qRegisterMetaType<QHash<QString, RSS::ArticleData>>();
 
-void RSS::Private::FeedSerializer::load(const Path &dataFileName, const QString &url)
+namespace
 {
-    QFile file {dataFileName.data()};
+    const QString DB_CONNECTION_NAME = u"RSSArticleStorage"_qs;
 
-    if (!file.exists())
+    const QString DB_TABLE_ARTICLES = u"articles"_qs;
+    const QString DB_INDEX_FEED_DATE = u"articles_feed_date"_qs;
+
+    struct Column
+    {
+        QString name;
+        QString placeholder;
+    };
+
+    Column makeColumn(const char *columnName)
+    {
+        return {QString::fromLatin1(columnName), (u':' + QString::fromLatin1(columnName))};
+    }
+
+    const Column DB_COLUMN_ID = makeColumn("id");
+    const Column DB_COLUMN_FEED_UID = makeColumn("feed_uid");
+    const Column DB_COLUMN_GUID = makeColumn("guid");
+    const Column DB_COLUMN_DATE = makeColumn("date");
+    const Column DB_COLUMN_TITLE = makeColumn("title");
+    const Column DB_COLUMN_AUTHOR = makeColumn("author");
+    const Column DB_COLUMN_LINK = makeColumn("link");
+    const Column DB_COLUMN_TORRENT_URL = makeColumn("torrent_url");
+    const Column DB_COLUMN_IS_READ = makeColumn("is_read");
+    const Column DB_COLUMN_DESCRIPTION = makeColumn("description");
+    const Column DB_COLUMN_EXTRA_DATA = makeColumn("extra_data");
+    const Column DB_COLUMN_LIMIT = makeColumn("limit");
+
+    QString quoted(const QString &name)
+    {
+        const QChar quote = u'`';
+
+        return (quote + name + quote);
+    }
+
+    QString makeColumnDefinition(const Column &column, const char *definition)
+    {
+        return u"%1 %2"_qs.arg(quoted(column.name), QString::fromLatin1(definition));
+    }
+
+    QString joinColumnNames(const QVector<Column> &columns)
+    {
+        QStringList names;
+        names.reserve(columns.size());
+        for (const Column &column : columns)
+            names.append(quoted(column.name));
+        return names.join(u',');
+    }
+
+    // Every thread uses its own connection
+    QString threadConnectionName()
+    {
+        return u"%1-%2"_qs.arg(DB_CONNECTION_NAME
+                , QString::number(reinterpret_cast<quintptr>(QThread::currentThread()), 16));
+    }
+
+    void createTables(QSqlDatabase &db)
+    {
+        const QStringList tableArticlesItems = {
+            makeColumnDefinition(DB_COLUMN_ID, "INTEGER PRIMARY KEY"),
+            makeColumnDefinition(DB_COLUMN_FEED_UID, "TEXT NOT NULL"),
+            makeColumnDefinition(DB_COLUMN_GUID, "TEXT NOT NULL"),
+            makeColumnDefinition(DB_COLUMN_DATE, "INTEGER NOT NULL"),
+            makeColumnDefinition(DB_COLUMN_TITLE, "TEXT"),
+            makeColumnDefinition(DB_COLUMN_AUTHOR, "TEXT"),
+            makeColumnDefinition(DB_COLUMN_LINK, "TEXT"),
+            makeColumnDefinition(DB_COLUMN_TORRENT_URL, "TEXT"),
+            makeColumnDefinition(DB_COLUMN_IS_READ, "INTEGER NOT NULL DEFAULT 0"),
+            makeColumnDefinition(DB_COLUMN_DESCRIPTION, "TEXT"),
+            makeColumnDefinition(DB_COLUMN_EXTRA_DATA, "BLOB"),
+            u"UNIQUE (%1)"_qs.arg(joinColumnNames({DB_COLUMN_FEED_UID, DB_COLUMN_GUID}))
+        };
+
+        QSqlQuery query {db};
+
+        // Allow reading articles while they are being written by the other connection
+        if (!query.exec(u"PRAGMA journal_mode = WAL;"_qs))
+            throw RuntimeError(query.lastError().text());
+
+        const auto createTableArticlesQuery = u"CREATE TABLE IF NOT EXISTS %1 (%2);"_qs
+                .arg(quoted(DB_TABLE_ARTICLES), tableArticlesItems.join(u','));
+        if (!query.exec(createTableArticlesQuery))
+            throw RuntimeError(query.lastError().text());
+
+        const auto createIndexQuery = u"CREATE INDEX IF NOT EXISTS %1 ON %2 (%3);"_qs
+                .arg(quoted(DB_INDEX_FEED_DATE), quoted(DB_TABLE_ARTICLES)
+                     , joinColumnNames({DB_COLUMN_FEED_UID, DB_COLUMN_DATE}));
+        if (!query.exec(createIndexQuery))
+            throw RuntimeError(query.lastError().text());
+    }
+
+    QSqlDatabase openDatabase(const Path &dbPath)
+    {
+        const QString connectionName = threadConnectionName();
+        auto db = QSqlDatabase::contains(connectionName)
+                ? QSqlDatabase::database(connectionName, false)
+                : QSqlDatabase::addDatabase(u"QSQLITE"_qs, connectionName);
+        if (db.isOpen())
+            return db;
+
+        db.setDatabaseName(dbPath.data());
+        db.setConnectOptions(u"QSQLITE_BUSY_TIMEOUT=5000"_qs);
+        if (!db.open())
+            throw RuntimeError(db.lastError().text());
+
+        try
+        {
+            createTables(db);
+        }
+        catch (const RuntimeError &)
+        {
+            db.close();
+            throw;
+        }
+
+        return db;
+    }
+
+    QByteArray serializeExtraData(const QVariantHash &extraData)
     {
-        emit loadingFinished({});
+        if (extraData.isEmpty())
+            return {};
+
+        return QJsonDocument(QJsonObject::fromVariantHash(extraData)).toJson(QJsonDocument::Compact);
     }
-    else if (file.open(QFile::ReadOnly))
+
+    QVariantHash deserializeExtraData(const QByteArray &data)
+    {
+        if (data.isEmpty())
+            return {};
+
+        return QJsonDocument::fromJson(data).object().toVariantHash();
+    }
+
+    RSS::ArticleData parseArticleBody(const QSqlQuery &query)
     {
-        emit loadingFinished(loadArticles(file.readAll(), url));
-        file.close();
+        RSS::ArticleData article;
+        article.description = query.value(DB_COLUMN_DESCRIPTION.name).toString();
+        article.extraData = deserializeExtraData(query.value(DB_COLUMN_EXTRA_DATA.name).toByteArray());
+        return article;
+    }
+
+    void storeArticles(QSqlDatabase &db, const QString &feedUID, const QVector<RSS::ArticleData> &articles)
+    {
+        const QVector<Column> columns {
+            DB_COLUMN_FEED_UID, DB_COLUMN_GUID, DB_COLUMN_DATE, DB_COLUMN_TITLE, DB_COLUMN_AUTHOR
+            , DB_COLUMN_LINK, DB_COLUMN_TORRENT_URL, DB_COLUMN_IS_READ, DB_COLUMN_DESCRIPTION, DB_COLUMN_EXTRA_DATA
+        };
+        QStringList placeholders;
+        placeholders.reserve(columns.size());
+        for (const Column &column : columns)
+            placeholders.append(column.placeholder);
+
+        const auto insertArticleStatement = u"INSERT OR IGNORE INTO %1 (%2) VALUES (%3);"_qs
+                .arg(quoted(DB_TABLE_ARTICLES), joinColumnNames(columns), placeholders.join(u','));
+
+        if (!db.transaction())
+            throw RuntimeError(db.lastError().text());
+
+        try
+        {
+            QSqlQuery query {db};
+            if (!query.prepare(insertArticleStatement))
+                throw RuntimeError(query.lastError().text());
+
+            for (const RSS::ArticleData &article : articles)
+            {
+                query.bindValue(DB_COLUMN_FEED_UID.placeholder, feedUID);
+                query.bindValue(DB_COLUMN_GUID.placeholder, article.guid);
+                query.bindValue(DB_COLUMN_DATE.placeholder, article.date.toMSecsSinceEpoch());
+                query.bindValue(DB_COLUMN_TITLE.placeholder, article.title);
+                query.bindValue(DB_COLUMN_AUTHOR.placeholder, article.author);
+                query.bindValue(DB_COLUMN_LINK.placeholder, article.link);
+                query.bindValue(DB_COLUMN_TORRENT_URL.placeholder, article.torrentURL);
+                query.bindValue(DB_COLUMN_IS_READ.placeholder, article.isRead);
+                query.bindValue(DB_COLUMN_DESCRIPTION.placeholder, article.description);
+                query.bindValue(DB_COLUMN_EXTRA_DATA.placeholder, serializeExtraData(article.extraData));
+
+                if (!query.exec())
+                    throw RuntimeError(query.lastError().text());
+            }
+
+            if (!db.commit())
+                throw RuntimeError(db.lastError().text());
+        }
+        catch (const RuntimeError &)
+        {
+            db.rollback();
+            throw;
+        }
     }
-    else
+
+    void execForEachArticle(QSqlDatabase &db, const QString &statement, const QString &feedUID, const QStringList &articleGUIDs)
     {
-        LogMsg(tr("Couldn't read RSS Session data from %1. Error: %2")
-               .arg(dataFileName.toString(), file.errorString())
+        if (!db.transaction())
+            throw RuntimeError(db.lastError().text());
+
+        try
+        {
+            QSqlQuery query {db};
+            if (!query.prepare(statement))
+                throw RuntimeError(query.lastError().text());
+
+            for (const QString &guid : articleGUIDs)
+            {
+                query.bindValue(DB_COLUMN_FEED_UID.placeholder, feedUID);
+                query.bindValue(DB_COLUMN_GUID.placeholder, guid);
+                if (!query.exec())
+                    throw RuntimeError(query.lastError().text());
+            }
+
+            if (!db.commit())
+                throw RuntimeError(db.lastError().text());
+        }
+        catch (const RuntimeError &)
+        {
+            db.rollback();
+            throw;
+        }
+    }
+}
+
+RSS::Private::FeedSerializer::FeedSerializer(const Path &dbPath, const QUuid &feedUID, QObject *parent)
+    : QObject(parent)
+    , m_dbPath {dbPath}
+    , m_feedUID {feedUID.toString()}
+{
+}
+
+void RSS::Private::FeedSerializer::load(const Path &legacyDataFileName, const QString &url, const int maxArticles)
+{
+    QVector<ArticleData> articles;
+
+    try
+    {
+        if (legacyDataFileName.exists())
+            importLegacyData(legacyDataFileName, url);
+
+        auto db = openDatabase(m_dbPath);
+        QSqlQuery query {db};
+
+        // Remove the articles that are out of limit (e.g. if it was decreased since the last run)
+        const auto removeOutOfLimitStatement = u"DELETE FROM %1 WHERE %2 IN (SELECT %2 FROM %1 WHERE %3 = %4 ORDER BY %5 DESC LIMIT -1 OFFSET %6);"_qs
+                .arg(quoted(DB_TABLE_ARTICLES), quoted(DB_COLUMN_ID.name), quoted(DB_COLUMN_FEED_UID.name)
+                     , DB_COLUMN_FEED_UID.placeholder, quoted(DB_COLUMN_DATE.name), DB_COLUMN_LIMIT.placeholder);
+        if (!query.prepare(removeOutOfLimitStatement))
+            throw RuntimeError(query.lastError().text());
+
+        query.bindValue(DB_COLUMN_FEED_UID.placeholder, m_feedUID);
+        query.bindValue(DB_COLUMN_LIMIT.placeholder, maxArticles);
+        if (!query.exec())
+            throw RuntimeError(query.lastError().text());
+
+        // Article bodies are loaded on demand
+        const auto selectArticlesStatement = u"SELECT %1 FROM %2 WHERE %3 = %4 ORDER BY %5 DESC;"_qs
+                .arg(joinColumnNames({DB_COLUMN_GUID, DB_COLUMN_DATE, DB_COLUMN_TITLE, DB_COLUMN_AUTHOR
+                                      , DB_COLUMN_LINK, DB_COLUMN_TORRENT_URL, DB_COLUMN_IS_READ})
+                     , quoted(DB_TABLE_ARTICLES), quoted(DB_COLUMN_FEED_UID.name), DB_COLUMN_FEED_UID.placeholder
+                     , quoted(DB_COLUMN_DATE.name));
+        if (!query.prepare(selectArticlesStatement))
+            throw RuntimeError(query.lastError().text());
+
+        query.bindValue(DB_COLUMN_FEED_UID.placeholder, m_feedUID);
+        if (!query.exec())
+            throw RuntimeError(query.lastError().text());
+
+        while (query.next())
+        {
+            ArticleData article;
+            article.guid = query.value(0).toString();
+            article.date = QDateTime::fromMSecsSinceEpoch(query.value(1).toLongLong());
+            article.title = query.value(2).toString();
+            article.author = query.value(3).toString();
+            article.link = query.value(4).toString();
+            article.torrentURL = query.value(5).toString();
+            article.isRead = query.value(6).toBool();
+            articles.append(article);
+        }
+    }
+    catch (const RuntimeError &err)
+    {
+        LogMsg(tr("Couldn't load RSS articles of feed '%1'. Error: %2").arg(url, err.message())
                , Log::WARNING);
     }
+
+    emit loadingFinished(articles);
 }
 
-void RSS::Private::FeedSerializer::store(const Path &dataFileName, const QVector<QVariantHash> &articlesData)
+void RSS::Private::FeedSerializer::addArticles(const QVector<ArticleData> &articles)
 {
-    QJsonArray arr;
-    for (const QVariantHash &data : articlesData)
+    try
+    {
+        auto db = openDatabase(m_dbPath);
+        storeArticles(db, m_feedUID, articles);
+    }
+    catch (const RuntimeError &err)
     {
-        auto jsonObj = QJsonObject::fromVariantHash(data);
-        // JSON object doesn't support DateTime so we need to convert it
-        jsonObj[Article::KeyDate] = data[Article::KeyDate].toDateTime().toString(Qt::RFC2822Date);
+        LogMsg(tr("Couldn't store RSS articles. Error: %1").arg(err.message()), Log::WARNING);
+    }
+}
+
+void RSS::Private::FeedSerializer::markAsRead(const QStringList &articleGUIDs)
+{
+    const auto updateStatement = u"UPDATE %1 SET %2 = 1 WHERE %3 = %4 AND %5 = %6;"_qs
+            .arg(quoted(DB_TABLE_ARTICLES), quoted(DB_COLUMN_IS_READ.name)
+                 , quoted(DB_COLUMN_FEED_UID.name), DB_COLUMN_FEED_UID.placeholder
+                 , quoted(DB_COLUMN_GUID.name), DB_COLUMN_GUID.placeholder);
 
-        arr << jsonObj;
+    try
+    {
+        auto db = openDatabase(m_dbPath);
+        execForEachArticle(db, updateStatement, m_feedUID, articleGUIDs);
+    }
+    catch (const RuntimeError &err)
+    {
+        LogMsg(tr("Couldn't store RSS articles. Error: %1").arg(err.message()), Log::WARNING);
     }
+}
 
-    const nonstd::expected<void, QString> result = Utils::IO::saveToFile(dataFileName, QJsonDocument(arr).toJson());
-    if (!result)
+void RSS::Private::FeedSerializer::removeArticles(const QStringList &articleGUIDs)
+{
+    const auto deleteStatement = u"DELETE FROM %1 WHERE %2 = %3 AND %4 = %5;"_qs
+            .arg(quoted(DB_TABLE_ARTICLES), quoted(DB_COLUMN_FEED_UID.name), DB_COLUMN_FEED_UID.placeholder
+                 , quoted(DB_COLUMN_GUID.name), DB_COLUMN_GUID.placeholder);
+
+    try
+    {
+        auto db = openDatabase(m_dbPath);
+        execForEachArticle(db, deleteStatement, m_feedUID, articleGUIDs);
+    }
+    catch (const RuntimeError &err)
     {
-       LogMsg(tr("Failed to save RSS feed in '%1', Reason: %2").arg(dataFileName.toString(), result.error())
-              , Log::WARNING);
+        LogMsg(tr("Couldn't store RSS articles. Error: %1").arg(err.message()), Log::WARNING);
     }
 }
 
-QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArray &data, const QString &url)
+void RSS::Private::FeedSerializer::removeAll()
+{
+    const auto deleteStatement = u"DELETE FROM %1 WHERE %2 = %3;"_qs
+            .arg(quoted(DB_TABLE_ARTICLES), quoted(DB_COLUMN_FEED_UID.name), DB_COLUMN_FEED_UID.placeholder);
+
+    try
+    {
+        auto db = openDatabase(m_dbPath);
+        QSqlQuery query {db};
+        if (!query.prepare(deleteStatement))
+            throw RuntimeError(query.lastError().text());
+
+        query.bindValue(DB_COLUMN_FEED_UID.placeholder, m_feedUID);
+        if (!query.exec())
+            throw RuntimeError(query.lastError().text());
+    }
+    catch (const RuntimeError &err)
+    {
+        LogMsg(tr("Couldn't remove RSS articles. Error: %1").arg(err.message()), Log::WARNING);
+    }
+}
+
+void RSS::Private::FeedSerializer::loadArticleBodies(const QStringList &articleGUIDs)
+{
+    const auto selectStatement = u"SELECT %1 FROM %2 WHERE %3 = %4 AND %5 = %6;"_qs
+            .arg(joinColumnNames({DB_COLUMN_DESCRIPTION, DB_COLUMN_EXTRA_DATA}), quoted(DB_TABLE_ARTICLES)
+                 , quoted(DB_COLUMN_FEED_UID.name), DB_COLUMN_FEED_UID.placeholder
+                 , quoted(DB_COLUMN_GUID.name), DB_COLUMN_GUID.placeholder);
+
+    QHash<QString, ArticleData> bodies;
+    bodies.reserve(articleGUIDs.size());
+    try
+    {
+        auto db = openDatabase(m_dbPath);
+        QSqlQuery query {db};
+        if (!query.prepare(selectStatement))
+            throw RuntimeError(query.lastError().text());
+
+        for (const QString &guid : articleGUIDs)
+        {
+            query.bindValue(DB_COLUMN_FEED_UID.placeholder, m_feedUID);
+            query.bindValue(DB_COLUMN_GUID.placeholder, guid);
+            if (!query.exec())
+                throw RuntimeError(query.lastError().text());
+
+            bodies.insert(guid, (query.next() ? parseArticleBody(query) : ArticleData()));
+        }
+    }
+    catch (const RuntimeError &err)
+    {
+        LogMsg(tr("Couldn't load RSS articles. Error: %1").arg(err.message()), Log::WARNING);
+        // don't let the articles wait for the bodies forever
+        for (const QString &guid : articleGUIDs)
+            bodies.insert(guid, {});
+    }
+
+    emit articleBodiesLoaded(bodies);
+}
+
+void RSS::Private::FeedSerializer::closeDatabase()
+{
+    const QString connectionName = threadConnectionName();
+    if (!QSqlDatabase::contains(connectionName))
+        return;
+
+    QSqlDatabase::database(connectionName, false).close();
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
+void RSS::Private::FeedSerializer::importLegacyData(const Path &legacyDataFileName, const QString &url)
+{
+    QFile file {legacyDataFileName.data()};
+    if (!file.open(QFile::ReadOnly))
+        throw RuntimeError(file.errorString());
+
+    const std::optional<QVector<ArticleData>> articles = loadLegacyArticles(file.readAll(), url);
+    file.close();
+
+    // Keep the legacy data file so it can be recovered manually
+    if (!articles)
+    {
+        LogMsg(tr("Couldn't import RSS articles of feed '%1'. Legacy data file is kept: '%2'")
+               .arg(url, legacyDataFileName.toString()), Log::WARNING);
+        return;
+    }
+
+    auto db = openDatabase(m_dbPath);
+    storeArticles(db, m_feedUID, *articles);
+
+    Utils::Fs::removeFile(legacyDataFileName);
+}
+
+std::optional<QVector<RSS::ArticleData>> RSS::Private::FeedSerializer::loadLegacyArticles(const QByteArray &data, const QString &url) const
 {
     QJsonParseError jsonError;
     const QJsonDocument jsonDoc = QJsonDocument::fromJson(data, &jsonError);
@@ -93,16 +488,16 @@ QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArra
     {
         LogMsg(tr("Couldn't parse RSS Session data. Error: %1").arg(jsonError.errorString())
                , Log::WARNING);
-        return {};
+        return std::nullopt;
     }
 
     if (!jsonDoc.isArray())
     {
         LogMsg(tr("Couldn't load RSS Session data. Invalid data format."), Log::WARNING);
-        return {};
+        return std::nullopt;
     }
 
-    QVector<QVariantHash> result;
+    QVector<ArticleData> result;
     const QJsonArray jsonArr = jsonDoc.array();
     result.reserve(jsonArr.size());
     for (int i = 0; i < jsonArr.size(); ++i)
@@ -121,13 +516,8 @@ QVector<QVariantHash> RSS::Private::FeedSerializer::loadArticles(const QByteArra
         varHash[Article::KeyDate] =
                 QDateTime::fromString(jsonObj.value(Article::KeyDate).toString(), Qt::RFC2822Date);
 
-        result.push_back(varHash);
+        result.push_back(ArticleData::fromVariantHash(varHash));
     }
 
-    std::sort(result.begin(), result.end(), [](const QVariantHash &left, const QVariantHash &right)
-    {
-        return (left.value(Article::KeyDate).toDateTime() > right.value(Article::KeyDate).toDateTime());
-    });
-
     return result;
 }
@@ -31,30 +31,52 @@
 
 #pragma once
 
+#include <optional>
+
 #include <QtContainerFwd>
+#include <QHash>
 #include <QObject>
 #include <QString>
-#include <QVariantHash>
+#include <QUuid>
 
-#include "base/pathfwd.h"
+#include "base/path.h"
+#include "rss_article.h"
 
 namespace RSS::Private
 {
+    // Articles of all the feeds are kept in the single SQLite database so that
+    // adding an article or changing its "read" flag doesn't rewrite the whole feed.
+    // Every feed has its own serializer living in the RSS working thread.
     class FeedSerializer final : public QObject
     {
         Q_OBJECT
         Q_DISABLE_COPY_MOVE(FeedSerializer)
 
     public:
-        using QObject::QObject;
+        FeedSerializer(const Path &dbPath, const QUuid &feedUID, QObject *parent = nullptr);
+
+        // Loads articles without their bodies. Articles from the legacy data file
+        // (if it exists) are imported to the database before.
+        void load(const Path &legacyDataFileName, const QString &url, int maxArticles);
+        void addArticles(const QVector<ArticleData> &articles);
+        void markAsRead(const QStringList &articleGUIDs);
+        void removeArticles(const QStringList &articleGUIDs);
+        void removeAll();
+        // Reports the bodies of the articles by articleBodiesLoaded().
+        // Articles that aren't stored (yet) get empty body.
+        void loadArticleBodies(const QStringList &articleGUIDs);
 
-        void load(const Path &dataFileName, const QString &url);
-        void store(const Path &dataFileName, const QVector<QVariantHash> &articlesData);
+        static void closeDatabase();
 
     signals:
-        void loadingFinished(const QVector<QVariantHash> &articles);
+        void loadingFinished(const QVector<RSS::ArticleData> &articles);
+        void articleBodiesLoaded(const QHash<QString, RSS::ArticleData> &bodies);
 
     private:
-        QVector<QVariantHash> loadArticles(const QByteArray &data, const QString &url);
+        void importLegacyData(const Path &legacyDataFileName, const QString &url);
+        std::optional<QVector<ArticleData>> loadLegacyArticles(const QByteArray &data, const QString &url) const;
+
+        const Path m_dbPath;
+        const QString m_feedUID;
     };
 }
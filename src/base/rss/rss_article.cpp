@@ -46,72 +46,116 @@ const QString Article::KeyTorrentURL = u"torrentURL"_qs;
 const QString Article::KeyLink = u"link"_qs;
 const QString Article::KeyIsRead = u"isRead"_qs;
 
-Article::Article(Feed *feed, const QVariantHash &varHash)
+ArticleData ArticleData::fromVariantHash(QVariantHash varHash)
+{
+    ArticleData data;
+    data.guid = varHash.take(Article::KeyId).toString();
+    data.date = varHash.take(Article::KeyDate).toDateTime();
+    data.title = varHash.take(Article::KeyTitle).toString();
+    data.author = varHash.take(Article::KeyAuthor).toString();
+    data.link = varHash.take(Article::KeyLink).toString();
+    data.torrentURL = varHash.take(Article::KeyTorrentURL).toString();
+    data.isRead = varHash.take(Article::KeyIsRead).toBool();
+    data.description = varHash.take(Article::KeyDescription).toString();
+    // keep the data of unknown elements
+    data.extraData = varHash;
+    return data;
+}
+
+QVariantHash ArticleData::toVariantHash() const
+{
+    QVariantHash varHash = extraData;
+    varHash[Article::KeyId] = guid;
+    varHash[Article::KeyDate] = date;
+    varHash[Article::KeyTitle] = title;
+    varHash[Article::KeyAuthor] = author;
+    varHash[Article::KeyLink] = link;
+    varHash[Article::KeyTorrentURL] = torrentURL;
+    varHash[Article::KeyIsRead] = isRead;
+    varHash[Article::KeyDescription] = description;
+    return varHash;
+}
+
+Article::Article(Feed *feed, const ArticleData &data, const bool isBodyLoaded)
     : QObject(feed)
     , m_feed(feed)
-    , m_guid(varHash.value(KeyId).toString())
-    , m_date(varHash.value(KeyDate).toDateTime())
-    , m_title(varHash.value(KeyTitle).toString())
-    , m_author(varHash.value(KeyAuthor).toString())
-    , m_description(varHash.value(KeyDescription).toString())
-    , m_torrentURL(varHash.value(KeyTorrentURL).toString())
-    , m_link(varHash.value(KeyLink).toString())
-    , m_isRead(varHash.value(KeyIsRead, false).toBool())
-    , m_data(varHash)
+    , m_data(data)
+    , m_isBodyLoaded(isBodyLoaded)
 {
 }
 
 QString Article::guid() const
 {
-    return m_guid;
+    return m_data.guid;
 }
 
 QDateTime Article::date() const
 {
-    return m_date;
+    return m_data.date;
 }
 
 QString Article::title() const
 {
-    return m_title;
+    return m_data.title;
 }
 
 QString Article::author() const
 {
-    return m_author;
+    return m_data.author;
 }
 
 QString Article::description() const
 {
-    return m_description;
+    return m_data.description;
 }
 
 QString Article::torrentUrl() const
 {
-    return (m_torrentURL.isEmpty() ? m_link : m_torrentURL);
+    return (m_data.torrentURL.isEmpty() ? m_data.link : m_data.torrentURL);
 }
 
 QString Article::link() const
 {
-    return m_link;
+    return m_data.link;
 }
 
 bool Article::isRead() const
 {
-    return m_isRead;
+    return m_data.isRead;
+}
+
+bool Article::isBodyLoaded() const
+{
+    return m_isBodyLoaded;
 }
 
 QVariantHash Article::data() const
 {
-    return m_data;
+    QVariantHash varHash = m_data.toVariantHash();
+    if (!m_isBodyLoaded)
+        varHash.remove(KeyDescription);
+    return varHash;
+}
+
+void Article::loadBody()
+{
+    if (!m_isBodyLoaded)
+        m_feed->requestArticleBodies({m_data.guid});
+}
+
+void Article::setBody(const ArticleData &body)
+{
+    m_data.description = body.description;
+    m_data.extraData = body.extraData;
+    m_isBodyLoaded = true;
+    emit bodyLoaded(this);
 }
 
 void Article::markAsRead()
 {
-    if (!m_isRead)
+    if (!m_data.isRead)
     {
-        m_isRead = true;
-        m_data[KeyIsRead] = m_isRead;
+        m_data.isRead = true;
         emit read(this);
     }
 }
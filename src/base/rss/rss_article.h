@@ -39,6 +39,25 @@ namespace RSS
 {
     class Feed;
 
+    struct ArticleData
+    {
+        QString guid;
+        QDateTime date;
+        QString title;
+        QString author;
+        QString link;
+        QString torrentURL;
+        bool isRead = false;
+
+        // Article body. It isn't kept in memory for the articles loaded
+        // from the storage until it is requested.
+        QString description;
+        QVariantHash extraData;
+
+        static ArticleData fromVariantHash(QVariantHash varHash);
+        QVariantHash toVariantHash() const;
+    };
+
     class Article final : public QObject
     {
         Q_OBJECT
@@ -46,7 +65,7 @@ namespace RSS
 
         friend class Feed;
 
-        Article(Feed *feed, const QVariantHash &varHash);
+        Article(Feed *feed, const ArticleData &data, bool isBodyLoaded);
 
     public:
         static const QString KeyId;
@@ -63,29 +82,34 @@ namespace RSS
         QDateTime date() const;
         QString title() const;
         QString author() const;
+        // Empty until the body is loaded
         QString description() const;
         QString torrentUrl() const;
         QString link() const;
         bool isRead() const;
+        bool isBodyLoaded() const;
+        // Article body is included only if it is loaded
         QVariantHash data() const;
 
+        // Loads the body asynchronously, bodyLoaded() is emitted when it is done
+        void loadBody();
         void markAsRead();
 
         static bool articleDateRecentThan(const Article *article, const QDateTime &date);
 
     signals:
         void read(Article *article = nullptr);
+        void bodyLoaded(Article *article = nullptr);
 
     private:
+        void setBody(const ArticleData &body);
+
         Feed *m_feed = nullptr;
-        QString m_guid;
-        QDateTime m_date;
-        QString m_title;
-        QString m_author;
-        QString m_description;
-        QString m_torrentURL;
-        QString m_link;
-        bool m_isRead = false;
-        QVariantHash m_data;
+        ArticleData m_data;
+        bool m_isBodyLoaded = false;
+        // revision of RSS session the article was added or changed at
+        qint64 m_revision = 0;
     };
 }
+
+Q_DECLARE_METATYPE(RSS::ArticleData)
@@ -207,6 +207,7 @@ bool AutoDownloader::renameRule(const QString &ruleName, const QString &newRuleN
     AutoDownloadRule rule = m_rules.take(ruleName);
     rule.setName(newRuleName);
     m_rules.insert(newRuleName, rule);
+    m_isRuleMatcherOutdated = true;
     m_dirty = true;
     store();
     emit ruleRenamed(newRuleName, ruleName);
@@ -219,6 +220,7 @@ void AutoDownloader::removeRule(const QString &ruleName)
     {
         emit ruleAboutToBeRemoved(ruleName);
         m_rules.remove(ruleName);
+        m_isRuleMatcherOutdated = true;
         m_dirty = true;
         store();
     }
@@ -364,6 +366,7 @@ void AutoDownloader::handleNewArticle(const Article *article)
 void AutoDownloader::setRule_impl(const AutoDownloadRule &rule)
 {
     m_rules.insert(rule.name(), rule);
+    m_isRuleMatcherOutdated = true;
 }
 
 void AutoDownloader::addJobForArticle(const Article *article)
@@ -381,10 +384,20 @@ void AutoDownloader::addJobForArticle(const Article *article)
 
 void AutoDownloader::processJob(const QSharedPointer<ProcessingJob> &job)
 {
-    for (AutoDownloadRule &rule : m_rules)
+    if (m_isRuleMatcherOutdated)
     {
-        if (!rule.isEnabled()) continue;
-        if (!rule.feedURLs().contains(job->feedURL)) continue;
+        m_ruleMatcher = AutoDownloadRuleMatcher(m_rules.values());
+        m_isRuleMatcherOutdated = false;
+    }
+
+    const QString articleTitle = job->articleData.value(Article::KeyTitle).toString();
+    const QStringList candidateRules = m_ruleMatcher.candidateRules(job->feedURL, articleTitle);
+    for (const QString &ruleName : candidateRules)
+    {
+        const auto ruleIter = m_rules.find(ruleName);
+        if (ruleIter == m_rules.end()) continue;
+
+        AutoDownloadRule &rule = ruleIter.value();
         if (!rule.accepts(job->articleData)) continue;
 
         m_dirty = true;
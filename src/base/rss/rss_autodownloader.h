@@ -39,6 +39,7 @@
 #include "base/exceptions.h"
 #include "base/settingvalue.h"
 #include "base/utils/thread.h"
+#include "rss_autodownloadrulematcher.h"
 
 class QThread;
 class QTimer;
@@ -141,6 +142,8 @@ namespace RSS
         Utils::Thread::UniquePtr m_ioThread;
         AsyncFileStorage *m_fileStorage = nullptr;
         QHash<QString, AutoDownloadRule> m_rules;
+        AutoDownloadRuleMatcher m_ruleMatcher;
+        bool m_isRuleMatcherOutdated = true;
         QList<QSharedPointer<ProcessingJob>> m_processingQueue;
         QHash<QString, QSharedPointer<ProcessingJob>> m_waitingJobs;
         bool m_dirty = false;
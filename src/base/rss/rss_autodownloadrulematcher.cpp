@@ -0,0 +1,256 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "rss_autodownloadrulematcher.h"
+
+#include <algorithm>
+#include <queue>
+
+#include <QRegularExpression>
+
+#include "base/global.h"
+#include "rss_autodownloadrule.h"
+
+namespace
+{
+    // Returns the longest part of wildcard that has to be literally present in matching text
+    QString longestWildcardLiteral(const QString &wildcard)
+    {
+        QString longestLiteral;
+        QString literal;
+        const auto commitLiteral = [&longestLiteral, &literal]()
+        {
+            if (literal.size() > longestLiteral.size())
+                longestLiteral = literal;
+            literal.clear();
+        };
+
+        for (const QChar c : wildcard)
+        {
+            if (c == u'[')
+            {
+                // character sets aren't handled, so stop at the first one
+                break;
+            }
+
+            if ((c == u'*') || (c == u'?') || (c == u'\\'))
+                commitLiteral();
+            else
+                literal.append(c);
+        }
+        commitLiteral();
+
+        return longestLiteral;
+    }
+
+    bool isLiteralRegex(const QString &pattern)
+    {
+        const QString metaCharacters = u"\\^$.|?*+()[]{}"_qs;
+        return std::none_of(pattern.cbegin(), pattern.cend(), [&metaCharacters](const QChar c)
+        {
+            return metaCharacters.contains(c);
+        });
+    }
+
+    // Returns the literal that has to be present in text matched by expression
+    // or empty string if there is no such literal
+    QString requiredLiteral(const QString &expression, const bool isRegex)
+    {
+        if (isRegex)
+            return isLiteralRegex(expression) ? expression : QString();
+
+        // Non-regex expression matches only if all of its wildcards match
+        const QRegularExpression whitespace {u"\\s+"_qs};
+        QString longestLiteral;
+        for (const QString &wildcard : asConst(expression.split(whitespace, Qt::SkipEmptyParts)))
+        {
+            const QString literal = longestWildcardLiteral(wildcard);
+            if (literal.size() > longestLiteral.size())
+                longestLiteral = literal;
+        }
+
+        return longestLiteral;
+    }
+}
+
+using namespace RSS;
+
+AutoDownloadRuleMatcher::AutoDownloadRuleMatcher(const QList<AutoDownloadRule> &rules)
+{
+    QList<AutoDownloadRule> enabledRules;
+    enabledRules.reserve(rules.size());
+    for (const AutoDownloadRule &rule : rules)
+    {
+        if (rule.isEnabled())
+            enabledRules.append(rule);
+    }
+
+    std::sort(enabledRules.begin(), enabledRules.end(), [](const AutoDownloadRule &left, const AutoDownloadRule &right)
+    {
+        return (left.name() < right.name());
+    });
+
+    m_ruleNames.reserve(enabledRules.size());
+    for (int ruleIndex = 0; ruleIndex < enabledRules.size(); ++ruleIndex)
+    {
+        const AutoDownloadRule &rule = enabledRules[ruleIndex];
+        m_ruleNames.append(rule.name());
+
+        // Rule can match only if some of its "must contain" expressions matches,
+        // so it is enough to find the literal required by any of them
+        const QString mustContain = rule.mustContain();
+        const QStringList expressions = rule.useRegex() ? QStringList {mustContain} : mustContain.split(u'|');
+        bool isUnconditional = mustContain.isEmpty();
+        QStringList literals;
+        for (const QString &expression : expressions)
+        {
+            if (isUnconditional)
+                break;
+
+            const QString literal = requiredLiteral(expression, rule.useRegex()).toCaseFolded();
+            if (literal.isEmpty())
+                isUnconditional = true;
+            else
+                literals.append(literal);
+        }
+
+        for (const QString &feedURL : asConst(rule.feedURLs()))
+        {
+            FeedIndex &feedIndex = m_feedIndexes[feedURL];
+            if (isUnconditional)
+            {
+                feedIndex.unconditionalRules.append(ruleIndex);
+            }
+            else
+            {
+                for (const QString &literal : asConst(literals))
+                    feedIndex.literalMatcher.addLiteral(literal, ruleIndex);
+            }
+        }
+    }
+
+    for (FeedIndex &feedIndex : m_feedIndexes)
+        feedIndex.literalMatcher.build();
+}
+
+QStringList AutoDownloadRuleMatcher::candidateRules(const QString &feedURL, const QString &articleTitle) const
+{
+    const auto feedIndexIter = m_feedIndexes.constFind(feedURL);
+    if (feedIndexIter == m_feedIndexes.cend())
+        return {};
+
+    std::vector<bool> matchedRules(static_cast<std::size_t>(m_ruleNames.size()), false);
+    for (const int ruleIndex : asConst(feedIndexIter->unconditionalRules))
+        matchedRules[ruleIndex] = true;
+    feedIndexIter->literalMatcher.findRules(articleTitle.toCaseFolded(), matchedRules);
+
+    QStringList ruleNames;
+    for (int ruleIndex = 0; ruleIndex < m_ruleNames.size(); ++ruleIndex)
+    {
+        if (matchedRules[ruleIndex])
+            ruleNames.append(m_ruleNames[ruleIndex]);
+    }
+
+    return ruleNames;
+}
+
+void AutoDownloadRuleMatcher::LiteralMatcher::addLiteral(const QString &literal, const int ruleIndex)
+{
+    int state = 0;
+    for (const QChar c : literal)
+    {
+        const auto iter = m_nodes[state].transitions.constFind(c);
+        if (iter != m_nodes[state].transitions.cend())
+        {
+            state = iter.value();
+            continue;
+        }
+
+        m_nodes.emplace_back();
+        const auto newState = static_cast<int>(m_nodes.size() - 1);
+        m_nodes[state].transitions.insert(c, newState);
+        state = newState;
+    }
+
+    m_nodes[state].rules.append(ruleIndex);
+}
+
+void AutoDownloadRuleMatcher::LiteralMatcher::build()
+{
+    // Compute failure links breadth-first, so the failure node is always
+    // processed before and its rules can be merged into current node
+    std::queue<int> queue;
+    for (const int child : asConst(m_nodes[0].transitions))
+        queue.push(child);
+
+    while (!queue.empty())
+    {
+        const int state = queue.front();
+        queue.pop();
+
+        for (auto iter = m_nodes[state].transitions.cbegin(); iter != m_nodes[state].transitions.cend(); ++iter)
+        {
+            const QChar c = iter.key();
+            const int child = iter.value();
+
+            int failure = m_nodes[state].failure;
+            while ((failure != 0) && !m_nodes[failure].transitions.contains(c))
+                failure = m_nodes[failure].failure;
+
+            m_nodes[child].failure = m_nodes[failure].transitions.value(c, 0);
+            m_nodes[child].rules += m_nodes[m_nodes[child].failure].rules;
+            queue.push(child);
+        }
+    }
+}
+
+void AutoDownloadRuleMatcher::LiteralMatcher::findRules(const QString &text, std::vector<bool> &matchedRules) const
+{
+    int state = 0;
+    for (const QChar c : text)
+    {
+        while (true)
+        {
+            const Node &node = m_nodes[state];
+            const auto iter = node.transitions.constFind(c);
+            if (iter != node.transitions.cend())
+            {
+                state = iter.value();
+                break;
+            }
+
+            if (state == 0)
+                break;
+
+            state = node.failure;
+        }
+
+        for (const int ruleIndex : m_nodes[state].rules)
+            matchedRules[ruleIndex] = true;
+    }
+}
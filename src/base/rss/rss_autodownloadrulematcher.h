@@ -0,0 +1,85 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace RSS
+{
+    class AutoDownloadRule;
+
+    // Preselects the rules that can match an article, so only a few of them need to be
+    // completely evaluated. The rules are indexed by affected feeds and the literal parts
+    // of their "must contain" expressions are searched for in article title all at once.
+    class AutoDownloadRuleMatcher
+    {
+    public:
+        AutoDownloadRuleMatcher() = default;
+        explicit AutoDownloadRuleMatcher(const QList<AutoDownloadRule> &rules);
+
+        // Returns the names (in alphabetical order) of enabled rules affecting given feed
+        // that could match the article. Rules that can't be prefiltered are always returned.
+        QStringList candidateRules(const QString &feedURL, const QString &articleTitle) const;
+
+    private:
+        // Aho-Corasick automaton over the literals required by the rules
+        class LiteralMatcher
+        {
+        public:
+            void addLiteral(const QString &literal, int ruleIndex);
+            void build();
+            void findRules(const QString &text, std::vector<bool> &matchedRules) const;
+
+        private:
+            struct Node
+            {
+                QHash<QChar, int> transitions;
+                int failure = 0;
+                QVector<int> rules;
+            };
+
+            std::vector<Node> m_nodes {Node()};
+        };
+
+        struct FeedIndex
+        {
+            LiteralMatcher literalMatcher;
+            QVector<int> unconditionalRules;
+        };
+
+        QStringList m_ruleNames;
+        QHash<QString, FeedIndex> m_feedIndexes;
+    };
+}
@@ -59,6 +59,17 @@ const QString KEY_LASTBUILDDATE = u"lastBuildDate"_qs;
 const QString KEY_ISLOADING = u"isLoading"_qs;
 const QString KEY_HASERROR = u"hasError"_qs;
 const QString KEY_ARTICLES = u"articles"_qs;
+const QString KEY_STATISTICS = u"statistics"_qs;
+const QString KEY_REMOVEDARTICLES = u"removedArticles"_qs;
+
+const QString ARTICLES_DB_FILE_NAME = u"articles.db"_qs;
+
+// The refresh interval of rarely updated feeds can grow up to this many base intervals
+const int MAX_REFRESH_INTERVAL_FACTOR = 8;
+// Number of the most recent articles used to estimate the publish cadence
+const int PUBLISH_CADENCE_SAMPLES = 10;
+// Removed articles are reported to the incremental requests only for a while
+const int MAX_TRACKED_REMOVED_ARTICLES = 1000;
 
 using namespace RSS;
 
@@ -69,21 +80,23 @@ Feed::Feed(const QUuid &uid, const QString &url, const QString &path, Session *s
     , m_url(url)
 {
     const auto uidHex = QString::fromLatin1(m_uid.toRfc4122().toHex());
-    m_dataFileName = Path(uidHex + u".json");
+    // Articles were stored in separate JSON file per feed before they were moved into the database
+    m_legacyDataFileName = Path(uidHex + u".json");
 
     // Move to new file naming scheme (since v4.1.2)
     const QString legacyFilename = Utils::Fs::toValidFileName(m_url, u"_"_qs) + u".json";
     const Path storageDir = m_session->dataFileStorage()->storageDir();
-    const Path dataFilePath = storageDir / m_dataFileName;
+    const Path dataFilePath = storageDir / m_legacyDataFileName;
     if (!dataFilePath.exists())
         Utils::Fs::renameFile((storageDir / Path(legacyFilename)), dataFilePath);
 
     m_iconPath = storageDir / Path(uidHex + u".ico");
 
-    m_serializer = new Private::FeedSerializer;
+    m_serializer = new Private::FeedSerializer((storageDir / Path(ARTICLES_DB_FILE_NAME)), m_uid);
     m_serializer->moveToThread(m_session->workingThread());
     connect(this, &Feed::destroyed, m_serializer, &Private::FeedSerializer::deleteLater);
     connect(m_serializer, &Private::FeedSerializer::loadingFinished, this, &Feed::handleArticleLoadFinished);
+    connect(m_serializer, &Private::FeedSerializer::articleBodiesLoaded, this, &Feed::handleArticleBodiesLoaded);
 
     m_parser = new Private::Parser(m_lastBuildDate);
     m_parser->moveToThread(m_session->workingThread());
@@ -91,6 +104,8 @@ Feed::Feed(const QUuid &uid, const QString &url, const QString &path, Session *s
     connect(m_parser, &Private::Parser::finished, this, &Feed::handleParsingFinished);
 
     connect(m_session, &Session::maxArticlesPerFeedChanged, this, &Feed::handleMaxArticlesPerFeedChanged);
+    connect(this, &Feed::titleChanged, this, &Feed::updateRevision);
+    connect(this, &Feed::stateChanged, this, &Feed::updateRevision);
 
     if (m_session->isProcessingEnabled())
         downloadIcon();
@@ -123,13 +138,14 @@ void Feed::markAsRead()
             article->disconnect(this);
             article->markAsRead();
             --m_unreadCount;
+            m_readArticleGUIDs.insert(article->guid());
+            updateArticleRevision(article);
             emit articleRead(article);
         }
     }
 
     if (m_unreadCount != oldUnreadCount)
     {
-        m_dirty = true;
         store();
         emit unreadCountChanged(this);
     }
@@ -143,19 +159,28 @@ void Feed::refresh()
         return;
     }
 
-    if (m_downloadHandler)
-        m_downloadHandler->cancel();
+    // The feed is already waiting for a download slot or being downloaded
+    if (m_isLoading)
+        return;
 
     // NOTE: Should we allow manually refreshing for disabled session?
 
-    m_downloadHandler = Net::DownloadManager::instance()->download(m_url);
+    m_lastRefreshTimer.start();
+    m_isLoading = true;
+    emit stateChanged(this);
+
+    m_session->scheduleFeedDownload(this);
+}
+
+void Feed::download()
+{
+    // Ask the server to send the feed only if it has changed since the last download
+    const auto request = Net::DownloadRequest(m_url).ifNoneMatch(m_eTag).ifModifiedSince(m_lastModified);
+    m_downloadHandler = Net::DownloadManager::instance()->download(request);
     connect(m_downloadHandler, &Net::DownloadHandler::finished, this, &Feed::handleDownloadFinished);
 
     if (!m_iconPath.exists())
         downloadIcon();
-
-    m_isLoading = true;
-    emit stateChanged(this);
 }
 
 QUuid Feed::uid() const
@@ -197,7 +222,7 @@ void Feed::handleMaxArticlesPerFeedChanged(const int n)
 {
     while (m_articlesByDate.size() > n)
         removeOldestArticle();
-    // We don't need store articles here
+    storeDeferred();
 }
 
 void Feed::handleIconDownloadFinished(const Net::DownloadResult &result)
@@ -216,9 +241,45 @@ bool Feed::hasError() const
 void Feed::handleDownloadFinished(const Net::DownloadResult &result)
 {
     m_downloadHandler = nullptr; // will be deleted by DownloadManager later
+    m_session->handleFeedDownloadFinished(this);
 
-    if (result.status == Net::DownloadStatus::Success)
+    ++m_statistics.refreshCount;
+
+    if (result.status == Net::DownloadStatus::NotModified)
     {
+        ++m_statistics.notModifiedCount;
+        m_statistics.savedBytes += m_contentSize;
+
+        LogMsg(tr("RSS feed at '%1' is not modified since last refresh.").arg(result.url));
+
+        m_isLoading = false;
+        updateRefreshInterval();
+        emit stateChanged(this);
+    }
+    else if (result.status == Net::DownloadStatus::Success)
+    {
+        m_eTag = result.eTag;
+        m_lastModified = result.lastModified;
+        m_statistics.downloadedBytes += result.data.size();
+
+        // Some servers don't support conditional requests so we
+        // avoid parsing the same content again at least
+        const std::size_t contentHash = qHash(result.data);
+        if ((result.data.size() == m_contentSize) && (contentHash == m_contentHash))
+        {
+            ++m_statistics.unchangedCount;
+
+            LogMsg(tr("RSS feed at '%1' is not modified since last refresh.").arg(result.url));
+
+            m_isLoading = false;
+            updateRefreshInterval();
+            emit stateChanged(this);
+            return;
+        }
+
+        m_contentSize = result.data.size();
+        m_contentHash = contentHash;
+
         LogMsg(tr("RSS feed at '%1' is successfully downloaded. Starting to parse it.")
                 .arg(result.url));
         // Parse the download RSS
@@ -232,9 +293,16 @@ void Feed::handleDownloadFinished(const Net::DownloadResult &result)
         m_isLoading = false;
         m_hasError = true;
 
+        // The state of the feed is unknown now, so the next refresh should be unconditional
+        m_eTag.clear();
+        m_lastModified.clear();
+        m_contentSize = 0;
+        m_contentHash = 0;
+
         LogMsg(tr("Failed to download RSS feed at '%1'. Reason: %2")
                .arg(result.url, result.errorString), Log::WARNING);
 
+        updateRefreshInterval();
         emit stateChanged(this);
     }
 }
@@ -243,17 +311,19 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
 {
     m_hasError = !result.error.isEmpty();
 
+    ++m_statistics.parseCount;
+    m_statistics.lastParseTime = result.elapsedTime;
+    m_statistics.totalParseTime += result.elapsedTime;
+
     if (!result.title.isEmpty() && (title() != result.title))
     {
         m_title = result.title;
-        m_dirty = true;
         emit titleChanged(this);
     }
 
     if (!result.lastBuildDate.isEmpty())
     {
         m_lastBuildDate = result.lastBuildDate;
-        m_dirty = true;
     }
 
     // For some reason, the RSS feed may contain malformed XML data and it may not be
@@ -272,39 +342,66 @@ void Feed::handleParsingFinished(const RSS::Private::ParsingResult &result)
            .arg(url(), QString::number(newArticlesCount)));
 
     m_isLoading = false;
+    updateRefreshInterval();
     emit stateChanged(this);
 }
 
 void Feed::load()
 {
     QMetaObject::invokeMethod(m_serializer
-            , [serializer = m_serializer, url = m_url
-                , path = (m_session->dataFileStorage()->storageDir() / m_dataFileName)]
+            , [serializer = m_serializer, url = m_url, maxArticles = m_session->maxArticlesPerFeed()
+                , legacyPath = (m_session->dataFileStorage()->storageDir() / m_legacyDataFileName)]
     {
-        serializer->load(path, url);
+        serializer->load(legacyPath, url, maxArticles);
     });
 }
 
 void Feed::store()
 {
-    if (!m_dirty)
-        return;
-
-    m_dirty = false;
     m_savingTimer.stop();
 
-    QVector<QVariantHash> articlesData;
-    articlesData.reserve(m_articles.size());
+    // Articles that are added and removed before they are stored don't need to be stored at all
+    const QSet<QString> transientArticleGUIDs = QSet<QString>(m_newArticleGUIDs).intersect(m_removedArticleGUIDs);
+    m_newArticleGUIDs.subtract(transientArticleGUIDs);
+    m_removedArticleGUIDs.subtract(transientArticleGUIDs);
+    // New articles are stored with their current "read" state
+    m_readArticleGUIDs.subtract(m_newArticleGUIDs);
+    m_readArticleGUIDs.subtract(m_removedArticleGUIDs);
 
-    for (Article *article :asConst(m_articles))
-        articlesData.push_back(article->data());
+    if (!m_newArticleGUIDs.isEmpty())
+    {
+        QVector<ArticleData> newArticles;
+        newArticles.reserve(m_newArticleGUIDs.size());
+        for (const QString &guid : asConst(m_newArticleGUIDs))
+        {
+            if (const Article *article = m_articles.value(guid))
+                newArticles.append(article->m_data);
+        }
+        m_newArticleGUIDs.clear();
 
-    QMetaObject::invokeMethod(m_serializer
-            , [articlesData, serializer = m_serializer
-                , path = (m_session->dataFileStorage()->storageDir() / m_dataFileName)]
+        QMetaObject::invokeMethod(m_serializer, [serializer = m_serializer, newArticles]
+        {
+            serializer->addArticles(newArticles);
+        });
+    }
+
+    if (!m_readArticleGUIDs.isEmpty())
     {
-        serializer->store(path, articlesData);
-    });
+        QMetaObject::invokeMethod(m_serializer, [serializer = m_serializer, guids = m_readArticleGUIDs.values()]
+        {
+            serializer->markAsRead(guids);
+        });
+        m_readArticleGUIDs.clear();
+    }
+
+    if (!m_removedArticleGUIDs.isEmpty())
+    {
+        QMetaObject::invokeMethod(m_serializer, [serializer = m_serializer, guids = m_removedArticleGUIDs.values()]
+        {
+            serializer->removeArticles(guids);
+        });
+        m_removedArticleGUIDs.clear();
+    }
 }
 
 void Feed::storeDeferred()
@@ -313,18 +410,18 @@ void Feed::storeDeferred()
         m_savingTimer.start(5 * 1000, this);
 }
 
-bool Feed::addArticle(const QVariantHash &articleData)
+bool Feed::addArticle(const ArticleData &articleData)
 {
-    Q_ASSERT(!m_articles.contains(articleData.value(Article::KeyId).toString()));
+    Q_ASSERT(!m_articles.contains(articleData.guid));
 
     // Insertion sort
     const int maxArticles = m_session->maxArticlesPerFeed();
     const auto lowerBound = std::lower_bound(m_articlesByDate.begin(), m_articlesByDate.end()
-                                       , articleData.value(Article::KeyDate).toDateTime(), Article::articleDateRecentThan);
+                                       , articleData.date, Article::articleDateRecentThan);
     if ((lowerBound - m_articlesByDate.begin()) >= maxArticles)
         return false; // we reach max articles
 
-    auto *article = new Article(this, articleData);
+    auto *article = new Article(this, articleData, true);
     m_articles[article->guid()] = article;
     m_articlesByDate.insert(lowerBound, article);
     if (!article->isRead())
@@ -333,7 +430,8 @@ bool Feed::addArticle(const QVariantHash &articleData)
         connect(article, &Article::read, this, &Feed::handleArticleRead);
     }
 
-    m_dirty = true;
+    m_newArticleGUIDs.insert(article->guid());
+    updateArticleRevision(article);
     emit newArticle(article);
 
     if (m_articlesByDate.size() > maxArticles)
@@ -349,6 +447,12 @@ void Feed::removeOldestArticle()
 
     m_articles.remove(oldestArticle->guid());
     m_articlesByDate.removeLast();
+    m_removedArticleGUIDs.insert(oldestArticle->guid());
+
+    updateRevision();
+    m_removedArticles.append({m_revision, oldestArticle->guid()});
+    if (m_removedArticles.size() > MAX_TRACKED_REMOVED_ARTICLES)
+        m_session->forgetChangesBefore(m_removedArticles.takeFirst().first);
     const bool isRead = oldestArticle->isRead();
     delete oldestArticle;
 
@@ -387,23 +491,23 @@ int Feed::updateArticles(const QList<QVariantHash> &loadedArticles)
         return 0;
 
     QDateTime dummyPubDate {QDateTime::currentDateTime()};
-    QVector<QVariantHash> newArticles;
+    QVector<ArticleData> newArticles;
     newArticles.reserve(loadedArticles.size());
-    for (QVariantHash article : loadedArticles)
+    for (const QVariantHash &loadedArticle : loadedArticles)
     {
         // If article has no publication date we use feed update time as a fallback.
         // To prevent processing of "out-of-limit" articles we must not assign dates
         // that are earlier than the dates of existing articles.
-        const Article *existingArticle = articleByGUID(article[Article::KeyId].toString());
+        const Article *existingArticle = articleByGUID(loadedArticle.value(Article::KeyId).toString());
         if (existingArticle)
         {
             dummyPubDate = existingArticle->date().addMSecs(-1);
             continue;
         }
 
-        QVariant &articleDate = article[Article::KeyDate];
-        if (!articleDate.toDateTime().isValid())
-            articleDate = dummyPubDate;
+        ArticleData article = ArticleData::fromVariantHash(loadedArticle);
+        if (!article.date.isValid())
+            article.date = dummyPubDate;
 
         newArticles.append(article);
     }
@@ -411,7 +515,7 @@ int Feed::updateArticles(const QList<QVariantHash> &loadedArticles)
     if (newArticles.empty())
         return 0;
 
-    using ArticleSortAdaptor = std::pair<QDateTime, const QVariantHash *>;
+    using ArticleSortAdaptor = std::pair<QDateTime, const ArticleData *>;
     std::vector<ArticleSortAdaptor> sortData;
     const QList<Article *> existingArticles = articles();
     sortData.reserve(existingArticles.size() + newArticles.size());
@@ -421,9 +525,9 @@ int Feed::updateArticles(const QList<QVariantHash> &loadedArticles)
         return std::make_pair(article->date(), nullptr);
     });
     std::transform(newArticles.begin(), newArticles.end(), std::back_inserter(sortData)
-                   , [](const QVariantHash &article)
+                   , [](const ArticleData &article)
     {
-        return std::make_pair(article[Article::KeyDate].toDateTime(), &article);
+        return std::make_pair(article.date, &article);
     });
 
     // Sort article list in reverse chronological order
@@ -454,33 +558,134 @@ Path Feed::iconPath() const
     return m_iconPath;
 }
 
+std::chrono::seconds Feed::refreshInterval() const
+{
+    return m_refreshInterval;
+}
+
+bool Feed::isRefreshDue() const
+{
+    if (!m_lastRefreshTimer.isValid())
+        return true;
+
+    return m_lastRefreshTimer.hasExpired(std::chrono::milliseconds(m_refreshInterval).count());
+}
+
+Feed::Statistics Feed::statistics() const
+{
+    return m_statistics;
+}
+
+void Feed::updateRefreshInterval()
+{
+    // Feeds that publish rarely are polled less often than the busy ones.
+    // Publish cadence is estimated from the dates of the most recent articles.
+    const std::chrono::seconds baseInterval = std::chrono::minutes(m_session->refreshInterval());
+    m_refreshInterval = baseInterval;
+
+    const int samplesCount = std::min(static_cast<int>(m_articlesByDate.size()), PUBLISH_CADENCE_SAMPLES);
+    if (m_hasError || (samplesCount < 2))
+        return;
+
+    const QDateTime newestDate = m_articlesByDate[0]->date();
+    const QDateTime oldestDate = m_articlesByDate[samplesCount - 1]->date();
+    const std::chrono::seconds cadence {oldestDate.secsTo(newestDate) / (samplesCount - 1)};
+    // Poll twice per expected publication to keep the delay low
+    m_refreshInterval = std::clamp((cadence / 2), baseInterval, (baseInterval * MAX_REFRESH_INTERVAL_FACTOR));
+}
+
 QJsonValue Feed::toJsonValue(const bool withData) const
 {
-    QJsonObject jsonObj;
-    jsonObj.insert(KEY_UID, uid().toString());
-    jsonObj.insert(KEY_URL, url());
+    if (!withData)
+    {
+        return QJsonObject {
+            {KEY_UID, uid().toString()},
+            {KEY_URL, url()}
+        };
+    }
 
-    if (withData)
+    // The bodies which aren't loaded yet are sent as changes once they are loaded
+    QStringList unloadedBodyGUIDs;
+    QJsonArray jsonArr;
+    for (const Article *article : asConst(m_articles))
     {
-        jsonObj.insert(KEY_TITLE, title());
-        jsonObj.insert(KEY_LASTBUILDDATE, lastBuildDate());
-        jsonObj.insert(KEY_ISLOADING, isLoading());
-        jsonObj.insert(KEY_HASERROR, hasError());
+        if (!article->isBodyLoaded())
+            unloadedBodyGUIDs.append(article->guid());
+        jsonArr.append(articleToJsonObject(article));
+    }
+    requestArticleBodies(unloadedBodyGUIDs);
 
-        QJsonArray jsonArr;
-        for (Article *article : asConst(m_articles))
-        {
-            auto articleObj = QJsonObject::fromVariantHash(article->data());
-            // JSON object doesn't support DateTime so we need to convert it
-            articleObj[Article::KeyDate] = article->date().toString(Qt::RFC2822Date);
-            jsonArr.append(articleObj);
-        }
-        jsonObj.insert(KEY_ARTICLES, jsonArr);
+    QJsonObject jsonObj = feedDataToJsonObject();
+    jsonObj.insert(KEY_ARTICLES, jsonArr);
+    return jsonObj;
+}
+
+QJsonValue Feed::changesToJsonValue(const qint64 sinceRevision) const
+{
+    QVector<const Article *> articles;
+    for (const Article *article : asConst(m_articlesByDate))
+    {
+        if (article->m_revision > sinceRevision)
+            articles.append(article);
     }
 
+    // Changed articles can be loaded from storage after the cursor was issued,
+    // so they are sent once again when their bodies are loaded
+    QStringList unloadedBodyGUIDs;
+    QJsonArray changedArticles;
+    for (const Article *article : asConst(articles))
+    {
+        if (!article->isBodyLoaded())
+            unloadedBodyGUIDs.append(article->guid());
+        changedArticles.append(articleToJsonObject(article));
+    }
+    requestArticleBodies(unloadedBodyGUIDs);
+
+    QJsonArray removedArticles;
+    for (auto it = m_removedArticles.crbegin(); it != m_removedArticles.crend(); ++it)
+    {
+        if (it->first <= sinceRevision)
+            break;
+
+        removedArticles.append(it->second);
+    }
+
+    QJsonObject jsonObj = feedDataToJsonObject();
+    jsonObj.insert(KEY_ARTICLES, changedArticles);
+    jsonObj.insert(KEY_REMOVEDARTICLES, removedArticles);
     return jsonObj;
 }
 
+QJsonObject Feed::feedDataToJsonObject() const
+{
+    return {
+        {KEY_UID, uid().toString()},
+        {KEY_URL, url()},
+        {KEY_TITLE, title()},
+        {KEY_LASTBUILDDATE, lastBuildDate()},
+        {KEY_ISLOADING, isLoading()},
+        {KEY_HASERROR, hasError()},
+        {KEY_STATISTICS, QJsonObject {
+            {u"refreshInterval"_qs, static_cast<qint64>(refreshInterval().count())},
+            {u"refreshCount"_qs, m_statistics.refreshCount},
+            {u"notModifiedCount"_qs, m_statistics.notModifiedCount},
+            {u"unchangedCount"_qs, m_statistics.unchangedCount},
+            {u"downloadedBytes"_qs, m_statistics.downloadedBytes},
+            {u"savedBytes"_qs, m_statistics.savedBytes},
+            {u"lastParseTime"_qs, m_statistics.lastParseTime},
+            {u"averageParseTime"_qs, ((m_statistics.parseCount > 0) ? (m_statistics.totalParseTime / m_statistics.parseCount) : 0)}
+        }}
+    };
+}
+
+QJsonObject Feed::articleToJsonObject(const Article *article) const
+{
+    auto articleObj = QJsonObject::fromVariantHash(article->data());
+    // JSON object doesn't support DateTime so we need to convert it
+    articleObj[Article::KeyDate] = article->date().toString(Qt::RFC2822Date);
+    return articleObj;
+}
+
 void Feed::handleSessionProcessingEnabledChanged(const bool enabled)
 {
     if (enabled)
@@ -497,11 +702,12 @@ void Feed::handleArticleRead(Article *article)
     decreaseUnreadCount();
     emit articleRead(article);
     // will be stored deferred
-    m_dirty = true;
+    m_readArticleGUIDs.insert(article->guid());
+    updateArticleRevision(article);
     storeDeferred();
 }
 
-void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
+void Feed::handleArticleLoadFinished(QVector<ArticleData> articles)
 {
     Q_ASSERT(m_articles.isEmpty());
     Q_ASSERT(m_unreadCount == 0);
@@ -513,14 +719,15 @@ void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
     m_articles.reserve(articles.size());
     m_articlesByDate.reserve(articles.size());
 
-    for (const QVariantHash &articleData : articles)
+    for (const ArticleData &articleData : asConst(articles))
     {
-        const auto articleID = articleData.value(Article::KeyId).toString();
+        const QString articleID = articleData.guid;
         // TODO: use [[unlikely]] in C++20
         if (Q_UNLIKELY(m_articles.contains(articleID)))
             continue;
 
-        auto *article = new Article(this, articleData);
+        auto *article = new Article(this, articleData, false);
+        article->m_revision = m_session->nextRevision();
         m_articles[articleID] = article;
         m_articlesByDate.append(article);
         if (!article->isRead())
@@ -536,6 +743,7 @@ void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
         emit unreadCountChanged(this);
 
     m_isInitialized = true;
+    updateRefreshInterval();
     emit stateChanged(this);
 
     if (m_pendingRefresh)
@@ -547,12 +755,71 @@ void Feed::handleArticleLoadFinished(QVector<QVariantHash> articles)
 
 void Feed::cleanup()
 {
-    m_dirty = false;
+    m_newArticleGUIDs.clear();
+    m_readArticleGUIDs.clear();
+    m_removedArticleGUIDs.clear();
     m_savingTimer.stop();
-    Utils::Fs::removeFile(m_session->dataFileStorage()->storageDir() / m_dataFileName);
+
+    QMetaObject::invokeMethod(m_serializer, [serializer = m_serializer]
+    {
+        serializer->removeAll();
+    });
+    Utils::Fs::removeFile(m_session->dataFileStorage()->storageDir() / m_legacyDataFileName);
     Utils::Fs::removeFile(m_iconPath);
 }
 
+void Feed::requestArticleBodies(const QStringList &guids) const
+{
+    QStringList newGUIDs;
+    for (const QString &guid : guids)
+    {
+        if (!m_requestedBodyGUIDs.contains(guid))
+        {
+            m_requestedBodyGUIDs.insert(guid);
+            newGUIDs.append(guid);
+        }
+    }
+
+    if (newGUIDs.isEmpty())
+        return;
+
+    QMetaObject::invokeMethod(m_serializer, [serializer = m_serializer, newGUIDs]
+    {
+        serializer->loadArticleBodies(newGUIDs);
+    });
+}
+
+void Feed::handleArticleBodiesLoaded(const QHash<QString, ArticleData> &bodies)
+{
+    for (auto it = bodies.cbegin(); it != bodies.cend(); ++it)
+    {
+        m_requestedBodyGUIDs.remove(it.key());
+
+        Article *article = m_articles.value(it.key());
+        if (!article || article->isBodyLoaded())
+            continue;
+
+        article->setBody(it.value());
+        updateArticleRevision(article);
+    }
+}
+
+qint64 Feed::revision() const
+{
+    return m_revision;
+}
+
+void Feed::updateRevision()
+{
+    m_revision = m_session->nextRevision();
+}
+
+void Feed::updateArticleRevision(Article *article)
+{
+    updateRevision();
+    article->m_revision = m_revision;
+}
+
 void Feed::timerEvent(QTimerEvent *event)
 {
     Q_UNUSED(event);
@@ -30,14 +30,21 @@
 
 #pragma once
 
+#include <chrono>
+#include <utility>
+
 #include <QtContainerFwd>
 #include <QBasicTimer>
+#include <QElapsedTimer>
 #include <QHash>
+#include <QJsonObject>
 #include <QList>
+#include <QSet>
 #include <QUuid>
 #include <QVariantHash>
 
 #include "base/path.h"
+#include "rss_article.h"
 #include "rss_item.h"
 
 class AsyncFileStorage;
@@ -50,7 +57,6 @@ namespace Net
 
 namespace RSS
 {
-    class Article;
     class Session;
 
     namespace Private
@@ -65,12 +71,27 @@ namespace RSS
         Q_OBJECT
         Q_DISABLE_COPY_MOVE(Feed)
 
+        friend class Article;
         friend class Session;
 
         Feed(const QUuid &uid, const QString &url, const QString &path, Session *session);
         ~Feed() override;
 
     public:
+        struct Statistics
+        {
+            int refreshCount = 0;
+            // refreshes the server answered with "304 Not Modified"
+            int notModifiedCount = 0;
+            // refreshes that downloaded the same content as the previous one
+            int unchangedCount = 0;
+            qint64 downloadedBytes = 0;
+            qint64 savedBytes = 0;
+            int parseCount = 0;
+            qint64 lastParseTime = 0;
+            qint64 totalParseTime = 0;
+        };
+
         QList<Article *> articles() const override;
         int unreadCount() const override;
         void markAsRead() override;
@@ -84,8 +105,14 @@ namespace RSS
         bool isLoading() const;
         Article *articleByGUID(const QString &guid) const;
         Path iconPath() const;
+        std::chrono::seconds refreshInterval() const;
+        bool isRefreshDue() const;
+        Statistics statistics() const;
+        qint64 revision() const;
 
         QJsonValue toJsonValue(bool withData = false) const override;
+        // Returns feed data with the articles added, changed or removed since given revision
+        QJsonValue changesToJsonValue(qint64 sinceRevision) const;
 
     signals:
         void iconLoaded(Feed *feed = nullptr);
@@ -99,7 +126,9 @@ namespace RSS
         void handleDownloadFinished(const Net::DownloadResult &result);
         void handleParsingFinished(const Private::ParsingResult &result);
         void handleArticleRead(Article *article);
-        void handleArticleLoadFinished(QVector<QVariantHash> articles);
+        void handleArticleLoadFinished(QVector<RSS::ArticleData> articles);
+        void handleArticleBodiesLoaded(const QHash<QString, RSS::ArticleData> &bodies);
+        void updateRevision();
 
     private:
         void timerEvent(QTimerEvent *event) override;
@@ -107,12 +136,18 @@ namespace RSS
         void load();
         void store();
         void storeDeferred();
-        bool addArticle(const QVariantHash &articleData);
+        bool addArticle(const ArticleData &articleData);
         void removeOldestArticle();
         void increaseUnreadCount();
         void decreaseUnreadCount();
         void downloadIcon();
+        void download();
+        void updateRefreshInterval();
         int updateArticles(const QList<QVariantHash> &loadedArticles);
+        void requestArticleBodies(const QStringList &guids) const;
+        void updateArticleRevision(Article *article);
+        QJsonObject feedDataToJsonObject() const;
+        QJsonObject articleToJsonObject(const Article *article) const;
 
         Session *m_session = nullptr;
         Private::Parser *m_parser = nullptr;
@@ -129,9 +164,24 @@ namespace RSS
         QList<Article *> m_articlesByDate;
         int m_unreadCount = 0;
         Path m_iconPath;
-        Path m_dataFileName;
+        Path m_legacyDataFileName;
         QBasicTimer m_savingTimer;
-        bool m_dirty = false;
+        // changes of articles that aren't stored yet
+        QSet<QString> m_newArticleGUIDs;
+        QSet<QString> m_readArticleGUIDs;
+        QSet<QString> m_removedArticleGUIDs;
+        // articles which bodies are being loaded from the storage
+        mutable QSet<QString> m_requestedBodyGUIDs;
         Net::DownloadHandler *m_downloadHandler = nullptr;
+        QByteArray m_eTag;
+        QByteArray m_lastModified;
+        qint64 m_contentSize = 0;
+        std::size_t m_contentHash = 0;
+        std::chrono::seconds m_refreshInterval {0};
+        QElapsedTimer m_lastRefreshTimer;
+        Statistics m_statistics;
+        qint64 m_revision = 0;
+        // revisions and GUIDs of the articles removed recently
+        QList<std::pair<qint64, QString>> m_removedArticles;
     };
 }
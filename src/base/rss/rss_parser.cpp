@@ -31,6 +31,7 @@
 
 #include <QDateTime>
 #include <QDebug>
+#include <QElapsedTimer>
 #include <QGlobalStatic>
 #include <QHash>
 #include <QMetaObject>
@@ -549,6 +550,9 @@ RSS::Private::Parser::Parser(const QString lastBuildDate)
 // read and create items from a rss document
 void RSS::Private::Parser::parse(const QByteArray &feedData)
 {
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
     QXmlStreamReader xml {feedData};
     XmlStreamEntityResolver resolver;
     xml.setEntityResolver(&resolver);
@@ -595,6 +599,7 @@ void RSS::Private::Parser::parse(const QByteArray &feedData)
         m_result.error = tr("Invalid RSS feed.");
     }
 
+    m_result.elapsedTime = elapsedTimer.elapsed();
     emit finished(m_result);
     m_result.articles.clear();
     m_result.error.clear();
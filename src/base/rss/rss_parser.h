@@ -45,6 +45,7 @@ namespace RSS::Private
         QString lastBuildDate;
         QString title;
         QList<QVariantHash> articles;
+        qint64 elapsedTime = 0;
     };
 
     class Parser final : public QObject
@@ -30,6 +30,7 @@
 
 #include "rss_session.h"
 
+#include <algorithm>
 #include <chrono>
 
 #include <QDebug>
@@ -45,6 +46,8 @@
 #include "../profile.h"
 #include "../settingsstorage.h"
 #include "../utils/fs.h"
+#include "../utils/random.h"
+#include "feed_serializer.h"
 #include "rss_article.h"
 #include "rss_feed.h"
 #include "rss_folder.h"
@@ -54,6 +57,10 @@ const QString CONF_FOLDER_NAME = u"rss"_qs;
 const QString DATA_FOLDER_NAME = u"rss/articles"_qs;
 const QString FEEDS_FILE_NAME = u"feeds.json"_qs;
 
+// Feeds have individual refresh intervals, so we check for the ones to be refreshed regularly
+const std::chrono::minutes REFRESH_CHECK_INTERVAL {1};
+const int MAX_CONCURRENT_FEED_DOWNLOADS = 6;
+
 using namespace RSS;
 
 QPointer<Session> Session::m_instance = nullptr;
@@ -63,6 +70,7 @@ Session::Session()
     , m_storeRefreshInterval(u"RSS/Session/RefreshInterval"_qs, 30)
     , m_storeMaxArticlesPerFeed(u"RSS/Session/MaxArticlesPerFeed"_qs, 50)
     , m_workingThread(new QThread)
+    , m_epoch(Utils::Random::rand())
 {
     Q_ASSERT(!m_instance); // only one instance is allowed
     m_instance = this;
@@ -90,10 +98,10 @@ Session::Session()
     m_workingThread->start();
     load();
 
-    connect(&m_refreshTimer, &QTimer::timeout, this, &Session::refresh);
+    connect(&m_refreshTimer, &QTimer::timeout, this, &Session::refreshDueFeeds);
     if (isProcessingEnabled())
     {
-        m_refreshTimer.start(std::chrono::minutes(refreshInterval()));
+        m_refreshTimer.start(REFRESH_CHECK_INTERVAL);
         refresh();
     }
 
@@ -126,6 +134,13 @@ Session::~Session()
     //store();
     delete m_itemsByPath[u""_qs]; // deleting root folder
 
+    // Pending article changes are stored by now so database connections can be closed
+    QMetaObject::invokeMethod(m_dataFileStorage, []
+    {
+        Private::FeedSerializer::closeDatabase();
+    }, Qt::BlockingQueuedConnection);
+    Private::FeedSerializer::closeDatabase();
+
     qDebug() << "RSS Session deleted.";
 }
 
@@ -197,6 +212,7 @@ nonstd::expected<void, QString> Session::moveItem(Item *item, const QString &des
     }
     m_itemsByPath.insert(destPath, m_itemsByPath.take(item->path()));
     item->setPath(destPath);
+    forgetChangesBefore(nextRevision());
     store();
     return {};
 }
@@ -417,6 +433,7 @@ void Session::addItem(Item *item, Folder *destFolder)
     connect(item, &Item::aboutToBeDestroyed, this, &Session::handleItemAboutToBeDestroyed);
     m_itemsByPath[item->path()] = item;
     destFolder->addItem(item);
+    forgetChangesBefore(nextRevision());
     emit itemAdded(item);
 }
 
@@ -432,7 +449,7 @@ void Session::setProcessingEnabled(const bool enabled)
         m_storeProcessingEnabled = enabled;
         if (enabled)
         {
-            m_refreshTimer.start(std::chrono::minutes(refreshInterval()));
+            m_refreshTimer.start(REFRESH_CHECK_INTERVAL);
             refresh();
         }
         else
@@ -469,6 +486,39 @@ Feed *Session::feedByURL(const QString &url) const
     return m_feedsByURL.value(url);
 }
 
+QString Session::changeCursor() const
+{
+    return u"%1-%2"_qs.arg(QString::number(m_epoch), QString::number(m_revision));
+}
+
+std::optional<qint64> Session::revisionFromCursor(const QString &cursor) const
+{
+    const QStringList parts = cursor.split(u'-');
+    if (parts.size() != 2)
+        return std::nullopt;
+
+    bool ok = false;
+    const quint32 epoch = parts[0].toUInt(&ok);
+    if (!ok || (epoch != m_epoch))
+        return std::nullopt;
+
+    const qint64 revision = parts[1].toLongLong(&ok);
+    if (!ok || (revision < m_trackingStartRevision) || (revision > m_revision))
+        return std::nullopt;
+
+    return revision;
+}
+
+qint64 Session::nextRevision()
+{
+    return ++m_revision;
+}
+
+void Session::forgetChangesBefore(const qint64 revision)
+{
+    m_trackingStartRevision = std::max(m_trackingStartRevision, revision);
+}
+
 int Session::refreshInterval() const
 {
     return m_storeRefreshInterval;
@@ -479,7 +529,8 @@ void Session::setRefreshInterval(const int refreshInterval)
     if (m_storeRefreshInterval != refreshInterval)
     {
         m_storeRefreshInterval = refreshInterval;
-        m_refreshTimer.start(std::chrono::minutes(m_storeRefreshInterval));
+        for (Feed *feed : asConst(m_feedsByUID))
+            feed->updateRefreshInterval();
     }
 }
 
@@ -491,11 +542,15 @@ QThread *Session::workingThread() const
 void Session::handleItemAboutToBeDestroyed(Item *item)
 {
     m_itemsByPath.remove(item->path());
+    forgetChangesBefore(nextRevision());
     auto feed = qobject_cast<Feed *>(item);
     if (feed)
     {
         m_feedsByUID.remove(feed->uid());
         m_feedsByURL.remove(feed->url());
+
+        m_feedDownloadQueue.removeOne(feed);
+        handleFeedDownloadFinished(feed);
     }
 }
 
@@ -535,3 +590,38 @@ void Session::refresh()
     // NOTE: Should we allow manually refreshing for disabled session?
     rootFolder()->refresh();
 }
+
+void Session::refreshDueFeeds()
+{
+    for (Feed *feed : asConst(m_feedsByUID))
+    {
+        if (feed->isRefreshDue())
+            feed->refresh();
+    }
+}
+
+void Session::scheduleFeedDownload(Feed *feed)
+{
+    if (m_downloadingFeeds.size() < MAX_CONCURRENT_FEED_DOWNLOADS)
+    {
+        m_downloadingFeeds.insert(feed);
+        feed->download();
+    }
+    else if (!m_feedDownloadQueue.contains(feed))
+    {
+        m_feedDownloadQueue.enqueue(feed);
+    }
+}
+
+void Session::handleFeedDownloadFinished(Feed *feed)
+{
+    if (!m_downloadingFeeds.remove(feed))
+        return;
+
+    while (!m_feedDownloadQueue.isEmpty() && (m_downloadingFeeds.size() < MAX_CONCURRENT_FEED_DOWNLOADS))
+    {
+        Feed *nextFeed = m_feedDownloadQueue.dequeue();
+        m_downloadingFeeds.insert(nextFeed);
+        nextFeed->download();
+    }
+}
@@ -68,9 +68,13 @@
  * 3.   Feed is JSON object (keys are property names, values are property values; 'uid' and 'url' are required)
  */
 
+#include <optional>
+
 #include <QHash>
 #include <QObject>
 #include <QPointer>
+#include <QQueue>
+#include <QSet>
 #include <QTimer>
 
 #include "base/3rdparty/expected.hpp"
@@ -94,6 +98,7 @@ namespace RSS
         Q_DISABLE_COPY_MOVE(Session)
 
         friend class ::Application;
+        friend class Feed;
 
         Session();
         ~Session() override;
@@ -127,6 +132,13 @@ namespace RSS
 
         Folder *rootFolder() const;
 
+        // Change cursor consists of the session epoch, which is different in every run,
+        // and the revision, which is increased on every change of feeds or their articles.
+        // If the cursor belongs to another run or the items were added, moved or removed
+        // since it, the changes can't be tracked and the whole items tree should be retrieved again.
+        QString changeCursor() const;
+        std::optional<qint64> revisionFromCursor(const QString &cursor) const;
+
     public slots:
         void refresh();
 
@@ -142,6 +154,7 @@ namespace RSS
     private slots:
         void handleItemAboutToBeDestroyed(Item *item);
         void handleFeedTitleChanged(Feed *feed);
+        void refreshDueFeeds();
 
     private:
         QUuid generateUID() const;
@@ -153,6 +166,10 @@ namespace RSS
         Folder *addSubfolder(const QString &name, Folder *parentFolder);
         Feed *addFeedToFolder(const QUuid &uid, const QString &url, const QString &name, Folder *parentFolder);
         void addItem(Item *item, Folder *destFolder);
+        void scheduleFeedDownload(Feed *feed);
+        void handleFeedDownloadFinished(Feed *feed);
+        qint64 nextRevision();
+        void forgetChangesBefore(qint64 revision);
 
         static QPointer<Session> m_instance;
 
@@ -166,5 +183,10 @@ namespace RSS
         QHash<QString, Item *> m_itemsByPath;
         QHash<QUuid, Feed *> m_feedsByUID;
         QHash<QString, Feed *> m_feedsByURL;
+        QSet<Feed *> m_downloadingFeeds;
+        QQueue<Feed *> m_feedDownloadQueue;
+        const quint32 m_epoch;
+        qint64 m_revision = 0;
+        qint64 m_trackingStartRevision = 0;
     };
 }
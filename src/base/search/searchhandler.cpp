@@ -31,16 +31,12 @@
 
 #include <chrono>
 
-#include <QMetaObject>
-#include <QProcess>
 #include <QTimer>
 #include <QVector>
 
 #include "base/global.h"
-#include "base/path.h"
-#include "base/utils/foreignapps.h"
-#include "base/utils/fs.h"
 #include "searchpluginmanager.h"
+#include "searchworkerpool.h"
 
 using namespace std::chrono_literals;
 
@@ -65,106 +61,69 @@ SearchHandler::SearchHandler(const QString &pattern, const QString &category, co
     , m_category {category}
     , m_usedPlugins {usedPlugins}
     , m_manager {manager}
-    , m_searchProcess {new QProcess {this}}
+    , m_searchJob {manager->workerPool()->startJob(pattern, category, usedPlugins)}
     , m_searchTimeout {new QTimer {this}}
 {
-    // Load environment variables (proxy)
-    m_searchProcess->setEnvironment(QProcess::systemEnvironment());
-
-    const QStringList params
-    {
-        (m_manager->engineLocation() / Path(u"nova2.py"_qs)).toString(),
-        m_usedPlugins.join(u','),
-        m_category
-    };
-
-    // Launch search
-    m_searchProcess->setProgram(Utils::ForeignApps::pythonInfo().executableName);
-    m_searchProcess->setArguments(params + m_pattern.split(u' '));
-
-    connect(m_searchProcess, &QProcess::errorOccurred, this, &SearchHandler::processFailed);
-    connect(m_searchProcess, &QProcess::readyReadStandardOutput, this, &SearchHandler::readSearchOutput);
-    connect(m_searchProcess, qOverload<int, QProcess::ExitStatus>(&QProcess::finished)
-            , this, &SearchHandler::processFinished);
+    // job reports its outcome asynchronously, so clients are able to handle starting-related signals
+    m_searchJob->setParent(this);
+    connect(m_searchJob, &SearchWorkerJob::outputReceived, this, &SearchHandler::readSearchOutput);
+    connect(m_searchJob, &SearchWorkerJob::finished, this, &SearchHandler::jobFinished);
+    connect(m_searchJob, &SearchWorkerJob::failed, this, &SearchHandler::jobFailed);
 
     m_searchTimeout->setSingleShot(true);
     connect(m_searchTimeout, &QTimer::timeout, this, &SearchHandler::cancelSearch);
     m_searchTimeout->start(3min);
-
-    // deferred start allows clients to handle starting-related signals
-    QMetaObject::invokeMethod(this, [this]() { m_searchProcess->start(QIODevice::ReadOnly); }
-        , Qt::QueuedConnection);
 }
 
 bool SearchHandler::isActive() const
 {
-    return (m_searchProcess->state() != QProcess::NotRunning);
+    return m_searchJob->isActive();
 }
 
 void SearchHandler::cancelSearch()
 {
-    if ((m_searchProcess->state() == QProcess::NotRunning) || m_searchCancelled)
+    if (!m_searchJob->isActive() || m_searchCancelled)
         return;
 
-#ifdef Q_OS_WIN
-    m_searchProcess->kill();
-#else
-    m_searchProcess->terminate();
-#endif
+    m_searchJob->cancel();
     m_searchCancelled = true;
     m_searchTimeout->stop();
 }
 
-// Slot called when QProcess is Finished
-// QProcess can be finished for 3 reasons:
-// Error | Stopped by user | Finished normally
-void SearchHandler::processFinished(const int exitcode)
+void SearchHandler::jobFinished()
+{
+    m_searchTimeout->stop();
+    emit searchFinished(m_searchCancelled);
+}
+
+void SearchHandler::jobFailed()
 {
     m_searchTimeout->stop();
 
     if (m_searchCancelled)
         emit searchFinished(true);
-    else if ((m_searchProcess->exitStatus() == QProcess::NormalExit) && (exitcode == 0))
-        emit searchFinished(false);
     else
         emit searchFailed();
 }
 
-// search QProcess return output as soon as it gets new
-// stuff to read. We split it into lines and parse each
-// line to SearchResult calling parseSearchResult().
-void SearchHandler::readSearchOutput()
+// search worker returns output as soon as it gets new
+// results. Each line is parsed to SearchResult by parseSearchResult().
+void SearchHandler::readSearchOutput(const QStringList &lines)
 {
-    QByteArray output = m_searchProcess->readAllStandardOutput();
-    output.replace('\r', "");
-
-    QList<QByteArray> lines = output.split('\n');
-    if (!m_searchResultLineTruncated.isEmpty())
-        lines.prepend(m_searchResultLineTruncated + lines.takeFirst());
-    m_searchResultLineTruncated = lines.takeLast().trimmed();
-
     QVector<SearchResult> searchResultList;
     searchResultList.reserve(lines.size());
 
-    for (const QByteArray &line : asConst(lines))
+    for (const QString &line : lines)
     {
         SearchResult searchResult;
-        if (parseSearchResult(QString::fromUtf8(line), searchResult))
+        if (parseSearchResult(line, searchResult))
             searchResultList << searchResult;
     }
 
-    if (!searchResultList.isEmpty())
-    {
-        for (const SearchResult &result : searchResultList)
-            m_results.append(result);
-        emit newSearchResults(searchResultList);
-    }
-}
-
-void SearchHandler::processFailed()
-{
-    if (!m_searchCancelled)
-        emit searchFailed();
+    // the same torrent can be reported by several search engines
+    const QVector<SearchResult> addedResults = m_results.addResults(searchResultList);
+    if (!addedResults.isEmpty())
+        emit newSearchResults(addedResults);
 }
 
 // Parse one line of search results list
@@ -204,7 +163,7 @@ SearchPluginManager *SearchHandler::manager() const
     return m_manager;
 }
 
-QList<SearchResult> SearchHandler::results() const
+const SearchResultStore &SearchHandler::results() const
 {
     return m_results;
 }
@@ -29,27 +29,17 @@
 
 #pragma once
 
-#include <QByteArray>
 #include <QList>
 #include <QObject>
 #include <QString>
 #include <QtContainerFwd>
 
-class QProcess;
-class QTimer;
+#include "searchresultstore.h"
 
-struct SearchResult
-{
-    QString fileName;
-    QString fileUrl;
-    qlonglong fileSize;
-    qlonglong nbSeeders;
-    qlonglong nbLeechers;
-    QString siteUrl;
-    QString descrLink;
-};
+class QTimer;
 
 class SearchPluginManager;
+class SearchWorkerJob;
 
 class SearchHandler : public QObject
 {
@@ -65,7 +55,7 @@ public:
     bool isActive() const;
     QString pattern() const;
     SearchPluginManager *manager() const;
-    QList<SearchResult> results() const;
+    const SearchResultStore &results() const;
 
     void cancelSearch();
 
@@ -75,18 +65,17 @@ signals:
     void newSearchResults(const QVector<SearchResult> &results);
 
 private:
-    void readSearchOutput();
-    void processFailed();
-    void processFinished(int exitcode);
+    void readSearchOutput(const QStringList &lines);
+    void jobFailed();
+    void jobFinished();
     bool parseSearchResult(QStringView line, SearchResult &searchResult);
 
     const QString m_pattern;
     const QString m_category;
     const QStringList m_usedPlugins;
     SearchPluginManager *m_manager = nullptr;
-    QProcess *m_searchProcess = nullptr;
+    SearchWorkerJob *m_searchJob = nullptr;
     QTimer *m_searchTimeout = nullptr;
-    QByteArray m_searchResultLineTruncated;
     bool m_searchCancelled = false;
-    QList<SearchResult> m_results;
+    SearchResultStore m_results;
 };
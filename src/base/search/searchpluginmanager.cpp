@@ -42,6 +42,7 @@
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/net/downloadmanager.h"
+#include "base/net/proxyconfigurationmanager.h"
 #include "base/preferences.h"
 #include "base/profile.h"
 #include "base/utils/bytearray.h"
@@ -49,6 +50,7 @@
 #include "base/utils/fs.h"
 #include "searchdownloadhandler.h"
 #include "searchhandler.h"
+#include "searchworkerpool.h"
 
 namespace
 {
@@ -86,10 +88,18 @@ QPointer<SearchPluginManager> SearchPluginManager::m_instance = nullptr;
 
 SearchPluginManager::SearchPluginManager()
     : m_updateUrl(u"http://searchplugins.qbittorrent.org/nova3/engines/"_qs)
+    , m_workerPool(new SearchWorkerPool(this))
 {
     Q_ASSERT(!m_instance); // only one instance is allowed
     m_instance = this;
 
+    // workers get proxy settings from environment when they are started
+    if (auto *proxyManager = Net::ProxyConfigurationManager::instance())
+    {
+        connect(proxyManager, &Net::ProxyConfigurationManager::proxyConfigurationChanged
+            , m_workerPool, &SearchWorkerPool::restartWorkers);
+    }
+
     updateNova();
     update();
 }
@@ -295,6 +305,7 @@ bool SearchPluginManager::uninstallPlugin(const QString &name)
         Utils::Fs::removeFile(pluginsPath / Path(file));
     // Remove it from supported engines
     delete m_plugins.take(name);
+    m_workerPool->restartWorkers();
 
     emit pluginUninstalled(name);
     return true;
@@ -326,6 +337,11 @@ void SearchPluginManager::checkForUpdates()
                                           , this, &SearchPluginManager::versionInfoDownloadFinished);
 }
 
+SearchWorkerPool *SearchPluginManager::workerPool() const
+{
+    return m_workerPool;
+}
+
 SearchDownloadHandler *SearchPluginManager::downloadTorrent(const QString &siteUrl, const QString &url)
 {
     return new SearchDownloadHandler {siteUrl, url, this};
@@ -448,6 +464,9 @@ void SearchPluginManager::updateNova()
 
 void SearchPluginManager::update()
 {
+    // workers have to import the changed engines again
+    m_workerPool->restartWorkers();
+
     QProcess nova;
     nova.setProcessEnvironment(QProcessEnvironment::systemEnvironment());
 
@@ -57,6 +57,7 @@ struct PluginInfo
 
 class SearchDownloadHandler;
 class SearchHandler;
+class SearchWorkerPool;
 
 class SearchPluginManager : public QObject
 {
@@ -84,6 +85,7 @@ public:
     void checkForUpdates();
 
     SearchHandler *startSearch(const QString &pattern, const QString &category, const QStringList &usedPlugins);
+    SearchWorkerPool *workerPool() const;
     SearchDownloadHandler *downloadTorrent(const QString &siteUrl, const QString &url);
 
     static PluginVersion getPluginVersion(const Path &filePath);
@@ -118,6 +120,7 @@ private:
     static QPointer<SearchPluginManager> m_instance;
 
     const QString m_updateUrl;
+    SearchWorkerPool *m_workerPool = nullptr;
 
     QHash<QString, PluginInfo*> m_plugins;
 };
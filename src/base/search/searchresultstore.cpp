@@ -0,0 +1,174 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "searchresultstore.h"
+
+#include <algorithm>
+
+#include "base/global.h"
+#include "base/utils/compare.h"
+
+namespace
+{
+    QString deduplicationKey(const SearchResult &result)
+    {
+        // [BEP 9] magnet:?xt=urn:btih:<info-hash>&...
+        const QString btihPrefix = u"xt=urn:btih:"_qs;
+        if (result.fileUrl.startsWith(u"magnet:", Qt::CaseInsensitive))
+        {
+            const int hashStart = result.fileUrl.indexOf(btihPrefix, 0, Qt::CaseInsensitive);
+            if (hashStart >= 0)
+            {
+                const int valueStart = hashStart + btihPrefix.size();
+                const int valueEnd = result.fileUrl.indexOf(u'&', valueStart);
+                return u"btih:" + QStringView(result.fileUrl).mid(valueStart, ((valueEnd < 0) ? -1 : (valueEnd - valueStart))).toString().toLower();
+            }
+        }
+
+        return result.fileUrl;
+    }
+
+    bool matches(const SearchResult &result, const SearchResultFilter &filter)
+    {
+        for (const QString &term : filter.nameTerms)
+        {
+            if (!result.fileName.contains(term, Qt::CaseInsensitive))
+                return false;
+        }
+
+        if ((filter.minSize && (result.fileSize < *filter.minSize))
+            || (filter.maxSize && (result.fileSize > *filter.maxSize)))
+            return false;
+
+        if ((filter.minSeeds && (result.nbSeeders < *filter.minSeeds))
+            || (filter.maxSeeds && (result.nbSeeders > *filter.maxSeeds)))
+            return false;
+
+        return true;
+    }
+}
+
+QVector<SearchResult> SearchResultStore::addResults(const QVector<SearchResult> &results)
+{
+    QVector<SearchResult> addedResults;
+    addedResults.reserve(results.size());
+
+    for (const SearchResult &result : results)
+    {
+        const QString key = deduplicationKey(result);
+        if (!key.isEmpty())
+        {
+            if (m_keys.contains(key))
+                continue;
+            m_keys.insert(key);
+        }
+
+        m_results.append(result);
+        addedResults.append(result);
+    }
+
+    return addedResults;
+}
+
+int SearchResultStore::size() const
+{
+    return m_results.size();
+}
+
+bool SearchResultStore::isEmpty() const
+{
+    return m_results.isEmpty();
+}
+
+const SearchResult &SearchResultStore::at(const int index) const
+{
+    return m_results.at(index);
+}
+
+const QVector<SearchResult> &SearchResultStore::results() const
+{
+    return m_results;
+}
+
+SearchResultPage SearchResultStore::query(const SearchResultQuery &query) const
+{
+    QVector<int> indexes;
+    indexes.reserve(m_results.size());
+    for (int i = 0; i < m_results.size(); ++i)
+    {
+        if (matches(m_results[i], query.filter))
+            indexes.append(i);
+    }
+
+    const auto sortIndexes = [&indexes, &query](const auto &lessThan)
+    {
+        if (query.sortOrder == Qt::AscendingOrder)
+            std::stable_sort(indexes.begin(), indexes.end(), lessThan);
+        else
+            std::stable_sort(indexes.begin(), indexes.end(), [&lessThan](const int left, const int right) { return lessThan(right, left); });
+    };
+
+    switch (query.sortField)
+    {
+    case SearchResultSortField::None:
+        break;
+    case SearchResultSortField::Name:
+        {
+            // natural comparison is expensive so sort keys are computed once per result
+            using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>;
+            QVector<SortKey> sortKeys(m_results.size());
+            for (const int index : asConst(indexes))
+                sortKeys[index] = SortKey(m_results[index].fileName);
+            sortIndexes([&sortKeys](const int left, const int right) { return sortKeys[left] < sortKeys[right]; });
+        }
+        break;
+    case SearchResultSortField::Size:
+        sortIndexes([this](const int left, const int right) { return m_results[left].fileSize < m_results[right].fileSize; });
+        break;
+    case SearchResultSortField::Seeders:
+        sortIndexes([this](const int left, const int right) { return m_results[left].nbSeeders < m_results[right].nbSeeders; });
+        break;
+    case SearchResultSortField::Leechers:
+        sortIndexes([this](const int left, const int right) { return m_results[left].nbLeechers < m_results[right].nbLeechers; });
+        break;
+    case SearchResultSortField::SiteUrl:
+        sortIndexes([this](const int left, const int right) { return m_results[left].siteUrl < m_results[right].siteUrl; });
+        break;
+    }
+
+    SearchResultPage page;
+    page.matchedCount = indexes.size();
+
+    const int offset = std::clamp(query.offset, 0, page.matchedCount);
+    const int count = (query.limit < 0) ? (page.matchedCount - offset) : std::min(query.limit, (page.matchedCount - offset));
+    page.results.reserve(count);
+    for (int i = offset; i < (offset + count); ++i)
+        page.results.append(m_results[indexes[i]]);
+
+    return page;
+}
@@ -0,0 +1,105 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <QtGlobal>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+struct SearchResult
+{
+    QString fileName;
+    QString fileUrl;
+    qlonglong fileSize;
+    qlonglong nbSeeders;
+    qlonglong nbLeechers;
+    QString siteUrl;
+    QString descrLink;
+};
+
+struct SearchResultFilter
+{
+    // every term must be contained in the name (case insensitive)
+    QStringList nameTerms;
+    // unset bounds aren't checked, so the results with unknown (i.e. -1) value are kept
+    std::optional<qint64> minSize;
+    std::optional<qint64> maxSize;
+    std::optional<qlonglong> minSeeds;
+    std::optional<qlonglong> maxSeeds;
+};
+
+enum class SearchResultSortField
+{
+    None,
+    Name,
+    Size,
+    Seeders,
+    Leechers,
+    SiteUrl
+};
+
+struct SearchResultQuery
+{
+    SearchResultFilter filter;
+    SearchResultSortField sortField = SearchResultSortField::None;
+    Qt::SortOrder sortOrder = Qt::AscendingOrder;
+    int offset = 0;
+    int limit = -1;  // negative value means "unlimited"
+};
+
+struct SearchResultPage
+{
+    QVector<SearchResult> results;
+    int matchedCount = 0;  // number of results matching the filter before offset and limit are applied
+};
+
+// Keeps results of a single search.
+// Results are deduplicated by info hash (for magnet links) or by download URL,
+// so the same torrent found by several search engines is stored only once.
+class SearchResultStore
+{
+public:
+    // Returns the results that were actually added, i.e. without duplicates
+    QVector<SearchResult> addResults(const QVector<SearchResult> &results);
+
+    int size() const;
+    bool isEmpty() const;
+    const SearchResult &at(int index) const;
+    const QVector<SearchResult> &results() const;
+
+    SearchResultPage query(const SearchResultQuery &query) const;
+
+private:
+    QVector<SearchResult> m_results;
+    QSet<QString> m_keys;
+};
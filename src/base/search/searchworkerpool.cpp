@@ -0,0 +1,324 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "searchworkerpool.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include <QList>
+#include <QProcess>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/path.h"
+#include "base/utils/foreignapps.h"
+#include "searchpluginmanager.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    const int MAX_WORKERS = 2;
+    const std::chrono::seconds ENGINE_TIMEOUT = 2min;
+
+    QString toCommandField(QString value)
+    {
+        // tabs and line breaks are delimiters of worker protocol
+        value.replace(u'\t', u' ').replace(u'\n', u' ').replace(u'\r', u' ');
+        return value;
+    }
+}
+
+qint64 SearchEngineStatistics::averageLatency() const
+{
+    return (searchCount > 0) ? (totalLatency / searchCount) : 0;
+}
+
+SearchWorkerJob::SearchWorkerJob(const quint64 id, SearchWorkerPool *pool)
+    : m_id {id}
+    , m_pool {pool}
+{
+}
+
+SearchWorkerJob::~SearchWorkerJob()
+{
+    // don't let the worker waste its time on results nobody is waiting for
+    cancel();
+}
+
+bool SearchWorkerJob::isActive() const
+{
+    return m_isActive;
+}
+
+void SearchWorkerJob::cancel()
+{
+    if (m_isActive && m_pool)
+        m_pool->cancelJob(m_id);
+}
+
+SearchWorkerPool::SearchWorkerPool(QObject *parent)
+    : QObject {parent}
+{
+}
+
+SearchWorkerPool::~SearchWorkerPool()
+{
+    for (QProcess *worker : asConst(m_workers.keys()))
+    {
+        worker->disconnect(this);
+        // worker cancels its jobs and exits when its input is closed
+        worker->closeWriteChannel();
+        if (!worker->waitForFinished(1000))
+            worker->kill();
+    }
+}
+
+SearchWorkerJob *SearchWorkerPool::startJob(const QString &pattern, const QString &category, const QStringList &usedPlugins)
+{
+    const quint64 jobID = ++m_lastJobID;
+    auto *job = new SearchWorkerJob {jobID, this};
+
+    QProcess *worker = pickWorker();
+    m_workers[worker].jobIDs.insert(jobID);
+    m_jobWorkers.insert(jobID, worker);
+    m_jobs.insert(jobID, job);
+
+    if (worker->state() != QProcess::NotRunning)
+    {
+        const QStringList command
+        {
+            u"S"_qs,
+            QString::number(jobID),
+            QString::number(ENGINE_TIMEOUT.count()),
+            toCommandField(usedPlugins.join(u',')),
+            toCommandField(category),
+            toCommandField(pattern)
+        };
+        worker->write((command.join(u'\t') + u'\n').toUtf8());
+    }
+
+    return job;
+}
+
+void SearchWorkerPool::restartWorkers()
+{
+    for (auto iter = m_workers.begin(); iter != m_workers.end(); ++iter)
+    {
+        if (iter->isRetired)
+            continue;
+
+        iter->isRetired = true;
+        if (iter->jobIDs.isEmpty())
+            stopWorker(iter.key());
+    }
+}
+
+QHash<QString, SearchEngineStatistics> SearchWorkerPool::engineStatistics() const
+{
+    return m_engineStatistics;
+}
+
+QProcess *SearchWorkerPool::pickWorker()
+{
+    QProcess *candidate = nullptr;
+    int candidateJobCount = 0;
+    int activeWorkerCount = 0;
+    for (auto iter = m_workers.cbegin(); iter != m_workers.cend(); ++iter)
+    {
+        if (iter->isRetired)
+            continue;
+
+        ++activeWorkerCount;
+        if (!candidate || (iter->jobIDs.size() < candidateJobCount))
+        {
+            candidate = iter.key();
+            candidateJobCount = iter->jobIDs.size();
+        }
+    }
+
+    // busy worker is shared only when no more workers can be started
+    if (!candidate || ((candidateJobCount > 0) && (activeWorkerCount < MAX_WORKERS)))
+        candidate = startWorker();
+
+    return candidate;
+}
+
+QProcess *SearchWorkerPool::startWorker()
+{
+    auto *worker = new QProcess {this};
+    // Load environment variables (proxy)
+    worker->setProcessEnvironment(QProcessEnvironment::systemEnvironment());
+    worker->setProgram(Utils::ForeignApps::pythonInfo().executableName);
+    worker->setArguments({(SearchPluginManager::engineLocation() / Path(u"nova2.py"_qs)).toString(), u"--worker"_qs});
+
+    connect(worker, &QProcess::readyReadStandardOutput, this, [this, worker]() { readWorkerOutput(worker); });
+    connect(worker, qOverload<int, QProcess::ExitStatus>(&QProcess::finished), this, [this, worker]()
+    {
+        handleWorkerStopped(worker);
+    });
+    connect(worker, &QProcess::errorOccurred, this, [this, worker](const QProcess::ProcessError error)
+    {
+        if (error != QProcess::FailedToStart)
+            return;
+
+        // it can be reported from `start()`, so jobs are failed once their owners are ready to handle it
+        QMetaObject::invokeMethod(this, [this, worker]() { handleWorkerStopped(worker); }, Qt::QueuedConnection);
+    });
+
+    m_workers.insert(worker, {});
+    worker->start();
+
+    return worker;
+}
+
+void SearchWorkerPool::stopWorker(QProcess *worker)
+{
+    // worker exits once its input is closed, then it is removed by `handleWorkerStopped()`
+    if (worker->state() != QProcess::NotRunning)
+        worker->closeWriteChannel();
+}
+
+void SearchWorkerPool::cancelJob(const quint64 jobID)
+{
+    QProcess *worker = m_jobWorkers.value(jobID);
+    if (!worker || (worker->state() == QProcess::NotRunning))
+        return;
+
+    worker->write(u"C\t%1\n"_qs.arg(jobID).toUtf8());
+}
+
+void SearchWorkerPool::readWorkerOutput(QProcess *worker)
+{
+    const auto workerIter = m_workers.find(worker);
+    if (workerIter == m_workers.end())
+        return;
+
+    QByteArray output = worker->readAllStandardOutput();
+    output.replace('\r', "");
+
+    QList<QByteArray> lines = output.split('\n');
+    if (!workerIter->truncatedLine.isEmpty())
+        lines.prepend(workerIter->truncatedLine + lines.takeFirst());
+    workerIter->truncatedLine = lines.takeLast();
+
+    QHash<quint64, QStringList> jobOutputs;
+    QVector<quint64> finishedJobIDs;
+    for (const QByteArray &rawLine : asConst(lines))
+    {
+        const QString line = QString::fromUtf8(rawLine);
+        const QStringView lineView {line};
+
+        // R <job id> <engine> <search result>
+        if (lineView.startsWith(u"R\t"))
+        {
+            // search result itself can contain tabs
+            const int jobIDEnd = lineView.indexOf(u'\t', 2);
+            const int engineEnd = (jobIDEnd < 0) ? -1 : lineView.indexOf(u'\t', (jobIDEnd + 1));
+            if (engineEnd < 0)
+                continue;
+
+            const quint64 jobID = lineView.mid(2, (jobIDEnd - 2)).toULongLong();
+            jobOutputs[jobID].append(lineView.mid(engineEnd + 1).toString());
+            continue;
+        }
+
+        const QList<QStringView> fields = lineView.split(u'\t');
+        // E <job id> <engine> <status> <elapsed time>
+        if ((fields.size() == 5) && (fields[0] == u"E"))
+            processEngineFinished(fields[2], fields[3], fields[4]);
+        // D <job id>
+        else if ((fields.size() == 2) && (fields[0] == u"D"))
+            finishedJobIDs.append(fields[1].toULongLong());
+    }
+
+    // results are delivered before the job is reported as finished
+    for (auto iter = jobOutputs.cbegin(); iter != jobOutputs.cend(); ++iter)
+    {
+        const QPointer<SearchWorkerJob> job = m_jobs.value(iter.key());
+        if (job)
+            emit job->outputReceived(iter.value());
+    }
+
+    for (const quint64 jobID : asConst(finishedJobIDs))
+        finishJob(jobID, false);
+}
+
+void SearchWorkerPool::processEngineFinished(const QStringView engineName, const QStringView status, const QStringView elapsedTime)
+{
+    if (status == u"cancelled")
+        return;
+
+    SearchEngineStatistics &statistics = m_engineStatistics[engineName.toString()];
+    const qint64 latency = elapsedTime.toLongLong();
+    ++statistics.searchCount;
+    statistics.totalLatency += latency;
+    statistics.maxLatency = std::max(statistics.maxLatency, latency);
+
+    if (status == u"error")
+        ++statistics.failureCount;
+    else if (status == u"timeout")
+        ++statistics.timeoutCount;
+}
+
+void SearchWorkerPool::finishJob(const quint64 jobID, const bool failed)
+{
+    QProcess *worker = m_jobWorkers.take(jobID);
+    const auto workerIter = m_workers.find(worker);
+    if (workerIter != m_workers.end())
+    {
+        workerIter->jobIDs.remove(jobID);
+        if (workerIter->isRetired && workerIter->jobIDs.isEmpty())
+            stopWorker(worker);
+    }
+
+    const QPointer<SearchWorkerJob> job = m_jobs.take(jobID);
+    if (!job)
+        return;
+
+    job->m_isActive = false;
+    if (failed)
+        emit job->failed();
+    else
+        emit job->finished();
+}
+
+void SearchWorkerPool::handleWorkerStopped(QProcess *worker)
+{
+    const auto workerIter = m_workers.find(worker);
+    if (workerIter == m_workers.end())
+        return;
+
+    const QSet<quint64> jobIDs = workerIter->jobIDs;
+    m_workers.erase(workerIter);
+    worker->deleteLater();
+
+    for (const quint64 jobID : jobIDs)
+        finishJob(jobID, true);
+}
@@ -0,0 +1,123 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+class QProcess;
+
+class SearchWorkerPool;
+
+struct SearchEngineStatistics
+{
+    int searchCount = 0;
+    int failureCount = 0;
+    int timeoutCount = 0;
+    qint64 totalLatency = 0;  // milliseconds
+    qint64 maxLatency = 0;  // milliseconds
+
+    qint64 averageLatency() const;
+};
+
+// Search running in one of the pool workers
+class SearchWorkerJob final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(SearchWorkerJob)
+
+    friend class SearchWorkerPool;
+
+    SearchWorkerJob(quint64 id, SearchWorkerPool *pool);
+
+public:
+    ~SearchWorkerJob() override;
+
+    bool isActive() const;
+    void cancel();
+
+signals:
+    void outputReceived(const QStringList &lines);
+    void finished();
+    void failed();
+
+private:
+    const quint64 m_id;
+    QPointer<SearchWorkerPool> m_pool;
+    bool m_isActive = true;
+};
+
+// Keeps long-lived search engine worker processes ("nova2.py --worker").
+// Every worker runs engines of its jobs in parallel, so engines are imported
+// only once per worker instead of once per search.
+class SearchWorkerPool final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(SearchWorkerPool)
+
+    friend class SearchWorkerJob;
+
+public:
+    explicit SearchWorkerPool(QObject *parent = nullptr);
+    ~SearchWorkerPool() override;
+
+    SearchWorkerJob *startJob(const QString &pattern, const QString &category, const QStringList &usedPlugins);
+    // Running workers are retired once their jobs are finished and new jobs go to fresh workers,
+    // e.g. when plugins or environment have changed
+    void restartWorkers();
+
+    QHash<QString, SearchEngineStatistics> engineStatistics() const;
+
+private:
+    struct WorkerState
+    {
+        QByteArray truncatedLine;
+        QSet<quint64> jobIDs;
+        bool isRetired = false;
+    };
+
+    QProcess *pickWorker();
+    QProcess *startWorker();
+    void stopWorker(QProcess *worker);
+    void cancelJob(quint64 jobID);
+    void readWorkerOutput(QProcess *worker);
+    void processEngineFinished(QStringView engineName, QStringView status, QStringView elapsedTime);
+    void finishJob(quint64 jobID, bool failed);
+    void handleWorkerStopped(QProcess *worker);
+
+    quint64 m_lastJobID = 0;
+    QHash<QProcess *, WorkerState> m_workers;
+    QHash<quint64, QProcess *> m_jobWorkers;
+    QHash<quint64, QPointer<SearchWorkerJob>> m_jobs;
+    QHash<QString, SearchEngineStatistics> m_engineStatistics;
+};
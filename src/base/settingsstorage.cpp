@@ -53,11 +53,18 @@ SettingsStorage::SettingsStorage()
     m_timer.setSingleShot(true);
     m_timer.setInterval(5s);
     connect(&m_timer, &QTimer::timeout, this, &SettingsStorage::save);
+
+    // single thread keeps the writes in order
+    m_ioPool.setMaxThreadCount(1);
 }
 
 SettingsStorage::~SettingsStorage()
 {
     save();
+    m_ioPool.waitForDone();
+
+    if (m_writeFailed)
+        LogMsg(tr("Settings changed since the last successful save are lost."), Log::CRITICAL);
 }
 
 void SettingsStorage::initInstance()
@@ -80,16 +87,34 @@ SettingsStorage *SettingsStorage::instance()
 bool SettingsStorage::save()
 {
     const QWriteLocker locker(&m_lock);  // guard for `m_dirty` too
-    if (!m_dirty) return true;
+    if (!m_dirty) return !m_writeFailed;
 
-    if (!writeNativeSettings())
+    m_dirty = false;
+    m_timer.stop();
+
+    // it is implicitly shared, so the data isn't copied unless it is changed while being written
+    const QVariantHash data = m_data;
+    m_ioPool.start([this, data]()
     {
-        m_timer.start();
-        return false;
-    }
+        if (writeNativeSettings(data))
+        {
+            m_writeFailed = false;
+            return;
+        }
 
-    m_dirty = false;
-    return true;
+        m_writeFailed = true;
+        LogMsg(tr("Failed to save settings. They will be saved again later."), Log::CRITICAL);
+
+        // retry later
+        QMetaObject::invokeMethod(this, [this]()
+        {
+            const QWriteLocker locker(&m_lock);
+            m_dirty = true;
+            m_timer.start();
+        });
+    });
+
+    return !m_writeFailed;
 }
 
 QVariant SettingsStorage::loadValueImpl(const QString &key, const QVariant &defaultValue) const
@@ -159,7 +184,7 @@ void SettingsStorage::readNativeSettings()
     }
 }
 
-bool SettingsStorage::writeNativeSettings() const
+bool SettingsStorage::writeNativeSettings(const QVariantHash &data) const
 {
     std::unique_ptr<QSettings> nativeSettings = Profile::instance()->applicationSettings(m_nativeSettingsName + u"_new");
 
@@ -168,7 +193,7 @@ bool SettingsStorage::writeNativeSettings() const
     // between deleting the file and recreating it. This is a safety measure.
     // Write everything to qBittorrent_new.ini/qBittorrent_new.conf and if it succeeds
     // replace qBittorrent.ini/qBittorrent.conf with it.
-    for (auto i = m_data.begin(); i != m_data.end(); ++i)
+    for (auto i = data.begin(); i != data.end(); ++i)
         nativeSettings->setValue(i.key(), i.value());
 
     nativeSettings->sync(); // Important to get error status
@@ -204,7 +229,13 @@ bool SettingsStorage::writeNativeSettings() const
 
     const Path finalPath {finalPathStr};
     Utils::Fs::removeFile(finalPath);
-    return Utils::Fs::renameFile(newPath, finalPath);
+    if (!Utils::Fs::renameFile(newPath, finalPath))
+    {
+        LogMsg(tr("Failed to replace the configuration file. Path: \"%1\"").arg(finalPath.toString()), Log::CRITICAL);
+        return false;
+    }
+
+    return true;
 }
 
 void SettingsStorage::removeValue(const QString &key)
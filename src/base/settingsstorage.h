@@ -29,10 +29,12 @@
 
 #pragma once
 
+#include <atomic>
 #include <type_traits>
 
 #include <QObject>
 #include <QReadWriteLock>
+#include <QThreadPool>
 #include <QTimer>
 #include <QVariant>
 #include <QVariantHash>
@@ -111,19 +113,24 @@ public:
     bool hasKey(const QString &key) const;
 
 public slots:
+    // Settings are written to disk in background. Returns `true` if there is nothing to write
+    // or the writing has been scheduled, and `false` if the previous writing attempt has failed
+    // (so the settings aren't stored yet)
     bool save();
 
 private:
     QVariant loadValueImpl(const QString &key, const QVariant &defaultValue = {}) const;
     void storeValueImpl(const QString &key, const QVariant &value);
     void readNativeSettings();
-    bool writeNativeSettings() const;
+    bool writeNativeSettings(const QVariantHash &data) const;
 
     static SettingsStorage *m_instance;
 
     const QString m_nativeSettingsName;
     bool m_dirty = false;
+    std::atomic_bool m_writeFailed = false;
     QVariantHash m_data;
     QTimer m_timer;
     mutable QReadWriteLock m_lock;
+    QThreadPool m_ioPool;
 };
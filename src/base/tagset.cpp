@@ -28,10 +28,44 @@
 
 #include "tagset.h"
 
+#include <QHash>
+
+namespace
+{
+    // Tags are drawn from a small set of names shared by all torrents,
+    // so their sort keys are computed once and reused by every comparison
+    const int MAX_CACHED_TAG_SORT_KEYS = 4096;
+
+    struct TagSortKey
+    {
+        Utils::Compare::NaturalSortKey<Qt::CaseInsensitive> key;
+        Utils::Compare::NaturalSortKey<Qt::CaseSensitive> subKey;
+    };
+
+    TagSortKey tagSortKey(const QString &tag)
+    {
+        thread_local QHash<QString, TagSortKey> cache;
+
+        if (const auto iter = cache.constFind(tag); iter != cache.cend())
+            return iter.value();
+
+        if (cache.size() >= MAX_CACHED_TAG_SORT_KEYS)
+            cache.clear();
+
+        const TagSortKey sortKey {Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>(tag)
+            , Utils::Compare::NaturalSortKey<Qt::CaseSensitive>(tag)};
+        cache.insert(tag, sortKey);
+        return sortKey;
+    }
+}
+
 bool TagLessThan::operator()(const QString &left, const QString &right) const
 {
-    const int result = m_compare(left, right);
+    const TagSortKey leftKey = tagSortKey(left);
+    const TagSortKey rightKey = tagSortKey(right);
+
+    const int result = leftKey.key.compare(rightKey.key);
     if (result != 0)
         return (result < 0);
-    return (m_subCompare(left, right) < 0);
+    return (leftKey.subKey.compare(rightKey.subKey) < 0);
 }
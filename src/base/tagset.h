@@ -38,10 +38,6 @@ class TagLessThan
 {
 public:
     bool operator()(const QString &left, const QString &right) const;
-
-private:
-    Utils::Compare::NaturalCompare<Qt::CaseInsensitive> m_compare;
-    Utils::Compare::NaturalCompare<Qt::CaseSensitive> m_subCompare;
 };
 
 using TagSet = OrderedSet<QString, TagLessThan>;
@@ -30,10 +30,22 @@
 #include "torrentfileswatcher.h"
 
 #include <chrono>
+#include <variant>
+#include <vector>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
 
 #include <QtGlobal>
+#include <QDateTime>
 #include <QDir>
 #include <QDirIterator>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QFileSystemWatcher>
 #include <QJsonArray>
@@ -41,11 +53,14 @@
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QSet>
+#include <QSocketNotifier>
 #include <QThread>
+#include <QThreadPool>
 #include <QTimer>
 #include <QVariant>
 
 #include "base/algorithm.h"
+#include "base/bittorrent/addtorrentrequest.h"
 #include "base/bittorrent/magneturi.h"
 #include "base/bittorrent/torrentcontentlayout.h"
 #include "base/bittorrent/session.h"
@@ -64,6 +79,8 @@
 using namespace std::chrono_literals;
 
 const std::chrono::seconds WATCH_INTERVAL {10};
+const std::chrono::milliseconds FILE_EVENTS_DEBOUNCE_DELAY {500};
+const std::size_t MAX_IMPORT_BATCH_SIZE = 1000;
 const int MAX_FAILED_RETRIES = 5;
 const QString CONF_FILE_NAME = u"watched_folders.json"_qs;
 
@@ -198,36 +215,69 @@ namespace
     }
 }
 
+struct TorrentFilesWatcher::FoundTorrent
+{
+    std::variant<BitTorrent::MagnetUri, BitTorrent::TorrentInfo> source;
+    BitTorrent::AddTorrentParams addTorrentParams;
+};
+
 class TorrentFilesWatcher::Worker final : public QObject
 {
     Q_OBJECT
     Q_DISABLE_COPY_MOVE(Worker)
 
 public:
-    Worker();
+    explicit Worker(TorrentFilesWatcher *owner);
+    ~Worker() override;
 
 public slots:
     void setWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
     void removeWatchedFolder(const Path &path);
 
-signals:
-    void magnetFound(const BitTorrent::MagnetUri &magnetURI, const BitTorrent::AddTorrentParams &addTorrentParams);
-    void torrentFound(const BitTorrent::TorrentInfo &torrentInfo, const BitTorrent::AddTorrentParams &addTorrentParams);
-
 private:
+    struct PendingFile
+    {
+        Path watchedFolderPath;
+        qint64 lastEventTime = 0;
+    };
+
     void onTimeout();
     void scheduleWatchedFolderProcessing(const Path &path);
     void processWatchedFolder(const Path &path);
     void processFolder(const Path &path, const Path &watchedFolderPath, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void enqueueFile(const Path &filePath, const Path &watchedFolderPath);
+    void processPendingFiles();
     void processFailedTorrents();
     void addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
     void updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
-
+    void startWatching(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options);
+    void stopWatching(const Path &path);
+    BitTorrent::AddTorrentParams makeAddTorrentParams(const Path &filePath, const Path &watchedFolderPath) const;
+    void notifyTorrentsFound(QVector<TorrentFilesWatcher::FoundTorrent> torrents, int processedFilesCount, qint64 elapsedTime);
+
+#ifdef Q_OS_LINUX
+    bool initInotify();
+    bool addInotifyWatches(const Path &dirPath, const Path &watchedFolderPath, bool recursive);
+    void removeInotifyWatches(const Path &watchedFolderPath);
+    void readInotifyEvents();
+
+    int m_inotifyFD = -1;
+    QSocketNotifier *m_inotifyNotifier = nullptr;
+    // watch descriptor -> (watched directory, watched folder it belongs to)
+    QHash<int, std::pair<Path, Path>> m_inotifyWatches;
+#endif
+
+    TorrentFilesWatcher *m_owner = nullptr;
     QFileSystemWatcher *m_watcher = nullptr;
     QTimer *m_watchTimer = nullptr;
     QHash<Path, TorrentFilesWatcher::WatchedFolderOptions> m_watchedFolders;
     QSet<Path> m_watchedByTimeoutFolders;
 
+    // Files waiting for processing, events are debounced to get complete files
+    QHash<Path, PendingFile> m_pendingFiles;
+    QTimer *m_pendingFilesTimer = nullptr;
+    QThreadPool *m_parsingThreadPool = nullptr;
+
     // Failed torrents
     QTimer *m_retryTorrentTimer = nullptr;
     QHash<Path, QHash<Path, int>> m_failedTorrents;
@@ -275,10 +325,7 @@ void TorrentFilesWatcher::initWorker()
 {
     Q_ASSERT(!m_asyncWorker);
 
-    m_asyncWorker = new TorrentFilesWatcher::Worker;
-
-    connect(m_asyncWorker, &TorrentFilesWatcher::Worker::magnetFound, this, &TorrentFilesWatcher::onMagnetFound);
-    connect(m_asyncWorker, &TorrentFilesWatcher::Worker::torrentFound, this, &TorrentFilesWatcher::onTorrentFound);
+    m_asyncWorker = new TorrentFilesWatcher::Worker(this);
 
     m_asyncWorker->moveToThread(m_ioThread.get());
     m_ioThread->start();
@@ -447,21 +494,28 @@ void TorrentFilesWatcher::removeWatchedFolder(const Path &path)
     }
 }
 
-void TorrentFilesWatcher::onMagnetFound(const BitTorrent::MagnetUri &magnetURI
-                                         , const BitTorrent::AddTorrentParams &addTorrentParams)
+void TorrentFilesWatcher::onTorrentsFound(const QVector<FoundTorrent> &torrents, const int processedFilesCount, const qint64 elapsedTime)
 {
-    BitTorrent::Session::instance()->addTorrent(magnetURI, addTorrentParams);
-}
+    QVector<BitTorrent::AddTorrentRequest> requests;
+    requests.reserve(torrents.size());
+    for (const FoundTorrent &torrent : torrents)
+        requests.append({torrent.source, torrent.addTorrentParams});
 
-void TorrentFilesWatcher::onTorrentFound(const BitTorrent::TorrentInfo &torrentInfo
-                                         , const BitTorrent::AddTorrentParams &addTorrentParams)
-{
-    BitTorrent::Session::instance()->addTorrent(torrentInfo, addTorrentParams);
+    BitTorrent::Session::instance()->addTorrents(requests);
+
+    if (torrents.size() > 1)
+    {
+        LogMsg(tr("Imported torrents from watched folders. Torrents: %1. Files: %2. Elapsed time: %3 ms")
+            .arg(QString::number(torrents.size()), QString::number(processedFilesCount), QString::number(elapsedTime)));
+    }
 }
 
-TorrentFilesWatcher::Worker::Worker()
-    : m_watcher {new QFileSystemWatcher(this)}
+TorrentFilesWatcher::Worker::Worker(TorrentFilesWatcher *owner)
+    : m_owner {owner}
+    , m_watcher {new QFileSystemWatcher(this)}
     , m_watchTimer {new QTimer(this)}
+    , m_pendingFilesTimer {new QTimer(this)}
+    , m_parsingThreadPool {new QThreadPool(this)}
     , m_retryTorrentTimer {new QTimer(this)}
 {
     connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &path)
@@ -470,9 +524,20 @@ TorrentFilesWatcher::Worker::Worker()
     });
     connect(m_watchTimer, &QTimer::timeout, this, &Worker::onTimeout);
 
+    m_pendingFilesTimer->setSingleShot(true);
+    connect(m_pendingFilesTimer, &QTimer::timeout, this, &Worker::processPendingFiles);
+
     connect(m_retryTorrentTimer, &QTimer::timeout, this, &Worker::processFailedTorrents);
 }
 
+TorrentFilesWatcher::Worker::~Worker()
+{
+#ifdef Q_OS_LINUX
+    if (m_inotifyFD >= 0)
+        ::close(m_inotifyFD);
+#endif
+}
+
 void TorrentFilesWatcher::Worker::onTimeout()
 {
     for (const Path &path : asConst(m_watchedByTimeoutFolders))
@@ -490,11 +555,12 @@ void TorrentFilesWatcher::Worker::setWatchedFolder(const Path &path, const Torre
 void TorrentFilesWatcher::Worker::removeWatchedFolder(const Path &path)
 {
     m_watchedFolders.remove(path);
+    stopWatching(path);
 
-    m_watcher->removePath(path.data());
-    m_watchedByTimeoutFolders.remove(path);
-    if (m_watchedByTimeoutFolders.isEmpty())
-        m_watchTimer->stop();
+    Algorithm::removeIf(m_pendingFiles, [&path](const Path &, const PendingFile &pendingFile)
+    {
+        return (pendingFile.watchedFolderPath == path);
+    });
 
     m_failedTorrents.remove(path);
     if (m_failedTorrents.isEmpty())
@@ -511,11 +577,11 @@ void TorrentFilesWatcher::Worker::scheduleWatchedFolderProcessing(const Path &pa
 
 void TorrentFilesWatcher::Worker::processWatchedFolder(const Path &path)
 {
-    const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(path);
-    processFolder(path, path, options);
+    const auto iter = m_watchedFolders.constFind(path);
+    if (iter == m_watchedFolders.cend())
+        return;
 
-    if (!m_failedTorrents.empty() && !m_retryTorrentTimer->isActive())
-        m_retryTorrentTimer->start(WATCH_INTERVAL);
+    processFolder(path, path, iter.value());
 }
 
 void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &watchedFolderPath
@@ -523,24 +589,92 @@ void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &wa
 {
     QDirIterator dirIter {path.data(), {u"*.torrent"_qs, u"*.magnet"_qs}, QDir::Files};
     while (dirIter.hasNext())
+        enqueueFile(Path(dirIter.next()), watchedFolderPath);
+
+    if (options.recursive)
     {
-        const Path filePath {dirIter.next()};
-        BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
-        if (path != watchedFolderPath)
+        QDirIterator dirIter {path.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
+        while (dirIter.hasNext())
         {
-            const Path subdirPath = watchedFolderPath.relativePathOf(path);
-            const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
-            if (useAutoTMM)
-            {
-                addTorrentParams.category = addTorrentParams.category.isEmpty()
-                        ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
-            }
-            else
-            {
-                addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
-            }
+            const Path folderPath {dirIter.next()};
+            // Skip processing of subdirectory that is explicitly set as watched folder
+            if (!m_watchedFolders.contains(folderPath))
+                processFolder(folderPath, watchedFolderPath, options);
+        }
+    }
+}
+
+void TorrentFilesWatcher::Worker::enqueueFile(const Path &filePath, const Path &watchedFolderPath)
+{
+    // Failed torrents are retried by their own timer
+    if (const auto iter = m_failedTorrents.constFind(watchedFolderPath);
+            (iter != m_failedTorrents.cend()) && iter->contains(filePath))
+    {
+        return;
+    }
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    PendingFile &pendingFile = m_pendingFiles[filePath];
+    pendingFile.watchedFolderPath = watchedFolderPath;
+    pendingFile.lastEventTime = now;
+
+    if (!m_pendingFilesTimer->isActive())
+        m_pendingFilesTimer->start(FILE_EVENTS_DEBOUNCE_DELAY);
+}
+
+void TorrentFilesWatcher::Worker::processPendingFiles()
+{
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    const qint64 debounceDelay = std::chrono::milliseconds(FILE_EVENTS_DEBOUNCE_DELAY).count();
+
+    // Process only the files that haven't been changed recently
+    std::vector<std::pair<Path, PendingFile>> readyFiles;
+    for (auto iter = m_pendingFiles.begin(); (iter != m_pendingFiles.end()) && (readyFiles.size() < MAX_IMPORT_BATCH_SIZE);)
+    {
+        if ((now - iter->lastEventTime) >= debounceDelay)
+        {
+            readyFiles.emplace_back(iter.key(), iter.value());
+            iter = m_pendingFiles.erase(iter);
         }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    if (!m_pendingFiles.isEmpty())
+        m_pendingFilesTimer->start((readyFiles.size() >= MAX_IMPORT_BATCH_SIZE) ? 0ms : FILE_EVENTS_DEBOUNCE_DELAY);
+
+    if (readyFiles.empty())
+        return;
+
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    // .torrent files are parsed in parallel since it is the most expensive part of import
+    std::vector<nonstd::expected<BitTorrent::TorrentInfo, QString>> parsingResults(readyFiles.size());
+    for (std::size_t i = 0; i < readyFiles.size(); ++i)
+    {
+        const Path &filePath = readyFiles[i].first;
+        if (!filePath.hasExtension(u".torrent"_qs))
+            continue;
+
+        m_parsingThreadPool->start([&parsingResult = parsingResults[i], filePath]
+        {
+            parsingResult = BitTorrent::TorrentInfo::loadFromFile(filePath);
+        });
+    }
+    m_parsingThreadPool->waitForDone();
 
+    QVector<TorrentFilesWatcher::FoundTorrent> foundTorrents;
+    foundTorrents.reserve(static_cast<int>(readyFiles.size()));
+    for (std::size_t i = 0; i < readyFiles.size(); ++i)
+    {
+        const auto &[filePath, pendingFile] = readyFiles[i];
+        if (!filePath.exists())
+            continue;
+
+        const BitTorrent::AddTorrentParams addTorrentParams = makeAddTorrentParams(filePath, pendingFile.watchedFolderPath);
         if (filePath.hasExtension(u".magnet"_qs))
         {
             QFile file {filePath.data()};
@@ -549,7 +683,8 @@ void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &wa
                 while (!file.atEnd())
                 {
                     const auto line = QString::fromLatin1(file.readLine()).trimmed();
-                    emit magnetFound(BitTorrent::MagnetUri(line), addTorrentParams);
+                    if (!line.isEmpty())
+                        foundTorrents.append({BitTorrent::MagnetUri(line), addTorrentParams});
                 }
 
                 file.close();
@@ -562,66 +697,48 @@ void TorrentFilesWatcher::Worker::processFolder(const Path &path, const Path &wa
         }
         else
         {
-            const nonstd::expected<BitTorrent::TorrentInfo, QString> result = BitTorrent::TorrentInfo::loadFromFile(filePath);
+            const nonstd::expected<BitTorrent::TorrentInfo, QString> &result = parsingResults[i];
             if (result)
             {
-                emit torrentFound(result.value(), addTorrentParams);
+                foundTorrents.append({result.value(), addTorrentParams});
                 Utils::Fs::removeFile(filePath);
             }
             else
             {
-                if (!m_failedTorrents.value(path).contains(filePath))
-                {
-                    m_failedTorrents[path][filePath] = 0;
-                }
+                // probably it is still being written
+                m_failedTorrents[pendingFile.watchedFolderPath].insert(filePath, 0);
             }
         }
     }
 
-    if (options.recursive)
-    {
-        QDirIterator dirIter {path.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
-        while (dirIter.hasNext())
-        {
-            const Path folderPath {dirIter.next()};
-            // Skip processing of subdirectory that is explicitly set as watched folder
-            if (!m_watchedFolders.contains(folderPath))
-                processFolder(folderPath, watchedFolderPath, options);
-        }
-    }
+    if (!m_failedTorrents.empty() && !m_retryTorrentTimer->isActive())
+        m_retryTorrentTimer->start(WATCH_INTERVAL);
+
+    notifyTorrentsFound(foundTorrents, static_cast<int>(readyFiles.size()), elapsedTimer.elapsed());
 }
 
 void TorrentFilesWatcher::Worker::processFailedTorrents()
 {
+    QElapsedTimer elapsedTimer;
+    elapsedTimer.start();
+
+    int processedFilesCount = 0;
+    QVector<TorrentFilesWatcher::FoundTorrent> foundTorrents;
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
     // Check which torrents are still partial
-    Algorithm::removeIf(m_failedTorrents, [this](const Path &watchedFolderPath, QHash<Path, int> &partialTorrents)
+    Algorithm::removeIf(m_failedTorrents, [&](const Path &watchedFolderPath, QHash<Path, int> &partialTorrents)
     {
-        const TorrentFilesWatcher::WatchedFolderOptions options = m_watchedFolders.value(watchedFolderPath);
-        Algorithm::removeIf(partialTorrents, [this, &watchedFolderPath, &options](const Path &torrentPath, int &value)
+        Algorithm::removeIf(partialTorrents, [&](const Path &torrentPath, int &value)
         {
             if (!torrentPath.exists())
                 return true;
 
+            ++processedFilesCount;
             const nonstd::expected<BitTorrent::TorrentInfo, QString> result = BitTorrent::TorrentInfo::loadFromFile(torrentPath);
             if (result)
             {
-                BitTorrent::AddTorrentParams addTorrentParams = options.addTorrentParams;
-                if (torrentPath != watchedFolderPath)
-                {
-                    const Path subdirPath = watchedFolderPath.relativePathOf(torrentPath);
-                    const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
-                    if (useAutoTMM)
-                    {
-                        addTorrentParams.category = addTorrentParams.category.isEmpty()
-                                ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
-                    }
-                    else
-                    {
-                        addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
-                    }
-                }
-
-                emit torrentFound(result.value(), addTorrentParams);
+                foundTorrents.append({result.value(), makeAddTorrentParams(torrentPath, watchedFolderPath), now});
                 Utils::Fs::removeFile(torrentPath);
 
                 return true;
@@ -649,24 +766,48 @@ void TorrentFilesWatcher::Worker::processFailedTorrents()
         m_retryTorrentTimer->stop();
     else
         m_retryTorrentTimer->start(WATCH_INTERVAL);
+
+    if (processedFilesCount > 0)
+        notifyTorrentsFound(foundTorrents, processedFilesCount, elapsedTimer.elapsed());
 }
 
-void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+BitTorrent::AddTorrentParams TorrentFilesWatcher::Worker::makeAddTorrentParams(const Path &filePath, const Path &watchedFolderPath) const
 {
-    // Check if the `path` points to a network file system or not
-    if (Utils::Fs::isNetworkFileSystem(path) || options.recursive)
+    BitTorrent::AddTorrentParams addTorrentParams = m_watchedFolders.value(watchedFolderPath).addTorrentParams;
+
+    const Path folderPath = filePath.parentPath();
+    if (folderPath != watchedFolderPath)
     {
-        m_watchedByTimeoutFolders.insert(path);
-        if (!m_watchTimer->isActive())
-            m_watchTimer->start(WATCH_INTERVAL);
+        const Path subdirPath = watchedFolderPath.relativePathOf(folderPath);
+        const bool useAutoTMM = addTorrentParams.useAutoTMM.value_or(!BitTorrent::Session::instance()->isAutoTMMDisabledByDefault());
+        if (useAutoTMM)
+        {
+            addTorrentParams.category = addTorrentParams.category.isEmpty()
+                    ? subdirPath.data() : (addTorrentParams.category + u'/' + subdirPath.data());
+        }
+        else
+        {
+            addTorrentParams.savePath = addTorrentParams.savePath / subdirPath;
+        }
     }
-    else
+
+    return addTorrentParams;
+}
+
+void TorrentFilesWatcher::Worker::notifyTorrentsFound(QVector<TorrentFilesWatcher::FoundTorrent> torrents
+        , const int processedFilesCount, const qint64 elapsedTime)
+{
+    // found torrents are handed over to the session all at once
+    QMetaObject::invokeMethod(m_owner, [owner = m_owner, torrents = std::move(torrents), processedFilesCount, elapsedTime]()
     {
-        m_watcher->addPath(path.data());
-        scheduleWatchedFolderProcessing(path);
-    }
+        owner->onTorrentsFound(torrents, processedFilesCount, elapsedTime);
+    });
+}
 
+void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
     m_watchedFolders[path] = options;
+    startWatching(path, options);
 
     LogMsg(tr("Watching folder: \"%1\"").arg(path.toString()));
 }
@@ -674,28 +815,170 @@ void TorrentFilesWatcher::Worker::addWatchedFolder(const Path &path, const Torre
 void TorrentFilesWatcher::Worker::updateWatchedFolder(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
 {
     const bool recursiveModeChanged = (m_watchedFolders[path].recursive != options.recursive);
-    if (recursiveModeChanged && !Utils::Fs::isNetworkFileSystem(path))
+    m_watchedFolders[path] = options;
+
+    if (recursiveModeChanged)
+    {
+        stopWatching(path);
+        startWatching(path, options);
+    }
+}
+
+void TorrentFilesWatcher::Worker::startWatching(const Path &path, const TorrentFilesWatcher::WatchedFolderOptions &options)
+{
+    // Network file systems don't support change notifications so they are polled.
+    // Generic file system watcher doesn't support watching subdirectories,
+    // so recursively watched folders are polled unless inotify is available.
+    const bool isNetworkFileSystem = Utils::Fs::isNetworkFileSystem(path);
+#ifdef Q_OS_LINUX
+    const bool isWatchedByInotify = !isNetworkFileSystem && initInotify()
+            && addInotifyWatches(path, path, options.recursive);
+#else
+    const bool isWatchedByInotify = false;
+#endif
+
+    if (isNetworkFileSystem || (!isWatchedByInotify && options.recursive))
+        m_watchedByTimeoutFolders.insert(path);
+    else if (!isWatchedByInotify)
+        m_watcher->addPath(path.data());
+
+    if (m_watchedByTimeoutFolders.contains(path) && !m_watchTimer->isActive())
+        m_watchTimer->start(WATCH_INTERVAL);
+
+    scheduleWatchedFolderProcessing(path);
+}
+
+void TorrentFilesWatcher::Worker::stopWatching(const Path &path)
+{
+    m_watcher->removePath(path.data());
+#ifdef Q_OS_LINUX
+    removeInotifyWatches(path);
+#endif
+
+    m_watchedByTimeoutFolders.remove(path);
+    if (m_watchedByTimeoutFolders.isEmpty())
+        m_watchTimer->stop();
+}
+
+#ifdef Q_OS_LINUX
+bool TorrentFilesWatcher::Worker::initInotify()
+{
+    if (m_inotifyFD >= 0)
+        return true;
+
+    m_inotifyFD = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFD < 0)
     {
-        if (options.recursive)
+        LogMsg(tr("Failed to initialize inotify, generic file system watcher will be used. Reason: %1")
+            .arg(QString::fromLocal8Bit(std::strerror(errno))), Log::WARNING);
+        return false;
+    }
+
+    m_inotifyNotifier = new QSocketNotifier(m_inotifyFD, QSocketNotifier::Read, this);
+    connect(m_inotifyNotifier, &QSocketNotifier::activated, this, &Worker::readInotifyEvents);
+    return true;
+}
+
+bool TorrentFilesWatcher::Worker::addInotifyWatches(const Path &dirPath, const Path &watchedFolderPath, const bool recursive)
+{
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR;
+    const int wd = ::inotify_add_watch(m_inotifyFD, QFile::encodeName(dirPath.data()).constData(), mask);
+    if (wd < 0)
+    {
+        LogMsg(tr("Failed to watch folder: \"%1\". Reason: %2")
+            .arg(dirPath.toString(), QString::fromLocal8Bit(std::strerror(errno))), Log::WARNING);
+        return false;
+    }
+
+    m_inotifyWatches[wd] = {dirPath, watchedFolderPath};
+
+    if (recursive)
+    {
+        QDirIterator dirIter {dirPath.data(), (QDir::Dirs | QDir::NoDot | QDir::NoDotDot)};
+        while (dirIter.hasNext())
         {
-            m_watcher->removePath(path.data());
+            const Path folderPath {dirIter.next()};
+            // Skip subdirectory that is explicitly set as watched folder
+            if (!m_watchedFolders.contains(folderPath))
+                addInotifyWatches(folderPath, watchedFolderPath, true);
+        }
+    }
 
-            m_watchedByTimeoutFolders.insert(path);
-            if (!m_watchTimer->isActive())
-                m_watchTimer->start(WATCH_INTERVAL);
+    return true;
+}
+
+void TorrentFilesWatcher::Worker::removeInotifyWatches(const Path &watchedFolderPath)
+{
+    for (auto iter = m_inotifyWatches.begin(); iter != m_inotifyWatches.end();)
+    {
+        if (iter->second == watchedFolderPath)
+        {
+            ::inotify_rm_watch(m_inotifyFD, iter.key());
+            iter = m_inotifyWatches.erase(iter);
         }
         else
         {
-            m_watchedByTimeoutFolders.remove(path);
-            if (m_watchedByTimeoutFolders.isEmpty())
-                m_watchTimer->stop();
-
-            m_watcher->addPath(path.data());
-            scheduleWatchedFolderProcessing(path);
+            ++iter;
         }
     }
+}
 
-    m_watchedFolders[path] = options;
+void TorrentFilesWatcher::Worker::readInotifyEvents()
+{
+    alignas(inotify_event) char buffer[16 * 1024];
+    while (true)
+    {
+        const ssize_t length = ::read(m_inotifyFD, buffer, sizeof(buffer));
+        if (length <= 0)
+            break;
+
+        for (const char *ptr = buffer; ptr < (buffer + length);)
+        {
+            const auto *event = reinterpret_cast<const inotify_event *>(ptr);
+            ptr += (sizeof(inotify_event) + event->len);
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // some events were lost
+                for (auto iter = m_watchedFolders.cbegin(); iter != m_watchedFolders.cend(); ++iter)
+                    scheduleWatchedFolderProcessing(iter.key());
+                continue;
+            }
+
+            const auto watchIter = m_inotifyWatches.constFind(event->wd);
+            if (watchIter == m_inotifyWatches.cend())
+                continue;
+
+            if (event->mask & IN_IGNORED)
+            {
+                // watched directory was removed
+                m_inotifyWatches.erase(watchIter);
+                continue;
+            }
+
+            if (event->len == 0)
+                continue;
+
+            const auto [dirPath, watchedFolderPath] = watchIter.value();
+            const Path path = dirPath / Path(QFile::decodeName(event->name));
+            if (event->mask & IN_ISDIR)
+            {
+                const auto folderIter = m_watchedFolders.constFind(watchedFolderPath);
+                if ((folderIter != m_watchedFolders.cend()) && folderIter->recursive && !m_watchedFolders.contains(path))
+                {
+                    // new subdirectory can already contain some files
+                    addInotifyWatches(path, watchedFolderPath, true);
+                    processFolder(path, watchedFolderPath, folderIter.value());
+                }
+            }
+            else if (path.hasExtension(u".torrent"_qs) || path.hasExtension(u".magnet"_qs))
+            {
+                if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                    enqueueFile(path, watchedFolderPath);
+            }
+        }
+    }
 }
+#endif
 
 #include "torrentfileswatcher.moc"
@@ -30,6 +30,7 @@
 #pragma once
 
 #include <QHash>
+#include <QVector>
 
 #include "base/bittorrent/addtorrentparams.h"
 #include "base/path.h"
@@ -37,15 +38,12 @@
 
 class QThread;
 
-namespace BitTorrent
-{
-    class MagnetUri;
-}
-
 /*
  * Watches the configured directories for new .torrent files in order
  * to add torrents to BitTorrent session. Supports Network File System
  * watching (NFS, CIFS) on Linux and Mac OS.
+ * On Linux the file change notifications are received via inotify,
+ * found files are parsed in parallel and added to session in batches.
  */
 class TorrentFilesWatcher final : public QObject
 {
@@ -71,11 +69,9 @@ signals:
     void watchedFolderSet(const Path &path, const WatchedFolderOptions &options);
     void watchedFolderRemoved(const Path &path);
 
-private slots:
-    void onMagnetFound(const BitTorrent::MagnetUri &magnetURI, const BitTorrent::AddTorrentParams &addTorrentParams);
-    void onTorrentFound(const BitTorrent::TorrentInfo &torrentInfo, const BitTorrent::AddTorrentParams &addTorrentParams);
-
 private:
+    struct FoundTorrent;
+
     explicit TorrentFilesWatcher(QObject *parent = nullptr);
     ~TorrentFilesWatcher() override;
 
@@ -85,6 +81,7 @@ private:
     void store() const;
 
     void doSetWatchedFolder(const Path &path, const WatchedFolderOptions &options);
+    void onTorrentsFound(const QVector<FoundTorrent> &torrents, int processedFilesCount, qint64 elapsedTime);
 
     static TorrentFilesWatcher *m_instance;
 
@@ -152,12 +152,21 @@ bool TorrentFilter::match(const Torrent *const torrent) const
 {
     if (!torrent) return false;
 
-    return (matchState(torrent) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent));
+    return (matchState(torrent, m_type) && matchHash(torrent) && matchCategory(torrent) && matchTag(torrent));
 }
 
-bool TorrentFilter::matchState(const BitTorrent::Torrent *const torrent) const
+TorrentFilter::TypeFlags TorrentFilter::matchedTypes(const Torrent *const torrent)
 {
-    switch (m_type)
+    TypeFlags types;
+    for (int type = 0; type < TypeCount; ++type)
+        types.set(type, matchState(torrent, static_cast<Type>(type)));
+
+    return types;
+}
+
+bool TorrentFilter::matchState(const BitTorrent::Torrent *const torrent, const Type type)
+{
+    switch (type)
     {
     case All:
     default:
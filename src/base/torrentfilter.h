@@ -28,6 +28,7 @@
 
 #pragma once
 
+#include <bitset>
 #include <optional>
 
 #include <QSet>
@@ -63,6 +64,10 @@ public:
         Errored
     };
 
+    static constexpr int TypeCount = Errored + 1;
+    // Set of state filter types, indexed by Type
+    using TypeFlags = std::bitset<TypeCount>;
+
     // These mean any permutation, including no category / tag.
     static const std::optional<QString> AnyCategory;
     static const std::optional<TorrentIDSet> AnyID;
@@ -97,8 +102,11 @@ public:
 
     bool match(const BitTorrent::Torrent *torrent) const;
 
+    // Returns all state filter types matched by torrent (including All)
+    static TypeFlags matchedTypes(const BitTorrent::Torrent *torrent);
+
 private:
-    bool matchState(const BitTorrent::Torrent *torrent) const;
+    static bool matchState(const BitTorrent::Torrent *torrent, Type type);
     bool matchHash(const BitTorrent::Torrent *torrent) const;
     bool matchCategory(const BitTorrent::Torrent *torrent) const;
     bool matchTag(const BitTorrent::Torrent *torrent) const;
@@ -28,6 +28,8 @@
 
 #include "compare.h"
 
+#include <QtEndian>
+#include <QByteArray>
 #include <QChar>
 #include <QString>
 
@@ -93,4 +95,50 @@ int Utils::Compare::naturalCompare(const QString &left, const QString &right, co
         }
     }
 }
+
+QByteArray Utils::Compare::naturalSortKey(const QString &str, const Qt::CaseSensitivity caseSensitivity)
+{
+    // Every code unit is stored big-endian so that byte order matches `QChar::unicode()` order.
+    // A run of digits is stored as a fixed marker followed by the run length and the digits themselves,
+    // so that numbers are ordered by their length first and then digit by digit, like `naturalCompare()` does.
+    // Digits of any script are stored as ASCII ones (by their value), so there is no other character
+    // in the range of '0'..'9' and the marker (which is the code unit of '0') keeps a number
+    // ordered correctly against a non-digit character.
+    const auto appendUInt16 = [](QByteArray &key, const quint16 value)
+    {
+        const quint16 beValue = qToBigEndian(value);
+        key.append(reinterpret_cast<const char *>(&beValue), sizeof(beValue));
+    };
+    const auto appendUInt32 = [](QByteArray &key, const quint32 value)
+    {
+        const quint32 beValue = qToBigEndian(value);
+        key.append(reinterpret_cast<const char *>(&beValue), sizeof(beValue));
+    };
+
+    QByteArray key;
+    key.reserve(str.size() * 2);
+
+    int pos = 0;
+    while (pos < str.size())
+    {
+        const QChar ch = str[pos];
+        if (!ch.isDigit())
+        {
+            appendUInt16(key, ((caseSensitivity == Qt::CaseSensitive) ? ch : ch.toLower()).unicode());
+            ++pos;
+            continue;
+        }
+
+        const int start = pos;
+        while ((pos < str.size()) && str[pos].isDigit())
+            ++pos;
+
+        appendUInt16(key, u'0');
+        appendUInt32(key, static_cast<quint32>(pos - start));
+        for (int i = start; i < pos; ++i)
+            appendUInt16(key, static_cast<quint16>(u'0' + str[i].digitValue()));
+    }
+
+    return key;
+}
 #endif
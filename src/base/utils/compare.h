@@ -30,10 +30,15 @@
 
 #include <Qt>
 #include <QtGlobal>
+#include <QMetaType>
 
 #if !defined(Q_OS_WIN) && (!defined(Q_OS_UNIX) || defined(Q_OS_MACOS) || defined(QT_FEATURE_icu))
 #define QBT_USE_QCOLLATOR
+#include <optional>
+
 #include <QCollator>
+#else
+#include <QByteArray>
 #endif
 
 class QString;
@@ -41,27 +46,37 @@ class QString;
 namespace Utils::Compare
 {
 #ifdef QBT_USE_QCOLLATOR
+    // Collator initialization is expensive so share a single instance per thread
+    // (QCollator is reentrant but not thread-safe)
     template <Qt::CaseSensitivity caseSensitivity>
-    class NaturalCompare
+    const QCollator &naturalCollator()
     {
-    public:
-        NaturalCompare()
+        thread_local const QCollator collator = []
         {
-            m_collator.setNumericMode(true);
-            m_collator.setCaseSensitivity(caseSensitivity);
-        }
+            QCollator result;
+            result.setNumericMode(true);
+            result.setCaseSensitivity(caseSensitivity);
+            return result;
+        }();
+        return collator;
+    }
 
+    template <Qt::CaseSensitivity caseSensitivity>
+    class NaturalCompare
+    {
+    public:
         int operator()(const QString &left, const QString &right) const
         {
-            return m_collator.compare(left, right);
+            return naturalCollator<caseSensitivity>().compare(left, right);
         }
-
-    private:
-        QCollator m_collator;
     };
 #else
     int naturalCompare(const QString &left, const QString &right, Qt::CaseSensitivity caseSensitivity);
 
+    // Returns a byte string such that comparing two keys with `memcmp()` yields
+    // the same order as `naturalCompare()` on the original strings.
+    QByteArray naturalSortKey(const QString &str, Qt::CaseSensitivity caseSensitivity);
+
     template <Qt::CaseSensitivity caseSensitivity>
     class NaturalCompare
     {
@@ -85,4 +100,49 @@ namespace Utils::Compare
     private:
         NaturalCompare<caseSensitivity> m_comparator;
     };
+
+    // Precomputed form of a string which orders the same as `NaturalCompare`.
+    // Computing it costs about as much as a single `NaturalCompare` call but comparing two keys
+    // is a plain byte comparison, so it pays off when the same strings are compared repeatedly (e.g. sorting).
+    template <Qt::CaseSensitivity caseSensitivity>
+    class NaturalSortKey
+    {
+    public:
+        NaturalSortKey() = default;
+
+        explicit NaturalSortKey(const QString &str)
+#ifdef QBT_USE_QCOLLATOR
+            : m_key {naturalCollator<caseSensitivity>().sortKey(str)}
+#else
+            : m_key {naturalSortKey(str, caseSensitivity)}
+#endif
+        {
+        }
+
+        int compare(const NaturalSortKey &other) const
+        {
+#ifdef QBT_USE_QCOLLATOR
+            if (!m_key || !other.m_key)
+                return (m_key.has_value() - other.m_key.has_value());
+            return m_key->compare(*other.m_key);
+#else
+            return m_key.compare(other.m_key);
+#endif
+        }
+
+        friend bool operator<(const NaturalSortKey &left, const NaturalSortKey &right)
+        {
+            return (left.compare(right) < 0);
+        }
+
+    private:
+#ifdef QBT_USE_QCOLLATOR
+        std::optional<QCollatorSortKey> m_key;
+#else
+        QByteArray m_key;
+#endif
+    };
 }
+
+Q_DECLARE_METATYPE(Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>)
+Q_DECLARE_METATYPE(Utils::Compare::NaturalSortKey<Qt::CaseSensitive>)
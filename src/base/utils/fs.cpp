@@ -214,6 +214,21 @@ qint64 Utils::Fs::freeDiskSpaceOnPath(const Path &path)
     return QStorageInfo(path.data()).bytesAvailable();
 }
 
+QString Utils::Fs::storageDeviceID(const Path &path)
+{
+    // the path may not exist yet (e.g. it is a destination of some operation),
+    // so the closest existing ancestor is used
+    Path existingPath = path;
+    while (!existingPath.isEmpty() && !existingPath.exists())
+        existingPath = existingPath.parentPath();
+
+    const QStorageInfo storageInfo {existingPath.data()};
+    if (!storageInfo.isValid())
+        return path.rootItem().data();
+
+    return QString::fromLocal8Bit(storageInfo.device());
+}
+
 Path Utils::Fs::tempPath()
 {
     static const Path path = Path(QDir::tempPath()) / Path(u".qBittorrent"_qs);
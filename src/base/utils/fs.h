@@ -44,6 +44,7 @@ namespace Utils::Fs
 {
     qint64 computePathSize(const Path &path);
     qint64 freeDiskSpaceOnPath(const Path &path);
+    QString storageDeviceID(const Path &path);
 
     bool isRegularFile(const Path &path);
     bool isDir(const Path &path);
@@ -37,6 +37,7 @@
 
 #include "base/bittorrent/session.h"
 #include "base/global.h"
+#include "base/path.h"
 #include "base/preferences.h"
 #include "base/unicodestrings.h"
 #include "gui/addnewtorrentdialog.h"
@@ -77,6 +78,11 @@ namespace
         SAVE_RESUME_DATA_INTERVAL,
         CONFIRM_RECHECK_TORRENT,
         RECHECK_COMPLETED,
+        // external programs
+        AUTORUN_MAX_CONCURRENT_PROGRAMS,
+        AUTORUN_TIMEOUT,
+        AUTORUN_BATCHING,
+        TORRENT_EVENT_STREAM_PATH,
         // UI related
         LIST_REFRESH,
         RESOLVE_HOSTS,
@@ -253,6 +259,11 @@ void AdvancedSettings::saveAdvancedSettings() const
     session->setBlockPeersOnPrivilegedPorts(m_checkBoxBlockPeersOnPrivilegedPorts.isChecked());
     // Recheck torrents on completion
     pref->recheckTorrentsOnCompletion(m_checkBoxRecheckCompleted.isChecked());
+    // External programs
+    pref->setAutoRunMaxConcurrentPrograms(m_spinBoxAutoRunMaxConcurrentPrograms.value());
+    pref->setAutoRunTimeout(m_spinBoxAutoRunTimeout.value());
+    pref->setAutoRunBatchingEnabled(m_checkBoxAutoRunBatching.isChecked());
+    pref->setTorrentEventStreamPath(Path(m_lineEditTorrentEventStreamPath.text().trimmed()));
     // Transfer list refresh interval
     session->setRefreshInterval(m_spinBoxListRefresh.value());
     // Peer resolution
@@ -641,6 +652,26 @@ void AdvancedSettings::loadAdvancedSettings()
     // Recheck completed torrents
     m_checkBoxRecheckCompleted.setChecked(pref->recheckTorrentsOnCompletion());
     addRow(RECHECK_COMPLETED, tr("Recheck torrents on completion"), &m_checkBoxRecheckCompleted);
+    // External programs
+    m_spinBoxAutoRunMaxConcurrentPrograms.setMinimum(1);
+    m_spinBoxAutoRunMaxConcurrentPrograms.setMaximum(64);
+    m_spinBoxAutoRunMaxConcurrentPrograms.setValue(pref->getAutoRunMaxConcurrentPrograms());
+    m_spinBoxAutoRunMaxConcurrentPrograms.setToolTip(tr("Programs to run on torrent added/finished are queued when this limit is reached"));
+    addRow(AUTORUN_MAX_CONCURRENT_PROGRAMS, tr("Maximum concurrently running external programs"), &m_spinBoxAutoRunMaxConcurrentPrograms);
+    m_spinBoxAutoRunTimeout.setMinimum(0);
+    m_spinBoxAutoRunTimeout.setMaximum(7 * 24 * 3600);
+    m_spinBoxAutoRunTimeout.setValue(pref->getAutoRunTimeout());
+    m_spinBoxAutoRunTimeout.setSuffix(tr(" s", " seconds"));
+    m_spinBoxAutoRunTimeout.setSpecialValueText(tr("Unlimited"));
+    m_spinBoxAutoRunTimeout.setToolTip(tr("External programs running longer than this are killed"));
+    addRow(AUTORUN_TIMEOUT, tr("External program timeout"), &m_spinBoxAutoRunTimeout);
+    m_checkBoxAutoRunBatching.setChecked(pref->isAutoRunBatchingEnabled());
+    m_checkBoxAutoRunBatching.setToolTip(tr("Run external program once for several torrents added/finished at the same time."
+        " Every argument containing a parameter is repeated for each torrent."));
+    addRow(AUTORUN_BATCHING, tr("Run external program for batches of torrents"), &m_checkBoxAutoRunBatching);
+    m_lineEditTorrentEventStreamPath.setText(pref->getTorrentEventStreamPath().toString());
+    m_lineEditTorrentEventStreamPath.setToolTip(tr("Torrent added/finished events are written as JSON lines to this local socket or FIFO. Leave empty to disable."));
+    addRow(TORRENT_EVENT_STREAM_PATH, tr("Torrent event stream socket/FIFO path"), &m_lineEditTorrentEventStreamPath);
     // Refresh interval
     m_spinBoxListRefresh.setMinimum(30);
     m_spinBoxListRefresh.setMaximum(99999);
@@ -212,9 +212,19 @@ LogPeerModel::LogPeerModel(QObject *parent)
 void LogPeerModel::handleNewMessage(const Log::Peer &peer)
 {
     const QString time = QLocale::system().toString(QDateTime::fromSecsSinceEpoch(peer.timestamp), QLocale::ShortFormat);
-    const QString message = peer.blocked
-            ? tr("%1 was blocked. Reason: %2.", "0.0.0.0 was blocked. Reason: reason for blocking.").arg(peer.ip, peer.reason)
-            : tr("%1 was banned", "0.0.0.0 was banned").arg(peer.ip);
+    QString message;
+    if (peer.count > 1)
+    {
+        message = peer.blocked
+                ? tr("%1 was blocked %2 times. Reason: %3.", "0.0.0.0 was blocked 3 times. Reason: reason for blocking.").arg(peer.ip, QString::number(peer.count), peer.reason)
+                : tr("%1 was banned %2 times", "0.0.0.0 was banned 3 times").arg(peer.ip, QString::number(peer.count));
+    }
+    else
+    {
+        message = peer.blocked
+                ? tr("%1 was blocked. Reason: %2.", "0.0.0.0 was blocked. Reason: reason for blocking.").arg(peer.ip, peer.reason)
+                : tr("%1 was banned", "0.0.0.0 was banned").arg(peer.ip);
+    }
 
     addNewMessage({time, message, m_bannedPeerForeground, Log::NORMAL});
 }
@@ -51,8 +51,7 @@
 #include "base/bittorrent/torrentinfo.h"
 #include "base/global.h"
 #include "base/logger.h"
-#include "base/net/geoipmanager.h"
-#include "base/net/reverseresolution.h"
+#include "base/net/peermetadataresolver.h"
 #include "base/preferences.h"
 #include "base/utils/misc.h"
 #include "base/utils/string.h"
@@ -170,6 +169,8 @@ PeerListWidget::PeerListWidget(PropertiesWidget *parent)
     // Enable sorting
     setSortingEnabled(true);
     // IP to Hostname resolver
+    connect(Net::PeerMetadataResolver::instance(), &Net::PeerMetadataResolver::hostNamesResolved
+        , this, &PeerListWidget::handleHostNamesResolved);
     updatePeerHostNameResolutionState();
     // SIGNAL/SLOT
     header()->setContextMenuPolicy(Qt::CustomContextMenu);
@@ -234,20 +235,13 @@ void PeerListWidget::displayColumnHeaderMenu()
 
 void PeerListWidget::updatePeerHostNameResolutionState()
 {
-    if (Preferences::instance()->resolvePeerHostNames())
-    {
-        if (!m_resolver)
-        {
-            m_resolver = new Net::ReverseResolution(this);
-            connect(m_resolver, &Net::ReverseResolution::ipResolved, this, &PeerListWidget::handleResolved);
-            loadPeers(m_properties->getCurrentTorrent());
-        }
-    }
-    else
-    {
-        delete m_resolver;
-        m_resolver = nullptr;
-    }
+    const bool resolveHostNames = Preferences::instance()->resolvePeerHostNames();
+    if (resolveHostNames == m_resolveHostNames)
+        return;
+
+    m_resolveHostNames = resolveHostNames;
+    if (m_resolveHostNames)
+        loadPeers(m_properties->getCurrentTorrent());
 }
 
 void PeerListWidget::updatePeerCountryResolutionState()
@@ -342,11 +336,9 @@ void PeerListWidget::banSelectedPeers()
         , tr("Are you sure you want to permanently ban the selected peers?"));
     if (btn != QMessageBox::Yes) return;
 
-    for (const QString &ip : selectedIPs)
-    {
-        BitTorrent::Session::instance()->banIP(ip);
+    BitTorrent::Session::instance()->banIPs(selectedIPs);
+    for (const QString &ip : asConst(selectedIPs))
         LogMsg(tr("Peer \"%1\" is manually banned").arg(ip));
-    }
     // Refresh list
     loadPeers(m_properties->getCurrentTorrent());
 }
@@ -491,17 +483,21 @@ void PeerListWidget::updatePeer(const BitTorrent::Torrent *torrent, const BitTor
     const QString downloadingFilesDisplayValue = downloadingFiles.join(u';');
     setModelData(row, PeerListColumns::DOWNLOADING_PIECE, downloadingFilesDisplayValue, downloadingFilesDisplayValue, {}, downloadingFiles.join(u'\n'));
 
-    if (m_resolver)
-        m_resolver->resolve(peerEndpoint.address.ip);
+    if (!m_resolveHostNames && !m_resolveCountries)
+        return;
+
+    const Net::PeerMetadata metadata = Net::PeerMetadataResolver::instance()->metadata(peerEndpoint.address.ip);
+
+    if (m_resolveHostNames && !metadata.hostName.isEmpty())
+        m_listModel->setData(m_listModel->index(row, PeerListColumns::IP), metadata.hostName, Qt::DisplayRole);
 
     if (m_resolveCountries)
     {
-        const QIcon icon = UIThemeManager::instance()->getFlagIcon(peer.country());
+        const QIcon icon = UIThemeManager::instance()->getFlagIcon(metadata.countryCode);
         if (!icon.isNull())
         {
             m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), icon, Qt::DecorationRole);
-            const QString countryName = Net::GeoIPManager::CountryName(peer.country());
-            m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), countryName, Qt::ToolTipRole);
+            m_listModel->setData(m_listModel->index(row, PeerListColumns::COUNTRY), metadata.countryName, Qt::ToolTipRole);
         }
     }
 }
@@ -518,14 +514,17 @@ int PeerListWidget::visibleColumnsCount() const
     return count;
 }
 
-void PeerListWidget::handleResolved(const QHostAddress &ip, const QString &hostname) const
+void PeerListWidget::handleHostNamesResolved(const QHash<QHostAddress, QString> &hostNames) const
 {
-    if (hostname.isEmpty())
+    if (!m_resolveHostNames)
         return;
 
-    const QSet<QStandardItem *> items = m_itemsByIP.value(ip);
-    for (QStandardItem *item : items)
-        item->setData(hostname, Qt::DisplayRole);
+    for (auto iter = hostNames.cbegin(); iter != hostNames.cend(); ++iter)
+    {
+        const QSet<QStandardItem *> items = m_itemsByIP.value(iter.key());
+        for (QStandardItem *item : items)
+            item->setData(iter.value(), Qt::DisplayRole);
+    }
 }
 
 void PeerListWidget::handleSortColumnChanged(const int col)
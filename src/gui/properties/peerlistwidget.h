@@ -47,11 +47,6 @@ namespace BitTorrent
     class PeerInfo;
 }
 
-namespace Net
-{
-    class ReverseResolution;
-}
-
 class PeerListWidget final : public QTreeView
 {
     Q_OBJECT
@@ -95,7 +90,7 @@ private slots:
     void banSelectedPeers();
     void copySelectedPeers();
     void handleSortColumnChanged(int col);
-    void handleResolved(const QHostAddress &ip, const QString &hostname) const;
+    void handleHostNamesResolved(const QHash<QHostAddress, QString> &hostNames) const;
 
 private:
     void updatePeer(const BitTorrent::Torrent *torrent, const BitTorrent::PeerInfo &peer, bool &isNewPeer);
@@ -106,8 +101,8 @@ private:
     QStandardItemModel *m_listModel = nullptr;
     PeerListSortModel *m_proxyModel = nullptr;
     PropertiesWidget *m_properties = nullptr;
-    Net::ReverseResolution *m_resolver = nullptr;
     QHash<PeerEndpoint, QStandardItem *> m_peerItems;
     QHash<QHostAddress, QSet<QStandardItem *>> m_itemsByIP;  // must be kept in sync with `m_peerItems`
+    bool m_resolveHostNames = false;
     bool m_resolveCountries;
 };
@@ -478,6 +478,27 @@ void RSSWidget::handleCurrentArticleItemChanged(QListWidgetItem *currentItem, QL
     auto article = m_articleListWidget->getRSSArticle(currentItem);
     Q_ASSERT(article);
 
+    if (!article->isBodyLoaded())
+    {
+        // the article is rendered once again when its body is loaded
+        connect(article, &RSS::Article::bodyLoaded, this, &RSSWidget::handleArticleBodyLoaded, Qt::UniqueConnection);
+        article->loadBody();
+    }
+
+    renderArticle(article);
+}
+
+void RSSWidget::handleArticleBodyLoaded(RSS::Article *article)
+{
+    disconnect(article, &RSS::Article::bodyLoaded, this, &RSSWidget::handleArticleBodyLoaded);
+
+    QListWidgetItem *currentItem = m_articleListWidget->currentItem();
+    if (currentItem && (m_articleListWidget->getRSSArticle(currentItem) == article))
+        renderArticle(article);
+}
+
+void RSSWidget::renderArticle(const RSS::Article *article)
+{
     const QString highlightedBaseColor = m_ui->textBrowser->palette().color(QPalette::Highlight).name();
     const QString highlightedBaseTextColor = m_ui->textBrowser->palette().color(QPalette::HighlightedText).name();
     const QString alternateBaseColor = m_ui->textBrowser->palette().color(QPalette::AlternateBase).name();
@@ -491,13 +512,13 @@ void RSSWidget::handleCurrentArticleItemChanged(QListWidgetItem *currentItem, QL
         html += u"<div style='background-color: \"%1\";'><b>%2</b>%3</div>"_qs.arg(alternateBaseColor, tr("Author: "), article->author());
     html += u"</div>"
             u"<div style='margin-left: 5px; margin-right: 5px;'>";
-    if (Qt::mightBeRichText(article->description()))
+    QString description = article->description();
+    if (Qt::mightBeRichText(description))
     {
-        html += article->description();
+        html += description;
     }
     else
     {
-        QString description = article->description();
         QRegularExpression rx;
         // If description is plain text, replace BBCode tags with HTML and wrap everything in <pre></pre> so it looks nice
         rx.setPatternOptions(QRegularExpression::InvertedGreedinessOption
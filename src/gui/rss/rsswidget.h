@@ -38,6 +38,11 @@ class QTreeWidgetItem;
 class ArticleListWidget;
 class FeedListWidget;
 
+namespace RSS
+{
+    class Article;
+}
+
 namespace Ui
 {
     class RSSWidget;
@@ -80,8 +85,11 @@ private slots:
     void on_rssDownloaderBtn_clicked();
     void handleSessionProcessingStateChanged(bool enabled);
     void handleUnreadCountChanged();
+    void handleArticleBodyLoaded(RSS::Article *article);
 
 private:
+    void renderArticle(const RSS::Article *article);
+
     Ui::RSSWidget *m_ui = nullptr;
     ArticleListWidget *m_articleListWidget = nullptr;
     FeedListWidget *m_feedListWidget = nullptr;
@@ -0,0 +1,154 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "searchresultmodel.h"
+
+#include "base/search/searchresultstore.h"
+#include "base/utils/misc.h"
+#include "searchsortmodel.h"
+
+SearchResultModel::SearchResultModel(const SearchResultStore &resultStore, QObject *parent)
+    : QAbstractTableModel(parent)
+    , m_resultStore(resultStore)
+{
+    updateRows();
+}
+
+void SearchResultModel::updateRows()
+{
+    const int newRowCount = m_resultStore.size();
+    if (newRowCount <= m_rowCount)
+        return;
+
+    beginInsertRows({}, m_rowCount, (newRowCount - 1));
+    m_rowCount = newRowCount;
+    endInsertRows();
+}
+
+int SearchResultModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : m_rowCount;
+}
+
+int SearchResultModel::columnCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : SearchSortModel::NB_SEARCH_COLUMNS;
+}
+
+QVariant SearchResultModel::data(const QModelIndex &index, const int role) const
+{
+    if (!index.isValid() || (index.row() >= m_rowCount))
+        return {};
+
+    if (role == Qt::ForegroundRole)
+        return m_rowForegrounds.value(index.row());
+
+    const SearchResult &result = m_resultStore.at(index.row());
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        switch (index.column())
+        {
+        case SearchSortModel::NAME:
+            return result.fileName;
+        case SearchSortModel::SIZE:
+            return Utils::Misc::friendlyUnit(result.fileSize);
+        case SearchSortModel::SEEDS:
+            return QString::number(result.nbSeeders);
+        case SearchSortModel::LEECHES:
+            return QString::number(result.nbLeechers);
+        case SearchSortModel::ENGINE_URL:
+            return result.siteUrl;
+        case SearchSortModel::DL_LINK:
+            return result.fileUrl;
+        case SearchSortModel::DESC_LINK:
+            return result.descrLink;
+        }
+        break;
+    case SearchSortModel::UnderlyingDataRole:
+        switch (index.column())
+        {
+        case SearchSortModel::NAME:
+            return result.fileName;
+        case SearchSortModel::SIZE:
+            return result.fileSize;
+        case SearchSortModel::SEEDS:
+            return result.nbSeeders;
+        case SearchSortModel::LEECHES:
+            return result.nbLeechers;
+        case SearchSortModel::ENGINE_URL:
+            return result.siteUrl;
+        case SearchSortModel::DL_LINK:
+            return result.fileUrl;
+        case SearchSortModel::DESC_LINK:
+            return result.descrLink;
+        }
+        break;
+    case Qt::TextAlignmentRole:
+        switch (index.column())
+        {
+        case SearchSortModel::SIZE:
+        case SearchSortModel::SEEDS:
+        case SearchSortModel::LEECHES:
+            return QVariant(Qt::AlignRight | Qt::AlignVCenter);
+        }
+        break;
+    }
+
+    return {};
+}
+
+bool SearchResultModel::setData(const QModelIndex &index, const QVariant &value, const int role)
+{
+    // only row color can be changed, results themselves are read-only
+    if (!index.isValid() || (index.row() >= m_rowCount) || (role != Qt::ForegroundRole))
+        return false;
+
+    m_rowForegrounds[index.row()] = value;
+    emit dataChanged(this->index(index.row(), 0), this->index(index.row(), (columnCount() - 1)), {Qt::ForegroundRole});
+    return true;
+}
+
+QVariant SearchResultModel::headerData(const int section, const Qt::Orientation orientation, const int role) const
+{
+    if (orientation != Qt::Horizontal)
+        return QAbstractTableModel::headerData(section, orientation, role);
+
+    return m_headerData.value({section, ((role == Qt::EditRole) ? Qt::DisplayRole : role)});
+}
+
+bool SearchResultModel::setHeaderData(const int section, const Qt::Orientation orientation, const QVariant &value, const int role)
+{
+    if ((orientation != Qt::Horizontal) || (section < 0) || (section >= columnCount()))
+        return false;
+
+    m_headerData[{section, ((role == Qt::EditRole) ? Qt::DisplayRole : role)}] = value;
+    emit headerDataChanged(orientation, section, section);
+    return true;
+}
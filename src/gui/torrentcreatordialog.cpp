@@ -39,6 +39,7 @@
 #include "base/bittorrent/torrentinfo.h"
 #include "base/global.h"
 #include "base/utils/fs.h"
+#include "base/utils/misc.h"
 #include "ui_torrentcreatordialog.h"
 #include "utils.h"
 
@@ -78,6 +79,7 @@ TorrentCreatorDialog::TorrentCreatorDialog(QWidget *parent, const Path &defaultP
     connect(m_creatorThread, &BitTorrent::TorrentCreatorThread::creationSuccess, this, &TorrentCreatorDialog::handleCreationSuccess);
     connect(m_creatorThread, &BitTorrent::TorrentCreatorThread::creationFailure, this, &TorrentCreatorDialog::handleCreationFailure);
     connect(m_creatorThread, &BitTorrent::TorrentCreatorThread::updateProgress, this, &TorrentCreatorDialog::updateProgressBar);
+    connect(m_creatorThread, &BitTorrent::TorrentCreatorThread::updateThroughput, this, &TorrentCreatorDialog::updateThroughput);
 
     loadSettings();
     updateInputPath(defaultPath);
@@ -257,9 +259,16 @@ void TorrentCreatorDialog::handleCreationSuccess(const Path &path, const Path &b
 
 void TorrentCreatorDialog::updateProgressBar(int progress)
 {
+    if (progress == 0)
+        m_ui->progressBar->setFormat(u"%p%"_qs);
     m_ui->progressBar->setValue(progress);
 }
 
+void TorrentCreatorDialog::updateThroughput(const qint64 bytesPerSecond)
+{
+    m_ui->progressBar->setFormat(u"%p% (%1)"_qs.arg(Utils::Misc::friendlyUnit(bytesPerSecond, true)));
+}
+
 void TorrentCreatorDialog::updatePiecesCount()
 {
     const Path path {m_ui->textInputPath->text().trimmed()};
@@ -52,6 +52,7 @@ public:
 
 private slots:
     void updateProgressBar(int progress);
+    void updateThroughput(qint64 bytesPerSecond);
     void updatePiecesCount();
     void onCreateButtonClicked();
     void onAddFileButtonClicked();
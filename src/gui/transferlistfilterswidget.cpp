@@ -218,10 +218,13 @@ StatusFilterWidget::StatusFilterWidget(QWidget *parent, TransferListWidget *tran
     setCurrentRow(pref->getTransSelFilter(), QItemSelectionModel::SelectCurrent);
     toggleFilter(pref->getStatusFilterState());
 
-    populate();
+    m_displayedCounts.fill(-1);
+    updateTexts();
 
     connect(BitTorrent::Session::instance(), &BitTorrent::Session::torrentsUpdated
             , this, &StatusFilterWidget::handleTorrentsUpdated);
+    connect(BitTorrent::Session::instance(), &BitTorrent::Session::torrentStateChanged
+            , this, &StatusFilterWidget::handleTorrentStateChanged);
 }
 
 StatusFilterWidget::~StatusFilterWidget()
@@ -229,78 +232,46 @@ StatusFilterWidget::~StatusFilterWidget()
     Preferences::instance()->setTransSelFilter(currentRow());
 }
 
-void StatusFilterWidget::populate()
-{
-    m_torrentsStatus.clear();
-
-    const QVector<BitTorrent::Torrent *> torrents = BitTorrent::Session::instance()->torrents();
-    for (const BitTorrent::Torrent *torrent : torrents)
-        updateTorrentStatus(torrent);
-
-    updateTexts();
-}
-
-void StatusFilterWidget::updateTorrentStatus(const BitTorrent::Torrent *torrent)
+void StatusFilterWidget::updateTexts()
 {
-    TorrentFilterBitset &torrentStatus = m_torrentsStatus[torrent];
-
-    const auto update = [torrent, &torrentStatus](const TorrentFilter::Type status, int &counter)
+    const auto *session = BitTorrent::Session::instance();
+    const auto updateText = [this, session](const TorrentFilter::Type type, const QString &text)
     {
-        const bool hasStatus = torrentStatus[status];
-        const bool needStatus = TorrentFilter(status).match(torrent);
-        if (needStatus && !hasStatus)
-        {
-            ++counter;
-            torrentStatus.set(status);
-        }
-        else if (!needStatus && hasStatus)
-        {
-            --counter;
-            torrentStatus.reset(status);
-        }
+        const qsizetype count = session->torrentsCount(type);
+        if (m_displayedCounts[type] == count)
+            return;
+
+        m_displayedCounts[type] = count;
+        item(type)->setData(Qt::DisplayRole, text.arg(count));
     };
 
-    update(TorrentFilter::Downloading, m_nbDownloading);
-    update(TorrentFilter::Seeding, m_nbSeeding);
-    update(TorrentFilter::Completed, m_nbCompleted);
-    update(TorrentFilter::Resumed, m_nbResumed);
-    update(TorrentFilter::Paused, m_nbPaused);
-    update(TorrentFilter::Active, m_nbActive);
-    update(TorrentFilter::Inactive, m_nbInactive);
-    update(TorrentFilter::StalledUploading, m_nbStalledUploading);
-    update(TorrentFilter::StalledDownloading, m_nbStalledDownloading);
-    update(TorrentFilter::Checking, m_nbChecking);
-    update(TorrentFilter::Moving, m_nbMoving);
-    update(TorrentFilter::Errored, m_nbErrored);
+    updateText(TorrentFilter::All, tr("All (%1)"));
+    updateText(TorrentFilter::Downloading, tr("Downloading (%1)"));
+    updateText(TorrentFilter::Seeding, tr("Seeding (%1)"));
+    updateText(TorrentFilter::Completed, tr("Completed (%1)"));
+    updateText(TorrentFilter::Resumed, tr("Resumed (%1)"));
+    updateText(TorrentFilter::Paused, tr("Paused (%1)"));
+    updateText(TorrentFilter::Active, tr("Active (%1)"));
+    updateText(TorrentFilter::Inactive, tr("Inactive (%1)"));
+    updateText(TorrentFilter::Stalled, tr("Stalled (%1)"));
+    updateText(TorrentFilter::StalledUploading, tr("Stalled Uploading (%1)"));
+    updateText(TorrentFilter::StalledDownloading, tr("Stalled Downloading (%1)"));
+    updateText(TorrentFilter::Checking, tr("Checking (%1)"));
+    updateText(TorrentFilter::Moving, tr("Moving (%1)"));
+    updateText(TorrentFilter::Errored, tr("Errored (%1)"));
 
-    m_nbStalled = m_nbStalledUploading + m_nbStalledDownloading;
+    m_countsChanged = false;
 }
 
-void StatusFilterWidget::updateTexts()
+void StatusFilterWidget::handleTorrentsUpdated(const QVector<BitTorrent::Torrent *>)
 {
-    const qsizetype torrentsCount = BitTorrent::Session::instance()->torrentsCount();
-    item(TorrentFilter::All)->setData(Qt::DisplayRole, tr("All (%1)").arg(torrentsCount));
-    item(TorrentFilter::Downloading)->setData(Qt::DisplayRole, tr("Downloading (%1)").arg(m_nbDownloading));
-    item(TorrentFilter::Seeding)->setData(Qt::DisplayRole, tr("Seeding (%1)").arg(m_nbSeeding));
-    item(TorrentFilter::Completed)->setData(Qt::DisplayRole, tr("Completed (%1)").arg(m_nbCompleted));
-    item(TorrentFilter::Resumed)->setData(Qt::DisplayRole, tr("Resumed (%1)").arg(m_nbResumed));
-    item(TorrentFilter::Paused)->setData(Qt::DisplayRole, tr("Paused (%1)").arg(m_nbPaused));
-    item(TorrentFilter::Active)->setData(Qt::DisplayRole, tr("Active (%1)").arg(m_nbActive));
-    item(TorrentFilter::Inactive)->setData(Qt::DisplayRole, tr("Inactive (%1)").arg(m_nbInactive));
-    item(TorrentFilter::Stalled)->setData(Qt::DisplayRole, tr("Stalled (%1)").arg(m_nbStalled));
-    item(TorrentFilter::StalledUploading)->setData(Qt::DisplayRole, tr("Stalled Uploading (%1)").arg(m_nbStalledUploading));
-    item(TorrentFilter::StalledDownloading)->setData(Qt::DisplayRole, tr("Stalled Downloading (%1)").arg(m_nbStalledDownloading));
-    item(TorrentFilter::Checking)->setData(Qt::DisplayRole, tr("Checking (%1)").arg(m_nbChecking));
-    item(TorrentFilter::Moving)->setData(Qt::DisplayRole, tr("Moving (%1)").arg(m_nbMoving));
-    item(TorrentFilter::Errored)->setData(Qt::DisplayRole, tr("Errored (%1)").arg(m_nbErrored));
-}
-
-void StatusFilterWidget::handleTorrentsUpdated(const QVector<BitTorrent::Torrent *> torrents)
-{
-    for (const BitTorrent::Torrent *torrent : torrents)
-        updateTorrentStatus(torrent);
+    if (m_countsChanged)
+        updateTexts();
+}
 
-    updateTexts();
+void StatusFilterWidget::handleTorrentStateChanged()
+{
+    m_countsChanged = true;
 }
 
 void StatusFilterWidget::showMenu()
@@ -323,45 +294,13 @@ void StatusFilterWidget::applyFilter(int row)
     transferList->applyStatusFilter(row);
 }
 
-void StatusFilterWidget::handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &torrents)
+void StatusFilterWidget::handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &)
 {
-    for (const BitTorrent::Torrent *torrent : torrents)
-        updateTorrentStatus(torrent);
-
     updateTexts();
 }
 
-void StatusFilterWidget::torrentAboutToBeDeleted(BitTorrent::Torrent *const torrent)
-{
-    const TorrentFilterBitset status = m_torrentsStatus.take(torrent);
-
-    if (status[TorrentFilter::Downloading])
-        --m_nbDownloading;
-    if (status[TorrentFilter::Seeding])
-        --m_nbSeeding;
-    if (status[TorrentFilter::Completed])
-        --m_nbCompleted;
-    if (status[TorrentFilter::Resumed])
-        --m_nbResumed;
-    if (status[TorrentFilter::Paused])
-        --m_nbPaused;
-    if (status[TorrentFilter::Active])
-        --m_nbActive;
-    if (status[TorrentFilter::Inactive])
-        --m_nbInactive;
-    if (status[TorrentFilter::StalledUploading])
-        --m_nbStalledUploading;
-    if (status[TorrentFilter::StalledDownloading])
-        --m_nbStalledDownloading;
-    if (status[TorrentFilter::Checking])
-        --m_nbChecking;
-    if (status[TorrentFilter::Moving])
-        --m_nbMoving;
-    if (status[TorrentFilter::Errored])
-        --m_nbErrored;
-
-    m_nbStalled = m_nbStalledUploading + m_nbStalledDownloading;
-
+void StatusFilterWidget::torrentAboutToBeDeleted(BitTorrent::Torrent *const)
+{
     updateTexts();
 }
 
@@ -475,6 +414,7 @@ void TrackerFiltersList::addItems(const QString &trackerURL, const QVector<BitTo
     {
         trackerItem = new QListWidgetItem();
         trackerItem->setData(Qt::DecorationRole, UIThemeManager::instance()->getIcon(u"trackers"_qs, u"network-server"_qs));
+        trackerItem->setData(Qt::UserRole, QVariant::fromValue(Utils::Compare::NaturalSortKey<Qt::CaseSensitive>(host)));
 
         const TrackerData trackerData {{}, trackerItem};
         trackersIt = m_trackers.insert(host, trackerData);
@@ -498,17 +438,20 @@ void TrackerFiltersList::addItems(const QString &trackerURL, const QVector<BitTo
     }
 
     Q_ASSERT(count() >= 4);
-    const Utils::Compare::NaturalLessThan<Qt::CaseSensitive> naturalLessThan {};
-    int insPos = count();
-    for (int i = 4; i < count(); ++i)
+    // Tracker items are kept sorted by host, find the insert position by binary search over their sort keys
+    using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseSensitive>;
+    const SortKey hostSortKey = trackerItem->data(Qt::UserRole).value<SortKey>();
+    int low = 4;
+    int high = count();
+    while (low < high)
     {
-        if (naturalLessThan(host, item(i)->text()))
-        {
-            insPos = i;
-            break;
-        }
+        const int mid = low + ((high - low) / 2);
+        if (hostSortKey < item(mid)->data(Qt::UserRole).value<SortKey>())
+            high = mid;
+        else
+            low = mid + 1;
     }
-    QListWidget::insertItem(insPos, trackerItem);
+    QListWidget::insertItem(low, trackerItem);
     updateGeometry();
 }
 
@@ -28,7 +28,7 @@
 
 #pragma once
 
-#include <bitset>
+#include <array>
 
 #include <QFrame>
 #include <QHash>
@@ -88,6 +88,7 @@ public:
 
 private slots:
     void handleTorrentsUpdated(const QVector<BitTorrent::Torrent *> torrents);
+    void handleTorrentStateChanged();
 
 private:
     // These 4 methods are virtual slots in the base class.
@@ -97,25 +98,12 @@ private:
     void handleTorrentsLoaded(const QVector<BitTorrent::Torrent *> &torrents) override;
     void torrentAboutToBeDeleted(BitTorrent::Torrent *const) override;
 
-    void populate();
-    void updateTorrentStatus(const BitTorrent::Torrent *torrent);
     void updateTexts();
 
-    using TorrentFilterBitset = std::bitset<32>;  // approximated size, this should be the number of TorrentFilter::Type elements
-    QHash<const BitTorrent::Torrent *, TorrentFilterBitset> m_torrentsStatus;
-    int m_nbDownloading = 0;
-    int m_nbSeeding = 0;
-    int m_nbCompleted = 0;
-    int m_nbResumed = 0;
-    int m_nbPaused = 0;
-    int m_nbActive = 0;
-    int m_nbInactive = 0;
-    int m_nbStalled = 0;
-    int m_nbStalledUploading = 0;
-    int m_nbStalledDownloading = 0;
-    int m_nbChecking = 0;
-    int m_nbMoving = 0;
-    int m_nbErrored = 0;
+    // Counters are maintained by the session, here we only keep the ones that are displayed
+    // so that the item texts are rewritten only when the respective counter changes.
+    std::array<qsizetype, TorrentFilter::TypeCount> m_displayedCounts;
+    bool m_countsChanged = false;
 };
 
 class TrackerFiltersList final : public BaseFilterWidget
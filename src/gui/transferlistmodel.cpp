@@ -34,6 +34,7 @@
 #include <QDebug>
 
 #include "base/bittorrent/infohash.h"
+#include "base/bittorrent/movestoragejobstatus.h"
 #include "base/bittorrent/session.h"
 #include "base/bittorrent/torrent.h"
 #include "base/global.h"
@@ -182,9 +183,11 @@ TransferListModel::TransferListModel(QObject *parent)
 
     connect(Session::instance(), &Session::torrentFinished, this, &TransferListModel::handleTorrentStatusUpdated);
     connect(Session::instance(), &Session::torrentMetadataReceived, this, &TransferListModel::handleTorrentStatusUpdated);
+    connect(Session::instance(), &Session::torrentNameChanged, this, &TransferListModel::handleTorrentStatusUpdated);
     connect(Session::instance(), &Session::torrentResumed, this, &TransferListModel::handleTorrentStatusUpdated);
     connect(Session::instance(), &Session::torrentPaused, this, &TransferListModel::handleTorrentStatusUpdated);
     connect(Session::instance(), &Session::torrentFinishedChecking, this, &TransferListModel::handleTorrentStatusUpdated);
+    connect(Session::instance(), &Session::torrentStorageMoveProgressUpdated, this, &TransferListModel::handleTorrentStatusUpdated);
 }
 
 int TransferListModel::rowCount(const QModelIndex &) const
@@ -379,6 +382,25 @@ QString TransferListModel::displayValue(const BitTorrent::Torrent *torrent, cons
                    : m_statusStrings[state];
     };
 
+    const auto movingStatusString = [this, &progressString](const BitTorrent::Torrent *torrent) -> QString
+    {
+        const QString status = m_statusStrings[BitTorrent::TorrentState::Moving];
+
+        BitTorrent::MoveStorageJobStatus jobStatus;
+        if (!BitTorrent::Session::instance()->moveStorageJobStatus(torrent->id(), jobStatus))
+            return status;
+
+        if (!jobStatus.isActive)
+            return u"%1 (%2)"_qs.arg(status, tr("queued", "Torrent local data move is waiting for other moves to complete"));
+
+        // moving within the same device doesn't provide any progress information
+        if (jobStatus.totalBytes <= 0)
+            return status;
+
+        const qreal progress = static_cast<qreal>(jobStatus.movedBytes) / jobStatus.totalBytes;
+        return u"%1 (%2, %3)"_qs.arg(status, progressString(progress), Utils::Misc::friendlyUnit(jobStatus.speed, true));
+    };
+
     const auto hashString = [hideValues](const auto &hash) -> QString
     {
         if (hideValues && !hash.isValid())
@@ -397,6 +419,8 @@ QString TransferListModel::displayValue(const BitTorrent::Torrent *torrent, cons
     case TR_PROGRESS:
         return progressString(torrent->progress());
     case TR_STATUS:
+        if (torrent->state() == BitTorrent::TorrentState::Moving)
+            return movingStatusString(torrent);
         return statusString(torrent->state(), torrent->error());
     case TR_SEEDS:
         return amountString(torrent->seedsCount(), torrent->totalSeedsCount());
@@ -651,12 +675,15 @@ void TransferListModel::addTorrents(const QVector<BitTorrent::Torrent *> &torren
     beginInsertRows({}, row, total);
 
     m_torrentList.reserve(total);
+    m_nameSortKeys.resize(total);
     for (BitTorrent::Torrent *torrent : torrents)
     {
         Q_ASSERT(!m_torrentMap.contains(torrent));
 
         m_torrentList.append(torrent);
-        m_torrentMap[torrent] = row++;
+        m_torrentMap[torrent] = row;
+        updateNameSortKey(row);
+        ++row;
         totalSize += torrent->totalSize();
     }
 
@@ -678,6 +705,32 @@ BitTorrent::Torrent *TransferListModel::torrentHandle(const QModelIndex &index)
     return m_torrentList.value(index.row());
 }
 
+const Utils::Compare::NaturalSortKey<Qt::CaseInsensitive> &TransferListModel::nameSortKey(const int row) const
+{
+    Q_ASSERT((row >= 0) && (row < m_nameSortKeys.size()));
+
+    return m_nameSortKeys[row].key;
+}
+
+void TransferListModel::updateNameSortKeys()
+{
+    for (int row = 0; row < m_torrentList.size(); ++row)
+        updateNameSortKey(row);
+}
+
+void TransferListModel::updateNameSortKey(const int row)
+{
+    // Torrent name can change at any time (e.g. when metadata is received)
+    // so the key is recomputed only when it no longer matches the current name
+    NameSortKey &sortKey = m_nameSortKeys[row];
+    const QString name = m_torrentList[row]->name();
+    if (sortKey.name != name)
+    {
+        sortKey.name = name;
+        sortKey.key = Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>(name);
+    }
+}
+
 void TransferListModel::handleTorrentAboutToBeRemoved(BitTorrent::Torrent *const torrent)
 {
     const int row = m_torrentMap.value(torrent, -1);
@@ -685,6 +738,7 @@ void TransferListModel::handleTorrentAboutToBeRemoved(BitTorrent::Torrent *const
 
     beginRemoveRows({}, row, row);
     m_torrentList.removeAt(row);
+    m_nameSortKeys.removeAt(row);
     m_torrentMap.remove(torrent);
     totalSize -= torrent->totalSize();
     for (int &value : m_torrentMap)
@@ -700,6 +754,7 @@ void TransferListModel::handleTorrentStatusUpdated(BitTorrent::Torrent *const to
     const int row = m_torrentMap.value(torrent, -1);
     Q_ASSERT(row >= 0);
 
+    updateNameSortKey(row);
     emit dataChanged(index(row, 0), index(row, columnCount() - 1));
 }
 
@@ -714,12 +769,14 @@ void TransferListModel::handleTorrentsUpdated(const QVector<BitTorrent::Torrent
             const int row = m_torrentMap.value(torrent, -1);
             Q_ASSERT(row >= 0);
 
+            updateNameSortKey(row);
             emit dataChanged(index(row, 0), index(row, columns));
         }
     }
     else
     {
         // save the overhead when more than half of the torrent list needs update
+        updateNameSortKeys();
         emit dataChanged(index(0, 0), index((rowCount() - 1), columns));
     }
 }
@@ -34,8 +34,10 @@
 #include <QHash>
 #include <QIcon>
 #include <QList>
+#include <QVector>
 
 #include "base/bittorrent/torrent.h"
+#include "base/utils/compare.h"
 
 namespace BitTorrent
 {
@@ -104,6 +106,10 @@ public:
     Qt::ItemFlags flags(const QModelIndex &index) const override;
 
     BitTorrent::Torrent *torrentHandle(const QModelIndex &index) const;
+    // Name sort keys are refreshed when torrents are updated,
+    // call updateNameSortKeys() to catch up with other name changes before sorting
+    const Utils::Compare::NaturalSortKey<Qt::CaseInsensitive> &nameSortKey(int row) const;
+    void updateNameSortKeys();
 
 public:
     QPair<qint64,qint64> *getTorrentsSize();
@@ -119,9 +125,17 @@ private:
     QString displayValue(const BitTorrent::Torrent *torrent, int column) const;
     QVariant internalValue(const BitTorrent::Torrent *torrent, int column, bool alt) const;
     QIcon getIconByState(const BitTorrent::TorrentState state) const;
+    void updateNameSortKey(int row);
 
     QList<BitTorrent::Torrent *> m_torrentList;  // maps row number to torrent handle
     QHash<BitTorrent::Torrent *, int> m_torrentMap;  // maps torrent handle to row number
+
+    struct NameSortKey
+    {
+        QString name;
+        Utils::Compare::NaturalSortKey<Qt::CaseInsensitive> key;
+    };
+    QVector<NameSortKey> m_nameSortKeys;  // maps row number to sort key of torrent name
     const QHash<BitTorrent::TorrentState, QString> m_statusStrings;
     // row text colors
     const QHash<BitTorrent::TorrentState, QColor> m_stateThemeColors;
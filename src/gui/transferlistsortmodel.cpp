@@ -109,6 +109,10 @@ void TransferListSortModel::sort(const int column, const Qt::SortOrder order)
     m_lastSortColumn = column;
     m_lastSortOrder = ((order == Qt::AscendingOrder) ? 0 : 1);
 
+    // build the name sort keys once rather than checking them on every comparison
+    if (auto *model = static_cast<TransferListModel *>(sourceModel()))
+        model->updateNameSortKeys();
+
     QSortFilterProxyModel::sort(column, order);
 }
 
@@ -157,6 +161,13 @@ void TransferListSortModel::disableTrackerFilter()
 int TransferListSortModel::compare(const QModelIndex &left, const QModelIndex &right) const
 {
     const int compareColumn = left.column();
+    if (compareColumn == TransferListModel::TR_NAME)
+    {
+        // Names are compared far more often than they change, so use the prebuilt sort keys
+        const auto *model = static_cast<const TransferListModel *>(sourceModel());
+        return model->nameSortKey(left.row()).compare(model->nameSortKey(right.row()));
+    }
+
     const QVariant leftValue = left.data(TransferListModel::UnderlyingDataRole);
     const QVariant rightValue = right.data(TransferListModel::UnderlyingDataRole);
 
@@ -164,7 +175,6 @@ int TransferListSortModel::compare(const QModelIndex &left, const QModelIndex &r
     {
     case TransferListModel::TR_CATEGORY:
     case TransferListModel::TR_DOWNLOAD_PATH:
-    case TransferListModel::TR_NAME:
     case TransferListModel::TR_SAVE_PATH:
     case TransferListModel::TR_TRACKER:
         return m_naturalCompare(leftValue.toString(), rightValue.toString());
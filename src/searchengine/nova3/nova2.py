@@ -1,4 +1,4 @@
-#VERSION: 1.43
+#VERSION: 1.44
 
 # Author:
 #  Fabien Devaux <fab AT gnux DOT info>
@@ -33,18 +33,30 @@
 # ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
 # POSSIBILITY OF SUCH DAMAGE.
 
+import multiprocessing
+import multiprocessing.connection
+import queue
+import sys
+import threading
+import time
 import urllib.parse
+from collections import deque
 from os import path
 from glob import glob
 from sys import argv
 from multiprocessing import Pool, cpu_count
 
+import novaprinter
+
 THREADED = True
 try:
     MAX_THREADS = cpu_count()
 except NotImplementedError:
     MAX_THREADS = 1
 
+# engines are mostly waiting for network, so worker runs more of them than there are cpus
+MAX_WORKER_ENGINES = max(4, MAX_THREADS)
+
 CATEGORIES = {'all', 'movies', 'tv', 'music', 'games', 'anime', 'software', 'pictures', 'books'}
 
 ################################################################################
@@ -142,6 +154,150 @@ def run_search(engine_list):
         return False
 
 
+def run_worker_engine(engine_name, what, cat, connection):
+    """ Run search in engine within a child process of search worker
+
+        Results are sent to the worker through the connection owned by this process only,
+        so terminating the process can't leave any state shared with other engines broken
+    """
+    if engine_name not in globals():
+        # child process was not forked from the worker so the engines have to be imported again
+        initialize_engines()
+
+    novaprinter.setOutputConnection(connection)
+    if not run_search([globals()[engine_name], what, cat]):
+        raise SystemExit(1)
+
+
+def run_worker(supported_engines):
+    """ Serve search jobs until stdin is closed
+
+        Commands (one per line, fields are separated by tab):
+          S <job id> <engine timeout in seconds> <engine1[,engine2]*> <category> <keywords>
+          C <job id>
+
+        Messages (one per line, fields are separated by tab):
+          R <job id> <engine> <search result>
+          E <job id> <engine> <ok|error|timeout|cancelled> <elapsed time in milliseconds>
+          D <job id>
+    """
+    # forked children inherit the imported engines, so only the first search pays for importing them
+    if 'fork' in multiprocessing.get_all_start_methods():
+        context = multiprocessing.get_context('fork')
+    else:
+        context = multiprocessing.get_context()
+
+    commands = queue.Queue()
+
+    def read_commands():
+        # own stream object, since child processes close `sys.stdin` at startup and that would
+        # block on the lock held by this thread if it was shared
+        with open(sys.stdin.fileno(), 'r', encoding='utf-8', closefd=False) as stdin:
+            for line in stdin:
+                commands.put(line.rstrip('\r\n').split('\t'))
+        commands.put(None)
+
+    threading.Thread(target=read_commands, daemon=True).start()
+
+    pending_engines = deque()  # (job id, engine, keywords, category, timeout)
+    running_engines = {}  # (job id, engine) -> (process, start time, timeout, output connection)
+    unfinished_engine_counts = {}  # job id -> number of engines which have not finished yet
+
+    def send(*fields):
+        novaprinter.printLine("\t".join(fields))
+
+    def forward_results(job_id, engine, connection):
+        try:
+            while connection.poll():
+                send("R", job_id, engine, connection.recv_bytes().decode('utf-8'))
+        except (EOFError, OSError):
+            pass
+
+    def stop_engine(key):
+        process, start_time, _, connection = running_engines.pop(key)
+        process.terminate()
+        process.join()
+        # a partially sent result of the terminated process is dropped along with its connection
+        connection.close()
+        return time.monotonic() - start_time
+
+    def finish_engine(job_id, engine, status, elapsed):
+        send("E", job_id, engine, status, str(int(elapsed * 1000)))
+        unfinished_engine_counts[job_id] -= 1
+        if unfinished_engine_counts[job_id] == 0:
+            del unfinished_engine_counts[job_id]
+            send("D", job_id)
+
+    def start_job(job_id, timeout, engines, cat, keywords):
+        engines_list = set(e.lower() for e in engines.strip().split(','))
+        if 'all' in engines_list:
+            engines_list = supported_engines
+        else:
+            engines_list = [engine for engine in engines_list
+                            if engine in supported_engines]
+
+        if (not engines_list) or (cat not in CATEGORIES) or (job_id in unfinished_engine_counts):
+            send("D", job_id)
+            return
+
+        what = urllib.parse.quote(keywords)
+        unfinished_engine_counts[job_id] = len(engines_list)
+        for engine in engines_list:
+            pending_engines.append((job_id, engine, what, cat, timeout))
+
+    def cancel_job(job_id):
+        for entry in [entry for entry in pending_engines if entry[0] == job_id]:
+            pending_engines.remove(entry)
+            finish_engine(job_id, entry[1], "cancelled", 0)
+        for key in [key for key in running_engines if key[0] == job_id]:
+            finish_engine(job_id, key[1], "cancelled", stop_engine(key))
+
+    stdin_closed = False
+    while not stdin_closed or unfinished_engine_counts:
+        connections = {entry[3]: key for key, entry in running_engines.items()}
+        try:
+            command = commands.get_nowait() if connections else commands.get(timeout=0.05)
+        except queue.Empty:
+            command = []
+
+        if connections:
+            for connection in multiprocessing.connection.wait(list(connections), timeout=0.05):
+                forward_results(*connections[connection], connection)
+
+        if command is None:
+            stdin_closed = True
+            for job_id in list(unfinished_engine_counts):
+                cancel_job(job_id)
+        elif (len(command) >= 6) and (command[0] == 'S'):
+            try:
+                timeout = float(command[2])
+            except ValueError:
+                timeout = 0
+            start_job(command[1], timeout, command[3], command[4].lower(), command[5])
+        elif (len(command) >= 2) and (command[0] == 'C'):
+            cancel_job(command[1])
+
+        now = time.monotonic()
+        for key, (process, start_time, timeout, connection) in list(running_engines.items()):
+            if not process.is_alive():
+                process.join()
+                del running_engines[key]
+                forward_results(*key, connection)
+                connection.close()
+                finish_engine(key[0], key[1], ("ok" if process.exitcode == 0 else "error"), now - start_time)
+            elif (timeout > 0) and ((now - start_time) > timeout):
+                finish_engine(key[0], key[1], "timeout", stop_engine(key))
+
+        while pending_engines and (len(running_engines) < MAX_WORKER_ENGINES):
+            job_id, engine, what, cat, timeout = pending_engines.popleft()
+            reader, writer = context.Pipe(duplex=False)
+            process = context.Process(target=run_worker_engine, args=(engine, what, cat, writer))
+            process.start()
+            # only the engine process writes to the pipe
+            writer.close()
+            running_engines[(job_id, engine)] = (process, time.monotonic(), timeout, reader)
+
+
 def main(args):
     supported_engines = initialize_engines()
 
@@ -153,6 +309,10 @@ def main(args):
         displayCapabilities(supported_engines)
         return
 
+    elif args[0] == "--worker":
+        run_worker(supported_engines)
+        return
+
     elif len(args) < 3:
         raise SystemExit("./nova2.py [all|engine1[,engine2]*] <category> <keywords>\n"
                          "available engines: %s" % (','.join(supported_engines)))
@@ -1,4 +1,4 @@
-#VERSION: 1.46
+#VERSION: 1.47
 
 # Redistribution and use in source and binary forms, with or without
 # modification, are permitted provided that the following conditions are met:
@@ -25,6 +25,16 @@
 # POSSIBILITY OF SUCH DAMAGE.
 
 
+# set by search worker processes, see nova2.py
+_output_connection = None
+
+
+def setOutputConnection(connection):
+    """ Send printed lines through the connection instead of writing them to stdout """
+    global _output_connection
+    _output_connection = connection
+
+
 def prettyPrinter(dictionary):
     dictionary['size'] = anySizeToBytes(dictionary['size'])
     outtext = "|".join((dictionary["link"], dictionary["name"].replace("|", " "),
@@ -33,9 +43,17 @@ def prettyPrinter(dictionary):
     if 'desc_link' in dictionary:
         outtext = "|".join((outtext, dictionary["desc_link"]))
 
+    printLine(outtext)
+
+
+def printLine(line):
+    if _output_connection is not None:
+        _output_connection.send_bytes(line.encode('utf-8'))
+        return
+
     # fd 1 is stdout
     with open(1, 'w', encoding='utf-8', closefd=False) as utf8stdout:
-        print(outtext, file=utf8stdout)
+        print(line, file=utf8stdout)
 
 
 def anySizeToBytes(size_string):
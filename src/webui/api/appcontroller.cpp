@@ -165,6 +165,10 @@ void AppController::preferencesAction()
     // Run an external program on torrent finished
     data[u"autorun_enabled"_qs] = pref->isAutoRunOnTorrentFinishedEnabled();
     data[u"autorun_program"_qs] = pref->getAutoRunOnTorrentFinishedProgram();
+    data[u"autorun_max_concurrent_programs"_qs] = pref->getAutoRunMaxConcurrentPrograms();
+    data[u"autorun_timeout"_qs] = pref->getAutoRunTimeout();
+    data[u"autorun_batching_enabled"_qs] = pref->isAutoRunBatchingEnabled();
+    data[u"torrent_event_stream_path"_qs] = pref->getTorrentEventStreamPath().toString();
 
     // Connection
     // Listening Port
@@ -531,6 +535,14 @@ void AppController::setPreferencesAction()
         pref->setAutoRunOnTorrentFinishedEnabled(it.value().toBool());
     if (hasKey(u"autorun_program"_qs))
         pref->setAutoRunOnTorrentFinishedProgram(it.value().toString());
+    if (hasKey(u"autorun_max_concurrent_programs"_qs))
+        pref->setAutoRunMaxConcurrentPrograms(it.value().toInt());
+    if (hasKey(u"autorun_timeout"_qs))
+        pref->setAutoRunTimeout(it.value().toInt());
+    if (hasKey(u"autorun_batching_enabled"_qs))
+        pref->setAutoRunBatchingEnabled(it.value().toBool());
+    if (hasKey(u"torrent_event_stream_path"_qs))
+        pref->setTorrentEventStreamPath(Path(it.value().toString()));
 
     // Connection
     // Listening Port
@@ -43,6 +43,7 @@ const QString KEY_LOG_MSG_MESSAGE = u"message"_qs;
 const QString KEY_LOG_PEER_IP = u"ip"_qs;
 const QString KEY_LOG_PEER_BLOCKED = u"blocked"_qs;
 const QString KEY_LOG_PEER_REASON = u"reason"_qs;
+const QString KEY_LOG_PEER_COUNT = u"count"_qs;
 
 // Returns the log in JSON format.
 // The return value is an array of dictionaries.
@@ -102,6 +103,7 @@ void LogController::mainAction()
 //   - "ip": IP of the peer
 //   - "blocked": whether or not the peer was blocked
 //   - "reason": reason of the block
+//   - "count": number of aggregated events of the peer
 // GET params:
 //   - last_known_id (int): exclude messages with id <= 'last_known_id' (default -1)
 void LogController::peersAction()
@@ -122,7 +124,8 @@ void LogController::peersAction()
             {KEY_LOG_TIMESTAMP, peer.timestamp},
             {KEY_LOG_PEER_IP, peer.ip},
             {KEY_LOG_PEER_BLOCKED, peer.blocked},
-            {KEY_LOG_PEER_REASON, peer.reason}
+            {KEY_LOG_PEER_REASON, peer.reason},
+            {KEY_LOG_PEER_COUNT, peer.count}
         });
     }
 
@@ -28,15 +28,19 @@
 
 #include "rsscontroller.h"
 
+#include <optional>
+
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonValue>
 #include <QVector>
 
+#include "base/global.h"
 #include "base/rss/rss_article.h"
 #include "base/rss/rss_autodownloader.h"
 #include "base/rss/rss_autodownloadrule.h"
+#include "base/rss/rss_autodownloadrulematcher.h"
 #include "base/rss/rss_feed.h"
 #include "base/rss/rss_folder.h"
 #include "base/rss/rss_session.h"
@@ -90,9 +94,41 @@ void RSSController::moveItemAction()
 void RSSController::itemsAction()
 {
     const bool withData {parseBool(params()[u"withData"_qs]).value_or(false)};
+    const auto *session = RSS::Session::instance();
+
+    if (!params().contains(u"cursor"_qs))
+    {
+        const auto jsonVal = session->rootFolder()->toJsonValue(withData);
+        setResult(jsonVal.toObject());
+        return;
+    }
 
-    const auto jsonVal = RSS::Session::instance()->rootFolder()->toJsonValue(withData);
-    setResult(jsonVal.toObject());
+    // Incremental request.
+    // The whole items tree is sent back if the changes since given cursor can't be tracked,
+    // otherwise it contains only the feeds changed since given cursor (keyed by their paths).
+    const std::optional<qint64> sinceRevision = session->revisionFromCursor(params()[u"cursor"_qs]);
+    const bool isFullUpdate = !sinceRevision;
+
+    QJsonObject jsonObj {
+        {u"cursor"_qs, session->changeCursor()},
+        {u"fullUpdate"_qs, isFullUpdate}
+    };
+    if (isFullUpdate)
+    {
+        jsonObj.insert(u"items"_qs, session->rootFolder()->toJsonValue(withData));
+    }
+    else
+    {
+        QJsonObject changedFeeds;
+        for (const RSS::Feed *feed : asConst(session->feeds()))
+        {
+            if (feed->revision() > *sinceRevision)
+                changedFeeds.insert(feed->path(), (withData ? feed->changesToJsonValue(*sinceRevision) : feed->toJsonValue()));
+        }
+        jsonObj.insert(u"feeds"_qs, changedFeeds);
+    }
+
+    setResult(jsonObj);
 }
 
 void RSSController::markAsReadAction()
@@ -177,6 +213,11 @@ void RSSController::matchingArticlesAction()
     const QString ruleName {params()[u"ruleName"_qs]};
     const RSS::AutoDownloadRule rule = RSS::AutoDownloader::instance()->ruleByName(ruleName);
 
+    // Matcher considers enabled rules only
+    RSS::AutoDownloadRule enabledRule = rule;
+    enabledRule.setEnabled(true);
+    const RSS::AutoDownloadRuleMatcher ruleMatcher {QList<RSS::AutoDownloadRule> {enabledRule}};
+
     QJsonObject jsonObj;
     for (const QString &feedURL : rule.feedURLs())
     {
@@ -184,8 +225,12 @@ void RSSController::matchingArticlesAction()
         if (!feed) continue; // feed doesn't exist
 
         QJsonArray matchingArticles;
-        for (const RSS::Article *article : feed->articles())
+        for (const RSS::Article *article : asConst(feed->articles()))
         {
+            // Only the articles preselected by the matcher need to be completely evaluated
+            if (ruleMatcher.candidateRules(feedURL, article->title()).isEmpty())
+                continue;
+
             if (rule.matches(article->data()))
                 matchingArticles << article->title();
         }
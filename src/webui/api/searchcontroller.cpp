@@ -29,16 +29,19 @@
 #include "searchcontroller.h"
 
 #include <limits>
+#include <optional>
 
 #include <QHash>
 #include <QJsonArray>
 #include <QJsonObject>
 #include <QList>
+#include <QVector>
 #include <QSharedPointer>
 
 #include "base/global.h"
 #include "base/logger.h"
 #include "base/search/searchhandler.h"
+#include "base/search/searchworkerpool.h"
 #include "base/utils/foreignapps.h"
 #include "base/utils/random.h"
 #include "base/utils/string.h"
@@ -163,6 +166,16 @@ void SearchController::statusAction()
     setResult(statusArray);
 }
 
+// Returns the results of the search.
+// GET params:
+//   - id (int): search id
+//   - filter (string): space separated terms, every one of them must be contained in the result name
+//   - minSize, maxSize (int): result size range in bytes (no filtering by missing bound)
+//   - minSeeds, maxSeeds (int): result seeders range (no filtering by missing bound)
+//   - sort (string): fileName, fileSize, nbSeeders, nbLeechers or siteUrl
+//   - reverse (bool): enable reverse sorting
+//   - limit (int): set limit number of results returned (if greater than 0, otherwise - unlimited)
+//   - offset (int): set offset (if less than 0 - offset from end)
 void SearchController::resultsAction()
 {
     requireParams({u"id"_qs});
@@ -175,25 +188,76 @@ void SearchController::resultsAction()
     if (iter == m_searchHandlers.end())
         throw APIError(APIErrorType::NotFound);
 
+    const auto parseLongLong = [this](const QString &name) -> std::optional<qlonglong>
+    {
+        const QString value = params()[name].trimmed();
+        if (value.isEmpty())
+            return std::nullopt;
+
+        bool ok = false;
+        const qlonglong result = value.toLongLong(&ok);
+        if (!ok)
+            throw APIError(APIErrorType::BadParams, tr("'%1' parameter is invalid").arg(name));
+        return result;
+    };
+
+    SearchResultQuery query;
+    query.filter.nameTerms = params()[u"filter"_qs].split(u' ', Qt::SkipEmptyParts);
+    query.filter.minSize = parseLongLong(u"minSize"_qs);
+    query.filter.maxSize = parseLongLong(u"maxSize"_qs);
+    query.filter.minSeeds = parseLongLong(u"minSeeds"_qs);
+    query.filter.maxSeeds = parseLongLong(u"maxSeeds"_qs);
+
+    const QString sortedColumn = params()[u"sort"_qs];
+    if (!sortedColumn.isEmpty())
+    {
+        const QHash<QString, SearchResultSortField> sortFields
+        {
+            {u"fileName"_qs, SearchResultSortField::Name},
+            {u"fileSize"_qs, SearchResultSortField::Size},
+            {u"nbSeeders"_qs, SearchResultSortField::Seeders},
+            {u"nbLeechers"_qs, SearchResultSortField::Leechers},
+            {u"siteUrl"_qs, SearchResultSortField::SiteUrl}
+        };
+
+        const auto sortFieldIter = sortFields.constFind(sortedColumn);
+        if (sortFieldIter == sortFields.cend())
+            throw APIError(APIErrorType::BadParams, tr("'sort' parameter is invalid"));
+
+        query.sortField = sortFieldIter.value();
+        query.sortOrder = Utils::String::parseBool(params()[u"reverse"_qs]).value_or(false)
+            ? Qt::DescendingOrder : Qt::AscendingOrder;
+    }
+
     const std::shared_ptr<SearchHandler> &searchHandler = iter.value();
-    const QList<SearchResult> searchResults = searchHandler->results();
-    const int size = searchResults.size();
+    const SearchResultStore &resultStore = searchHandler->results();
+
+    // offset from end can be resolved only after filtering, so all matched results are queried in this case
+    if (offset >= 0)
+    {
+        query.offset = offset;
+        query.limit = (limit > 0) ? limit : -1;
+    }
+
+    SearchResultPage page = resultStore.query(query);
+    const int size = page.matchedCount;
 
     if (offset > size)
         throw APIError(APIErrorType::Conflict, tr("Offset is out of range"));
 
-    // normalize values
     if (offset < 0)
+    {
+        // normalize values
         offset = size + offset;
-    if (offset < 0)  // check again
-        throw APIError(APIErrorType::Conflict, tr("Offset is out of range"));
-    if (limit <= 0)
-        limit = -1;
+        if (offset < 0)  // check again
+            throw APIError(APIErrorType::Conflict, tr("Offset is out of range"));
+        if (limit <= 0)
+            limit = -1;
 
-    if ((limit > 0) || (offset > 0))
-        setResult(getResults(searchResults.mid(offset, limit), searchHandler->isActive(), size));
-    else
-        setResult(getResults(searchResults, searchHandler->isActive(), size));
+        page.results = page.results.mid(offset, limit);
+    }
+
+    setResult(getResults(page.results, searchHandler->isActive(), resultStore.size(), size));
 }
 
 void SearchController::deleteAction()
@@ -292,7 +356,8 @@ int SearchController::generateSearchId() const
 /**
  * Returns the search results in JSON format.
  *
- * The return value is an object with a status and an array of dictionaries.
+ * The return value is an object with a status, total number of results,
+ * number of results matching the filter and an array of dictionaries.
  * The dictionary keys are:
  *   - "fileName"
  *   - "fileUrl"
@@ -302,7 +367,7 @@ int SearchController::generateSearchId() const
  *   - "siteUrl"
  *   - "descrLink"
  */
-QJsonObject SearchController::getResults(const QList<SearchResult> &searchResults, const bool isSearchActive, const int totalResults) const
+QJsonObject SearchController::getResults(const QVector<SearchResult> &searchResults, const bool isSearchActive, const int totalResults, const int matchedResults) const
 {
     QJsonArray searchResultsArray;
     for (const SearchResult &searchResult : searchResults)
@@ -323,7 +388,8 @@ QJsonObject SearchController::getResults(const QList<SearchResult> &searchResult
     {
         {u"status"_qs, isSearchActive ? u"Running"_qs : u"Stopped"_qs},
         {u"results"_qs, searchResultsArray},
-        {u"total"_qs, totalResults}
+        {u"total"_qs, totalResults},
+        {u"totalMatched"_qs, matchedResults}
     };
 
     return result;
@@ -341,14 +407,18 @@ QJsonObject SearchController::getResults(const QList<SearchResult> &searchResult
  *   - "supportedCategories"
  *   - "iconPath"
  *   - "enabled"
+ *   - "statistics": object with "searchCount", "failureCount", "timeoutCount",
+ *     "averageLatency" and "maxLatency" (in milliseconds) of the plugin searches
  */
 QJsonArray SearchController::getPluginsInfo(const QStringList &plugins) const
 {
     QJsonArray pluginsArray;
+    const QHash<QString, SearchEngineStatistics> engineStatistics = SearchPluginManager::instance()->workerPool()->engineStatistics();
 
     for (const QString &plugin : plugins)
     {
         const PluginInfo *const pluginInfo = SearchPluginManager::instance()->pluginInfo(plugin);
+        const SearchEngineStatistics statistics = engineStatistics.value(plugin);
 
         pluginsArray << QJsonObject
         {
@@ -357,7 +427,14 @@ QJsonArray SearchController::getPluginsInfo(const QStringList &plugins) const
             {u"fullName"_qs, pluginInfo->fullName},
             {u"url"_qs, pluginInfo->url},
             {u"supportedCategories"_qs, getPluginCategories(pluginInfo->supportedCategories)},
-            {u"enabled"_qs, pluginInfo->enabled}
+            {u"enabled"_qs, pluginInfo->enabled},
+            {u"statistics"_qs, QJsonObject {
+                {u"searchCount"_qs, statistics.searchCount},
+                {u"failureCount"_qs, statistics.failureCount},
+                {u"timeoutCount"_qs, statistics.timeoutCount},
+                {u"averageLatency"_qs, statistics.averageLatency()},
+                {u"maxLatency"_qs, statistics.maxLatency}
+            }}
         };
     }
 
@@ -29,6 +29,7 @@
 #include "synccontroller.h"
 
 #include <algorithm>
+#include <utility>
 
 #include <QJsonObject>
 #include <QMetaObject>
@@ -44,8 +45,9 @@
 #include "base/bittorrent/torrentinfo.h"
 #include "base/bittorrent/trackerentry.h"
 #include "base/global.h"
-#include "base/net/geoipmanager.h"
+#include "base/net/peermetadataresolver.h"
 #include "base/preferences.h"
+#include "base/torrentfilter.h"
 #include "base/utils/string.h"
 #include "apierror.h"
 #include "freediskspacechecker.h"
@@ -60,6 +62,26 @@ namespace
     const QString KEY_SYNC_MAINDATA_REFRESH_INTERVAL = u"refresh_interval"_qs;
     const QString KEY_SYNC_MAINDATA_USE_ALT_SPEED_LIMITS = u"use_alt_speed_limits"_qs;
 
+    // Sync main data status counters keys (same as status filter names)
+    const QString KEY_STATUS_COUNTS = u"status_counts"_qs;
+    const std::pair<TorrentFilter::Type, QString> STATUS_COUNTS_KEYS[] =
+    {
+        {TorrentFilter::All, u"all"_qs},
+        {TorrentFilter::Downloading, u"downloading"_qs},
+        {TorrentFilter::Seeding, u"seeding"_qs},
+        {TorrentFilter::Completed, u"completed"_qs},
+        {TorrentFilter::Resumed, u"resumed"_qs},
+        {TorrentFilter::Paused, u"paused"_qs},
+        {TorrentFilter::Active, u"active"_qs},
+        {TorrentFilter::Inactive, u"inactive"_qs},
+        {TorrentFilter::Stalled, u"stalled"_qs},
+        {TorrentFilter::StalledUploading, u"stalled_uploading"_qs},
+        {TorrentFilter::StalledDownloading, u"stalled_downloading"_qs},
+        {TorrentFilter::Checking, u"checking"_qs},
+        {TorrentFilter::Moving, u"moving"_qs},
+        {TorrentFilter::Errored, u"errored"_qs}
+    };
+
     // Sync torrent peers keys
     const QString KEY_SYNC_TORRENT_PEERS_SHOW_FLAGS = u"show_flags"_qs;
 
@@ -105,6 +127,8 @@ namespace
     const QString KEY_TRANSFER_TOTAL_QUEUED_SIZE = u"total_queued_size"_qs;
     const QString KEY_TRANSFER_TOTAL_WASTE_SESSION = u"total_wasted_session"_qs;
     const QString KEY_TRANSFER_WRITE_CACHE_OVERLOAD = u"write_cache_overload"_qs;
+    const QString KEY_TRANSFER_ACTIVE_REFRESH_TORRENTS = u"active_refresh_torrents"_qs;
+    const QString KEY_TRANSFER_IDLE_REFRESH_TORRENTS = u"idle_refresh_torrents"_qs;
 
     const QString KEY_FULL_UPDATE = u"full_update"_qs;
     const QString KEY_RESPONSE_ID = u"rid"_qs;
@@ -152,6 +176,9 @@ namespace
         map[KEY_TRANSFER_AVERAGE_TIME_QUEUE] = cacheStatus.averageJobTime;
         map[KEY_TRANSFER_TOTAL_QUEUED_SIZE] = cacheStatus.queuedBytes;
 
+        map[KEY_TRANSFER_ACTIVE_REFRESH_TORRENTS] = static_cast<qlonglong>(session->torrentsCount(BitTorrent::TorrentRefreshTier::Active));
+        map[KEY_TRANSFER_IDLE_REFRESH_TORRENTS] = static_cast<qlonglong>(session->torrentsCount(BitTorrent::TorrentRefreshTier::Idle));
+
         map[KEY_TRANSFER_DHT_NODES] = sessionStatus.dhtNodes;
         map[KEY_TRANSFER_CONNECTION_STATUS] = session->isListening()
             ? (sessionStatus.hasIncomingConnections ? u"connected"_qs : u"firewalled"_qs)
@@ -389,6 +416,7 @@ SyncController::SyncController(IApplication *app, QObject *parent)
 //  - "trackers": dictionary contains information about trackers
 //  - "trackers_removed": a list of removed trackers
 //  - "server_state": map contains information about the state of the server
+//  - "status_counts": map of status filter names to the number of torrents matching them
 // The keys of the 'torrents' dictionary are hashes of torrents.
 // Each value of the 'torrents' dictionary contains map. The map can contain following keys:
 //  - "name": Torrent name
@@ -515,72 +543,244 @@ void SyncController::maindataAction()
     serverState[KEY_SYNC_MAINDATA_REFRESH_INTERVAL] = session->refreshInterval();
     data[u"server_state"_qs] = serverState;
 
+    QVariantMap statusCounts;
+    for (const auto &[type, key] : STATUS_COUNTS_KEYS)
+        statusCounts[key] = static_cast<qlonglong>(session->torrentsCount(type));
+    data[KEY_STATUS_COUNTS] = statusCounts;
+
     const int acceptedResponseId = params()[u"rid"_qs].toInt();
     setResult(QJsonObject::fromVariantMap(generateSyncData(acceptedResponseId, data, m_lastAcceptedMaindataResponse, m_lastMaindataResponse)));
 }
 
+// The function returns the changed peers data of torrent(s) to synchronize with the web client.
+// Peers are identified by their endpoint ("ip:port") which stays the same during peer connection.
+// Only fields which changed since last accepted response are sent for known peers.
 // GET param:
 //   - hash (string): torrent hash (ID)
+//   - hashes (string): hashes of several torrents separated by "|", can be used instead of "hash"
 //   - rid (int): last response id
+// When "hashes" is used the peers data of each torrent is put into "torrents" dictionary
+// indexed by torrent hash and "torrents_removed" contains hashes of torrents which are gone.
 void SyncController::torrentPeersAction()
 {
-    const auto id = BitTorrent::TorrentID::fromString(params()[u"hash"_qs]);
-    const BitTorrent::Torrent *torrent = BitTorrent::Session::instance()->getTorrent(id);
-    if (!torrent)
-        throw APIError(APIErrorType::NotFound);
+    const bool isMultiple = params().contains(u"hashes"_qs);
+    const QStringList idStrings = isMultiple
+        ? params()[u"hashes"_qs].split(u'|', Qt::SkipEmptyParts)
+        : QStringList {params()[u"hash"_qs]};
+
+    QVector<const BitTorrent::Torrent *> torrents;
+    torrents.reserve(idStrings.size());
+    for (const QString &idString : idStrings)
+    {
+        const auto id = BitTorrent::TorrentID::fromString(idString);
+        const BitTorrent::Torrent *torrent = BitTorrent::Session::instance()->getTorrent(id);
+        if (torrent)
+            torrents.append(torrent);
+        else if (!isMultiple)
+            throw APIError(APIErrorType::NotFound);
+    }
 
-    QVariantMap data;
-    QVariantHash peers;
+    const int acceptedResponseId = params()[u"rid"_qs].toInt();
+    bool fullUpdate = true;
+    if (acceptedResponseId > 0)
+    {
+        if (acceptedResponseId == m_lastPeersResponseId)
+        {
+            m_lastAcceptedPeersSnapshot = m_lastPeersSnapshot;
+            m_lastAcceptedPeersResponseId = m_lastPeersResponseId;
+        }
 
-    const QVector<BitTorrent::PeerInfo> peersList = torrent->peers();
+        fullUpdate = (acceptedResponseId != m_lastAcceptedPeersResponseId);
+    }
 
-    bool resolvePeerCountries = Preferences::instance()->resolvePeerCountries();
+    if (fullUpdate)
+    {
+        m_lastAcceptedPeersSnapshot.clear();
+        m_lastAcceptedPeersResponseId = 0;
+    }
 
-    data[KEY_SYNC_TORRENT_PEERS_SHOW_FLAGS] = resolvePeerCountries;
+    const bool showFlags = Preferences::instance()->resolvePeerCountries();
+
+    PeersSyncSnapshot snapshot;
+    QVariantMap syncData;
+    QVariantMap torrentsData;
+    for (const BitTorrent::Torrent *torrent : asConst(torrents))
+    {
+        TorrentPeersSyncData &torrentSyncData = snapshot[torrent->id()];
+        const QVariantMap torrentPeersData = syncTorrentPeers(torrent, showFlags, torrentSyncData);
+        if (!isMultiple)
+            syncData = torrentPeersData;
+        else if (!torrentPeersData.isEmpty())
+            torrentsData[torrent->id().toString()] = torrentPeersData;
+    }
+
+    if (isMultiple)
+    {
+        if (fullUpdate)
+            syncData[KEY_FULL_UPDATE] = true;
+        if (!torrentsData.isEmpty() || fullUpdate)
+            syncData[u"torrents"_qs] = torrentsData;
+
+        QVariantList removedTorrents;
+        for (auto iter = m_lastAcceptedPeersSnapshot.cbegin(); iter != m_lastAcceptedPeersSnapshot.cend(); ++iter)
+        {
+            if (!snapshot.contains(iter.key()))
+                removedTorrents.append(iter.key().toString());
+        }
+        if (!removedTorrents.isEmpty())
+            syncData[u"torrents_removed"_qs] = removedTorrents;
+    }
+
+    // Forget cached files of pieces of torrents which aren't watched anymore
+    for (auto iter = m_pieceFilesCache.begin(); iter != m_pieceFilesCache.end();)
+    {
+        if (snapshot.contains(iter.key()))
+            ++iter;
+        else
+            iter = m_pieceFilesCache.erase(iter);
+    }
 
+    const int lastResponseId = (acceptedResponseId > 0) ? m_lastPeersResponseId : 0;
+    m_lastPeersResponseId = (lastResponseId % 1000000) + 1;  // cycle between 1 and 1000000
+    m_lastPeersSnapshot = std::move(snapshot);
+    syncData[KEY_RESPONSE_ID] = m_lastPeersResponseId;
+
+    setResult(QJsonObject::fromVariantMap(syncData));
+}
+
+QVariantMap SyncController::syncTorrentPeers(const BitTorrent::Torrent *torrent, const bool showFlags, TorrentPeersSyncData &syncData)
+{
+    const auto prevSyncDataIter = m_lastAcceptedPeersSnapshot.constFind(torrent->id());
+    const TorrentPeersSyncData *prevSyncData = (prevSyncDataIter != m_lastAcceptedPeersSnapshot.cend())
+        ? &prevSyncDataIter.value() : nullptr;
+
+    syncData.showFlags = showFlags;
+    const bool hasMetadata = torrent->hasMetadata();
+    const QVector<BitTorrent::PeerInfo> peersList = torrent->peers();
+
+    QVariantHash peers;
     for (const BitTorrent::PeerInfo &pi : peersList)
     {
         if (pi.address().ip.isNull()) continue;
 
-        QVariantMap peer =
+        const QString peerID = pi.address().toString();
+        const PeerSyncData *prevPeer = nullptr;
+        if (prevSyncData)
         {
-            {KEY_PEER_IP, pi.address().ip.toString()},
-            {KEY_PEER_PORT, pi.address().port},
-            {KEY_PEER_CLIENT, pi.client()},
-            {KEY_PEER_ID_CLIENT, pi.peerIdClient()},
-            {KEY_PEER_PROGRESS, pi.progress()},
-            {KEY_PEER_DOWN_SPEED, pi.payloadDownSpeed()},
-            {KEY_PEER_UP_SPEED, pi.payloadUpSpeed()},
-            {KEY_PEER_TOT_DOWN, pi.totalDownload()},
-            {KEY_PEER_TOT_UP, pi.totalUpload()},
-            {KEY_PEER_CONNECTION_TYPE, pi.connectionType()},
-            {KEY_PEER_FLAGS, pi.flags()},
-            {KEY_PEER_FLAGS_DESCRIPTION, pi.flagsDescription()},
-            {KEY_PEER_RELEVANCE, pi.relevance()}
-        };
-
-        if (torrent->hasMetadata())
+            const auto prevPeerIter = prevSyncData->peers.constFind(peerID);
+            if (prevPeerIter != prevSyncData->peers.cend())
+                prevPeer = &prevPeerIter.value();
+        }
+
+        PeerSyncData &peerData = syncData.peers[peerID];
+        peerData.client = pi.client();
+        peerData.peerIdClient = pi.peerIdClient();
+        peerData.progress = pi.progress();
+        peerData.downSpeed = pi.payloadDownSpeed();
+        peerData.upSpeed = pi.payloadUpSpeed();
+        peerData.totalDown = pi.totalDownload();
+        peerData.totalUp = pi.totalUpload();
+        peerData.flags = pi.flags();
+        peerData.relevance = pi.relevance();
+        peerData.downloadingPieceIndex = pi.downloadingPieceIndex();
+        peerData.hasFiles = hasMetadata;
+
+        const bool isNewPeer = !prevPeer || (prevSyncData->showFlags != showFlags);
+        QVariantMap peer;
+
+        if (isNewPeer)
+        {
+            peer[KEY_PEER_IP] = pi.address().ip.toString();
+            peer[KEY_PEER_PORT] = pi.address().port;
+            peer[KEY_PEER_CONNECTION_TYPE] = pi.connectionType();
+        }
+
+        if (isNewPeer || (peerData.client != prevPeer->client))
+            peer[KEY_PEER_CLIENT] = peerData.client;
+        if (isNewPeer || (peerData.peerIdClient != prevPeer->peerIdClient))
+            peer[KEY_PEER_ID_CLIENT] = peerData.peerIdClient;
+        if (isNewPeer || (peerData.progress != prevPeer->progress))
+            peer[KEY_PEER_PROGRESS] = peerData.progress;
+        if (isNewPeer || (peerData.downSpeed != prevPeer->downSpeed))
+            peer[KEY_PEER_DOWN_SPEED] = peerData.downSpeed;
+        if (isNewPeer || (peerData.upSpeed != prevPeer->upSpeed))
+            peer[KEY_PEER_UP_SPEED] = peerData.upSpeed;
+        if (isNewPeer || (peerData.totalDown != prevPeer->totalDown))
+            peer[KEY_PEER_TOT_DOWN] = peerData.totalDown;
+        if (isNewPeer || (peerData.totalUp != prevPeer->totalUp))
+            peer[KEY_PEER_TOT_UP] = peerData.totalUp;
+        if (isNewPeer || (peerData.flags != prevPeer->flags))
+        {
+            peer[KEY_PEER_FLAGS] = peerData.flags;
+            peer[KEY_PEER_FLAGS_DESCRIPTION] = pi.flagsDescription();
+        }
+        if (isNewPeer || (peerData.relevance != prevPeer->relevance))
+            peer[KEY_PEER_RELEVANCE] = peerData.relevance;
+
+        if (hasMetadata && (isNewPeer || !prevPeer->hasFiles
+                || (peerData.downloadingPieceIndex != prevPeer->downloadingPieceIndex)))
         {
-            const PathList filePaths = torrent->info().filesForPiece(pi.downloadingPieceIndex());
-            QStringList filesForPiece;
-            filesForPiece.reserve(filePaths.size());
-            for (const Path &filePath : filePaths)
-                filesForPiece.append(filePath.toString());
-            peer.insert(KEY_PEER_FILES, filesForPiece.join(u'\n'));
+            peer[KEY_PEER_FILES] = filesForPiece(torrent, peerData.downloadingPieceIndex);
         }
 
-        if (resolvePeerCountries)
+        if (showFlags)
         {
-            peer[KEY_PEER_COUNTRY_CODE] = pi.country().toLower();
-            peer[KEY_PEER_COUNTRY] = Net::GeoIPManager::CountryName(pi.country());
+            // host names aren't sent, so there is no need to look them up
+            const Net::PeerMetadata metadata = Net::PeerMetadataResolver::instance()->countryMetadata(pi.address().ip);
+            peerData.countryCode = metadata.countryCode.toLower();
+            if (isNewPeer || (peerData.countryCode != prevPeer->countryCode))
+            {
+                peer[KEY_PEER_COUNTRY_CODE] = peerData.countryCode;
+                peer[KEY_PEER_COUNTRY] = metadata.countryName;
+            }
         }
 
-        peers[pi.address().toString()] = peer;
+        if (!peer.isEmpty())
+            peers[peerID] = peer;
     }
-    data[u"peers"_qs] = peers;
 
-    const int acceptedResponseId = params()[u"rid"_qs].toInt();
-    setResult(QJsonObject::fromVariantMap(generateSyncData(acceptedResponseId, data, m_lastAcceptedPeersResponse, m_lastPeersResponse)));
+    QVariantMap data;
+    if (!prevSyncData)
+    {
+        data[KEY_FULL_UPDATE] = true;
+        data[KEY_SYNC_TORRENT_PEERS_SHOW_FLAGS] = showFlags;
+        data[u"peers"_qs] = peers;
+        return data;
+    }
+
+    if (prevSyncData->showFlags != showFlags)
+        data[KEY_SYNC_TORRENT_PEERS_SHOW_FLAGS] = showFlags;
+    if (!peers.isEmpty())
+        data[u"peers"_qs] = peers;
+
+    QVariantList removedPeers;
+    for (auto iter = prevSyncData->peers.cbegin(); iter != prevSyncData->peers.cend(); ++iter)
+    {
+        if (!syncData.peers.contains(iter.key()))
+            removedPeers.append(iter.key());
+    }
+    if (!removedPeers.isEmpty())
+        data[u"peers_removed"_qs] = removedPeers;
+
+    return data;
+}
+
+QString SyncController::filesForPiece(const BitTorrent::Torrent *torrent, const int pieceIndex)
+{
+    QHash<int, QString> &pieceFiles = m_pieceFilesCache[torrent->id()];
+    const auto iter = pieceFiles.constFind(pieceIndex);
+    if (iter != pieceFiles.cend())
+        return iter.value();
+
+    const PathList filePaths = torrent->info().filesForPiece(pieceIndex);
+    QStringList files;
+    files.reserve(filePaths.size());
+    for (const Path &filePath : filePaths)
+        files.append(filePath.toString());
+
+    const QString joinedFiles = files.join(u'\n');
+    pieceFiles.insert(pieceIndex, joinedFiles);
+    return joinedFiles;
 }
 
 qint64 SyncController::getFreeDiskSpace()
@@ -29,14 +29,21 @@
 #pragma once
 
 #include <QElapsedTimer>
+#include <QHash>
 #include <QVariantMap>
 
+#include "base/bittorrent/infohash.h"
 #include "apicontroller.h"
 
 class QThread;
 
 class FreeDiskSpaceChecker;
 
+namespace BitTorrent
+{
+    class Torrent;
+}
+
 class SyncController : public APIController
 {
     Q_OBJECT
@@ -52,8 +59,35 @@ private slots:
     void torrentPeersAction();
 
 private:
+    // Peer data which was sent to client (only fields which can change during peer connection)
+    struct PeerSyncData
+    {
+        QString client;
+        QString peerIdClient;
+        QString countryCode;
+        qreal progress = 0;
+        int downSpeed = 0;
+        int upSpeed = 0;
+        qlonglong totalDown = 0;
+        qlonglong totalUp = 0;
+        QString flags;
+        qreal relevance = 0;
+        int downloadingPieceIndex = -1;
+        bool hasFiles = false;
+    };
+
+    struct TorrentPeersSyncData
+    {
+        QHash<QString, PeerSyncData> peers;
+        bool showFlags = false;
+    };
+
+    using PeersSyncSnapshot = QHash<BitTorrent::TorrentID, TorrentPeersSyncData>;
+
     qint64 getFreeDiskSpace();
     void invokeChecker();
+    QVariantMap syncTorrentPeers(const BitTorrent::Torrent *torrent, bool showFlags, TorrentPeersSyncData &syncData);
+    QString filesForPiece(const BitTorrent::Torrent *torrent, int pieceIndex);
 
     qint64 m_freeDiskSpace = 0;
     QElapsedTimer m_freeDiskSpaceElapsedTimer;
@@ -61,6 +95,11 @@ private:
 
     QVariantMap m_lastMaindataResponse;
     QVariantMap m_lastAcceptedMaindataResponse;
-    QVariantMap m_lastPeersResponse;
-    QVariantMap m_lastAcceptedPeersResponse;
+
+    PeersSyncSnapshot m_lastPeersSnapshot;
+    PeersSyncSnapshot m_lastAcceptedPeersSnapshot;
+    int m_lastPeersResponseId = 0;
+    int m_lastAcceptedPeersResponseId = 0;
+    // Joined file paths of pieces, grouped by torrent
+    QHash<BitTorrent::TorrentID, QHash<int, QString>> m_pieceFilesCache;
 };
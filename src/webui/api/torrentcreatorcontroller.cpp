@@ -0,0 +1,238 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include "torrentcreatorcontroller.h"
+
+#include <optional>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QSet>
+#include <QVector>
+
+#include "base/bittorrent/torrentcreationmanager.h"
+#include "base/global.h"
+#include "base/path.h"
+#include "base/utils/string.h"
+#include "apierror.h"
+
+using Utils::String::parseBool;
+using Utils::String::parseInt;
+
+namespace
+{
+    const int MIN_PIECE_SIZE = 16 * 1024;
+
+    qint64 toSecsSinceEpoch(const QDateTime &time)
+    {
+        return time.isValid() ? time.toSecsSinceEpoch() : -1;
+    }
+
+    QString stateToString(const BitTorrent::TorrentCreationTask::State state)
+    {
+        switch (state)
+        {
+        case BitTorrent::TorrentCreationTask::State::Queued:
+            return u"Queued"_qs;
+        case BitTorrent::TorrentCreationTask::State::Running:
+            return u"Running"_qs;
+        case BitTorrent::TorrentCreationTask::State::Finished:
+            return u"Finished"_qs;
+        case BitTorrent::TorrentCreationTask::State::Failed:
+            return u"Failed"_qs;
+        case BitTorrent::TorrentCreationTask::State::Cancelled:
+            return u"Cancelled"_qs;
+        }
+        return {};
+    }
+
+#ifdef QBT_USES_LIBTORRENT2
+    std::optional<BitTorrent::TorrentFormat> parseTorrentFormat(const QString &format)
+    {
+        if (format.isEmpty() || (format == u"hybrid"))
+            return BitTorrent::TorrentFormat::Hybrid;
+        if (format == u"v1")
+            return BitTorrent::TorrentFormat::V1;
+        if (format == u"v2")
+            return BitTorrent::TorrentFormat::V2;
+        return std::nullopt;
+    }
+#endif
+
+    BitTorrent::TorrentCreationTask *findTask(const QString &id)
+    {
+        BitTorrent::TorrentCreationTask *task = BitTorrent::TorrentCreationManager::instance()->getTask(id);
+        if (!task)
+            throw APIError(APIErrorType::NotFound);
+        return task;
+    }
+}
+
+// Queues creation of a torrent for every source path using the same settings.
+// POST params:
+//   - sourcePaths (string): '|' separated list of absolute paths of files or folders
+//   - outputFolder (string): folder to save torrent files to (otherwise they are kept until the task is deleted)
+//   - format (string): v1, v2 or hybrid (libtorrent 2.0 only)
+//   - optimizeAlignment (bool), paddedFileSizeLimit (int): libtorrent 1.2 only
+//   - pieceSize (int): piece size in bytes (0 means automatic)
+//   - private (bool), comment (string), source (string)
+//   - trackers (string): '|' separated list of tracker URLs, empty entries separate tiers
+//   - urlSeeds (string): '|' separated list of web seed URLs
+//   - startSeeding (bool): add created torrent to the session without checking its content
+//   - ignoreShareLimits (bool): don't apply share limits to the added torrent
+void TorrentCreatorController::addTaskAction()
+{
+    requireParams({u"sourcePaths"_qs});
+
+    const QStringList sourcePaths = params()[u"sourcePaths"_qs].split(u'|', Qt::SkipEmptyParts);
+    if (sourcePaths.isEmpty())
+        throw APIError(APIErrorType::BadParams, tr("'%1' parameter is invalid").arg(u"sourcePaths"_qs));
+
+    const Path outputFolder {params()[u"outputFolder"_qs].trimmed()};
+    if (!outputFolder.isEmpty() && (!outputFolder.isAbsolute() || !outputFolder.exists()))
+        throw APIError(APIErrorType::BadParams, tr("Output folder \"%1\" doesn't exist").arg(outputFolder.toString()));
+
+    const int pieceSize = parseInt(params()[u"pieceSize"_qs]).value_or(0);
+    if ((pieceSize != 0) && ((pieceSize < MIN_PIECE_SIZE) || ((pieceSize & (pieceSize - 1)) != 0)))
+        throw APIError(APIErrorType::BadParams, tr("'%1' parameter is invalid").arg(u"pieceSize"_qs));
+
+    BitTorrent::TorrentCreatorParams createParams {};
+    createParams.isPrivate = parseBool(params()[u"private"_qs]).value_or(false);
+#ifdef QBT_USES_LIBTORRENT2
+    const std::optional<BitTorrent::TorrentFormat> torrentFormat = parseTorrentFormat(params()[u"format"_qs]);
+    if (!torrentFormat)
+        throw APIError(APIErrorType::BadParams, tr("'%1' parameter is invalid").arg(u"format"_qs));
+    createParams.torrentFormat = *torrentFormat;
+#else
+    createParams.isAlignmentOptimized = parseBool(params()[u"optimizeAlignment"_qs]).value_or(true);
+    createParams.paddedFileSizeLimit = parseInt(params()[u"paddedFileSizeLimit"_qs]).value_or(-1);
+#endif
+    createParams.pieceSize = pieceSize;
+    createParams.comment = params()[u"comment"_qs];
+    createParams.source = params()[u"source"_qs];
+    createParams.trackers = params()[u"trackers"_qs].split(u'|');
+    createParams.urlSeeds = params()[u"urlSeeds"_qs].split(u'|', Qt::SkipEmptyParts);
+
+    const bool startSeeding = parseBool(params()[u"startSeeding"_qs]).value_or(false);
+    const bool ignoreShareLimits = parseBool(params()[u"ignoreShareLimits"_qs]).value_or(false);
+
+    // validate all the paths first so that the batch is either queued as a whole or rejected
+    QVector<BitTorrent::TorrentCreatorParams> batch;
+    QSet<QString> torrentFilePaths;
+    for (const QString &sourcePathStr : sourcePaths)
+    {
+        const Path sourcePath {sourcePathStr.trimmed()};
+        if (!sourcePath.isAbsolute() || !sourcePath.exists())
+            throw APIError(APIErrorType::BadParams, tr("Source path \"%1\" doesn't exist").arg(sourcePath.toString()));
+
+        BitTorrent::TorrentCreatorParams taskParams = createParams;
+        taskParams.inputPath = sourcePath;
+        if (!outputFolder.isEmpty())
+        {
+            taskParams.savePath = outputFolder / (Path(sourcePath.filename()) + u".torrent");
+            if (torrentFilePaths.contains(taskParams.savePath.data()))
+                throw APIError(APIErrorType::Conflict, tr("Several source paths result in the same torrent file \"%1\"").arg(taskParams.savePath.toString()));
+            torrentFilePaths.insert(taskParams.savePath.data());
+            // existing files aren't overwritten silently
+            if (taskParams.savePath.exists())
+                throw APIError(APIErrorType::Conflict, tr("Torrent file \"%1\" already exists").arg(taskParams.savePath.toString()));
+        }
+
+        batch.append(taskParams);
+    }
+
+    QJsonArray taskIDs;
+    for (const BitTorrent::TorrentCreatorParams &taskParams : asConst(batch))
+        taskIDs.append(BitTorrent::TorrentCreationManager::instance()->createTask(taskParams, startSeeding, ignoreShareLimits));
+
+    setResult(QJsonObject {{u"taskIDs"_qs, taskIDs}});
+}
+
+// Returns the status of creation tasks.
+// GET params:
+//   - taskID (string): task id (all the tasks if not specified)
+void TorrentCreatorController::statusAction()
+{
+    const QString id = params()[u"taskID"_qs];
+    const QVector<BitTorrent::TorrentCreationTask *> tasks = id.isEmpty()
+            ? BitTorrent::TorrentCreationManager::instance()->tasks()
+            : QVector<BitTorrent::TorrentCreationTask *> {findTask(id)};
+
+    QJsonArray statusArray;
+    for (const BitTorrent::TorrentCreationTask *task : tasks)
+    {
+        statusArray << QJsonObject
+        {
+            {u"taskID"_qs, task->id()},
+            {u"sourcePath"_qs, task->params().inputPath.toString()},
+            {u"torrentFilePath"_qs, task->params().savePath.toString()},
+            {u"status"_qs, stateToString(task->state())},
+            {u"progress"_qs, task->progress()},
+            {u"throughput"_qs, task->throughput()},
+            {u"errorMessage"_qs, task->errorMessage()},
+            {u"startSeeding"_qs, task->isSeedingRequested()},
+            {u"timeAdded"_qs, toSecsSinceEpoch(task->timeAdded())},
+            {u"timeStarted"_qs, toSecsSinceEpoch(task->timeStarted())},
+            {u"timeFinished"_qs, toSecsSinceEpoch(task->timeFinished())}
+        };
+    }
+
+    setResult(statusArray);
+}
+
+void TorrentCreatorController::torrentFileAction()
+{
+    requireParams({u"taskID"_qs});
+
+    const BitTorrent::TorrentCreationTask *task = findTask(params()[u"taskID"_qs]);
+    if (task->state() != BitTorrent::TorrentCreationTask::State::Finished)
+        throw APIError(APIErrorType::Conflict, tr("Torrent creation is not finished"));
+
+    QFile torrentFile {task->params().savePath.data()};
+    if (!torrentFile.open(QIODevice::ReadOnly))
+        throw APIError(APIErrorType::Conflict, tr("Cannot read file %1: %2").arg(task->params().savePath.toString(), torrentFile.errorString()));
+
+    setResult(torrentFile.readAll());
+}
+
+void TorrentCreatorController::cancelTaskAction()
+{
+    requireParams({u"taskID"_qs});
+
+    if (!BitTorrent::TorrentCreationManager::instance()->cancelTask(params()[u"taskID"_qs]))
+        throw APIError(APIErrorType::NotFound);
+}
+
+void TorrentCreatorController::deleteTaskAction()
+{
+    requireParams({u"taskID"_qs});
+
+    if (!BitTorrent::TorrentCreationManager::instance()->deleteTask(params()[u"taskID"_qs]))
+        throw APIError(APIErrorType::NotFound);
+}
@@ -38,9 +38,12 @@
 #include <QRegularExpression>
 #include <QUrl>
 
+#include "base/bittorrent/addtorrentrequest.h"
 #include "base/bittorrent/categoryoptions.h"
 #include "base/bittorrent/downloadpriority.h"
 #include "base/bittorrent/infohash.h"
+#include "base/bittorrent/magneturi.h"
+#include "base/bittorrent/movestoragejobstatus.h"
 #include "base/bittorrent/peeraddress.h"
 #include "base/bittorrent/peerinfo.h"
 #include "base/bittorrent/session.h"
@@ -69,6 +72,20 @@ const QString KEY_TRACKER_DOWNLOADED_COUNT = u"num_downloaded"_qs;
 // Web seed keys
 const QString KEY_WEBSEED_URL = u"url"_qs;
 
+// Storage move job keys
+const QString KEY_MOVE_HASH = u"hash"_qs;
+const QString KEY_MOVE_TARGET_PATH = u"target_path"_qs;
+const QString KEY_MOVE_ACTIVE = u"active"_qs;
+const QString KEY_MOVE_TOTAL_BYTES = u"total_bytes"_qs;
+const QString KEY_MOVE_MOVED_BYTES = u"moved_bytes"_qs;
+const QString KEY_MOVE_SPEED = u"speed"_qs;
+
+// Batch add result keys
+const QString KEY_ADD_SOURCE = u"source"_qs;
+const QString KEY_ADD_HASH = u"hash"_qs;
+const QString KEY_ADD_STATUS = u"status"_qs;
+const QString KEY_ADD_MESSAGE = u"message"_qs;
+
 // Torrent keys (Properties)
 const QString KEY_PROP_TIME_ELAPSED = u"time_elapsed"_qs;
 const QString KEY_PROP_SEEDING_TIME = u"seeding_time"_qs;
@@ -230,6 +247,77 @@ namespace
             idList << BitTorrent::TorrentID::fromString(hash);
         return idList;
     }
+
+    QList<QNetworkCookie> parseCookies(const QString &cookie)
+    {
+        QList<QNetworkCookie> cookies;
+        if (cookie.isEmpty())
+            return cookies;
+
+        const QStringList cookiesStr = cookie.split(u"; "_qs);
+        for (QString cookieStr : cookiesStr)
+        {
+            cookieStr = cookieStr.trimmed();
+            int index = cookieStr.indexOf(u'=');
+            if (index > 1)
+            {
+                QByteArray name = cookieStr.left(index).toLatin1();
+                QByteArray value = cookieStr.right(cookieStr.length() - index - 1).toLatin1();
+                cookies += QNetworkCookie(name, value);
+            }
+        }
+
+        return cookies;
+    }
+
+    BitTorrent::AddTorrentParams parseAddTorrentParams(const StringMap &params)
+    {
+        const QString stopConditionParam = params[u"stopCondition"_qs];
+        const QString contentLayoutParam = params[u"contentLayout"_qs];
+        const QStringList tags = params[u"tags"_qs].split(u',', Qt::SkipEmptyParts);
+
+        BitTorrent::AddTorrentParams addTorrentParams;
+        // TODO: Check if destination actually exists
+        addTorrentParams.skipChecking = parseBool(params[u"skip_checking"_qs]).value_or(false);
+        addTorrentParams.sequential = parseBool(params[u"sequentialDownload"_qs]).value_or(false);
+        addTorrentParams.firstLastPiecePriority = parseBool(params[u"firstLastPiecePrio"_qs]).value_or(false);
+        addTorrentParams.addPaused = parseBool(params[u"paused"_qs]);
+        addTorrentParams.stopCondition = (!stopConditionParam.isEmpty()
+                ? Utils::String::toEnum(stopConditionParam, BitTorrent::Torrent::StopCondition::None)
+                : std::optional<BitTorrent::Torrent::StopCondition> {});
+        addTorrentParams.contentLayout = (!contentLayoutParam.isEmpty()
+                ? Utils::String::toEnum(contentLayoutParam, BitTorrent::TorrentContentLayout::Original)
+                : std::optional<BitTorrent::TorrentContentLayout> {});
+        addTorrentParams.savePath = Path(params[u"savepath"_qs].trimmed());
+        addTorrentParams.downloadPath = Path(params[u"downloadPath"_qs].trimmed());
+        addTorrentParams.useDownloadPath = parseBool(params[u"useDownloadPath"_qs]);
+        addTorrentParams.category = params[u"category"_qs];
+        addTorrentParams.tags.insert(tags.cbegin(), tags.cend());
+        addTorrentParams.name = params[u"rename"_qs].trimmed();
+        addTorrentParams.uploadLimit = parseInt(params[u"upLimit"_qs]).value_or(-1);
+        addTorrentParams.downloadLimit = parseInt(params[u"dlLimit"_qs]).value_or(-1);
+        addTorrentParams.seedingTimeLimit = parseInt(params[u"seedingTimeLimit"_qs]).value_or(BitTorrent::Torrent::USE_GLOBAL_SEEDING_TIME);
+        addTorrentParams.ratioLimit = parseDouble(params[u"ratioLimit"_qs]).value_or(BitTorrent::Torrent::USE_GLOBAL_RATIO);
+        addTorrentParams.useAutoTMM = parseBool(params[u"autoTMM"_qs]);
+
+        return addTorrentParams;
+    }
+
+    QString addTorrentStatusString(const BitTorrent::AddTorrentStatus status)
+    {
+        switch (status)
+        {
+        case BitTorrent::AddTorrentStatus::Added:
+            return u"added"_qs;
+        case BitTorrent::AddTorrentStatus::Duplicate:
+            return u"duplicate"_qs;
+        case BitTorrent::AddTorrentStatus::InvalidSource:
+            return u"invalid"_qs;
+        case BitTorrent::AddTorrentStatus::Failed:
+        default:
+            return u"failed"_qs;
+        }
+    }
 }
 
 // Returns all the torrents in JSON format.
@@ -656,70 +744,8 @@ void TorrentsController::pieceStatesAction()
 void TorrentsController::addAction()
 {
     const QString urls = params()[u"urls"_qs];
-    const QString cookie = params()[u"cookie"_qs];
-
-    const bool skipChecking = parseBool(params()[u"skip_checking"_qs]).value_or(false);
-    const bool seqDownload = parseBool(params()[u"sequentialDownload"_qs]).value_or(false);
-    const bool firstLastPiece = parseBool(params()[u"firstLastPiecePrio"_qs]).value_or(false);
-    const std::optional<bool> addPaused = parseBool(params()[u"paused"_qs]);
-    const QString savepath = params()[u"savepath"_qs].trimmed();
-    const QString downloadPath = params()[u"downloadPath"_qs].trimmed();
-    const std::optional<bool> useDownloadPath = parseBool(params()[u"useDownloadPath"_qs]);
-    const QString category = params()[u"category"_qs];
-    const QStringList tags = params()[u"tags"_qs].split(u',', Qt::SkipEmptyParts);
-    const QString torrentName = params()[u"rename"_qs].trimmed();
-    const int upLimit = parseInt(params()[u"upLimit"_qs]).value_or(-1);
-    const int dlLimit = parseInt(params()[u"dlLimit"_qs]).value_or(-1);
-    const double ratioLimit = parseDouble(params()[u"ratioLimit"_qs]).value_or(BitTorrent::Torrent::USE_GLOBAL_RATIO);
-    const int seedingTimeLimit = parseInt(params()[u"seedingTimeLimit"_qs]).value_or(BitTorrent::Torrent::USE_GLOBAL_SEEDING_TIME);
-    const std::optional<bool> autoTMM = parseBool(params()[u"autoTMM"_qs]);
-
-    const QString stopConditionParam = params()[u"stopCondition"_qs];
-    const std::optional<BitTorrent::Torrent::StopCondition> stopCondition = (!stopConditionParam.isEmpty()
-            ? Utils::String::toEnum(stopConditionParam, BitTorrent::Torrent::StopCondition::None)
-            : std::optional<BitTorrent::Torrent::StopCondition> {});
-
-    const QString contentLayoutParam = params()[u"contentLayout"_qs];
-    const std::optional<BitTorrent::TorrentContentLayout> contentLayout = (!contentLayoutParam.isEmpty()
-            ? Utils::String::toEnum(contentLayoutParam, BitTorrent::TorrentContentLayout::Original)
-            : std::optional<BitTorrent::TorrentContentLayout> {});
-
-    QList<QNetworkCookie> cookies;
-    if (!cookie.isEmpty())
-    {
-        const QStringList cookiesStr = cookie.split(u"; "_qs);
-        for (QString cookieStr : cookiesStr)
-        {
-            cookieStr = cookieStr.trimmed();
-            int index = cookieStr.indexOf(u'=');
-            if (index > 1)
-            {
-                QByteArray name = cookieStr.left(index).toLatin1();
-                QByteArray value = cookieStr.right(cookieStr.length() - index - 1).toLatin1();
-                cookies += QNetworkCookie(name, value);
-            }
-        }
-    }
-
-    BitTorrent::AddTorrentParams addTorrentParams;
-    // TODO: Check if destination actually exists
-    addTorrentParams.skipChecking = skipChecking;
-    addTorrentParams.sequential = seqDownload;
-    addTorrentParams.firstLastPiecePriority = firstLastPiece;
-    addTorrentParams.addPaused = addPaused;
-    addTorrentParams.stopCondition = stopCondition;
-    addTorrentParams.contentLayout = contentLayout;
-    addTorrentParams.savePath = Path(savepath);
-    addTorrentParams.downloadPath = Path(downloadPath);
-    addTorrentParams.useDownloadPath = useDownloadPath;
-    addTorrentParams.category = category;
-    addTorrentParams.tags.insert(tags.cbegin(), tags.cend());
-    addTorrentParams.name = torrentName;
-    addTorrentParams.uploadLimit = upLimit;
-    addTorrentParams.downloadLimit = dlLimit;
-    addTorrentParams.seedingTimeLimit = seedingTimeLimit;
-    addTorrentParams.ratioLimit = ratioLimit;
-    addTorrentParams.useAutoTMM = autoTMM;
+    const QList<QNetworkCookie> cookies = parseCookies(params()[u"cookie"_qs]);
+    const BitTorrent::AddTorrentParams addTorrentParams = parseAddTorrentParams(params());
 
     bool partialSuccess = false;
     for (QString url : asConst(urls.split(u'\n')))
@@ -751,6 +777,88 @@ void TorrentsController::addAction()
         setResult(u"Fails."_qs);
 }
 
+// Adds torrents in bulk and reports the result of each item.
+// Magnet links and torrent files are added to session in single batch,
+// torrents that need to be downloaded first are reported as "pending".
+// Results are in the same order as the items are: URLs first, then torrent files.
+void TorrentsController::addBatchAction()
+{
+    const QString urls = params()[u"urls"_qs];
+    const QList<QNetworkCookie> cookies = parseCookies(params()[u"cookie"_qs]);
+    const BitTorrent::AddTorrentParams addTorrentParams = parseAddTorrentParams(params());
+
+    auto *session = BitTorrent::Session::instance();
+
+    QVector<QJsonObject> results;
+    QVector<BitTorrent::AddTorrentRequest> requests;
+    // positions of the results of batch added items
+    QVector<int> requestResultIndexes;
+
+    for (QString url : asConst(urls.split(u'\n')))
+    {
+        url = url.trimmed();
+        if (url.isEmpty())
+            continue;
+
+        const BitTorrent::MagnetUri magnetUri {url};
+        if (magnetUri.isValid())
+        {
+            requests.append({magnetUri, addTorrentParams});
+            requestResultIndexes.append(results.size());
+            results.append(QJsonObject {{KEY_ADD_SOURCE, url}});
+            continue;
+        }
+
+        const bool isDownloadable = Net::DownloadManager::hasSupportedScheme(url);
+        if (isDownloadable)
+            Net::DownloadManager::instance()->setCookiesFromUrl(cookies, QUrl::fromEncoded(url.toUtf8()));
+
+        const bool isAdded = session->addTorrent(url, addTorrentParams);
+        results.append(QJsonObject
+        {
+            {KEY_ADD_SOURCE, url},
+            {KEY_ADD_STATUS, (isAdded ? (isDownloadable ? u"pending"_qs : u"added"_qs) : u"failed"_qs)}
+        });
+    }
+
+    const DataMap torrents = data();
+    for (auto it = torrents.constBegin(); it != torrents.constEnd(); ++it)
+    {
+        const nonstd::expected<BitTorrent::TorrentInfo, QString> result = BitTorrent::TorrentInfo::load(it.value());
+        if (!result)
+        {
+            results.append(QJsonObject
+            {
+                {KEY_ADD_SOURCE, it.key()},
+                {KEY_ADD_STATUS, addTorrentStatusString(BitTorrent::AddTorrentStatus::InvalidSource)},
+                {KEY_ADD_MESSAGE, result.error()}
+            });
+            continue;
+        }
+
+        requests.append({result.value(), addTorrentParams});
+        requestResultIndexes.append(results.size());
+        results.append(QJsonObject {{KEY_ADD_SOURCE, it.key()}});
+    }
+
+    const QVector<BitTorrent::AddTorrentResult> addResults = session->addTorrents(requests);
+    for (int i = 0; i < addResults.size(); ++i)
+    {
+        const BitTorrent::AddTorrentResult &addResult = addResults[i];
+        QJsonObject &item = results[requestResultIndexes[i]];
+        item[KEY_ADD_STATUS] = addTorrentStatusString(addResult.status);
+        if (addResult.torrentID.isValid())
+            item[KEY_ADD_HASH] = addResult.torrentID.toString();
+        if (!addResult.message.isEmpty())
+            item[KEY_ADD_MESSAGE] = addResult.message;
+    }
+
+    QJsonArray jsonResults;
+    for (const QJsonObject &item : asConst(results))
+        jsonResults.append(item);
+    setResult(jsonResults);
+}
+
 void TorrentsController::addTrackersAction()
 {
     requireParams({u"hash"_qs, u"urls"_qs});
@@ -1422,3 +1530,32 @@ void TorrentsController::exportAction()
 
     setResult(result.value());
 }
+
+// Returns the torrent storage move jobs in JSON format.
+// Active jobs are listed first, then queued ones in the order they will be started.
+// The return value is a JSON-formatted list of dictionaries.
+// The dictionary keys are:
+//   - "hash": Torrent hash
+//   - "target_path": Destination path
+//   - "active": Whether the data is being moved right now
+//   - "total_bytes": Amount of data to be moved (0 if it is unknown, e.g. moving within the same device)
+//   - "moved_bytes": Amount of data already moved
+//   - "speed": Average move speed (bytes/s)
+void TorrentsController::storageMovesAction()
+{
+    QJsonArray jobList;
+    for (const BitTorrent::MoveStorageJobStatus &job : asConst(BitTorrent::Session::instance()->moveStorageJobs()))
+    {
+        jobList.append(QJsonObject
+        {
+            {KEY_MOVE_HASH, job.torrentID.toString()},
+            {KEY_MOVE_TARGET_PATH, job.targetPath.toString()},
+            {KEY_MOVE_ACTIVE, job.isActive},
+            {KEY_MOVE_TOTAL_BYTES, job.totalBytes},
+            {KEY_MOVE_MOVED_BYTES, job.movedBytes},
+            {KEY_MOVE_SPEED, job.speed}
+        });
+    }
+
+    setResult(jobList);
+}
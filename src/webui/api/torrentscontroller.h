@@ -62,6 +62,7 @@ private slots:
     void deleteTagsAction();
     void tagsAction();
     void addAction();
+    void addBatchAction();
     void deleteAction();
     void addTrackersAction();
     void editTrackerAction();
@@ -88,4 +89,5 @@ private slots:
     void renameFileAction();
     void renameFolderAction();
     void exportAction();
+    void storageMovesAction();
 };
@@ -28,6 +28,8 @@
 
 #include "transfercontroller.h"
 
+#include <chrono>
+
 #include <QJsonObject>
 #include <QVector>
 
@@ -48,6 +50,21 @@ const QString KEY_TRANSFER_UPRATELIMIT = u"up_rate_limit"_qs;
 const QString KEY_TRANSFER_DHT_NODES = u"dht_nodes"_qs;
 const QString KEY_TRANSFER_CONNECTION_STATUS = u"connection_status"_qs;
 
+namespace
+{
+    QStringList parsePeerIPs(const QString &peers)
+    {
+        QStringList ips;
+        for (const QString &peer : asConst(peers.split(u'|')))
+        {
+            const BitTorrent::PeerAddress addr = BitTorrent::PeerAddress::parse(peer.trimmed());
+            if (!addr.ip.isNull())
+                ips.append(addr.ip.toString());
+        }
+        return ips;
+    }
+}
+
 // Returns the global transfer information in JSON format.
 // The return value is a JSON-formatted dictionary.
 // The dictionary keys are:
@@ -135,11 +152,23 @@ void TransferController::banPeersAction()
 {
     requireParams({u"peers"_qs});
 
-    const QStringList peers = params()[u"peers"_qs].split(u'|');
-    for (const QString &peer : peers)
+    // Optional ban duration in seconds, the ban is permanent if it isn't specified
+    std::chrono::seconds duration {0};
+    const QString durationParam = params().value(u"duration"_qs);
+    if (!durationParam.isEmpty())
     {
-        const BitTorrent::PeerAddress addr = BitTorrent::PeerAddress::parse(peer.trimmed());
-        if (!addr.ip.isNull())
-            BitTorrent::Session::instance()->banIP(addr.ip.toString());
+        const std::optional<int> durationSecs = Utils::String::parseInt(durationParam);
+        if (!durationSecs || (*durationSecs <= 0))
+            throw APIError(APIErrorType::BadParams, tr("'duration' must be a positive number of seconds"));
+        duration = std::chrono::seconds(*durationSecs);
     }
+
+    BitTorrent::Session::instance()->banIPs(parsePeerIPs(params()[u"peers"_qs]), duration);
+}
+
+void TransferController::unbanPeersAction()
+{
+    requireParams({u"peers"_qs});
+
+    BitTorrent::Session::instance()->unbanIPs(parsePeerIPs(params()[u"peers"_qs]));
 }
@@ -59,6 +59,7 @@
 #include "api/rsscontroller.h"
 #include "api/searchcontroller.h"
 #include "api/synccontroller.h"
+#include "api/torrentcreatorcontroller.h"
 #include "api/torrentscontroller.h"
 #include "api/transfercontroller.h"
 
@@ -650,6 +651,7 @@ void WebApplication::sessionStart()
     m_currentSession->registerAPIController<RSSController>(u"rss"_qs);
     m_currentSession->registerAPIController<SearchController>(u"search"_qs);
     m_currentSession->registerAPIController<SyncController>(u"sync"_qs);
+    m_currentSession->registerAPIController<TorrentCreatorController>(u"torrentcreator"_qs);
     m_currentSession->registerAPIController<TorrentsController>(u"torrents"_qs);
     m_currentSession->registerAPIController<TransferController>(u"transfer"_qs);
     m_sessions[m_currentSession->id()] = m_currentSession;
@@ -52,7 +52,7 @@
 #include "base/utils/version.h"
 #include "api/isessionmanager.h"
 
-inline const Utils::Version<3, 2> API_VERSION {2, 8, 19};
+inline const Utils::Version<3, 2> API_VERSION {2, 8, 32};
 
 class APIController;
 class AuthController;
@@ -163,7 +163,11 @@ private:
         {{u"search"_qs, u"stop"_qs}, Http::METHOD_POST},
         {{u"search"_qs, u"uninstallPlugin"_qs}, Http::METHOD_POST},
         {{u"search"_qs, u"updatePlugins"_qs}, Http::METHOD_POST},
+        {{u"torrentcreator"_qs, u"addTask"_qs}, Http::METHOD_POST},
+        {{u"torrentcreator"_qs, u"cancelTask"_qs}, Http::METHOD_POST},
+        {{u"torrentcreator"_qs, u"deleteTask"_qs}, Http::METHOD_POST},
         {{u"torrents"_qs, u"add"_qs}, Http::METHOD_POST},
+        {{u"torrents"_qs, u"addBatch"_qs}, Http::METHOD_POST},
         {{u"torrents"_qs, u"addPeers"_qs}, Http::METHOD_POST},
         {{u"torrents"_qs, u"addTags"_qs}, Http::METHOD_POST},
         {{u"torrents"_qs, u"addTrackers"_qs}, Http::METHOD_POST},
@@ -205,6 +209,7 @@ private:
         {{u"transfer"_qs, u"setSpeedLimitsMode"_qs}, Http::METHOD_POST},
         {{u"transfer"_qs, u"setUploadLimit"_qs}, Http::METHOD_POST},
         {{u"transfer"_qs, u"toggleSpeedLimitsMode"_qs}, Http::METHOD_POST},
+        {{u"transfer"_qs, u"unbanPeers"_qs}, Http::METHOD_POST},
     };
     bool m_isAltUIUsed = false;
     Path m_rootFolder;
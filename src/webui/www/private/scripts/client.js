@@ -310,6 +310,7 @@ window.addEvent('load', function() {
 
     let syncMainDataLastResponseId = 0;
     const serverState = {};
+    const statusCounts = {};
 
     const removeTorrentFromCategoryList = function(hash) {
         if (hash === null || hash === "")
@@ -389,7 +390,10 @@ window.addEvent('load', function() {
     };
 
     const updateFilter = function(filter, filterTitle) {
-        $(filter + '_filter').firstChild.childNodes[1].nodeValue = filterTitle.replace('%1', torrentsTable.getFilteredTorrentsNumber(filter, CATEGORIES_ALL, TAGS_ALL, TRACKERS_ALL));
+        const count = (statusCounts[filter] !== undefined)
+            ? statusCounts[filter]
+            : torrentsTable.getFilteredTorrentsNumber(filter, CATEGORIES_ALL, TAGS_ALL, TRACKERS_ALL);
+        $(filter + '_filter').firstChild.childNodes[1].nodeValue = filterTitle.replace('%1', count);
     };
 
     const updateFiltersList = function() {
@@ -694,6 +698,11 @@ window.addEvent('load', function() {
                             serverState[k] = tmp[k];
                         processServerState();
                     }
+                    if (response['status_counts']) {
+                        const tmp = response['status_counts'];
+                        for (const k in tmp)
+                            statusCounts[k] = tmp[k];
+                    }
                     updateFiltersList();
                     if (update_categories) {
                         updateCategoryList();
@@ -0,0 +1,105 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <chrono>
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QTest>
+
+#include "app/torrenteventstream.h"
+#include "base/global.h"
+#include "base/logger.h"
+#include "base/path.h"
+
+using namespace std::chrono_literals;
+
+namespace
+{
+    QString serverName()
+    {
+        return u"qbt-test-event-stream-%1"_qs.arg(QCoreApplication::applicationPid());
+    }
+}
+
+class TestAppTorrentEventStream final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestAppTorrentEventStream)
+
+public:
+    TestAppTorrentEventStream() = default;
+
+private slots:
+    void initTestCase() const
+    {
+        Logger::initInstance();
+    }
+
+    void cleanupTestCase() const
+    {
+        Logger::freeInstance();
+    }
+
+    void testDeliveryAfterReconnect() const
+    {
+        QLocalServer::removeServer(serverName());
+
+        // there is no reader yet, so the event has to wait for it
+        TorrentEventStream stream {Path(serverName())};
+        stream.setReconnectInterval(10ms);
+        stream.write("first\n");
+
+        QLocalServer server;
+        QVERIFY(server.listen(serverName()));
+
+        QByteArray received;
+        connect(&server, &QLocalServer::newConnection, &server, [&server, &received]()
+        {
+            QLocalSocket *socket = server.nextPendingConnection();
+            connect(socket, &QLocalSocket::readyRead, socket, [socket, &received]()
+            {
+                received += socket->readAll();
+            });
+        });
+
+        // the stream reconnects by itself, so the event is delivered without any further writes
+        QTRY_COMPARE(received, QByteArray("first\n"));
+
+        stream.write("second\n");
+        QTRY_COMPARE(received, QByteArray("first\nsecond\n"));
+
+        stream.write("third\n");
+        QTRY_COMPARE(received, QByteArray("first\nsecond\nthird\n"));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestAppTorrentEventStream)
+#include "testapptorrenteventstream.moc"
@@ -0,0 +1,249 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <libtorrent/address.hpp>
+#include <libtorrent/ip_filter.hpp>
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+
+#include "base/bittorrent/filterparserthread.h"
+#include "base/global.h"
+#include "base/logger.h"
+#include "base/path.h"
+
+namespace
+{
+    const int BENCHMARK_SIZE = 200'000;
+
+    bool isBlocked(const lt::ip_filter &filter, const char *address)
+    {
+        return (filter.access(lt::make_address(address)) == lt::ip_filter::blocked);
+    }
+
+    bool writeFile(const Path &path, const QByteArray &data)
+    {
+        QFile file {path.data()};
+        return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+    }
+
+    bool setModificationTime(const Path &path, const QDateTime &time)
+    {
+        QFile file {path.data()};
+        return file.open(QIODevice::ReadWrite) && file.setFileTime(time, QFileDevice::FileModificationTime);
+    }
+
+    QByteArray generateDATFilter(const int size)
+    {
+        QByteArray data;
+        for (int i = 0; i < size; ++i)
+        {
+            const QByteArray prefix = QByteArray::number((i >> 16) & 0xFF) + '.' + QByteArray::number((i >> 8) & 0xFF)
+                    + '.' + QByteArray::number(i & 0xFF);
+            data += "# range " + QByteArray::number(i) + '\n';
+            data += prefix + ".0 - " + prefix + ".127 , 000 , Some organization\n";
+        }
+        return data;
+    }
+
+    int parseFilter(FilterParserThread &parser, const Path &filePath)
+    {
+        int ruleCount = -1;
+        const QMetaObject::Connection connection = QObject::connect(&parser, &FilterParserThread::IPFilterParsed
+                , &parser, [&ruleCount](const int count) { ruleCount = count; }, Qt::DirectConnection);
+        parser.processFilterFile(filePath);
+        parser.wait();
+        QObject::disconnect(connection);
+        return ruleCount;
+    }
+}
+
+class TestBittorrentFilterParserThread final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentFilterParserThread)
+
+public:
+    TestBittorrentFilterParserThread() = default;
+
+private slots:
+    void initTestCase() const
+    {
+        Logger::initInstance();
+    }
+
+    void cleanupTestCase() const
+    {
+        Logger::freeInstance();
+    }
+
+    void testParseDAT() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path filePath = Path(dir.path()) / Path(u"filter.dat"_qs);
+        QVERIFY(writeFile(filePath, "# comment\r\n"
+                "// another comment\r\n"
+                "001.009.096.105 - 001.009.096.110 , 000 , Some organization\r\n"
+                "10.0.0.0 - 10.0.0.255 , 200 , Allowed by access level\r\n"
+                "malformed line\r\n"
+                "2001:db8:: - 2001:db8::ffff\r\n"
+                "192.168.0.1 - 192.168.0.10"));
+
+        FilterParserThread parser;
+        QCOMPARE(parseFilter(parser, filePath), 3);
+
+        const lt::ip_filter filter = parser.IPfilter();
+        QVERIFY(isBlocked(filter, "1.9.96.107"));
+        QVERIFY(!isBlocked(filter, "1.9.96.111"));
+        QVERIFY(!isBlocked(filter, "10.0.0.1"));
+        QVERIFY(isBlocked(filter, "2001:db8::1"));
+        QVERIFY(isBlocked(filter, "192.168.0.10"));
+    }
+
+    void testParseP2P() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path filePath = Path(dir.path()) / Path(u"filter.p2p"_qs);
+        QVERIFY(writeFile(filePath, "# comment\n"
+                "Some organization:1.0.0.0-1.255.255.255\n"
+                "Org: with colon:3.3.3.3 - 3.3.3.4\n"
+                "missing delimiter 4.4.4.4-4.4.4.5\n"));
+
+        FilterParserThread parser;
+        QCOMPARE(parseFilter(parser, filePath), 2);
+
+        const lt::ip_filter filter = parser.IPfilter();
+        QVERIFY(isBlocked(filter, "1.2.3.4"));
+        QVERIFY(isBlocked(filter, "3.3.3.4"));
+        QVERIFY(!isBlocked(filter, "4.4.4.4"));
+    }
+
+    void testParseChunked() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // large enough to be split into several chunks
+        const Path filePath = Path(dir.path()) / Path(u"filter.dat"_qs);
+        QVERIFY(writeFile(filePath, generateDATFilter(BENCHMARK_SIZE)));
+
+        FilterParserThread parser;
+        QCOMPARE(parseFilter(parser, filePath), BENCHMARK_SIZE);
+
+        const lt::ip_filter filter = parser.IPfilter();
+        QVERIFY(isBlocked(filter, "0.0.0.1"));
+        QVERIFY(!isBlocked(filter, "0.0.0.200"));
+        QVERIFY(isBlocked(filter, "3.13.63.127"));
+        QVERIFY(!isBlocked(filter, "3.13.64.0"));
+    }
+
+    void testCache() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path cacheFilePath = Path(dir.path()) / Path(u"ipfilter.cache"_qs);
+        const Path filePath = Path(dir.path()) / Path(u"filter.dat"_qs);
+        QVERIFY(writeFile(filePath, "1.1.1.1 - 1.1.1.2\n2001:db8::1 - 2001:db8::2\n"));
+
+        {
+            FilterParserThread parser {cacheFilePath};
+            QCOMPARE(parseFilter(parser, filePath), 2);
+            QVERIFY(cacheFilePath.exists());
+        }
+
+        // unchanged content with different modification time is still served from cache
+        QVERIFY(setModificationTime(filePath, QDateTime::currentDateTime().addDays(-1)));
+
+        {
+            FilterParserThread parser {cacheFilePath};
+            QCOMPARE(parseFilter(parser, filePath), 2);
+
+            const lt::ip_filter filter = parser.IPfilter();
+            QVERIFY(isBlocked(filter, "1.1.1.2"));
+            QVERIFY(isBlocked(filter, "2001:db8::2"));
+            QVERIFY(!isBlocked(filter, "2001:db8::3"));
+        }
+
+        // changed content of the same size invalidates cache
+        QVERIFY(writeFile(filePath, "1.1.1.3 - 1.1.1.4\n2001:db8::3 - 2001:db8::4\n"));
+        QVERIFY(setModificationTime(filePath, QDateTime::currentDateTime().addDays(-2)));
+
+        {
+            FilterParserThread parser {cacheFilePath};
+            QCOMPARE(parseFilter(parser, filePath), 2);
+
+            const lt::ip_filter filter = parser.IPfilter();
+            QVERIFY(!isBlocked(filter, "1.1.1.2"));
+            QVERIFY(isBlocked(filter, "1.1.1.4"));
+            QVERIFY(isBlocked(filter, "2001:db8::3"));
+        }
+    }
+
+    void benchmarkParseDAT() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path filePath = Path(dir.path()) / Path(u"filter.dat"_qs);
+        QVERIFY(writeFile(filePath, generateDATFilter(BENCHMARK_SIZE)));
+
+        FilterParserThread parser;
+        QBENCHMARK
+        {
+            parseFilter(parser, filePath);
+        }
+    }
+
+    void benchmarkLoadCache() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path cacheFilePath = Path(dir.path()) / Path(u"ipfilter.cache"_qs);
+        const Path filePath = Path(dir.path()) / Path(u"filter.dat"_qs);
+        QVERIFY(writeFile(filePath, generateDATFilter(BENCHMARK_SIZE)));
+
+        FilterParserThread parser {cacheFilePath};
+        QCOMPARE(parseFilter(parser, filePath), BENCHMARK_SIZE);
+        QBENCHMARK
+        {
+            parseFilter(parser, filePath);
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TestBittorrentFilterParserThread)
+#include "testbittorrentfilterparserthread.moc"
@@ -0,0 +1,135 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <vector>
+
+#include <QTest>
+
+#include "base/bittorrent/movestoragequeue.h"
+#include "base/global.h"
+
+using BitTorrent::MoveStorageQueue;
+
+namespace
+{
+    const QString DEVICE_A = u"A"_qs;
+    const QString DEVICE_B = u"B"_qs;
+    const QString DEVICE_C = u"C"_qs;
+
+    using Keys = std::vector<int>;
+}
+
+class TestBittorrentMoveStorageQueue final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentMoveStorageQueue)
+
+public:
+    TestBittorrentMoveStorageQueue() = default;
+
+private slots:
+    void testDeviceLimit() const
+    {
+        MoveStorageQueue<int> queue {1};
+        queue.enqueue(1, DEVICE_A, DEVICE_B);
+        queue.enqueue(2, DEVICE_A, DEVICE_B);
+        queue.enqueue(3, DEVICE_A, DEVICE_C);
+        queue.enqueue(4, DEVICE_B, DEVICE_B);
+
+        // moving within the same device isn't limited
+        QCOMPARE(queue.start(), Keys({1, 3, 4}));
+        QVERIFY(queue.isActive(1));
+        QVERIFY(queue.isQueued(2));
+        QCOMPARE(queue.queuedKeys(), Keys({2}));
+        QVERIFY(queue.start().empty());
+
+        queue.finish(3);
+        QVERIFY(queue.start().empty());
+        queue.finish(1);
+        QCOMPARE(queue.start(), Keys({2}));
+
+        queue.finish(2);
+        queue.finish(4);
+        QVERIFY(queue.isEmpty());
+    }
+
+    void testParallelJobsLimit() const
+    {
+        MoveStorageQueue<int> queue {2};
+        queue.enqueue(1, DEVICE_A, DEVICE_B);
+        queue.enqueue(2, DEVICE_C, DEVICE_B);
+        queue.enqueue(3, DEVICE_A, DEVICE_B);
+
+        QCOMPARE(queue.start(), Keys({1, 2}));
+        queue.finish(2);
+        QCOMPARE(queue.start(), Keys({3}));
+    }
+
+    void testSameTorrent() const
+    {
+        MoveStorageQueue<int> queue {1};
+        queue.enqueue(1, DEVICE_A, DEVICE_B);
+        QCOMPARE(queue.start(), Keys({1}));
+
+        // torrent is moved by one job at a time
+        queue.enqueue(1, DEVICE_B, DEVICE_C);
+        QVERIFY(queue.start().empty());
+        QVERIFY(queue.isActive(1));
+        QVERIFY(queue.isQueued(1));
+
+        // waiting job is replaced and it loses its position
+        queue.enqueue(2, DEVICE_A, DEVICE_C);
+        queue.enqueue(1, DEVICE_B, DEVICE_A);
+        QCOMPARE(queue.queuedKeys(), Keys({2, 1}));
+
+        queue.finish(1);
+        QCOMPARE(queue.start(), Keys({2, 1}));
+    }
+
+    void testRemove() const
+    {
+        MoveStorageQueue<int> queue {1};
+        const quint64 firstJobID = queue.enqueue(1, DEVICE_A, DEVICE_B);
+        const quint64 secondJobID = queue.enqueue(2, DEVICE_A, DEVICE_B);
+        QVERIFY(firstJobID != secondJobID);
+        queue.enqueue(3, DEVICE_C, DEVICE_B);
+
+        QVERIFY(queue.remove(1));
+        QVERIFY(!queue.remove(1));
+        QVERIFY(!queue.isQueued(1));
+        QCOMPARE(queue.queuedKeys(), Keys({2, 3}));
+        QCOMPARE(queue.start(), Keys({2}));
+
+        // running job can only be finished
+        QVERIFY(!queue.remove(2));
+        QVERIFY(queue.isActive(2));
+    }
+};
+
+QTEST_APPLESS_MAIN(TestBittorrentMoveStorageQueue)
+#include "testbittorrentmovestoragequeue.moc"
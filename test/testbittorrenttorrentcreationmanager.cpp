@@ -0,0 +1,151 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QVector>
+
+#include "base/bittorrent/torrentcreationmanager.h"
+#include "base/global.h"
+#include "base/path.h"
+
+using namespace BitTorrent;
+
+namespace
+{
+    const int PIECE_SIZE = 64 * 1024;
+    const int TIMEOUT = 30'000;
+
+    QString createTask(const Path &folder, const QString &name, const int size)
+    {
+        const Path inputPath = folder / Path(name);
+        QFile file {inputPath.data()};
+        if (!file.open(QIODevice::WriteOnly) || (file.write(QByteArray(size, 'x')) != size))
+            return {};
+        file.close();
+
+        // default parameters are enough for single file torrents
+        TorrentCreatorParams params {};
+        params.pieceSize = PIECE_SIZE;
+        params.inputPath = inputPath;
+        params.savePath = inputPath + u".torrent";
+        return TorrentCreationManager::instance()->createTask(params, false, false);
+    }
+}
+
+class TestBittorrentTorrentCreationManager final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentTorrentCreationManager)
+
+public:
+    TestBittorrentTorrentCreationManager() = default;
+
+private slots:
+    void init() const
+    {
+        TorrentCreationManager::initInstance();
+    }
+
+    void cleanup() const
+    {
+        TorrentCreationManager::freeInstance();
+    }
+
+    void testBatch() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        QVector<QString> ids;
+        for (int i = 0; i < 4; ++i)
+            ids.append(createTask(Path(dir.path()), u"file%1.bin"_qs.arg(i), ((i + 1) * PIECE_SIZE)));
+        QVERIFY(!ids.contains(QString()));
+
+        const auto *manager = TorrentCreationManager::instance();
+        QCOMPARE(manager->tasks().size(), ids.size());
+
+        for (const QString &id : asConst(ids))
+        {
+            const TorrentCreationTask *task = manager->getTask(id);
+            QVERIFY(task);
+            QTRY_VERIFY_WITH_TIMEOUT(task->isDone(), TIMEOUT);
+            QCOMPARE(task->state(), TorrentCreationTask::State::Finished);
+            QCOMPARE(task->progress(), 100);
+            QVERIFY(task->timeFinished() >= task->timeStarted());
+            QVERIFY(task->params().savePath.exists());
+        }
+    }
+
+    void testOneTaskPerDevice() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        // both inputs share the same device so the second task has to wait
+        const QString firstID = createTask(Path(dir.path()), u"first.bin"_qs, (4 * PIECE_SIZE));
+        const QString secondID = createTask(Path(dir.path()), u"second.bin"_qs, (4 * PIECE_SIZE));
+
+        auto *manager = TorrentCreationManager::instance();
+        QCOMPARE(manager->getTask(firstID)->state(), TorrentCreationTask::State::Running);
+        QCOMPARE(manager->getTask(secondID)->state(), TorrentCreationTask::State::Queued);
+
+        QVERIFY(manager->cancelTask(secondID));
+        QCOMPARE(manager->getTask(secondID)->state(), TorrentCreationTask::State::Cancelled);
+
+        QTRY_VERIFY_WITH_TIMEOUT(manager->getTask(firstID)->isDone(), TIMEOUT);
+        QCOMPARE(manager->getTask(firstID)->state(), TorrentCreationTask::State::Finished);
+    }
+
+    void testDelete() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const QString id = createTask(Path(dir.path()), u"file.bin"_qs, (16 * PIECE_SIZE));
+        const QString otherID = createTask(Path(dir.path()), u"other.bin"_qs, (4 * PIECE_SIZE));
+
+        auto *manager = TorrentCreationManager::instance();
+        QCOMPARE(manager->getTask(id)->state(), TorrentCreationTask::State::Running);
+        QVERIFY(manager->deleteTask(id));
+        QVERIFY(!manager->getTask(id));
+        QCOMPARE(manager->tasks().size(), 1);
+        QVERIFY(!manager->deleteTask(id));
+        QVERIFY(!manager->cancelTask(id));
+
+        // the deleted task keeps the device busy until it is interrupted
+        QCOMPARE(manager->getTask(otherID)->state(), TorrentCreationTask::State::Queued);
+        QTRY_VERIFY_WITH_TIMEOUT(manager->getTask(otherID)->isDone(), TIMEOUT);
+        QCOMPARE(manager->getTask(otherID)->state(), TorrentCreationTask::State::Finished);
+    }
+};
+
+QTEST_GUILESS_MAIN(TestBittorrentTorrentCreationManager)
+#include "testbittorrenttorrentcreationmanager.moc"
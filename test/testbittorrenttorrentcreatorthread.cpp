@@ -0,0 +1,304 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <iterator>
+#include <vector>
+
+#include <libtorrent/bencode.hpp>
+#include <libtorrent/create_torrent.hpp>
+#include <libtorrent/file_storage.hpp>
+#include <libtorrent/torrent_info.hpp>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QVector>
+
+#include "base/bittorrent/torrentcreatorthread.h"
+#include "base/global.h"
+#include "base/path.h"
+
+using namespace BitTorrent;
+
+namespace
+{
+    const int PIECE_SIZE = 256 * 1024;
+    const int BENCHMARK_FILE_COUNT = 16;
+    const int BENCHMARK_FILE_SIZE = 4 * 1024 * 1024;
+
+    QByteArray generateData(const int size, quint32 seed)
+    {
+        QByteArray data {size, Qt::Uninitialized};
+        for (char &c : data)
+        {
+            seed = (seed * 1103515245) + 12345;
+            c = static_cast<char>(seed >> 24);
+        }
+        return data;
+    }
+
+    bool writeFile(const Path &path, const QByteArray &data)
+    {
+        if (!QDir().mkpath(path.parentPath().data()))
+            return false;
+
+        QFile file {path.data()};
+        return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+    }
+
+    // files are spread over several folders and have sizes which aren't multiples of the piece size
+    bool generateFileTree(const Path &rootPath, const QVector<int> &fileSizes)
+    {
+        for (int i = 0; i < fileSizes.size(); ++i)
+        {
+            const Path filePath = rootPath / Path(u"dir%1/file%2.bin"_qs.arg(QString::number(i % 3), QString::number(i)));
+            if (!writeFile(filePath, generateData(fileSizes[i], i)))
+                return false;
+        }
+        return true;
+    }
+
+    TorrentCreatorParams makeParams(const Path &inputPath, const Path &savePath)
+    {
+        TorrentCreatorParams params {};
+        params.isPrivate = false;
+#ifdef QBT_USES_LIBTORRENT2
+        params.torrentFormat = TorrentFormat::V1;
+#else
+        params.isAlignmentOptimized = false;
+        params.paddedFileSizeLimit = -1;
+#endif
+        params.pieceSize = PIECE_SIZE;
+        params.inputPath = inputPath;
+        params.savePath = savePath;
+        return params;
+    }
+
+    bool createTorrent(TorrentCreatorThread &creator, const TorrentCreatorParams &params, QString &error)
+    {
+        bool isSuccess = false;
+        const QMetaObject::Connection successConnection = QObject::connect(&creator, &TorrentCreatorThread::creationSuccess
+                , &creator, [&isSuccess]() { isSuccess = true; }, Qt::DirectConnection);
+        const QMetaObject::Connection failureConnection = QObject::connect(&creator, &TorrentCreatorThread::creationFailure
+                , &creator, [&error](const QString &msg) { error = msg; }, Qt::DirectConnection);
+        creator.create(params);
+        creator.wait();
+        QObject::disconnect(successConnection);
+        QObject::disconnect(failureConnection);
+        return isSuccess;
+    }
+
+    // reference hashes are calculated over the whole content at once
+    QVector<QByteArray> calculatePieceHashes(const lt::torrent_info &info, const Path &basePath)
+    {
+        const lt::file_storage &fs = info.files();
+
+        QByteArray content;
+        for (const lt::file_index_t index : fs.file_range())
+        {
+            if (fs.pad_file_at(index))
+            {
+                content.append(QByteArray(static_cast<int>(fs.file_size(index)), '\0'));
+                continue;
+            }
+
+            QFile file {QString::fromStdString(fs.file_path(index, basePath.toString().toStdString()))};
+            if (file.open(QIODevice::ReadOnly))
+                content.append(file.readAll());
+        }
+
+        QVector<QByteArray> hashes;
+        for (int i = 0; i < info.num_pieces(); ++i)
+            hashes.append(QCryptographicHash::hash(content.mid((i * info.piece_length()), info.piece_length()), QCryptographicHash::Sha1));
+        return hashes;
+    }
+
+    void verifyPieceHashes(const Path &torrentPath, const Path &basePath)
+    {
+        const lt::torrent_info info {torrentPath.toString().toStdString()};
+        const QVector<QByteArray> expectedHashes = calculatePieceHashes(info, basePath);
+        QCOMPARE(info.num_pieces(), expectedHashes.size());
+        for (int i = 0; i < info.num_pieces(); ++i)
+            QCOMPARE(QByteArray::fromStdString(info.hash_for_piece(lt::piece_index_t {i}).to_string()), expectedHashes[i]);
+    }
+}
+
+class TestBittorrentTorrentCreatorThread final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestBittorrentTorrentCreatorThread)
+
+public:
+    TestBittorrentTorrentCreatorThread() = default;
+
+private slots:
+    void testV1PieceHashes() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path inputPath = Path(dir.path()) / Path(u"content"_qs);
+        QVERIFY(generateFileTree(inputPath, {0, 1, 100'000, (3 * PIECE_SIZE), (PIECE_SIZE - 1), (5 * 1024 * 1024) + 17}));
+
+        const Path savePath = Path(dir.path()) / Path(u"content.torrent"_qs);
+        TorrentCreatorThread creator;
+        QString error;
+        QVERIFY2(createTorrent(creator, makeParams(inputPath, savePath), error), qPrintable(error));
+
+        verifyPieceHashes(savePath, Path(dir.path()));
+    }
+
+    void testSingleFile() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path inputPath = Path(dir.path()) / Path(u"file.bin"_qs);
+        QVERIFY(writeFile(inputPath, generateData(((2 * PIECE_SIZE) + 1), 42)));
+
+        const Path savePath = Path(dir.path()) / Path(u"file.torrent"_qs);
+        TorrentCreatorThread creator;
+        QString error;
+        QVERIFY2(createTorrent(creator, makeParams(inputPath, savePath), error), qPrintable(error));
+
+        verifyPieceHashes(savePath, Path(dir.path()));
+    }
+
+    void testPadFiles() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path inputPath = Path(dir.path()) / Path(u"content"_qs);
+        QVERIFY(generateFileTree(inputPath, {1000, (PIECE_SIZE + 3), 5000, (2 * PIECE_SIZE)}));
+
+        const Path savePath = Path(dir.path()) / Path(u"content.torrent"_qs);
+        TorrentCreatorParams params = makeParams(inputPath, savePath);
+#ifdef QBT_USES_LIBTORRENT2
+        params.torrentFormat = TorrentFormat::Hybrid;
+#else
+        params.isAlignmentOptimized = true;
+#endif
+        TorrentCreatorThread creator;
+        QString error;
+        QVERIFY2(createTorrent(creator, params, error), qPrintable(error));
+
+        verifyPieceHashes(savePath, Path(dir.path()));
+    }
+
+    void testV1PadFiles() const
+    {
+        // v1 torrents get pad files only on libtorrent 1.2 (see testPadFiles),
+        // so the torrent is prepared manually to hash them on any version
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const QVector<int> fileSizes {1000, (PIECE_SIZE + 3), 5000};
+        const Path inputPath = Path(dir.path()) / Path(u"content"_qs);
+        QVERIFY(generateFileTree(inputPath, fileSizes));
+
+        lt::file_storage fs;
+        for (int i = 0; i < fileSizes.size(); ++i)
+        {
+            const QString filePath = u"content/dir%1/file%2.bin"_qs.arg(QString::number(i % 3), QString::number(i));
+            fs.add_file(filePath.toStdString(), fileSizes[i]);
+
+            const int padSize = PIECE_SIZE - (fileSizes[i] % PIECE_SIZE);
+            if (i < (fileSizes.size() - 1))
+                fs.add_file(u"content/.pad/%1"_qs.arg(padSize).toStdString(), padSize, lt::file_storage::flag_pad_file);
+        }
+
+#ifdef QBT_USES_LIBTORRENT2
+        lt::create_torrent newTorrent {fs, PIECE_SIZE, lt::create_torrent::v1_only};
+#else
+        lt::create_torrent newTorrent {fs, PIECE_SIZE, -1, {}};
+#endif
+        QVERIFY(newTorrent.files().pad_file_at(lt::file_index_t {1}));
+
+        TorrentCreatorThread creator;
+        creator.calculateV1PieceHashes(newTorrent, Path(dir.path()));
+
+        std::vector<char> torrentData;
+        lt::bencode(std::back_inserter(torrentData), newTorrent.generate());
+        const Path savePath = Path(dir.path()) / Path(u"content.torrent"_qs);
+        QVERIFY(writeFile(savePath, QByteArray(torrentData.data(), static_cast<int>(torrentData.size()))));
+
+        verifyPieceHashes(savePath, Path(dir.path()));
+    }
+
+    void testAbort() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path inputPath = Path(dir.path()) / Path(u"content"_qs);
+        // content is read in several batches
+        QVERIFY(generateFileTree(inputPath, {(96 * PIECE_SIZE), (96 * PIECE_SIZE)}));
+
+        const Path savePath = Path(dir.path()) / Path(u"content.torrent"_qs);
+        TorrentCreatorThread creator;
+        // progress is first reported before any piece is hashed,
+        // so interrupt the creation once the first batch is reported
+        int progressReports = 0;
+        connect(&creator, &TorrentCreatorThread::updateProgress, &creator, [&creator, &progressReports]()
+        {
+            if (++progressReports == 2)
+                creator.requestInterruption();
+        }, Qt::DirectConnection);
+
+        QString error;
+        QVERIFY(!createTorrent(creator, makeParams(inputPath, savePath), error));
+        QVERIFY(!error.isEmpty());
+        QVERIFY(!savePath.exists());
+        // no more batches are processed after the interruption
+        QCOMPARE(progressReports, 2);
+    }
+
+    void benchmarkCreate() const
+    {
+        QTemporaryDir dir;
+        QVERIFY(dir.isValid());
+
+        const Path inputPath = Path(dir.path()) / Path(u"content"_qs);
+        QVERIFY(generateFileTree(inputPath, QVector<int>(BENCHMARK_FILE_COUNT, BENCHMARK_FILE_SIZE)));
+
+        const Path savePath = Path(dir.path()) / Path(u"content.torrent"_qs);
+        TorrentCreatorThread creator;
+        QString error;
+        QBENCHMARK
+        {
+            QVERIFY2(createTorrent(creator, makeParams(inputPath, savePath), error), qPrintable(error));
+        }
+    }
+};
+
+QTEST_GUILESS_MAIN(TestBittorrentTorrentCreatorThread)
+#include "testbittorrenttorrentcreatorthread.moc"
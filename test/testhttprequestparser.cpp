@@ -0,0 +1,229 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <algorithm>
+
+#include <QByteArray>
+#include <QTest>
+
+#include "base/global.h"
+#include "base/http/requestparser.h"
+#include "base/http/types.h"
+
+using namespace Http;
+
+namespace
+{
+    const QByteArray BOUNDARY = "----qbtBoundary1234";
+    const int CHUNK_SIZE = 64 * 1024;
+
+    QByteArray multipartRequest(const QByteArray &fileData)
+    {
+        QByteArray body;
+        body.append("--" + BOUNDARY + "\r\n");
+        body.append("Content-Disposition: form-data; name=\"category\"\r\n\r\n");
+        body.append("linux\r\n");
+        body.append("--" + BOUNDARY + "\r\n");
+        body.append("Content-Disposition: form-data; name=\"torrents\"; filename=\"file.torrent\"\r\n");
+        body.append("Content-Type: application/x-bittorrent\r\n\r\n");
+        body.append(fileData);
+        body.append("\r\n");
+        body.append("--" + BOUNDARY + "--\r\n");
+
+        QByteArray request;
+        request.append("POST /api/v2/torrents/add HTTP/1.1\r\n");
+        request.append("Host: localhost\r\n");
+        request.append("Content-Type: multipart/form-data; boundary=" + BOUNDARY + "\r\n");
+        request.append("Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n");
+        request.append(body);
+        return request;
+    }
+
+    QByteArray generateData(const int size)
+    {
+        QByteArray data;
+        data.reserve(size);
+
+        quint32 state = 12345;
+        for (int i = 0; i < size; ++i)
+        {
+            state = (state * 1103515245) + 12345;
+            data.append(static_cast<char>(state >> 24));
+        }
+
+        return data;
+    }
+}
+
+class TestHttpRequestParser final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestHttpRequestParser)
+
+public:
+    TestHttpRequestParser() = default;
+
+private slots:
+    void testGet() const
+    {
+        const QByteArray data = "GET /api/v2/app/version?a=1&b=%20x HTTP/1.1\r\nHost: localhost\r\nX-Test: value\r\n\r\n";
+        const RequestParser::ParseResult result = RequestParser::parse(data);
+        QCOMPARE(result.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(result.frameSize, static_cast<long>(data.size()));
+        QCOMPARE(result.request.method, u"GET"_qs);
+        QCOMPARE(result.request.path, u"/api/v2/app/version"_qs);
+        QCOMPARE(result.request.query.value(u"a"_qs), QByteArray("1"));
+        QCOMPARE(result.request.query.value(u"b"_qs), QByteArray(" x"));
+        QCOMPARE(result.request.headers.value(u"x-test"_qs), u"value"_qs);
+    }
+
+    void testPostUrlEncoded() const
+    {
+        const QByteArray body = "hashes=abc%7Cdef&name=a+b";
+        const QByteArray data = "POST /api/v2/torrents/pause HTTP/1.1\r\n"
+            "Content-Type: application/x-www-form-urlencoded\r\n"
+            "Content-Length: " + QByteArray::number(body.size()) + "\r\n\r\n" + body;
+        const RequestParser::ParseResult result = RequestParser::parse(data);
+        QCOMPARE(result.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(result.frameSize, static_cast<long>(data.size()));
+        QCOMPARE(result.request.posts.value(u"hashes"_qs), u"abc|def"_qs);
+        QCOMPARE(result.request.posts.value(u"name"_qs), u"a b"_qs);
+    }
+
+    void testMultipart() const
+    {
+        const QByteArray fileData = generateData(1000);
+        const QByteArray data = multipartRequest(fileData);
+        const RequestParser::ParseResult result = RequestParser::parse(data);
+        QCOMPARE(result.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(result.frameSize, static_cast<long>(data.size()));
+        QCOMPARE(result.request.posts.value(u"category"_qs), u"linux"_qs);
+        QCOMPARE(result.request.files.size(), 1);
+        QCOMPARE(result.request.files[0].filename, u"file.torrent"_qs);
+        QCOMPARE(result.request.files[0].type, u"application/x-bittorrent"_qs);
+        QCOMPARE(result.request.files[0].data, fileData);
+    }
+
+    void testIncremental() const
+    {
+        const QByteArray fileData = generateData(1000);
+        const QByteArray data = multipartRequest(fileData);
+
+        RequestParser parser;
+        for (int i = 0; i < (data.size() - 1); ++i)
+        {
+            parser.addData(data.mid(i, 1));
+            QCOMPARE(parser.parseNext().status, RequestParser::ParseStatus::Incomplete);
+        }
+
+        parser.addData(data.right(1));
+        const RequestParser::ParseResult result = parser.parseNext();
+        QCOMPARE(result.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(result.frameSize, static_cast<long>(data.size()));
+        QCOMPARE(result.request.posts.value(u"category"_qs), u"linux"_qs);
+        QCOMPARE(result.request.files.size(), 1);
+        QCOMPARE(result.request.files[0].data, fileData);
+        QCOMPARE(parser.bufferedSize(), 0);
+    }
+
+    void testPipelined() const
+    {
+        const QByteArray first = "GET /first HTTP/1.1\r\n\r\n";
+        const QByteArray second = "GET /second HTTP/1.1\r\n\r\n";
+
+        RequestParser parser;
+        parser.addData(first + second + "GET /thi");
+
+        const RequestParser::ParseResult firstResult = parser.parseNext();
+        QCOMPARE(firstResult.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(firstResult.request.path, u"/first"_qs);
+        QCOMPARE(firstResult.frameSize, static_cast<long>(first.size()));
+
+        const RequestParser::ParseResult secondResult = parser.parseNext();
+        QCOMPARE(secondResult.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(secondResult.request.path, u"/second"_qs);
+
+        QCOMPARE(parser.parseNext().status, RequestParser::ParseStatus::Incomplete);
+        parser.addData("rd HTTP/1.1\r\n\r\n");
+        const RequestParser::ParseResult thirdResult = parser.parseNext();
+        QCOMPARE(thirdResult.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(thirdResult.request.path, u"/third"_qs);
+    }
+
+    void testLargePart() const
+    {
+        const QByteArray fileData = generateData((RequestParser::MAX_PART_BUFFER_SIZE * 2) + 123);
+        const QByteArray data = multipartRequest(fileData);
+
+        RequestParser parser;
+        RequestParser::ParseResult result {RequestParser::ParseStatus::Incomplete, {}, 0};
+        for (int pos = 0; pos < data.size(); pos += CHUNK_SIZE)
+        {
+            parser.addData(data.mid(pos, CHUNK_SIZE));
+            result = parser.parseNext();
+            QVERIFY(parser.bufferedSize() <= (RequestParser::MAX_PART_BUFFER_SIZE + CHUNK_SIZE));
+        }
+
+        QCOMPARE(result.status, RequestParser::ParseStatus::OK);
+        QCOMPARE(result.request.files.size(), 1);
+        QCOMPARE(result.request.files[0].data, fileData);
+        QCOMPARE(result.request.posts.value(u"category"_qs), u"linux"_qs);
+    }
+
+    void testBadRequest() const
+    {
+        QCOMPARE(RequestParser::parse("INVALID\r\n\r\n").status, RequestParser::ParseStatus::BadRequest);
+        QCOMPARE(RequestParser::parse("POST / HTTP/1.1\r\nContent-Length: -1\r\n\r\n").status
+            , RequestParser::ParseStatus::BadRequest);
+        QCOMPARE(RequestParser::parse("POST / HTTP/1.1\r\nContent-Type: multipart/form-data\r\nContent-Length: 4\r\n\r\ntest").status
+            , RequestParser::ParseStatus::BadRequest);
+    }
+
+    void benchmarkUpload() const
+    {
+        const QByteArray data = multipartRequest(generateData(32 * 1024 * 1024));
+
+        int peakBufferedSize = 0;
+        QBENCHMARK
+        {
+            RequestParser parser;
+            for (int pos = 0; pos < data.size(); pos += CHUNK_SIZE)
+            {
+                parser.addData(QByteArray::fromRawData((data.constData() + pos), std::min(CHUNK_SIZE, (data.size() - pos))));
+                peakBufferedSize = std::max(peakBufferedSize, parser.bufferedSize());
+                parser.parseNext();
+            }
+        }
+
+        qInfo("Upload size: %d bytes, peak buffered size: %d bytes", data.size(), peakBufferedSize);
+        QVERIFY(peakBufferedSize <= (RequestParser::MAX_PART_BUFFER_SIZE + (2 * CHUNK_SIZE)));
+    }
+};
+
+QTEST_GUILESS_MAIN(TestHttpRequestParser)
+#include "testhttprequestparser.moc"
@@ -0,0 +1,248 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <iterator>
+#include <memory>
+
+#include <QHostAddress>
+#include <QTemporaryFile>
+#include <QTest>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/net/geoipdatabase.h"
+#include "base/path.h"
+
+namespace
+{
+    // Synthetic database layout:
+    // nodes 0..95 lead to the IPv4 subtree (::/96), any set bit in that range means "no data",
+    // except the very first one which points to the "AU" record (i.e. 8000::/1 is "AU");
+    // nodes 96..350 form a complete tree over the first octet of IPv4 address.
+    const quint32 IPV4_TREE_DEPTH = 8;
+    const quint32 IPV4_TREE_NODES = (1 << IPV4_TREE_DEPTH) - 1;
+    const quint32 NODE_COUNT = 96 + IPV4_TREE_NODES;
+    const int BENCHMARK_SIZE = 100'000;
+
+    const char *const IPV4_COUNTRIES[] = {"US", "DE", "FR", "JP"};
+    const char IPV6_COUNTRY[] = "AU";
+
+    void appendRecord(QByteArray &data, const quint32 value)
+    {
+        data.append(static_cast<char>((value >> 16) & 0xFF));
+        data.append(static_cast<char>((value >> 8) & 0xFF));
+        data.append(static_cast<char>(value & 0xFF));
+    }
+
+    void appendString(QByteArray &data, const QByteArray &str)
+    {
+        data.append(static_cast<char>(0x40 | str.size()));
+        data.append(str);
+    }
+
+    void appendUShort(QByteArray &data, const quint8 value)
+    {
+        data.append(static_cast<char>(0xA1));
+        data.append(static_cast<char>(value));
+    }
+
+    QByteArray countryEntry(const char *isoCode)
+    {
+        QByteArray entry;
+        entry.append(static_cast<char>(0xE1));
+        appendString(entry, "country");
+        entry.append(static_cast<char>(0xE1));
+        appendString(entry, "iso_code");
+        appendString(entry, isoCode);
+        return entry;
+    }
+
+    QByteArray buildDatabase()
+    {
+        QByteArray dataSection;
+        QVector<quint32> ipv4Records;
+        for (const char *isoCode : IPV4_COUNTRIES)
+        {
+            ipv4Records.append(NODE_COUNT + 16 + dataSection.size());
+            dataSection.append(countryEntry(isoCode));
+        }
+        const quint32 ipv6Record = NODE_COUNT + 16 + dataSection.size();
+        dataSection.append(countryEntry(IPV6_COUNTRY));
+
+        QByteArray db;
+        for (quint32 node = 0; node < 96; ++node)
+        {
+            appendRecord(db, node + 1);
+            appendRecord(db, ((node == 0) ? ipv6Record : NODE_COUNT));
+        }
+        for (quint32 k = 0; k < IPV4_TREE_NODES; ++k)
+        {
+            for (const quint32 child : {(2 * k) + 1, (2 * k) + 2})
+            {
+                if (child < IPV4_TREE_NODES)
+                    appendRecord(db, (96 + child));
+                else
+                    appendRecord(db, ipv4Records[(child - IPV4_TREE_NODES) % ipv4Records.size()]);
+            }
+        }
+
+        db.append(QByteArray(16, '\0'));
+        db.append(dataSection);
+
+        db.append("\xab\xcd\xefMaxMind.com");
+        db.append(static_cast<char>(0xE7));  // map with 7 entries
+        appendString(db, "binary_format_major_version");
+        appendUShort(db, 2);
+        appendString(db, "binary_format_minor_version");
+        db.append(static_cast<char>(0xA0));
+        appendString(db, "ip_version");
+        appendUShort(db, 6);
+        appendString(db, "record_size");
+        appendUShort(db, 24);
+        appendString(db, "node_count");
+        db.append(static_cast<char>(0xC2));
+        db.append(static_cast<char>((NODE_COUNT >> 8) & 0xFF));
+        db.append(static_cast<char>(NODE_COUNT & 0xFF));
+        appendString(db, "database_type");
+        appendString(db, "Test-Country");
+        appendString(db, "build_epoch");
+        db.append(static_cast<char>(0x04));  // extended type, 4 bytes
+        db.append(static_cast<char>(0x02));  // Integer64
+        db.append(QByteArray::fromHex("62000000"));
+
+        return db;
+    }
+
+    QString expectedCountry(const quint8 firstOctet)
+    {
+        return QString::fromLatin1(IPV4_COUNTRIES[firstOctet % std::size(IPV4_COUNTRIES)]);
+    }
+
+    QVector<QHostAddress> generateAddresses(const int size)
+    {
+        QVector<QHostAddress> addresses;
+        addresses.reserve(size);
+
+        quint32 state = 12345;
+        for (int i = 0; i < size; ++i)
+        {
+            state = (state * 1103515245) + 12345;
+            addresses.append(QHostAddress(state));
+        }
+
+        return addresses;
+    }
+}
+
+class TestNetGeoIPDatabase final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestNetGeoIPDatabase)
+
+public:
+    TestNetGeoIPDatabase() = default;
+
+private slots:
+    void testLoad() const
+    {
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(buildDatabase(), error)};
+        QVERIFY2(db, qPrintable(error));
+        QCOMPARE(db->type(), u"Test-Country"_qs);
+        QCOMPARE(db->ipVersion(), static_cast<quint16>(6));
+        QCOMPARE(db->buildEpoch().toSecsSinceEpoch(), Q_INT64_C(0x62000000));
+    }
+
+    void testLoadFile() const
+    {
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        QVERIFY(file.write(buildDatabase()) > 0);
+        QVERIFY(file.flush());
+
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(Path(file.fileName()), error)};
+        QVERIFY2(db, qPrintable(error));
+        QCOMPARE(db->lookup(QHostAddress(u"1.2.3.4"_qs)), expectedCountry(1));
+        QCOMPARE(db->lookup(QHostAddress(u"203.0.113.1"_qs)), expectedCountry(203));
+    }
+
+    void testLoadInvalid() const
+    {
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(QByteArray("invalid"), error)};
+        QVERIFY(!db);
+        QVERIFY(!error.isEmpty());
+    }
+
+    void testLookupIPv4() const
+    {
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(buildDatabase(), error)};
+        QVERIFY2(db, qPrintable(error));
+
+        for (int octet = 0; octet < 256; ++octet)
+        {
+            const QHostAddress addr {u"%1.10.20.30"_qs.arg(octet)};
+            QCOMPARE(db->lookup(addr), expectedCountry(octet));
+            // again, served from cache this time
+            QCOMPARE(db->lookup(addr), expectedCountry(octet));
+        }
+
+        QCOMPARE(db->lookup(QHostAddress(u"::ffff:9.8.7.6"_qs)), expectedCountry(9));
+    }
+
+    void testLookupIPv6() const
+    {
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(buildDatabase(), error)};
+        QVERIFY2(db, qPrintable(error));
+
+        QCOMPARE(db->lookup(QHostAddress(u"fe80::1"_qs)), QString::fromLatin1(IPV6_COUNTRY));
+        QCOMPARE(db->lookup(QHostAddress(u"2001:db8::1"_qs)), QString());
+        // IPv4-compatible address walks the IPv4 subtree the usual way
+        QCOMPARE(db->lookup(QHostAddress(u"::5.6.7.8"_qs)), expectedCountry(5));
+    }
+
+    void benchmarkLookupIPv4() const
+    {
+        QString error;
+        const std::unique_ptr<GeoIPDatabase> db {GeoIPDatabase::load(buildDatabase(), error)};
+        QVERIFY2(db, qPrintable(error));
+
+        const QVector<QHostAddress> addresses = generateAddresses(BENCHMARK_SIZE);
+        QBENCHMARK
+        {
+            for (const QHostAddress &addr : addresses)
+                db->lookup(addr);
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TestNetGeoIPDatabase)
+#include "testnetgeoipdatabase.moc"
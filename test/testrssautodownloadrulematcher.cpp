@@ -0,0 +1,239 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QDateTime>
+#include <QTest>
+#include <QVariantHash>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/rss/rss_article.h"
+#include "base/rss/rss_autodownloadrule.h"
+#include "base/rss/rss_autodownloadrulematcher.h"
+
+namespace
+{
+    const int BENCHMARK_FEEDS_COUNT = 300;
+    const int BENCHMARK_RULES_COUNT = 2'000;
+    const int BENCHMARK_ARTICLES_COUNT = 2'000;
+
+    const QString FEED_A = u"https://example.com/a.rss"_qs;
+    const QString FEED_B = u"https://example.com/b.rss"_qs;
+
+    RSS::AutoDownloadRule makeRule(const QString &name, const QString &mustContain
+            , const QStringList &feedURLs, const bool useRegex = false)
+    {
+        RSS::AutoDownloadRule rule {name};
+        rule.setUseRegex(useRegex);
+        rule.setMustContain(mustContain);
+        rule.setFeedURLs(feedURLs);
+        return rule;
+    }
+
+    QString makeFeedURL(const int index)
+    {
+        return u"https://example.com/feed%1.rss"_qs.arg(index);
+    }
+
+    // Rule set resembling the real one: mostly per-show wildcard rules,
+    // some regex rules and a few ones without any "must contain" expression
+    QList<RSS::AutoDownloadRule> generateRules()
+    {
+        QList<RSS::AutoDownloadRule> rules;
+        rules.reserve(BENCHMARK_RULES_COUNT);
+        for (int i = 0; i < BENCHMARK_RULES_COUNT; ++i)
+        {
+            const QStringList feedURLs {makeFeedURL(i % BENCHMARK_FEEDS_COUNT), makeFeedURL((i * 7) % BENCHMARK_FEEDS_COUNT)};
+            const QString name = u"Rule %1"_qs.arg(i);
+            if ((i % 10) == 0)
+                rules.append(makeRule(name, u"ShowName%1\\.S0\\d"_qs.arg(i), feedURLs, true));
+            else if ((i % 100) == 1)
+                rules.append(makeRule(name, {}, feedURLs));
+            else
+                rules.append(makeRule(name, u"showname%1 1080p|showname%1 720p"_qs.arg(i), feedURLs));
+        }
+
+        return rules;
+    }
+
+    QVector<std::pair<QString, QVariantHash>> generateArticles()
+    {
+        const QDateTime date = QDateTime::currentDateTime();
+
+        QVector<std::pair<QString, QVariantHash>> articles;
+        articles.reserve(BENCHMARK_ARTICLES_COUNT);
+        for (int i = 0; i < BENCHMARK_ARTICLES_COUNT; ++i)
+        {
+            const int show = (i * 13) % (BENCHMARK_RULES_COUNT * 2);
+            const QVariantHash articleData
+            {
+                {RSS::Article::KeyTitle, u"ShowName%1.S0%2E%3.%4.WEB.x264-GROUP"_qs
+                    .arg(QString::number(show), QString::number(i % 9), QString::number(i % 24)
+                         , (((i % 2) == 0) ? u"1080p"_qs : u"480p"_qs))},
+                {RSS::Article::KeyDate, date}
+            };
+            articles.append({makeFeedURL(i % BENCHMARK_FEEDS_COUNT), articleData});
+        }
+
+        return articles;
+    }
+
+    bool isApplicable(const RSS::AutoDownloadRule &rule, const QString &feedURL, const QVariantHash &articleData)
+    {
+        return rule.isEnabled() && rule.feedURLs().contains(feedURL) && rule.matches(articleData);
+    }
+}
+
+class TestRSSAutoDownloadRuleMatcher final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestRSSAutoDownloadRuleMatcher)
+
+public:
+    TestRSSAutoDownloadRuleMatcher() = default;
+
+private slots:
+    void testFeeds() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{
+            makeRule(u"A"_qs, u"ubuntu"_qs, {FEED_A}),
+            makeRule(u"B"_qs, u"ubuntu"_qs, {FEED_B}),
+            makeRule(u"AB"_qs, u"ubuntu"_qs, {FEED_A, FEED_B})
+        }};
+
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Ubuntu 22.04"_qs), QStringList({u"A"_qs, u"AB"_qs}));
+        QCOMPARE(matcher.candidateRules(FEED_B, u"Ubuntu 22.04"_qs), QStringList({u"AB"_qs, u"B"_qs}));
+        QCOMPARE(matcher.candidateRules(u"https://example.com/c.rss"_qs, u"Ubuntu 22.04"_qs), QStringList());
+    }
+
+    void testDisabledRule() const
+    {
+        RSS::AutoDownloadRule rule = makeRule(u"A"_qs, u"ubuntu"_qs, {FEED_A});
+        rule.setEnabled(false);
+        const RSS::AutoDownloadRuleMatcher matcher {{rule}};
+
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Ubuntu 22.04"_qs), QStringList());
+    }
+
+    void testWildcards() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{
+            makeRule(u"Server"_qs, u"ubuntu*server 22.04"_qs, {FEED_A}),
+            makeRule(u"Desktop"_qs, u"debian|ubuntu?desktop"_qs, {FEED_A})
+        }};
+
+        QCOMPARE(matcher.candidateRules(FEED_A, u"UBUNTU-SERVER 22.04 LTS"_qs), QStringList({u"Server"_qs}));
+        // candidates don't have to match completely
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Ubuntu Desktop 22.04"_qs), QStringList({u"Desktop"_qs, u"Server"_qs}));
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Debian 12"_qs), QStringList({u"Desktop"_qs}));
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Fedora 38"_qs), QStringList());
+    }
+
+    void testOverlappingLiterals() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{
+            makeRule(u"A"_qs, u"abcd"_qs, {FEED_A}),
+            makeRule(u"B"_qs, u"bc"_qs, {FEED_A}),
+            makeRule(u"C"_qs, u"cde"_qs, {FEED_A})
+        }};
+
+        QCOMPARE(matcher.candidateRules(FEED_A, u"xabcdex"_qs), QStringList({u"A"_qs, u"B"_qs, u"C"_qs}));
+        QCOMPARE(matcher.candidateRules(FEED_A, u"abcx"_qs), QStringList({u"B"_qs}));
+        QCOMPARE(matcher.candidateRules(FEED_A, u"abccde"_qs), QStringList({u"B"_qs, u"C"_qs}));
+    }
+
+    void testUnconditionalRules() const
+    {
+        const RSS::AutoDownloadRuleMatcher matcher {{
+            makeRule(u"Empty"_qs, {}, {FEED_A}),
+            makeRule(u"Any"_qs, u"*"_qs, {FEED_A}),
+            makeRule(u"EmptyAlternative"_qs, u"ubuntu|"_qs, {FEED_A}),
+            makeRule(u"CharacterSet"_qs, u"[ab]"_qs, {FEED_A}),
+            makeRule(u"Regex"_qs, u"^fedora.*"_qs, {FEED_A}, true),
+            makeRule(u"LiteralRegex"_qs, u"fedora"_qs, {FEED_A}, true)
+        }};
+
+        QCOMPARE(matcher.candidateRules(FEED_A, u"Debian 12"_qs)
+            , QStringList({u"Any"_qs, u"CharacterSet"_qs, u"Empty"_qs, u"EmptyAlternative"_qs, u"Regex"_qs}));
+    }
+
+    void testNoMissedMatches() const
+    {
+        const QList<RSS::AutoDownloadRule> rules = generateRules();
+        const RSS::AutoDownloadRuleMatcher matcher {rules};
+
+        for (const auto &[feedURL, articleData] : asConst(generateArticles()))
+        {
+            const QStringList candidateRules = matcher.candidateRules(feedURL, articleData[RSS::Article::KeyTitle].toString());
+            for (const RSS::AutoDownloadRule &rule : rules)
+            {
+                if (isApplicable(rule, feedURL, articleData))
+                    QVERIFY2(candidateRules.contains(rule.name()), qPrintable(rule.name()));
+            }
+        }
+    }
+
+    void benchmarkAllRules() const
+    {
+        const QList<RSS::AutoDownloadRule> rules = generateRules();
+        const QVector<std::pair<QString, QVariantHash>> articles = generateArticles();
+
+        QBENCHMARK
+        {
+            for (const auto &[feedURL, articleData] : articles)
+            {
+                for (const RSS::AutoDownloadRule &rule : rules)
+                    isApplicable(rule, feedURL, articleData);
+            }
+        }
+    }
+
+    void benchmarkCandidateRules() const
+    {
+        const QList<RSS::AutoDownloadRule> rules = generateRules();
+        const QVector<std::pair<QString, QVariantHash>> articles = generateArticles();
+
+        QHash<QString, RSS::AutoDownloadRule> rulesByName;
+        for (const RSS::AutoDownloadRule &rule : rules)
+            rulesByName.insert(rule.name(), rule);
+
+        QBENCHMARK
+        {
+            const RSS::AutoDownloadRuleMatcher matcher {rules};
+            for (const auto &[feedURL, articleData] : articles)
+            {
+                const QStringList candidateRules = matcher.candidateRules(feedURL, articleData[RSS::Article::KeyTitle].toString());
+                for (const QString &ruleName : candidateRules)
+                    rulesByName[ruleName].matches(articleData);
+            }
+        }
+    }
+};
+
+QTEST_APPLESS_MAIN(TestRSSAutoDownloadRuleMatcher)
+#include "testrssautodownloadrulematcher.moc"
@@ -0,0 +1,218 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QByteArray>
+#include <QDateTime>
+#include <QFile>
+#include <QHash>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QTest>
+#include <QUuid>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/logger.h"
+#include "base/path.h"
+#include "base/rss/feed_serializer.h"
+#include "base/rss/rss_article.h"
+
+using RSS::ArticleData;
+using RSS::Private::FeedSerializer;
+
+namespace
+{
+    const QString FEED_URL = u"https://example.com/feed"_qs;
+
+    ArticleData makeArticle(const QString &guid, const qint64 secsSinceEpoch)
+    {
+        ArticleData article;
+        article.guid = guid;
+        article.date = QDateTime::fromSecsSinceEpoch(secsSinceEpoch);
+        article.title = u"Title of "_qs + guid;
+        article.link = u"https://example.com/"_qs + guid;
+        article.description = u"Description of "_qs + guid;
+        article.extraData = {{u"category"_qs, guid}};
+        return article;
+    }
+
+    QVector<ArticleData> loadArticles(FeedSerializer &serializer, const Path &legacyDataFileName, const int maxArticles = 100)
+    {
+        QSignalSpy spy {&serializer, &FeedSerializer::loadingFinished};
+        serializer.load(legacyDataFileName, FEED_URL, maxArticles);
+        if (spy.count() != 1)
+            return {};
+        return spy.takeFirst().at(0).value<QVector<ArticleData>>();
+    }
+
+    QHash<QString, ArticleData> loadBodies(FeedSerializer &serializer, const QStringList &guids)
+    {
+        QSignalSpy spy {&serializer, &FeedSerializer::articleBodiesLoaded};
+        serializer.loadArticleBodies(guids);
+        if (spy.count() != 1)
+            return {};
+        return spy.takeFirst().at(0).value<QHash<QString, ArticleData>>();
+    }
+
+    QStringList guids(const QVector<ArticleData> &articles)
+    {
+        QStringList list;
+        for (const ArticleData &article : articles)
+            list.append(article.guid);
+        return list;
+    }
+
+    bool writeFile(const Path &path, const QByteArray &data)
+    {
+        QFile file {path.data()};
+        return file.open(QIODevice::WriteOnly) && (file.write(data) == data.size());
+    }
+}
+
+class TestRSSFeedSerializer final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestRSSFeedSerializer)
+
+public:
+    TestRSSFeedSerializer() = default;
+
+private slots:
+    void initTestCase() const
+    {
+        Logger::initInstance();
+    }
+
+    void cleanupTestCase() const
+    {
+        Logger::freeInstance();
+    }
+
+    void cleanup() const
+    {
+        FeedSerializer::closeDatabase();
+    }
+
+    void testStore() const
+    {
+        const QTemporaryDir tmpDir;
+        QVERIFY(tmpDir.isValid());
+        const Path dbPath = Path(tmpDir.path()) / Path(u"articles.sqlite"_qs);
+        const Path legacyPath = Path(tmpDir.path()) / Path(u"feed.json"_qs);
+
+        FeedSerializer serializer {dbPath, QUuid::createUuid()};
+        FeedSerializer otherSerializer {dbPath, QUuid::createUuid()};
+        serializer.addArticles({makeArticle(u"a"_qs, 1000), makeArticle(u"b"_qs, 3000), makeArticle(u"c"_qs, 2000)});
+        otherSerializer.addArticles({makeArticle(u"a"_qs, 1000)});
+        // already stored articles are kept intact
+        serializer.addArticles({makeArticle(u"a"_qs, 5000)});
+        serializer.markAsRead({u"c"_qs});
+
+        const QVector<ArticleData> articles = loadArticles(serializer, legacyPath);
+        QCOMPARE(guids(articles), QStringList({u"b"_qs, u"c"_qs, u"a"_qs}));
+        QCOMPARE(articles[0].title, u"Title of b"_qs);
+        QCOMPARE(articles[0].date, QDateTime::fromSecsSinceEpoch(3000));
+        QVERIFY(!articles[0].isRead);
+        QVERIFY(articles[1].isRead);
+        QCOMPARE(articles[2].date, QDateTime::fromSecsSinceEpoch(1000));
+        // bodies are loaded on demand
+        QVERIFY(articles[0].description.isEmpty());
+        QVERIFY(articles[0].extraData.isEmpty());
+
+        const QHash<QString, ArticleData> bodies = loadBodies(serializer, {u"b"_qs, u"unknown"_qs});
+        QCOMPARE(bodies.size(), 2);
+        QCOMPARE(bodies[u"b"_qs].description, u"Description of b"_qs);
+        QCOMPARE(bodies[u"b"_qs].extraData.value(u"category"_qs).toString(), u"b"_qs);
+        QVERIFY(bodies[u"unknown"_qs].description.isEmpty());
+
+        serializer.removeArticles({u"b"_qs});
+        QCOMPARE(guids(loadArticles(serializer, legacyPath)), QStringList({u"c"_qs, u"a"_qs}));
+
+        // articles out of limit are removed
+        QCOMPARE(guids(loadArticles(serializer, legacyPath, 1)), QStringList({u"c"_qs}));
+        QCOMPARE(guids(loadArticles(serializer, legacyPath)), QStringList({u"c"_qs}));
+
+        // articles of other feeds aren't affected
+        serializer.removeAll();
+        QVERIFY(loadArticles(serializer, legacyPath).isEmpty());
+        QCOMPARE(guids(loadArticles(otherSerializer, legacyPath)), QStringList({u"a"_qs}));
+    }
+
+    void testLegacyImport() const
+    {
+        const QTemporaryDir tmpDir;
+        QVERIFY(tmpDir.isValid());
+        const Path dbPath = Path(tmpDir.path()) / Path(u"articles.sqlite"_qs);
+        const Path legacyPath = Path(tmpDir.path()) / Path(u"feed.json"_qs);
+
+        const QByteArray legacyData = R"([
+            {"id": "old", "date": "Mon, 01 Jan 2018 10:00:00 +0000", "title": "Old", "description": "Old body", "isRead": true},
+            {"id": "new", "date": "Tue, 02 Jan 2018 10:00:00 +0000", "title": "New", "torrentURL": "https://example.com/new.torrent", "category": "linux"},
+            "invalid"
+        ])";
+        QVERIFY(writeFile(legacyPath, legacyData));
+
+        FeedSerializer serializer {dbPath, QUuid::createUuid()};
+        const QVector<ArticleData> articles = loadArticles(serializer, legacyPath);
+        QCOMPARE(guids(articles), QStringList({u"new"_qs, u"old"_qs}));
+        QCOMPARE(articles[0].torrentURL, u"https://example.com/new.torrent"_qs);
+        QCOMPARE(articles[1].date, QDateTime::fromString(u"Mon, 01 Jan 2018 10:00:00 +0000"_qs, Qt::RFC2822Date));
+        QVERIFY(articles[1].isRead);
+        QVERIFY(!legacyPath.exists());
+
+        const QHash<QString, ArticleData> bodies = loadBodies(serializer, {u"old"_qs, u"new"_qs});
+        QCOMPARE(bodies[u"old"_qs].description, u"Old body"_qs);
+        QCOMPARE(bodies[u"new"_qs].extraData.value(u"category"_qs).toString(), u"linux"_qs);
+
+        // already imported articles are loaded from the database only
+        QCOMPARE(guids(loadArticles(serializer, legacyPath)), QStringList({u"new"_qs, u"old"_qs}));
+    }
+
+    void testInvalidLegacyData() const
+    {
+        const QTemporaryDir tmpDir;
+        QVERIFY(tmpDir.isValid());
+        const Path dbPath = Path(tmpDir.path()) / Path(u"articles.sqlite"_qs);
+        const Path legacyPath = Path(tmpDir.path()) / Path(u"feed.json"_qs);
+
+        FeedSerializer serializer {dbPath, QUuid::createUuid()};
+        serializer.addArticles({makeArticle(u"a"_qs, 1000)});
+
+        // the stored articles are still loaded but the data file that can't be parsed is kept
+        QVERIFY(writeFile(legacyPath, R"([{"id": "old", "title": "Truncated)"));
+        QCOMPARE(guids(loadArticles(serializer, legacyPath)), QStringList({u"a"_qs}));
+        QVERIFY(legacyPath.exists());
+
+        QVERIFY(writeFile(legacyPath, R"({"id": "old"})"));
+        QCOMPARE(guids(loadArticles(serializer, legacyPath)), QStringList({u"a"_qs}));
+        QVERIFY(legacyPath.exists());
+    }
+};
+
+QTEST_GUILESS_MAIN(TestRSSFeedSerializer)
+#include "testrssfeedserializer.moc"
@@ -0,0 +1,151 @@
+/*
+ * Bittorrent Client using Qt and libtorrent.
+ * Copyright (C) 2026  agent <agent@local>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+ *
+ * In addition, as a special exception, the copyright holders give permission to
+ * link this program with the OpenSSL project's "OpenSSL" library (or with
+ * modified versions of it that use the same license as the "OpenSSL" library),
+ * and distribute the linked executables. You must obey the GNU General Public
+ * License in all respects for all of the code used other than "OpenSSL".  If you
+ * modify file(s), you may extend this exception to your version of the file(s),
+ * but you are not obligated to do so. If you do not wish to do so, delete this
+ * exception statement from your version.
+ */
+
+#include <QTest>
+#include <QVector>
+
+#include "base/global.h"
+#include "base/search/searchresultstore.h"
+
+namespace
+{
+    SearchResult makeResult(const QString &name, const QString &url, const qlonglong size, const qlonglong seeders, const QString &site = u"https://example.com"_qs)
+    {
+        return {name, url, size, seeders, 0, site, {}};
+    }
+
+    QStringList names(const QVector<SearchResult> &results)
+    {
+        QStringList list;
+        for (const SearchResult &result : results)
+            list.append(result.fileName);
+        return list;
+    }
+}
+
+class TestSearchResultStore final : public QObject
+{
+    Q_OBJECT
+    Q_DISABLE_COPY_MOVE(TestSearchResultStore)
+
+public:
+    TestSearchResultStore() = default;
+
+private slots:
+    void testDeduplication() const
+    {
+        SearchResultStore store;
+
+        const QVector<SearchResult> added = store.addResults(
+        {
+            makeResult(u"Debian"_qs, u"magnet:?xt=urn:btih:ABCDEF0123456789ABCDEF0123456789ABCDEF01&dn=debian"_qs, 100, 10),
+            makeResult(u"Debian copy"_qs, u"magnet:?dn=debian&xt=urn:btih:abcdef0123456789abcdef0123456789abcdef01"_qs, 100, 20, u"https://other.org"_qs),
+            makeResult(u"Ubuntu"_qs, u"https://example.com/ubuntu.torrent"_qs, 200, 5)
+        });
+        QCOMPARE(names(added), QStringList({u"Debian"_qs, u"Ubuntu"_qs}));
+
+        // duplicates are dropped across batches as well
+        QVERIFY(store.addResults({makeResult(u"Ubuntu again"_qs, u"https://example.com/ubuntu.torrent"_qs, 200, 7)}).isEmpty());
+        QCOMPARE(store.size(), 2);
+
+        // results without any URL cannot be identified, so they are kept
+        QCOMPARE(store.addResults({makeResult(u"A"_qs, {}, 1, 1), makeResult(u"B"_qs, {}, 1, 1)}).size(), 2);
+        QCOMPARE(store.size(), 4);
+    }
+
+    void testFilter() const
+    {
+        SearchResultStore store;
+        store.addResults(
+        {
+            makeResult(u"Linux Mint Cinnamon"_qs, u"url1"_qs, 3000, 50),
+            makeResult(u"Linux Mint Xfce"_qs, u"url2"_qs, 2000, 5),
+            makeResult(u"FreeBSD"_qs, u"url3"_qs, 1000, 100),
+            makeResult(u"linux kernel"_qs, u"url4"_qs, 100, 500),
+            makeResult(u"Unknown"_qs, u"url5"_qs, -1, -1)
+        });
+
+        SearchResultQuery query;
+        QCOMPARE(store.query(query).matchedCount, 5);
+
+        query.filter.nameTerms = QStringList {u"MINT"_qs, u"linux"_qs};
+        QCOMPARE(names(store.query(query).results), QStringList({u"Linux Mint Cinnamon"_qs, u"Linux Mint Xfce"_qs}));
+
+        // results with unknown size or seeders are kept unless the bound is set
+        query.filter = {};
+        query.filter.maxSize = 100;
+        query.filter.maxSeeds = 500;
+        QCOMPARE(names(store.query(query).results), QStringList({u"linux kernel"_qs, u"Unknown"_qs}));
+
+        query.filter.nameTerms.clear();
+        query.filter.minSize = 1000;
+        query.filter.maxSize = 2000;
+        QCOMPARE(names(store.query(query).results), QStringList({u"Linux Mint Xfce"_qs, u"FreeBSD"_qs}));
+
+        query.filter = {};
+        query.filter.minSeeds = 50;
+        query.filter.maxSeeds = 100;
+        const SearchResultPage page = store.query(query);
+        QCOMPARE(page.matchedCount, 2);
+        QCOMPARE(names(page.results), QStringList({u"Linux Mint Cinnamon"_qs, u"FreeBSD"_qs}));
+    }
+
+    void testSortAndPaging() const
+    {
+        SearchResultStore store;
+        store.addResults(
+        {
+            makeResult(u"file10"_qs, u"url1"_qs, 30, 1),
+            makeResult(u"file2"_qs, u"url2"_qs, 10, 3),
+            makeResult(u"File1"_qs, u"url3"_qs, 20, 2)
+        });
+
+        SearchResultQuery query;
+        query.sortField = SearchResultSortField::Name;
+        QCOMPARE(names(store.query(query).results), QStringList({u"File1"_qs, u"file2"_qs, u"file10"_qs}));
+
+        query.sortField = SearchResultSortField::Size;
+        query.sortOrder = Qt::DescendingOrder;
+        QCOMPARE(names(store.query(query).results), QStringList({u"file10"_qs, u"File1"_qs, u"file2"_qs}));
+
+        query.sortField = SearchResultSortField::Seeders;
+        query.sortOrder = Qt::AscendingOrder;
+        query.offset = 1;
+        query.limit = 1;
+        const SearchResultPage page = store.query(query);
+        QCOMPARE(page.matchedCount, 3);
+        QCOMPARE(names(page.results), QStringList({u"File1"_qs}));
+
+        query.offset = 5;
+        query.limit = -1;
+        QVERIFY(store.query(query).results.isEmpty());
+    }
+};
+
+QTEST_APPLESS_MAIN(TestSearchResultStore)
+#include "testsearchresultstore.moc"
@@ -26,8 +26,12 @@
  * exception statement from your version.
  */
 
+#include <algorithm>
+#include <iterator>
 #include <tuple>
+#include <vector>
 
+#include <QStringList>
 #include <QTest>
 
 #include "base/global.h"
@@ -144,8 +148,8 @@ class TestUtilsCompare final : public QObject
 public:
     TestUtilsCompare() = default;
 
-#ifndef QBT_USE_QCOLLATOR  // only test qbt own implementation, not QCollator
 private slots:
+#ifndef QBT_USE_QCOLLATOR  // only test qbt own implementation, not QCollator
     void testNaturalCompareCaseInsensitive() const
     {
         const Utils::Compare::NaturalCompare<Qt::CaseInsensitive> cmp;
@@ -177,7 +181,114 @@ private slots:
         for (const TestData &data : testData)
             testLessThan(data, cmp(data.lhs, data.rhs), data.caseSensitiveResult);
     }
+
+    void testNaturalSortKeyCaseInsensitive() const
+    {
+        using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>;
+
+        for (const TestData &data : testData)
+            testCompare(data, SortKey(data.lhs).compare(SortKey(data.rhs)), data.caseInsensitiveResult);
+    }
+
+    void testNaturalSortKeyCaseSensitive() const
+    {
+        using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseSensitive>;
+
+        for (const TestData &data : testData)
+            testCompare(data, SortKey(data.lhs).compare(SortKey(data.rhs)), data.caseSensitiveResult);
+    }
+
+    void testNaturalSortKeyNonASCIIDigits() const
+    {
+        using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseSensitive>;
+
+        // digits of other scripts are ordered by their values
+        const QString arabicIndicTwo = u"\u0662"_qs;
+        QVERIFY(SortKey(u"a1"_qs) < SortKey(u"a"_qs + arabicIndicTwo));
+        QVERIFY(SortKey(u"a"_qs + arabicIndicTwo) < SortKey(u"a3"_qs));
+        QVERIFY(SortKey(u"a"_qs + arabicIndicTwo) < SortKey(u"a10"_qs));
+        QVERIFY(SortKey(u"a/"_qs) < SortKey(u"a"_qs + arabicIndicTwo));
+        QVERIFY(SortKey(u"a"_qs + arabicIndicTwo) < SortKey(u"a:"_qs));
+    }
 #endif
+
+    void testNaturalSortKeyMatchesNaturalCompare() const
+    {
+        const Utils::Compare::NaturalCompare<Qt::CaseInsensitive> cmp;
+        using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>;
+
+        const QStringList strings = generateNames(500);
+        std::vector<SortKey> keys;
+        keys.reserve(strings.size());
+        for (const QString &str : strings)
+            keys.emplace_back(str);
+
+        for (int i = 0; i < strings.size(); ++i)
+        {
+            for (int j = 0; j < strings.size(); ++j)
+            {
+                const int expected = cmp(strings[i], strings[j]);
+                const int actual = keys[i].compare(keys[j]);
+                QVERIFY2(((expected < 0) == (actual < 0)) && ((expected > 0) == (actual > 0))
+                    , qPrintable(u"LHS: \"%1\". RHS: \"%2\""_qs.arg(strings[i], strings[j])));
+            }
+        }
+    }
+
+    void benchmarkSortNaturalCompare() const
+    {
+        const QStringList strings = generateNames(BENCHMARK_SIZE);
+        const Utils::Compare::NaturalLessThan<Qt::CaseInsensitive> naturalLessThan {};
+
+        QBENCHMARK
+        {
+            QStringList sorted = strings;
+            std::sort(sorted.begin(), sorted.end(), naturalLessThan);
+        }
+    }
+
+    void benchmarkSortNaturalSortKey() const
+    {
+        const QStringList strings = generateNames(BENCHMARK_SIZE);
+        using SortKey = Utils::Compare::NaturalSortKey<Qt::CaseInsensitive>;
+
+        std::vector<SortKey> keys;
+        keys.reserve(strings.size());
+        for (const QString &str : strings)
+            keys.emplace_back(str);
+
+        QBENCHMARK
+        {
+            std::vector<SortKey> sorted = keys;
+            std::sort(sorted.begin(), sorted.end());
+        }
+    }
+
+private:
+    static constexpr int BENCHMARK_SIZE = 100'000;
+
+    // Generates torrent-like names, e.g. "Show.alpha.S1E12.720p"
+    static QStringList generateNames(const int count)
+    {
+        const QString words[] = {u"alpha"_qs, u"Beta"_qs, u"GAMMA"_qs, u"delta"_qs, u"Show"_qs, u"ubuntu"_qs, u"x264"_qs};
+
+        QStringList result;
+        result.reserve(count);
+        quint32 seed = 42;
+        const auto next = [&seed]() -> quint32
+        {
+            // deterministic LCG so benchmark runs are comparable
+            seed = (seed * 1103515245) + 12345;
+            return (seed >> 16);
+        };
+        for (int i = 0; i < count; ++i)
+        {
+            result.append(u"%1.%2.S%3E%4.%5p"_qs
+                .arg(words[next() % std::size(words)], words[next() % std::size(words)]
+                    , QString::number(next() % 20), QString::number(next() % 120), QString::number(next() % 2000)));
+        }
+        return result;
+    }
 };
 
 QTEST_APPLESS_MAIN(TestUtilsCompare)